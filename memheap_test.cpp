@@ -23,10 +23,15 @@
 #include "xmem_comm.h"
 
 #include <stdio.h>
+#include <assert.h>
 #include <chrono>
 
 ////////////////////////////////////////////////////////////////////////////////
 
+#define XVERIFY(xptr) do { if (!(xptr)) assert(0); } while (0)
+
+////////////////////////////////////////////////////////////////////////////////
+
 void test_xmheap(void)
 {
     xchunk_memptr_t xchunk_ptr = X_NULL;
@@ -49,11 +54,75 @@ void test_xmheap(void)
     xmheap_destroy(xmheap_ptr);
 }
 
+void test_xmheap_decay(void)
+{
+    xchunk_memptr_t xchunk_ptr[4] = { X_NULL };
+    xmheap_handle_t xmheap_ptr = xmheap_create( 32 * 1024 * 1024,
+                                               512 * 1024 * 1024);
+
+    x_int32_t  xit_iter   = 0;
+    x_int32_t  xit_error  = XMEM_ERR_OK;
+    x_uint64_t xut_base   = 0;
+    x_uint64_t xsize_idle = 0;
+    x_uint64_t xsize_last = 0;
+
+    const x_uint32_t xut_decay_ms = 1000;
+
+    xmheap_set_decay(xmheap_ptr, xut_decay_ms);
+    xut_base = xsys_msecs();
+
+    //======================================
+    // ÿڴռһ ڴ飬ȫպ󣬸Ϊ״̬
+
+    for (xit_iter = 0; xit_iter < 4; ++xit_iter)
+    {
+        xchunk_ptr[xit_iter] = xmheap_alloc(xmheap_ptr,
+                                            24 * 1024 * 1024,
+                                            (xowner_handle_t)xmheap_ptr);
+        XVERIFY(X_NULL != xchunk_ptr[xit_iter]);
+        memset(xchunk_ptr[xit_iter], 0xA5, 24 * 1024 * 1024);
+    }
+
+    for (xit_iter = 0; xit_iter < 4; ++xit_iter)
+    {
+        xit_error = xmheap_recyc(xmheap_ptr, xchunk_ptr[xit_iter]);
+        XVERIFY(XMEM_ERR_OK == xit_error);
+    }
+
+    //======================================
+    // ¼鵽Ŀ鲻ᱻ黹֮󰴰˥ڣģʱ㣩𲽹黹
+
+    xsize_idle = xmheap_valid_size(xmheap_ptr);
+    xsize_last = xmheap_tick(xmheap_ptr, xut_base);
+    XVERIFY(0 == xsize_last);
+    XVERIFY(xsize_idle == xmheap_valid_size(xmheap_ptr));
+
+    xsize_last = xsize_idle;
+    for (xit_iter = 1; xit_iter <= 200; ++xit_iter)
+    {
+        xut_base += (xut_decay_ms / 4);
+        xmheap_tick(xmheap_ptr, xut_base);
+        XVERIFY(xmheap_valid_size(xmheap_ptr) <= xsize_last);
+        xsize_last = xmheap_valid_size(xmheap_ptr);
+    }
+
+    XVERIFY(0 == xmheap_valid_size(xmheap_ptr));
+
+    printf("[DECAY  ] heap valid : %.3lf MB -> %.3lf MB\n",
+           xsize_idle / (1024.0 * 1024.0),
+           xmheap_valid_size(xmheap_ptr) / (1024.0 * 1024.0));
+
+    //======================================
+
+    xmheap_destroy(xmheap_ptr);
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 
 int main(int argc, char * argv[])
 {
     test_xmheap();
+    test_xmheap_decay();
 
     return 0;
 }
@@ -28,14 +28,25 @@
 #include <assert.h>
 #include <inttypes.h>
 #include <chrono>
+#include <algorithm>
+#include <thread>
+#include <atomic>
 
 #ifdef _MSC_VER
 #include <windows.h>
 #else // !_MSC_VER
 #include <unistd.h>
+#include <signal.h>
 #include <sys/mman.h>
+#include <sys/wait.h>
 #endif // _MSC_VER
 
+#ifdef __linux__
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <linux/perf_event.h>
+#endif // __linux__
+
 ////////////////////////////////////////////////////////////////////////////////
 
 #define XVERIFY(xptr) do { if (!(xptr)) assert(0); } while (0)
@@ -75,6 +86,69 @@ x_void_t heap_free(x_void_t * xmt_heap,
 
 ////////////////////////////////////////////////////////////////////////////////
 
+/**
+ * 统计调用线程的 L1 数据缓存读未命中次数（Linux perf_event），
+ * 不支持（或无权限）时，stop() 返回 -1 。
+ */
+class xcache_miss_t
+{
+public:
+    xcache_miss_t(void) : m_xit_fd(-1)
+    {
+#ifdef __linux__
+        struct perf_event_attr xattr;
+        memset(&xattr, 0, sizeof(xattr));
+        xattr.type           = PERF_TYPE_HW_CACHE;
+        xattr.size           = sizeof(xattr);
+        xattr.config         = PERF_COUNT_HW_CACHE_L1D |
+                               (PERF_COUNT_HW_CACHE_OP_READ << 8) |
+                               (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+        xattr.disabled       = 1;
+        xattr.exclude_kernel = 1;
+        xattr.exclude_hv     = 1;
+        m_xit_fd = (x_int32_t)syscall(__NR_perf_event_open, &xattr, 0, -1, -1, 0);
+#endif // __linux__
+    }
+
+    ~xcache_miss_t(void)
+    {
+#ifdef __linux__
+        if (m_xit_fd >= 0)
+            close(m_xit_fd);
+#endif // __linux__
+    }
+
+    x_void_t start(void)
+    {
+#ifdef __linux__
+        if (m_xit_fd >= 0)
+        {
+            ioctl(m_xit_fd, PERF_EVENT_IOC_RESET, 0);
+            ioctl(m_xit_fd, PERF_EVENT_IOC_ENABLE, 0);
+        }
+#endif // __linux__
+    }
+
+    x_int64_t stop(void)
+    {
+        x_int64_t xit_count = -1;
+#ifdef __linux__
+        if (m_xit_fd >= 0)
+        {
+            ioctl(m_xit_fd, PERF_EVENT_IOC_DISABLE, 0);
+            if (sizeof(xit_count) != read(m_xit_fd, &xit_count, sizeof(xit_count)))
+                xit_count = -1;
+        }
+#endif // __linux__
+        return xit_count;
+    }
+
+private:
+    x_int32_t m_xit_fd;
+};
+
+////////////////////////////////////////////////////////////////////////////////
+
 xmheap_handle_t xmheap_ptr = X_NULL;
 
 x_void_t * vx_alloc(x_size_t xst_size,
@@ -281,59 +355,2135 @@ void test_malloc2(x_int32_t xit_test_count, x_int32_t xit_alloc_count, x_int32_t
 
 //====================================================================
 
-int main(int argc, char * argv[])
+void test_xmpool_remote(x_int32_t xit_test_count, x_int32_t xit_alloc_count, x_int32_t xit_test_size)
 {
-    x_int32_t xit_test_count  = 100;
-    x_int32_t xit_alloc_count = 0;
-    x_int32_t xit_test_size   = (32 * 1024);
-    x_int32_t xit_first_test  = 0;
+    x_int32_t xit_iter = 0;
+    x_int32_t xit_kter = 0;
 
-    printf("Usage: \n%s < test count > < alloc count [0] > < test size[32768] > < first_test [0] : 0 or 1 >\n\n", argv[0]);
+    xtime_point xtm_begin;
+    xtime_value xtm_value;
 
-    if (argc >= 2) xit_test_count  = atoi(argv[1]);
-    if (argc >= 3) xit_alloc_count = atoi(argv[2]);
-    if (argc >= 4) xit_test_size   = atoi(argv[3]);
-    if (argc >= 5) xit_first_test  = atoi(argv[4]);
+    xmheap_holder_t xholder;
 
-    printf("test  count: %10d\n", xit_test_count );
-    printf("alloc count: %10d\n", xit_alloc_count);
-    printf("test  size : %10d\n", xit_test_size  );
+    xmem_slice_t  * xmem_slice = (xmem_slice_t *)calloc(xit_alloc_count, sizeof(xmem_slice_t));
+    xmpool_handle_t xmpool_ptr = xmpool_create(&vx_alloc, &vx_free, X_NULL);
 
-    if (xit_alloc_count > 0)
-        printf("Tatol count: %10d\n", xit_test_count * xit_alloc_count * xit_test_size);
-    else
-        printf("Tatol count: %10d\n", xit_test_count * xit_test_size);
+    //======================================
+    // 工作线程申请分片，多个线程交错回收分片（fan-in）
 
-    printf("//======================================\n");
+    const x_int32_t XRECYC_THREADS = 4;
 
-    if (0 != xit_first_test)
+    xtm_begin = xtime_clock::now();
+    for (xit_iter = 0; xit_iter < xit_test_count; ++xit_iter)
     {
-        if (xit_alloc_count > 0)
+        for (xit_kter = 0; xit_kter < xit_alloc_count; ++xit_kter)
         {
-            test_xmpool2(xit_test_count, xit_alloc_count, xit_test_size);
-            test_malloc2(xit_test_count, xit_alloc_count, xit_test_size);
+            xmem_slice[xit_kter] = xmpool_alloc(xmpool_ptr, 1 + (xit_kter % xit_test_size));
+            assert(X_NULL != xmem_slice[xit_kter]);
+            xmem_slice[xit_kter][0] = (x_byte_t)xit_kter;
         }
-        else
+
+        std::thread xthread_recyc[XRECYC_THREADS];
+        for (x_int32_t xit_thread = 0; xit_thread < XRECYC_THREADS; ++xit_thread)
         {
-            test_xmpool1(xit_test_count, xit_test_size);
-            test_malloc1(xit_test_count, xit_test_size);
+            xthread_recyc[xit_thread] = std::thread([&, xit_thread]() -> void
+            {
+                for (x_int32_t xit_jter = xit_thread; xit_jter < xit_alloc_count; xit_jter += XRECYC_THREADS)
+                {
+                    XVERIFY(XMEM_ERR_OK == xmpool_recyc(xmpool_ptr, xmem_slice[xit_jter]));
+                }
+            });
+        }
+
+        for (x_int32_t xit_thread = 0; xit_thread < XRECYC_THREADS; ++xit_thread)
+        {
+            xthread_recyc[xit_thread].join();
         }
     }
-    else
+
+    xmpool_release_unused(xmpool_ptr);
+    XVERIFY(0 == xmpool_using_size(xmpool_ptr));
+
+    xtm_value = xtime_dcast(xtime_clock::now() - xtm_begin);
+    printf("[POOL, R] time cost : %12" PRId64 " ns\n", xtm_value.count());
+    printf("[POOL, R] alloc/free: %12.6lf ns\n", xtm_value.count() / (1.0 * xit_test_count * xit_alloc_count));
+
+    //======================================
+
+    xmpool_destroy(xmpool_ptr);
+    free(xmem_slice);
+}
+
+void test_xmpool_remote_churn(x_int32_t xit_test_count, x_int32_t xit_alloc_count, x_int32_t xit_test_size, x_uint32_t xut_flags)
+{
+    x_int32_t xit_iter = 0;
+    x_int32_t xit_kter = 0;
+    x_int32_t xit_mode = (0 != (xut_flags & XMPOOL_FLAG_ALIGN_CHUNK)) ? 'A' : 'T';
+    x_uint64_t xut_now = 0;
+
+    xtime_point xtm_begin;
+    xtime_value xtm_value;
+
+    xmpool_handle_t xmpool_ptr = xmpool_create_ex(X_NULL, X_NULL, X_NULL, xut_flags);
+    XVERIFY(X_NULL != xmpool_ptr);
+
+    //======================================
+    // 工作线程不停地 申请/回收 分片，并释放 空闲 chunk 对象（保留上限、衰减、release_unused），
+    // 与此同时，多个线程经由交接槽回收同一批 chunk 对象中的分片；
+    // 用于验证 chunk 对象不会在其他线程的回收操作尚未完成时被释放
+
+    const x_int32_t XRECYC_THREADS = 4;
+    const x_int32_t XHANDOFF_SLOTS = 64;
+
+    std::atomic< xmem_slice_t > xslice_slot[XHANDOFF_SLOTS];
+    std::atomic< bool > xbt_stop(false);
+
+    for (xit_kter = 0; xit_kter < XHANDOFF_SLOTS; ++xit_kter)
     {
-        if (xit_alloc_count > 0)
+        xslice_slot[xit_kter].store(X_NULL);
+    }
+
+    xmpool_set_decay(xmpool_ptr, 1);
+
+    std::thread xthread_recyc[XRECYC_THREADS];
+    for (x_int32_t xit_thread = 0; xit_thread < XRECYC_THREADS; ++xit_thread)
+    {
+        xthread_recyc[xit_thread] = std::thread([&, xit_thread]() -> void
         {
-            test_malloc2(xit_test_count, xit_alloc_count, xit_test_size);
-            test_xmpool2(xit_test_count, xit_alloc_count, xit_test_size);
+            xmem_slice_t xmem_slice = X_NULL;
+
+            while (!xbt_stop.load())
+            {
+                for (x_int32_t xit_jter = xit_thread; xit_jter < XHANDOFF_SLOTS; xit_jter += XRECYC_THREADS)
+                {
+                    xmem_slice = xslice_slot[xit_jter].exchange(X_NULL);
+                    if (X_NULL != xmem_slice)
+                    {
+                        XVERIFY(XMEM_ERR_OK == xmpool_recyc(xmpool_ptr, xmem_slice));
+                    }
+                }
+            }
+        });
+    }
+
+    xmem_slice_t * xmem_slice = (xmem_slice_t *)calloc(xit_alloc_count, sizeof(xmem_slice_t));
+    xmem_slice_t   xslice_old = X_NULL;
+
+    srand(0xC0FE);
+
+    xtm_begin = xtime_clock::now();
+    for (xit_iter = 0; xit_iter < xit_test_count; ++xit_iter)
+    {
+        for (xit_kter = 0; xit_kter < xit_alloc_count; ++xit_kter)
+        {
+            // 偶尔申请大块分片，使其经由其他线程回收后进入大块缓存
+            xmem_slice[xit_kter] = xmpool_alloc(
+                xmpool_ptr, (0 == (rand() % 251)) ? (128 * 1024) : (1 + (rand() % xit_test_size)));
+            XVERIFY(X_NULL != xmem_slice[xit_kter]);
+            xmem_slice[xit_kter][0] = (x_byte_t)xit_kter;
         }
-        else
+
+        // 一半交给其他线程回收（交接槽已被占用时由工作线程回收），另一半由工作线程回收
+        for (xit_kter = 0; xit_kter < xit_alloc_count; ++xit_kter)
         {
-            test_malloc1(xit_test_count, xit_test_size);
-            test_xmpool1(xit_test_count, xit_test_size);
+            xslice_old = X_NULL;
+            if ((0 == (xit_kter & 1)) ||
+                !xslice_slot[xit_kter % XHANDOFF_SLOTS].compare_exchange_strong(
+                    xslice_old, xmem_slice[xit_kter]))
+            {
+                XVERIFY(XMEM_ERR_OK == xmpool_recyc(xmpool_ptr, xmem_slice[xit_kter]));
+            }
+            xmem_slice[xit_kter] = X_NULL;
+        }
+
+        switch (xit_iter % 3)
+        {
+        case 0:
+            xmpool_set_retain(xmpool_ptr, 0, 0);
+            break;
+
+        case 1:
+            xmpool_release_unused(xmpool_ptr);
+            break;
+
+        default:
+            xmpool_set_retain(xmpool_ptr, ~0U, ~0ULL);
+            break;
         }
+
+        // 每轮都进行衰减（两个阶段：先归还物理内存，再释放地址空间）
+        xut_now += 1000;
+        xmpool_tick(xmpool_ptr, xut_now);
     }
 
-    printf("//======================================\n");
+    xbt_stop.store(true);
+    for (x_int32_t xit_thread = 0; xit_thread < XRECYC_THREADS; ++xit_thread)
+    {
+        xthread_recyc[xit_thread].join();
+    }
+
+    for (xit_kter = 0; xit_kter < XHANDOFF_SLOTS; ++xit_kter)
+    {
+        xslice_old = xslice_slot[xit_kter].exchange(X_NULL);
+        if (X_NULL != xslice_old)
+        {
+            XVERIFY(XMEM_ERR_OK == xmpool_recyc(xmpool_ptr, xslice_old));
+        }
+    }
+
+    xmpool_release_unused(xmpool_ptr);
+    XVERIFY(0 == xmpool_using_size(xmpool_ptr));
+    XVERIFY(0 == xmpool_cached_size(xmpool_ptr));
+
+    xtm_value = xtime_dcast(xtime_clock::now() - xtm_begin);
+    printf("[CHURN, %c] time cost: %12" PRId64 " ns\n", xit_mode, xtm_value.count());
+
+    //======================================
+
+    xmpool_destroy(xmpool_ptr);
+    free(xmem_slice);
+}
+
+void test_xmpool_random(x_int32_t xit_test_count, x_int32_t xit_alloc_count, x_int32_t xit_test_size, x_uint32_t xut_flags)
+{
+    x_int32_t xit_iter = 0;
+    x_int32_t xit_kter = 0;
+    x_int32_t xit_jter = 0;
+    x_int32_t xit_mode = (0 != (xut_flags & XMPOOL_FLAG_MAGAZINE   )) ? 'M' :
+                         (0 != (xut_flags & XMPOOL_FLAG_ALIGN_CHUNK)) ? 'A' : 'T';
+
+    xtime_point xtm_begin;
+    xtime_value xtm_value;
+
+    xmem_slice_t  * xmem_slice = (xmem_slice_t *)calloc(xit_alloc_count, sizeof(xmem_slice_t));
+    xmpool_handle_t xmpool_ptr = xmpool_create_ex(X_NULL, X_NULL, X_NULL, xut_flags);
+    XVERIFY(X_NULL != xmpool_ptr);
+
+    //======================================
+    // 以随机顺序回收分片（分片大多不在 xchunk_cptr 中，需查找所属 chunk）
+
+    srand(0x5EED);
+
+    xtm_begin = xtime_clock::now();
+    for (xit_iter = 0; xit_iter < xit_test_count; ++xit_iter)
+    {
+        for (xit_kter = 0; xit_kter < xit_alloc_count; ++xit_kter)
+        {
+            xmem_slice[xit_kter] = xmpool_alloc(xmpool_ptr, 1 + (rand() % xit_test_size));
+            XVERIFY(X_NULL != xmem_slice[xit_kter]);
+        }
+
+        for (xit_kter = xit_alloc_count - 1; xit_kter > 0; --xit_kter)
+        {
+            xit_jter = rand() % (xit_kter + 1);
+            std::swap(xmem_slice[xit_kter], xmem_slice[xit_jter]);
+        }
+
+        for (xit_kter = 0; xit_kter < xit_alloc_count; ++xit_kter)
+        {
+            XVERIFY(XMEM_ERR_OK == xmpool_recyc(xmpool_ptr, xmem_slice[xit_kter]));
+        }
+    }
+
+    xtm_value = xtime_dcast(xtime_clock::now() - xtm_begin);
+    printf("[POOL, %c] time cost : %12" PRId64 " ns\n", xit_mode, xtm_value.count());
+    printf("[POOL, %c] alloc/free: %12.6lf ns\n",
+           xit_mode, xtm_value.count() / (1.0 * xit_test_count * xit_alloc_count));
+
+    XVERIFY(0 == xmpool_using_size(xmpool_ptr));
+
+    //======================================
+
+    xmpool_release_unused(xmpool_ptr);
+    xmpool_destroy(xmpool_ptr);
+    free(xmem_slice);
+}
+
+void test_xmpool_mask_large(void)
+{
+    x_uint32_t   xut_iter  = 0;
+    x_uint32_t   xut_fill  = 0;
+    x_size_t   * xst_words = X_NULL;
+    xmem_slice_t xmem_addr = X_NULL;
+
+    const x_uint32_t xut_size = 3 * XMPOOL_CHUNK_ALIGN + 4096;
+
+    xmpool_handle_t xmpool_ptr = xmpool_create_ex(X_NULL, X_NULL, X_NULL, XMPOOL_FLAG_ALIGN_CHUNK);
+    XVERIFY(X_NULL != xmpool_ptr);
+
+    xmem_slice_t xmem_slice = xmpool_alloc(xmpool_ptr, xut_size);
+    XVERIFY(X_NULL != xmem_slice);
+
+    //======================================
+    // 大块分片中超出首个对齐区间的地址，掩码后落在用户数据中，
+    // 无论用户数据的内容如何，都须由红黑树确认其所属的 chunk 对象
+
+    for (xut_fill = 0; xut_fill < 2; ++xut_fill)
+    {
+        xst_words = (x_size_t *)xmem_slice;
+        for (xut_iter = 0; xut_iter < xut_size / sizeof(x_size_t); ++xut_iter)
+        {
+            xst_words[xut_iter] = (0 == xut_fill) ? 0 : (x_size_t)xmpool_ptr;
+        }
+
+        for (xut_iter = 1; xut_iter <= 3; ++xut_iter)
+        {
+            xmem_addr = (xmem_slice_t)(((x_size_t)xmem_slice + xut_iter * XMPOOL_CHUNK_ALIGN) &
+                                       ~((x_size_t)XMPOOL_CHUNK_ALIGN - 1)) + 64;
+            XVERIFY(xmem_slice == xmpool_slice_head(xmpool_ptr, xmem_addr));
+            XVERIFY(XMEM_ERR_OK != xmpool_recyc(xmpool_ptr, xmem_addr));
+        }
+    }
+
+    XVERIFY(XMEM_ERR_OK == xmpool_recyc(xmpool_ptr, xmem_slice));
+    XVERIFY(0 == xmpool_using_size(xmpool_ptr));
+
+    printf("[MASK   ] large slice interior addresses resolved via rbtree\n");
+
+    //======================================
+
+    xmpool_release_unused(xmpool_ptr);
+    xmpool_destroy(xmpool_ptr);
+}
+
+void test_xmpool_retain(x_int32_t xit_test_count, x_int32_t xit_alloc_count, x_int32_t xit_test_size)
+{
+    x_int32_t  xit_iter = 0;
+    x_int32_t  xit_kter = 0;
+    x_uint64_t xsize_peak  = 0;
+    x_uint64_t xsize_after = 0;
+
+    xtime_point xtm_begin;
+    xtime_value xtm_value;
+
+    xmem_slice_t  * xmem_slice = (xmem_slice_t *)calloc(xit_alloc_count, sizeof(xmem_slice_t));
+    xmpool_handle_t xmpool_ptr = xmpool_create(X_NULL, X_NULL, X_NULL);
+    XVERIFY(X_NULL != xmpool_ptr);
+
+    //======================================
+    // 每个分类只保留 1 个 空闲 chunk 对象，总大小不限；
+    // 每轮以同一大小占用多个 chunk 对象，全部回收后只保留 1 个
+
+    xmpool_set_retain(xmpool_ptr, 1, ~0ULL);
+
+    xtm_begin = xtime_clock::now();
+    for (xit_iter = 0; xit_iter < xit_test_count; ++xit_iter)
+    {
+        for (xit_kter = 0; xit_kter < xit_alloc_count; ++xit_kter)
+        {
+            xmem_slice[xit_kter] = xmpool_alloc(xmpool_ptr, xit_test_size);
+            XVERIFY(X_NULL != xmem_slice[xit_kter]);
+        }
+
+        if (xsize_peak < xmpool_cached_size(xmpool_ptr))
+            xsize_peak = xmpool_cached_size(xmpool_ptr);
+
+        for (xit_kter = 0; xit_kter < xit_alloc_count; ++xit_kter)
+        {
+            XVERIFY(XMEM_ERR_OK == xmpool_recyc(xmpool_ptr, xmem_slice[xit_kter]));
+        }
+    }
+    xtm_value = xtime_dcast(xtime_clock::now() - xtm_begin);
+
+    XVERIFY(0 == xmpool_using_size(xmpool_ptr));
+    xsize_after = xmpool_cached_size(xmpool_ptr);
+
+    //======================================
+    // 总大小上限为 0 时，立即释放所有 空闲 chunk 对象
+
+    xmpool_set_retain(xmpool_ptr, 0, 0);
+    XVERIFY(0 == xmpool_cached_size(xmpool_ptr));
+
+    printf("[RETAIN ] alloc/free: %12.6lf ns, cached : %.3lf MB -> %.3lf MB\n",
+           xtm_value.count() / (1.0 * xit_test_count * xit_alloc_count),
+           xsize_peak / (1024.0 * 1024.0), xsize_after / (1024.0 * 1024.0));
+
+    //======================================
+
+    xmpool_destroy(xmpool_ptr);
+    free(xmem_slice);
+}
+
+void test_xmpool_decay(x_int32_t xit_test_count, x_int32_t xit_alloc_count, x_int32_t xit_test_size)
+{
+    x_int32_t  xit_iter = 0;
+    x_int32_t  xit_kter = 0;
+    x_uint64_t xut_base = 0;
+    x_uint64_t xsize_idle = 0;
+    x_uint64_t xsize_half = 0;
+    x_uint64_t xsize_last = 0;
+    x_uint64_t xsize_free = 0;
+
+    const x_uint32_t xut_decay_ms = 1000;
+
+    xmem_slice_t  * xmem_slice = (xmem_slice_t *)calloc(xit_alloc_count, sizeof(xmem_slice_t));
+    xmpool_handle_t xmpool_ptr = xmpool_create(X_NULL, X_NULL, X_NULL);
+    XVERIFY(X_NULL != xmpool_ptr);
+
+    // 不限制保留数量，空闲 chunk 对象只按时间衰减归还
+    xmpool_set_retain(xmpool_ptr, ~0U, ~0ULL);
+    xmpool_set_decay(xmpool_ptr, xut_decay_ms);
+    xut_base = xsys_msecs();
+
+    //======================================
+    // 第二轮重新使用（部分已归还物理内存的）空闲 chunk 对象，
+    // 每轮全部回收后，以模拟的时间点（每次 1/4 个半衰期）调用 xmpool_tick()
+
+    for (xit_iter = 0; xit_iter < 2; ++xit_iter)
+    {
+        for (xit_kter = 0; xit_kter < xit_alloc_count; ++xit_kter)
+        {
+            xmem_slice[xit_kter] = xmpool_alloc(xmpool_ptr, xit_test_size);
+            XVERIFY(X_NULL != xmem_slice[xit_kter]);
+            memset(xmem_slice[xit_kter], 0xA5, xit_test_size);
+        }
+
+        for (xit_kter = 0; xit_kter < xit_alloc_count; ++xit_kter)
+        {
+            XVERIFY(0xA5 == xmem_slice[xit_kter][xit_test_size - 1]);
+            XVERIFY(XMEM_ERR_OK == xmpool_recyc(xmpool_ptr, xmem_slice[xit_kter]));
+        }
+
+        // 刚转入空闲状态的 chunk 对象不会被立即归还
+        xsize_idle = xmpool_cached_size(xmpool_ptr);
+        XVERIFY(0 == xmpool_tick(xmpool_ptr, xut_base));
+        XVERIFY(xsize_idle == xmpool_cached_size(xmpool_ptr));
+
+        xsize_last = xsize_idle;
+        for (xit_kter = 1; xit_kter <= ((0 == xit_iter) ? 4 : 200); ++xit_kter)
+        {
+            xut_base   += (xut_decay_ms / 4);
+            xsize_free += xmpool_tick(xmpool_ptr, xut_base);
+            XVERIFY(xmpool_cached_size(xmpool_ptr) <= xsize_last);
+            xsize_last  = xmpool_cached_size(xmpool_ptr);
+        }
+
+        if (0 == xit_iter)
+            xsize_half = xsize_last;
+    }
+
+    XVERIFY(0 == xmpool_cached_size(xmpool_ptr));
+    XVERIFY(xsize_free >= xsize_idle);
+
+    printf("[DECAY  ] cached : %.3lf MB -> %.3lf MB (1 half-life) -> %.3lf MB, returned : %.3lf MB\n",
+           xsize_idle / (1024.0 * 1024.0), xsize_half / (1024.0 * 1024.0),
+           xmpool_cached_size(xmpool_ptr) / (1024.0 * 1024.0),
+           xsize_free / (1024.0 * 1024.0));
+
+    //======================================
+
+    xmpool_destroy(xmpool_ptr);
+    free(xmem_slice);
+}
+
+void test_xmpool_large(x_int32_t xit_test_count, x_bool_t xbt_cache)
+{
+    x_int32_t  xit_iter = 0;
+    x_int32_t  xit_kter = 0;
+    x_uint32_t xut_size = 0;
+    x_uint32_t xut_seed = 1;
+
+    xtime_point xtm_begin;
+    xtime_value xtm_value;
+
+    const x_int32_t XLARGE_COUNT = 8;
+    xmem_slice_t xmem_slice[XLARGE_COUNT] = { X_NULL };
+    x_uint32_t   xmem_size[XLARGE_COUNT]  = { 0 };
+
+    xmpool_handle_t xmpool_ptr = xmpool_create(X_NULL, X_NULL, X_NULL);
+    XVERIFY(X_NULL != xmpool_ptr);
+
+    if (!xbt_cache)
+    {
+        xmpool_set_large_cache(xmpool_ptr, 0);
+    }
+
+    //======================================
+    // 反复申请/回收 128 KB ~ 4 MB 之间的大块分片，
+    // 对比 大块缓存 复用 chunk 对象 与 每次经 xfunc_alloc/xfunc_free 申请/释放
+
+    xtm_begin = xtime_clock::now();
+    for (xit_iter = 0; xit_iter < xit_test_count * 64; ++xit_iter)
+    {
+        xit_kter = xit_iter % XLARGE_COUNT;
+
+        if (X_NULL != xmem_slice[xit_kter])
+        {
+            XVERIFY((x_byte_t)xmem_size[xit_kter] == xmem_slice[xit_kter][0]);
+            XVERIFY((x_byte_t)xmem_size[xit_kter] == xmem_slice[xit_kter][xmem_size[xit_kter] - 1]);
+            XVERIFY(XMEM_ERR_OK == xmpool_recyc(xmpool_ptr, xmem_slice[xit_kter]));
+        }
+
+        xut_seed = xut_seed * 1103515245 + 12345;
+        xut_size = (128 * 1024) << ((xut_seed >> 16) % 6);
+        xut_size += (xut_seed >> 8) % 4096;
+
+        xmem_slice[xit_kter] = xmpool_alloc(xmpool_ptr, xut_size);
+        XVERIFY(X_NULL != xmem_slice[xit_kter]);
+        xmem_size[xit_kter] = xut_size;
+        xmem_slice[xit_kter][0] = (x_byte_t)xut_size;
+        xmem_slice[xit_kter][xut_size - 1] = (x_byte_t)xut_size;
+
+        // 缓存的 chunk 对象不会超出默认的总大小上限
+        XVERIFY(xmpool_cached_size(xmpool_ptr) <=
+                (xmpool_using_size(xmpool_ptr) + XMPOOL_LARGE_CACHE_BYTES + XLARGE_COUNT * XMEM_PAGE_SIZE));
+    }
+    xtm_value = xtime_dcast(xtime_clock::now() - xtm_begin);
+
+    for (xit_kter = 0; xit_kter < XLARGE_COUNT; ++xit_kter)
+    {
+        XVERIFY(XMEM_ERR_OK == xmpool_recyc(xmpool_ptr, xmem_slice[xit_kter]));
+    }
+
+    // 重复回收 缓存中的 chunk 对象，可被识别出来
+    if (xbt_cache)
+    {
+        XVERIFY(XMEM_ERR_RECYCLED == xmpool_recyc(xmpool_ptr, xmem_slice[XLARGE_COUNT - 1]));
+    }
+
+    printf("[LARGE  ] %s : %12.6lf ms, cached : %.3lf MB\n",
+           xbt_cache ? "cache    " : "no cache ",
+           xtm_value.count() / (1.0e6 * xit_test_count),
+           xmpool_cached_size(xmpool_ptr) / (1024.0 * 1024.0));
+
+    XVERIFY(0 == xmpool_using_size(xmpool_ptr));
+
+    //======================================
+    // 长时间未被复用的大块缓存，经 xmpool_tick() 逐步释放
+
+    if (xbt_cache)
+    {
+        x_uint64_t xut_now = xsys_msecs();
+
+        xmpool_set_decay(xmpool_ptr, 1000);
+        xmpool_tick(xmpool_ptr, xut_now);
+        for (xit_iter = 1; (xit_iter <= 64) && (0 != xmpool_cached_size(xmpool_ptr)); ++xit_iter)
+        {
+            xmpool_tick(xmpool_ptr, xut_now + xit_iter * 1000);
+        }
+
+        XVERIFY(0 == xmpool_cached_size(xmpool_ptr));
+    }
+
+    //======================================
+
+    xmpool_release_unused(xmpool_ptr);
+    XVERIFY(0 == xmpool_cached_size(xmpool_ptr));
+    xmpool_destroy(xmpool_ptr);
+}
+
+void test_xmpool_hugepage(x_int32_t xit_test_count, x_uint32_t xut_flags)
+{
+    x_int32_t  xit_iter = 0;
+    x_int32_t  xit_kter = 0;
+    x_uint32_t xut_seed = 1;
+
+    xtime_point xtm_begin;
+    xtime_value xtm_value;
+
+    typedef struct xnode_t
+    {
+        struct xnode_t * xnext_ptr;
+        x_byte_t         xdata_buf[56];
+    } xnode_t;
+
+    const x_int32_t XNODE_COUNT = 1024 * 1024;
+
+    xnode_t ** xnode_array = (xnode_t **)calloc(XNODE_COUNT, sizeof(xnode_t *));
+    xnode_t  * xnode_iter  = X_NULL;
+
+    // 以指定工作模式的 堆内存管理对象 作为内存池的后备内存
+    xmheap_handle_t xmheap_bak = xmheap_ptr;
+    xmheap_ptr = xmheap_create_ex(32 * 1024 * 1024, 1024 * 1024 * 1024, xut_flags, XMEM_NUMA_ANY);
+    XVERIFY(X_NULL != xmheap_ptr);
+
+    xmpool_handle_t xmpool_ptr = xmpool_create(&vx_alloc, &vx_free, X_NULL);
+    XVERIFY(X_NULL != xmpool_ptr);
+
+    //======================================
+    // 将内存池分配的节点按随机顺序串成环，沿指针随机访问（TLB 缺失占主要开销）
+
+    for (xit_iter = 0; xit_iter < XNODE_COUNT; ++xit_iter)
+    {
+        xnode_array[xit_iter] = (xnode_t *)xmpool_alloc(xmpool_ptr, sizeof(xnode_t));
+        XVERIFY(X_NULL != xnode_array[xit_iter]);
+    }
+
+    for (xit_iter = XNODE_COUNT - 1; xit_iter > 0; --xit_iter)
+    {
+        xut_seed = xut_seed * 1103515245 + 12345;
+        xit_kter = (x_int32_t)((xut_seed >> 8) % (x_uint32_t)(xit_iter + 1));
+        std::swap(xnode_array[xit_iter], xnode_array[xit_kter]);
+    }
+
+    for (xit_iter = 0; xit_iter < XNODE_COUNT; ++xit_iter)
+    {
+        xnode_array[xit_iter]->xnext_ptr = xnode_array[(xit_iter + 1) % XNODE_COUNT];
+    }
+
+    xnode_iter = xnode_array[0];
+    xtm_begin  = xtime_clock::now();
+    for (xit_iter = 0; xit_iter < xit_test_count; ++xit_iter)
+    {
+        for (xit_kter = 0; xit_kter < XNODE_COUNT; ++xit_kter)
+        {
+            xnode_iter = xnode_iter->xnext_ptr;
+        }
+    }
+    xtm_value = xtime_dcast(xtime_clock::now() - xtm_begin);
+
+    // 每轮恰好走完整个环
+    XVERIFY(xnode_iter == xnode_array[0]);
+
+    printf("[HUGEPAG] %s : %12.6lf ns\n",
+           (0 != (xut_flags & XMHEAP_FLAG_HUGETLB  )) ? "hugetlb  " :
+           (0 != (xut_flags & XMHEAP_FLAG_HUGE_PAGE)) ? "thp      " : "4K page  ",
+           xtm_value.count() / (1.0 * xit_test_count * XNODE_COUNT));
+
+    //======================================
+
+    for (xit_iter = 0; xit_iter < XNODE_COUNT; ++xit_iter)
+    {
+        XVERIFY(XMEM_ERR_OK == xmpool_recyc(xmpool_ptr, (xmem_slice_t)xnode_array[xit_iter]));
+    }
+
+    xmpool_destroy(xmpool_ptr);
+    xmheap_destroy(xmheap_ptr);
+    xmheap_ptr = xmheap_bak;
+
+    free(xnode_array);
+}
+
+/**
+ * @brief 将当前线程绑定到指定的 CPU 上运行。
+ */
+x_bool_t test_pin_cpu(x_int32_t xit_cpu)
+{
+#ifdef _MSC_VER
+    return (0 != SetThreadAffinityMask(GetCurrentThread(), ((DWORD_PTR)1) << xit_cpu));
+#else // !_MSC_VER
+    cpu_set_t xcpu_set;
+    CPU_ZERO(&xcpu_set);
+    CPU_SET(xit_cpu, &xcpu_set);
+    return (0 == sched_setaffinity(0, sizeof(xcpu_set), &xcpu_set));
+#endif // _MSC_VER
+}
+
+/**
+ * @brief 查找隶属于指定 NUMA 节点的（首个）CPU 编号，未找到时返回 -1。
+ */
+x_int32_t test_numa_cpu(x_int32_t xit_node)
+{
+    x_int32_t xit_found = -1;
+
+    // 在临时线程中逐个绑定 CPU 并查询其节点，不影响调用线程的 CPU 亲和性
+    std::thread([&]() -> void
+    {
+        x_int32_t xit_count = (x_int32_t)std::thread::hardware_concurrency();
+        for (x_int32_t xit_cpu = 0; xit_cpu < xit_count; ++xit_cpu)
+        {
+            if (test_pin_cpu(xit_cpu) && (xsys_numa_node() == xit_node))
+            {
+                xit_found = xit_cpu;
+                break;
+            }
+        }
+    }).join();
+
+    return xit_found;
+}
+
+void test_xmpool_numa(x_int32_t xit_test_count)
+{
+    x_int32_t xit_nodes  = xsys_numa_count();
+    x_int32_t xit_cpu    = test_numa_cpu(0);
+    x_int32_t xit_remote = xit_nodes - 1;
+
+    const x_int32_t XSLICE_SIZE  = 64 * 1024;
+    const x_int32_t XSLICE_COUNT = 1024;
+
+    xmheap_handle_t xmheap_bak = xmheap_ptr;
+
+    if (xit_cpu < 0)
+    {
+        printf("[NUMA   ] no cpu found on node 0, skipped\n");
+        return;
+    }
+
+    //======================================
+    // 读取线程固定在节点 0 的 CPU 上，后备内存依次绑定到节点 0（本地）与最后一个节点（远端）
+
+    for (x_int32_t xit_node = 0; xit_node <= xit_remote; xit_node += ((xit_remote > 0) ? xit_remote : 1))
+    {
+        xtime_value xtm_value;
+        x_uint64_t  xut_sum = 0;
+
+        xmheap_ptr = xmheap_create_ex(32 * 1024 * 1024, 1024 * 1024 * 1024, XMHEAP_FLAG_NONE, xit_node);
+        XVERIFY(X_NULL != xmheap_ptr);
+        XVERIFY(xit_node == xmheap_numa_node(xmheap_ptr));
+
+        std::thread([&]() -> void
+        {
+            x_int32_t    xit_iter  = 0;
+            x_int32_t    xit_kter  = 0;
+            x_int32_t    xit_lter  = 0;
+            x_uint64_t * xslice_array[XSLICE_COUNT];
+
+            XVERIFY(test_pin_cpu(xit_cpu));
+
+            xmpool_handle_t xmpool_ptr = xmpool_create(&vx_alloc, &vx_free, X_NULL);
+            XVERIFY(X_NULL != xmpool_ptr);
+
+            for (xit_iter = 0; xit_iter < XSLICE_COUNT; ++xit_iter)
+            {
+                xslice_array[xit_iter] = (x_uint64_t *)xmpool_alloc(xmpool_ptr, XSLICE_SIZE);
+                XVERIFY(X_NULL != xslice_array[xit_iter]);
+                memset(xslice_array[xit_iter], xit_iter, XSLICE_SIZE);
+            }
+
+            xtime_point xtm_begin = xtime_clock::now();
+            for (xit_iter = 0; xit_iter < xit_test_count; ++xit_iter)
+            {
+                for (xit_kter = 0; xit_kter < XSLICE_COUNT; ++xit_kter)
+                {
+                    for (xit_lter = 0; xit_lter < (XSLICE_SIZE / (x_int32_t)sizeof(x_uint64_t)); ++xit_lter)
+                    {
+                        xut_sum += xslice_array[xit_kter][xit_lter];
+                    }
+                }
+            }
+            xtm_value = xtime_dcast(xtime_clock::now() - xtm_begin);
+
+            for (xit_iter = 0; xit_iter < XSLICE_COUNT; ++xit_iter)
+            {
+                XVERIFY(XMEM_ERR_OK == xmpool_recyc(xmpool_ptr, (xmem_slice_t)xslice_array[xit_iter]));
+            }
+
+            xmpool_destroy(xmpool_ptr);
+        }).join();
+
+        // 每个分片的字节值均为 (分片序号 & 0xFF)
+        XVERIFY(xut_sum == (x_uint64_t)xit_test_count * (XSLICE_COUNT / 256) *
+                           (XSLICE_SIZE / 8) * (255 * 256 / 2) * 0x0101010101010101ULL);
+
+        printf("[NUMA   ] cpu %3d (node 0) <- node %2d %s : %10.3lf GB/s\n",
+               xit_cpu, xit_node, (0 == xit_node) ? "local " : "remote",
+               (1.0 * xit_test_count * XSLICE_COUNT * XSLICE_SIZE) / xtm_value.count());
+
+        xmheap_destroy(xmheap_ptr);
+        xmheap_ptr = xmheap_bak;
+    }
+
+    if (xit_remote <= 0)
+    {
+        printf("[NUMA   ] single node system, remote access skipped\n");
+    }
+}
+
+void test_xmpool_purge_pages(x_int32_t xit_alloc_count)
+{
+    x_int32_t  xit_iter   = 0;
+    x_int32_t  xit_kter   = 0;
+    x_uint32_t xut_size   = 0;
+    x_uint64_t xsize_free = 0;
+
+    const x_uint32_t xut_sizes[] = { 4096, 5120, 8192, 20480, 65536 };
+    const x_int32_t  XKEEP_STEP  = 64;
+
+    xmem_slice_t  * xmem_slice = (xmem_slice_t *)calloc(xit_alloc_count, sizeof(xmem_slice_t));
+    xmpool_handle_t xmpool_ptr = xmpool_create(X_NULL, X_NULL, X_NULL);
+    XVERIFY(X_NULL != xmpool_ptr);
+
+    for (xit_kter = 0; xit_kter < (x_int32_t)(sizeof(xut_sizes) / sizeof(xut_sizes[0])); ++xit_kter)
+    {
+        xut_size = xut_sizes[xit_kter];
+
+        //======================================
+        // 模拟峰值过后：只保留每 XKEEP_STEP 个分片中的一个，其余回收
+
+        for (xit_iter = 0; xit_iter < xit_alloc_count; ++xit_iter)
+        {
+            xmem_slice[xit_iter] = xmpool_alloc(xmpool_ptr, xut_size);
+            XVERIFY(X_NULL != xmem_slice[xit_iter]);
+            memset(xmem_slice[xit_iter], (x_byte_t)xit_iter, xut_size);
+        }
+
+        for (xit_iter = 0; xit_iter < xit_alloc_count; ++xit_iter)
+        {
+            if (0 != (xit_iter % XKEEP_STEP))
+            {
+                XVERIFY(XMEM_ERR_OK == xmpool_recyc(xmpool_ptr, xmem_slice[xit_iter]));
+                xmem_slice[xit_iter] = X_NULL;
+            }
+        }
+
+        // 大部分 chunk 对象仍被保留的分片钉住，按分页归还其余空闲分片的物理内存
+        xsize_free = xmpool_purge_pages(xmpool_ptr);
+        XVERIFY(xsize_free == xmpool_pgpurged_size(xmpool_ptr));
+        XVERIFY((xit_alloc_count < XKEEP_STEP) || (xsize_free > 0));
+
+        // 已归还的分页不重复处理
+        XVERIFY(0 == xmpool_purge_pages(xmpool_ptr));
+
+        printf("[PGPURGE] slice : %6u, purged : %10.3lf MB, using : %10.3lf MB\n",
+               xut_size, xsize_free / (1024.0 * 1024.0),
+               xmpool_using_size(xmpool_ptr) / (1024.0 * 1024.0));
+
+        //======================================
+        // 保留的分片内容不受影响；重新分配的分片（所在分页由系统重新提供）可正常读写
+
+        for (xit_iter = 0; xit_iter < xit_alloc_count; ++xit_iter)
+        {
+            if (X_NULL != xmem_slice[xit_iter])
+            {
+                XVERIFY((x_byte_t)xit_iter == xmem_slice[xit_iter][0]);
+                XVERIFY((x_byte_t)xit_iter == xmem_slice[xit_iter][xut_size - 1]);
+            }
+            else
+            {
+                xmem_slice[xit_iter] = xmpool_alloc(xmpool_ptr, xut_size);
+                XVERIFY(X_NULL != xmem_slice[xit_iter]);
+                memset(xmem_slice[xit_iter], 0x5A, xut_size);
+            }
+        }
+
+        // 重新分配出去的分片，其所覆盖的分页已被清除标识，不再计入
+        XVERIFY(xmpool_pgpurged_size(xmpool_ptr) <= xsize_free);
+
+        for (xit_iter = 0; xit_iter < xit_alloc_count; ++xit_iter)
+        {
+            XVERIFY(XMEM_ERR_OK == xmpool_recyc(xmpool_ptr, xmem_slice[xit_iter]));
+        }
+
+        xmpool_release_unused(xmpool_ptr);
+        XVERIFY(0 == xmpool_pgpurged_size(xmpool_ptr));
+    }
+
+    //======================================
+
+    xmpool_destroy(xmpool_ptr);
+    free(xmem_slice);
+}
+
+void test_xmpool_aligned(x_int32_t xit_test_count, x_int32_t xit_alloc_count, x_int32_t xit_test_size)
+{
+    x_int32_t  xit_iter  = 0;
+    x_int32_t  xit_kter  = 0;
+    x_uint32_t xut_size  = 0;
+    x_uint32_t xut_align = 0;
+
+    xtime_point xtm_begin;
+    xtime_value xtm_value;
+
+    xmheap_holder_t xholder;
+
+    xmem_slice_t  * xmem_slice = (xmem_slice_t *)calloc(xit_alloc_count, sizeof(xmem_slice_t));
+    xmpool_handle_t xmpool_ptr = xmpool_create(&vx_alloc, &vx_free, X_NULL);
+    xmpool_handle_t xmpool_cln = xmpool_create_ex(&vx_alloc, &vx_free, X_NULL, XMPOOL_FLAG_CACHE_ALIGN);
+
+    //======================================
+    // 对齐值依次取 16 ~ XMEM_PAGE_SIZE，校验分片地址，并用 xmpool_recyc() 直接回收
+
+    srand(0x5EED);
+
+    xtm_begin = xtime_clock::now();
+    for (xit_iter = 0; xit_iter < xit_test_count; ++xit_iter)
+    {
+        xut_align = 16 << (xit_iter % 9);
+
+        for (xit_kter = 0; xit_kter < xit_alloc_count; ++xit_kter)
+        {
+            xut_size = 1 + (rand() % xit_test_size);
+            xmem_slice[xit_kter] = xmpool_alloc_aligned(xmpool_ptr, xut_size, xut_align);
+            XVERIFY(X_NULL != xmem_slice[xit_kter]);
+            XVERIFY(0 == ((x_size_t)xmem_slice[xit_kter] & (xut_align - 1)));
+            XVERIFY(xmpool_slice_size(xmpool_ptr, xmem_slice[xit_kter]) >= xut_size);
+            xmem_slice[xit_kter][xut_size - 1] = (x_byte_t)xit_kter;
+        }
+
+        for (xit_kter = 0; xit_kter < xit_alloc_count; ++xit_kter)
+        {
+            XVERIFY(XMEM_ERR_OK == xmpool_recyc(xmpool_ptr, xmem_slice[xit_kter]));
+        }
+    }
+    xtm_value = xtime_dcast(xtime_clock::now() - xtm_begin);
+
+    XVERIFY(0 == xmpool_using_size(xmpool_ptr));
+    printf("[ALIGN  ] alloc/free: %12.6lf ns\n", xtm_value.count() / (1.0 * xit_test_count * xit_alloc_count));
+
+    //======================================
+    // XMPOOL_FLAG_CACHE_ALIGN 模式：不小于缓存行的分片均按缓存行对齐
+
+    for (xit_kter = 0; xit_kter < xit_alloc_count; ++xit_kter)
+    {
+        xut_size = XMPOOL_CACHE_LINE + (rand() % xit_test_size);
+        xmem_slice[xit_kter] = xmpool_alloc(xmpool_cln, xut_size);
+        XVERIFY(X_NULL != xmem_slice[xit_kter]);
+        XVERIFY(0 == ((x_size_t)xmem_slice[xit_kter] & (XMPOOL_CACHE_LINE - 1)));
+    }
+
+    for (xit_kter = 0; xit_kter < xit_alloc_count; ++xit_kter)
+    {
+        XVERIFY(XMEM_ERR_OK == xmpool_recyc(xmpool_cln, xmem_slice[xit_kter]));
+    }
+
+    XVERIFY(0 == xmpool_using_size(xmpool_cln));
+
+    //======================================
+
+    xmpool_release_unused(xmpool_ptr);
+    xmpool_release_unused(xmpool_cln);
+    xmpool_destroy(xmpool_ptr);
+    xmpool_destroy(xmpool_cln);
+    free(xmem_slice);
+}
+
+void test_xmpool_realloc(x_int32_t xit_test_count, x_bool_t xbt_realloc)
+{
+    x_int32_t    xit_iter   = 0;
+    x_uint32_t   xut_size   = 0;
+    x_uint32_t   xut_used   = 0;
+    xmem_slice_t xmem_slice = X_NULL;
+    xmem_slice_t xnew_slice = X_NULL;
+
+    xtime_point xtm_begin;
+    xtime_value xtm_value;
+
+    xmpool_handle_t xmpool_ptr = xmpool_create(X_NULL, X_NULL, X_NULL);
+
+    //======================================
+    // 可增长的字节缓冲区：每次追加少量数据，容量不足时扩展（对比 申请 + 复制 + 回收）
+
+    const x_uint32_t XBUFFER_MAX = 4 * 1024 * 1024;
+
+    xtm_begin = xtime_clock::now();
+    for (xit_iter = 0; xit_iter < xit_test_count; ++xit_iter)
+    {
+        xmem_slice = X_NULL;
+        xut_used   = 0;
+
+        for (xut_size = 16; xut_size <= XBUFFER_MAX; xut_size += 1 + (xut_size >> 4))
+        {
+            if (xbt_realloc)
+            {
+                xnew_slice = xmpool_realloc(xmpool_ptr, xmem_slice, xut_size);
+            }
+            else
+            {
+                xnew_slice = xmpool_alloc(xmpool_ptr, xut_size);
+                if (X_NULL != xmem_slice)
+                {
+                    memcpy(xnew_slice, xmem_slice, xut_used);
+                    XVERIFY(XMEM_ERR_OK == xmpool_recyc(xmpool_ptr, xmem_slice));
+                }
+            }
+
+            XVERIFY(X_NULL != xnew_slice);
+            XVERIFY((0 == xut_used) || ((x_byte_t)(xut_used - 1) == xnew_slice[xut_used - 1]));
+
+            xmem_slice = xnew_slice;
+            for (; xut_used < xut_size; ++xut_used)
+                xmem_slice[xut_used] = (x_byte_t)xut_used;
+        }
+
+        XVERIFY(XMEM_ERR_OK == xmpool_recyc(xmpool_ptr, xmem_slice));
+    }
+    xtm_value = xtime_dcast(xtime_clock::now() - xtm_begin);
+
+    printf("[REALLOC] %s : %12.6lf ms\n",
+           xbt_realloc ? "realloc  " : "copy     ", xtm_value.count() / (1.0e6 * xit_test_count));
+
+    XVERIFY(0 == xmpool_using_size(xmpool_ptr));
+
+    //======================================
+
+    xmpool_release_unused(xmpool_ptr);
+    xmpool_destroy(xmpool_ptr);
+}
+
+void test_xmpool_sized(x_int32_t xit_test_count, x_int32_t xit_alloc_count, x_int32_t xit_test_size, x_bool_t xbt_sized)
+{
+    x_int32_t xit_iter = 0;
+    x_int32_t xit_kter = 0;
+    x_int32_t xit_jter = 0;
+
+    xtime_point xtm_begin;
+    xtime_value xtm_value;
+
+    xmheap_holder_t xholder;
+
+    xmem_slice_t  * xmem_slice = (xmem_slice_t *)calloc(xit_alloc_count, sizeof(xmem_slice_t));
+    x_uint32_t    * xmem_size  = (x_uint32_t   *)calloc(xit_alloc_count, sizeof(x_uint32_t  ));
+    xmpool_handle_t xmpool_ptr = xmpool_create(&vx_alloc, &vx_free, X_NULL);
+
+    //======================================
+    // 以随机顺序回收分片，对比 xmpool_recyc() 与 xmpool_recyc_sized()
+
+    srand(0x5EED);
+
+    xtm_begin = xtime_clock::now();
+    for (xit_iter = 0; xit_iter < xit_test_count; ++xit_iter)
+    {
+        for (xit_kter = 0; xit_kter < xit_alloc_count; ++xit_kter)
+        {
+            xmem_size[xit_kter]  = 1 + (rand() % xit_test_size);
+            xmem_slice[xit_kter] = xmpool_alloc(xmpool_ptr, xmem_size[xit_kter]);
+            XVERIFY(X_NULL != xmem_slice[xit_kter]);
+        }
+
+        for (xit_kter = xit_alloc_count - 1; xit_kter > 0; --xit_kter)
+        {
+            xit_jter = rand() % (xit_kter + 1);
+            std::swap(xmem_slice[xit_kter], xmem_slice[xit_jter]);
+            std::swap(xmem_size [xit_kter], xmem_size [xit_jter]);
+        }
+
+        for (xit_kter = 0; xit_kter < xit_alloc_count; ++xit_kter)
+        {
+            if (xbt_sized)
+                XVERIFY(XMEM_ERR_OK == xmpool_recyc_sized(xmpool_ptr, xmem_slice[xit_kter], xmem_size[xit_kter]));
+            else
+                XVERIFY(XMEM_ERR_OK == xmpool_recyc(xmpool_ptr, xmem_slice[xit_kter]));
+        }
+    }
+
+    xtm_value = xtime_dcast(xtime_clock::now() - xtm_begin);
+    printf("[POOL, %c] alloc/free: %12.6lf ns\n",
+           xbt_sized ? 'S' : 'U', xtm_value.count() / (1.0 * xit_test_count * xit_alloc_count));
+
+    XVERIFY(0 == xmpool_using_size(xmpool_ptr));
+
+    //======================================
+
+    xmpool_release_unused(xmpool_ptr);
+    xmpool_destroy(xmpool_ptr);
+    free(xmem_size);
+    free(xmem_slice);
+}
+
+void test_xmpool_batch(x_int32_t xit_test_count, x_int32_t xit_alloc_count, x_int32_t xit_test_size)
+{
+    x_int32_t  xit_iter = 0;
+    x_int32_t  xit_kter = 0;
+    x_uint32_t xut_size = 0;
+
+    xtime_point xtm_begin;
+    xtime_value xtm_single;
+    xtime_value xtm_batch;
+
+    xmheap_holder_t xholder;
+
+    xmem_slice_t  * xmem_slice = (xmem_slice_t *)calloc(xit_alloc_count, sizeof(xmem_slice_t));
+    xmpool_handle_t xmpool_ptr = xmpool_create(&vx_alloc, &vx_free, X_NULL);
+
+    //======================================
+    // 每轮申请 xit_alloc_count 个同样大小的分片，再全部回收（如：报文解码的节点）
+
+    xtm_begin = xtime_clock::now();
+    for (xit_iter = 0; xit_iter < xit_test_count; ++xit_iter)
+    {
+        xut_size = 1 + (xit_iter % xit_test_size);
+
+        for (xit_kter = 0; xit_kter < xit_alloc_count; ++xit_kter)
+        {
+            xmem_slice[xit_kter] = xmpool_alloc(xmpool_ptr, xut_size);
+            XVERIFY(X_NULL != xmem_slice[xit_kter]);
+        }
+
+        for (xit_kter = 0; xit_kter < xit_alloc_count; ++xit_kter)
+        {
+            XVERIFY(XMEM_ERR_OK == xmpool_recyc(xmpool_ptr, xmem_slice[xit_kter]));
+        }
+    }
+    xtm_single = xtime_dcast(xtime_clock::now() - xtm_begin);
+
+    XVERIFY(0 == xmpool_using_size(xmpool_ptr));
+
+    //======================================
+
+    xtm_begin = xtime_clock::now();
+    for (xit_iter = 0; xit_iter < xit_test_count; ++xit_iter)
+    {
+        xut_size = 1 + (xit_iter % xit_test_size);
+
+        XVERIFY((x_uint32_t)xit_alloc_count ==
+                xmpool_alloc_batch(xmpool_ptr, xut_size, xit_alloc_count, xmem_slice));
+        XVERIFY((x_uint32_t)xit_alloc_count ==
+                xmpool_recyc_batch(xmpool_ptr, xmem_slice, xit_alloc_count));
+    }
+    xtm_batch = xtime_dcast(xtime_clock::now() - xtm_begin);
+
+    XVERIFY(0 == xmpool_using_size(xmpool_ptr));
+
+    //======================================
+    // 非工作线程批量回收
+
+    XVERIFY((x_uint32_t)xit_alloc_count ==
+            xmpool_alloc_batch(xmpool_ptr, xit_test_size, xit_alloc_count, xmem_slice));
+    std::thread([&]() -> void
+    {
+        XVERIFY((x_uint32_t)xit_alloc_count ==
+                xmpool_recyc_batch(xmpool_ptr, xmem_slice, xit_alloc_count));
+    }).join();
+
+    xmpool_release_unused(xmpool_ptr);
+    XVERIFY(0 == xmpool_using_size(xmpool_ptr));
+
+    printf("[BATCH  ] single    : %12.6lf ns\n", xtm_single.count() / (1.0 * xit_test_count * xit_alloc_count));
+    printf("[BATCH  ] batch     : %12.6lf ns\n", xtm_batch.count()  / (1.0 * xit_test_count * xit_alloc_count));
+
+    //======================================
+
+    xmpool_destroy(xmpool_ptr);
+    free(xmem_slice);
+}
+
+void test_xmpool_magazine(x_int32_t xit_test_count, x_int32_t xit_alloc_count, x_uint32_t xut_flags)
+{
+    x_int32_t xit_iter = 0;
+    x_int32_t xit_kter = 0;
+
+    xtime_point xtm_begin;
+    xtime_value xtm_value;
+
+    xmem_slice_t  * xmem_slice = (xmem_slice_t *)calloc(xit_alloc_count, sizeof(xmem_slice_t));
+    x_uint32_t    * xslice_len = (x_uint32_t   *)calloc(xit_alloc_count, sizeof(x_uint32_t));
+    xmpool_handle_t xmpool_ptr = xmpool_create_ex(X_NULL, X_NULL, X_NULL, xut_flags);
+    XVERIFY(X_NULL != xmpool_ptr);
+
+    srand(0x5EED);
+    for (xit_kter = 0; xit_kter < xit_alloc_count; ++xit_kter)
+    {
+        xslice_len[xit_kter] = 1 + (rand() % 256);
+    }
+
+    //======================================
+    // 小对象的短生命周期 申请/回收（如：临时字符串、容器节点），
+    // 每个分片在其后第 8 次申请时回收
+
+    xtm_begin = xtime_clock::now();
+    for (xit_iter = 0; xit_iter < xit_test_count; ++xit_iter)
+    {
+        for (xit_kter = 0; xit_kter < xit_alloc_count; ++xit_kter)
+        {
+            xmem_slice[xit_kter] = xmpool_alloc(xmpool_ptr, xslice_len[xit_kter]);
+            XVERIFY(X_NULL != xmem_slice[xit_kter]);
+            xmem_slice[xit_kter][0] = (x_byte_t)xit_kter;
+
+            if (xit_kter >= 8)
+            {
+                XVERIFY(XMEM_ERR_OK == xmpool_recyc(xmpool_ptr, xmem_slice[xit_kter - 8]));
+            }
+        }
+
+        for (xit_kter = (xit_alloc_count > 8) ? (xit_alloc_count - 8) : 0;
+             xit_kter < xit_alloc_count;
+             ++xit_kter)
+        {
+            XVERIFY(XMEM_ERR_OK == xmpool_recyc(xmpool_ptr, xmem_slice[xit_kter]));
+        }
+    }
+    xtm_value = xtime_dcast(xtime_clock::now() - xtm_begin);
+
+    XVERIFY(0 == xmpool_using_size(xmpool_ptr));
+
+    printf("[MAGAZIN] %s : %12.6lf ns\n",
+           (0 != (xut_flags & XMPOOL_FLAG_MAGAZINE)) ? "magazine" : "chunk   ",
+           xtm_value.count() / (1.0 * xit_test_count * xit_alloc_count));
+
+    //======================================
+    // 压入弹匣前，仍校验分片地址是否对齐于分片边界
+
+    xmem_slice[0] = xmpool_alloc(xmpool_ptr, 64);
+    XVERIFY(XMEM_ERR_OK == xmpool_recyc(xmpool_ptr, xmem_slice[0]));
+    XVERIFY(XMEM_ERR_UNALIGNED == xmpool_recyc(xmpool_ptr, xmem_slice[0] + 8));
+    xmpool_release_unused(xmpool_ptr);
+    xmpool_destroy(xmpool_ptr);
+    free(xslice_len);
+    free(xmem_slice);
+}
+
+void test_xmpool_stats(x_int32_t xit_test_count, x_int32_t xit_alloc_count, x_uint32_t xut_flags)
+{
+    x_int32_t  xit_iter = 0;
+    x_int32_t  xit_kter = 0;
+    x_uint32_t xut_iter = 0;
+
+    x_uint64_t xut_round = 0;
+    x_uint64_t xut_alloc = 0;
+    x_uint64_t xut_free  = 0;
+    x_uint64_t xut_live  = 0;
+    x_uint64_t xut_slow  = 0;
+    x_uint64_t xut_bytes = 0;
+
+    xmem_slice_t   * xmem_slice = (xmem_slice_t *)calloc(xit_alloc_count, sizeof(xmem_slice_t));
+    x_uint32_t     * xslice_len = (x_uint32_t   *)calloc(xit_alloc_count, sizeof(x_uint32_t));
+    xmpool_stats_t * xstats_ptr = (xmpool_stats_t *)calloc(1, sizeof(xmpool_stats_t));
+    xmpool_handle_t  xmpool_ptr = xmpool_create_ex(X_NULL, X_NULL, X_NULL, xut_flags);
+    XVERIFY(X_NULL != xmpool_ptr);
+
+    // 汇总各分类的统计计数
+    auto xstats_sum = [&]() -> void
+    {
+        xmpool_stats(xmpool_ptr, xstats_ptr);
+        XVERIFY(xstats_ptr->xclass_count > 0);
+
+        xut_alloc = xut_free = xut_live = xut_slow = xut_round = xut_bytes = 0;
+        for (xut_iter = 0; xut_iter < xstats_ptr->xclass_count; ++xut_iter)
+        {
+            const xmpool_class_stats_t & xcstat = xstats_ptr->xclass_stats[xut_iter];
+
+            XVERIFY(xcstat.xlive_count == xcstat.xalloc_count - xcstat.xfree_count);
+            XVERIFY(xcstat.xslow_count <= xcstat.xalloc_count);
+
+            xut_alloc += xcstat.xalloc_count;
+            xut_free  += xcstat.xfree_count;
+            xut_live  += xcstat.xlive_count;
+            xut_slow  += xcstat.xslow_count;
+            xut_round += xcstat.xround_bytes;
+            xut_bytes += xcstat.xlive_count * xcstat.xslice_size;
+        }
+    };
+
+    srand(0x57A7);
+    for (xit_kter = 0; xit_kter < xit_alloc_count; ++xit_kter)
+    {
+        xslice_len[xit_kter] = 1 + (rand() % 1024);
+    }
+
+    //======================================
+    // 申请：各分类的计数之和与逐个累计的结果一致
+
+    x_uint64_t xut_expect = 0;
+    for (xit_kter = 0; xit_kter < xit_alloc_count; ++xit_kter)
+    {
+        xmem_slice[xit_kter] = xmpool_alloc(xmpool_ptr, xslice_len[xit_kter]);
+        XVERIFY(X_NULL != xmem_slice[xit_kter]);
+        xut_expect += xmpool_slice_size(xmpool_ptr, xmem_slice[xit_kter]) - xslice_len[xit_kter];
+    }
+
+    xstats_sum();
+    XVERIFY((x_uint64_t)xit_alloc_count == xut_alloc);
+    XVERIFY((x_uint64_t)xit_alloc_count == xut_live);
+    XVERIFY(xut_expect == xut_round);
+    XVERIFY(xmpool_using_size(xmpool_ptr) == xut_bytes);
+
+    //======================================
+    // 回收：前一半在工作线程中，其后的四分之一在其他线程中
+
+    for (xit_kter = 0; xit_kter < xit_alloc_count / 2; ++xit_kter)
+    {
+        XVERIFY(XMEM_ERR_OK == xmpool_recyc(xmpool_ptr, xmem_slice[xit_kter]));
+    }
+
+    std::thread([&]() -> void
+    {
+        for (x_int32_t xit_jter = xit_alloc_count / 2; xit_jter < xit_alloc_count * 3 / 4; ++xit_jter)
+        {
+            XVERIFY(XMEM_ERR_OK == xmpool_recyc(xmpool_ptr, xmem_slice[xit_jter]));
+        }
+    }).join();
+
+    xstats_sum();
+    XVERIFY((x_uint64_t)(xit_alloc_count * 3 / 4) == xut_free);
+    XVERIFY((x_uint64_t)(xit_alloc_count - xit_alloc_count * 3 / 4) == xut_live);
+    XVERIFY(xmpool_using_size(xmpool_ptr) == xut_bytes);
+
+    for (xit_kter = xit_alloc_count * 3 / 4; xit_kter < xit_alloc_count; ++xit_kter)
+    {
+        XVERIFY(XMEM_ERR_OK == xmpool_recyc(xmpool_ptr, xmem_slice[xit_kter]));
+    }
+
+    //======================================
+    // 大块分片单独计数
+
+    xmem_slice[0] = xmpool_alloc(xmpool_ptr, 256 * 1024);
+    XVERIFY(X_NULL != xmem_slice[0]);
+    xmpool_stats(xmpool_ptr, xstats_ptr);
+    XVERIFY((1 == xstats_ptr->xlarge_alloc) && (0 == xstats_ptr->xlarge_free));
+    XVERIFY(XMEM_ERR_OK == xmpool_recyc(xmpool_ptr, xmem_slice[0]));
+    xmpool_stats(xmpool_ptr, xstats_ptr);
+    XVERIFY((1 == xstats_ptr->xlarge_alloc) && (1 == xstats_ptr->xlarge_free));
+
+    //======================================
+    // 稳定负载下的慢速路径命中率
+
+    for (xit_iter = 0; xit_iter < xit_test_count; ++xit_iter)
+    {
+        for (xit_kter = 0; xit_kter < xit_alloc_count; ++xit_kter)
+        {
+            xmem_slice[xit_kter] = xmpool_alloc(xmpool_ptr, xslice_len[xit_kter]);
+            XVERIFY(X_NULL != xmem_slice[xit_kter]);
+        }
+
+        for (xit_kter = 0; xit_kter < xit_alloc_count; ++xit_kter)
+        {
+            XVERIFY(XMEM_ERR_OK == xmpool_recyc(xmpool_ptr, xmem_slice[xit_kter]));
+        }
+    }
+
+    xstats_sum();
+    XVERIFY(0 == xut_live);
+    XVERIFY(xut_alloc == xut_free);
+
+    printf("[STATS  ] %s : alloc : %10llu, slow path : %8.4lf%%, round : %10.3lf B/alloc\n",
+           (0 != (xut_flags & XMPOOL_FLAG_MAGAZINE)) ? "magazine" : "chunk   ",
+           (unsigned long long)xut_alloc,
+           (0 != xut_alloc) ? (100.0 * xut_slow / xut_alloc) : 0.0,
+           (0 != xut_alloc) ? (1.0 * xut_round / xut_alloc) : 0.0);
+
+    //======================================
+    // 释放未使用的缓存后，不再有非空闲的 chunk 对象
+
+    xmpool_release_unused(xmpool_ptr);
+    xmpool_stats(xmpool_ptr, xstats_ptr);
+    for (xut_iter = 0; xut_iter < xstats_ptr->xclass_count; ++xut_iter)
+    {
+        XVERIFY(0 == xstats_ptr->xclass_stats[xut_iter].xchunk_busy);
+        XVERIFY(0 == xstats_ptr->xclass_stats[xut_iter].xchunk_part);
+        XVERIFY(0 == xstats_ptr->xclass_stats[xut_iter].xmag_count);
+    }
+
+    xmpool_destroy(xmpool_ptr);
+    free(xstats_ptr);
+    free(xslice_len);
+    free(xmem_slice);
+}
+
+void test_xmpool_grow(x_uint32_t xut_flags)
+{
+    x_int32_t  xit_iter  = 0;
+    x_uint32_t xut_class = 0;
+    x_uint32_t xut_first = 0;
+    x_uint32_t xut_peak  = 0;
+    x_uint32_t xut_count = 0;
+
+    const x_uint32_t XSLICE_SIZE  = 64;
+    const x_int32_t  XSLICE_COUNT = 100000;
+
+    xmem_slice_t   * xmem_slice = (xmem_slice_t *)calloc(XSLICE_COUNT, sizeof(xmem_slice_t));
+    xmpool_stats_t * xstats_ptr = (xmpool_stats_t *)calloc(1, sizeof(xmpool_stats_t));
+    xmpool_handle_t  xmpool_ptr = xmpool_create_ex(X_NULL, X_NULL, X_NULL, xut_flags);
+    XVERIFY(X_NULL != xmpool_ptr);
+
+    xmpool_stats(xmpool_ptr, xstats_ptr);
+    for (xut_class = 0; xut_class < xstats_ptr->xclass_count; ++xut_class)
+    {
+        if (XSLICE_SIZE == xstats_ptr->xclass_stats[xut_class].xslice_size)
+            break;
+    }
+    XVERIFY(xut_class < xstats_ptr->xclass_count);
+
+    //======================================
+    // 少量使用的分类只占用一个较小的 chunk 对象
+
+    xmem_slice[0] = xmpool_alloc(xmpool_ptr, XSLICE_SIZE);
+    XVERIFY(X_NULL != xmem_slice[0]);
+
+    xmpool_stats(xmpool_ptr, xstats_ptr);
+    xut_first = xstats_ptr->xclass_stats[xut_class].xchunk_size;
+    XVERIFY(xmpool_cached_size(xmpool_ptr) == xut_first);
+    XVERIFY(xut_first <= 32 * 1024);
+    XVERIFY(XMEM_ERR_OK == xmpool_recyc(xmpool_ptr, xmem_slice[0]));
+
+    //======================================
+    // 大量使用时，chunk 大小随 chunk 数量倍增，chunk 数量只按对数增长
+
+    for (xit_iter = 0; xit_iter < XSLICE_COUNT; ++xit_iter)
+    {
+        xmem_slice[xit_iter] = xmpool_alloc(xmpool_ptr, XSLICE_SIZE);
+        XVERIFY(X_NULL != xmem_slice[xit_iter]);
+        memset(xmem_slice[xit_iter], (x_byte_t)xit_iter, XSLICE_SIZE);
+    }
+
+    xmpool_stats(xmpool_ptr, xstats_ptr);
+    xut_peak  = xstats_ptr->xclass_stats[xut_class].xchunk_size;
+    xut_count = xstats_ptr->xclass_stats[xut_class].xchunk_busy +
+                xstats_ptr->xclass_stats[xut_class].xchunk_part +
+                xstats_ptr->xclass_stats[xut_class].xchunk_idle;
+    XVERIFY(xut_peak >= 8 * xut_first);
+    XVERIFY(xut_count <= 16);
+    XVERIFY((0 == (xut_flags & XMPOOL_FLAG_ALIGN_CHUNK)) || (xut_peak <= XMPOOL_CHUNK_ALIGN));
+
+    for (xit_iter = 0; xit_iter < XSLICE_COUNT; ++xit_iter)
+    {
+        XVERIFY((x_byte_t)xit_iter == xmem_slice[xit_iter][XSLICE_SIZE - 1]);
+        XVERIFY(XMEM_ERR_OK == xmpool_recyc(xmpool_ptr, xmem_slice[xit_iter]));
+    }
+
+    //======================================
+    // 释放之后，重新从较小的 chunk 对象开始
+
+    xmpool_release_unused(xmpool_ptr);
+    XVERIFY(0 == xmpool_cached_size(xmpool_ptr));
+
+    xmem_slice[0] = xmpool_alloc(xmpool_ptr, XSLICE_SIZE);
+    XVERIFY(X_NULL != xmem_slice[0]);
+    xmpool_stats(xmpool_ptr, xstats_ptr);
+    XVERIFY(xut_first == xstats_ptr->xclass_stats[xut_class].xchunk_size);
+    XVERIFY(xmpool_cached_size(xmpool_ptr) == xut_first);
+    XVERIFY(XMEM_ERR_OK == xmpool_recyc(xmpool_ptr, xmem_slice[0]));
+
+    printf("[GROW   ] %s : chunks : %3u, chunk size : %6u KB -> %6u KB -> %6u KB\n",
+           (0 != (xut_flags & XMPOOL_FLAG_ALIGN_CHUNK)) ? "aligned " : "default ",
+           xut_count, xut_first / 1024, xut_peak / 1024,
+           xstats_ptr->xclass_stats[xut_class].xchunk_size / 1024);
+
+    xmpool_destroy(xmpool_ptr);
+    free(xstats_ptr);
+    free(xmem_slice);
+}
+
+void test_xmpool_prof(x_int32_t xit_test_count, x_int32_t xit_alloc_count, x_uint32_t xut_flags)
+{
+    x_int32_t  xit_iter = 0;
+    x_int32_t  xit_kter = 0;
+    x_uint64_t xut_size = 0;
+
+    xtime_point xtm_begin;
+    xtime_value xtm_off;
+    xtime_value xtm_on;
+
+    const x_char_t * xpath_ptr = "xmem_prof_test.heap";
+
+    xmem_slice_t  * xmem_slice = (xmem_slice_t *)calloc(xit_alloc_count, sizeof(xmem_slice_t));
+    x_uint32_t    * xslice_len = (x_uint32_t   *)calloc(xit_alloc_count, sizeof(x_uint32_t));
+    xmpool_handle_t xmpool_ptr = xmpool_create_ex(X_NULL, X_NULL, X_NULL, xut_flags);
+    xmprof_handle_t xmprof_ptr = xmprof_create(XMPROF_INTERVAL);
+    XVERIFY((X_NULL != xmpool_ptr) && (X_NULL != xmprof_ptr));
+
+    srand(0x9E0F);
+    for (xit_kter = 0; xit_kter < xit_alloc_count; ++xit_kter)
+    {
+        xslice_len[xit_kter] = 1 + (rand() % 1024);
+        xut_size += xslice_len[xit_kter];
+    }
+
+    auto xround = [&]() -> void
+    {
+        for (xit_kter = 0; xit_kter < xit_alloc_count; ++xit_kter)
+        {
+            xmem_slice[xit_kter] = xmpool_alloc(xmpool_ptr, xslice_len[xit_kter]);
+            XVERIFY(X_NULL != xmem_slice[xit_kter]);
+        }
+
+        for (xit_kter = 0; xit_kter < xit_alloc_count; ++xit_kter)
+        {
+            XVERIFY(XMEM_ERR_OK == xmpool_recyc(xmpool_ptr, xmem_slice[xit_kter]));
+        }
+    };
+
+    //======================================
+    // 默认采样间隔下的额外开销（与未设置剖析器时对比）
+
+    xround();
+
+    xtm_begin = xtime_clock::now();
+    for (xit_iter = 0; xit_iter < xit_test_count; ++xit_iter)
+        xround();
+    xtm_off = xtime_dcast(xtime_clock::now() - xtm_begin);
+
+    xmpool_set_profiler(xmpool_ptr, xmprof_ptr);
+
+    xtm_begin = xtime_clock::now();
+    for (xit_iter = 0; xit_iter < xit_test_count; ++xit_iter)
+        xround();
+    xtm_on = xtime_dcast(xtime_clock::now() - xtm_begin);
+
+    XVERIFY(0 == xmprof_live_count(xmprof_ptr));
+
+    printf("[PROFILE] %s : off : %10.3lf ns, on : %10.3lf ns (%+7.2lf%%)\n",
+           (0 != (xut_flags & XMPOOL_FLAG_MAGAZINE)) ? "magazine" : "chunk   ",
+           xtm_off.count() / (1.0 * xit_test_count * xit_alloc_count),
+           xtm_on.count()  / (1.0 * xit_test_count * xit_alloc_count),
+           100.0 * ((x_int64_t)xtm_on.count() - (x_int64_t)xtm_off.count()) /
+               ((0 != xtm_off.count()) ? xtm_off.count() : 1));
+
+    //======================================
+    // 缩小采样间隔：被采样的分片在（本线程或其他线程）回收后，都不再被跟踪
+
+    xmprof_set_interval(xmprof_ptr, 256);
+    xmpool_set_profiler(xmpool_ptr, X_NULL);
+    xmpool_set_profiler(xmpool_ptr, xmprof_ptr);
+
+    for (xit_kter = 0; xit_kter < xit_alloc_count; ++xit_kter)
+    {
+        xmem_slice[xit_kter] = xmpool_alloc(xmpool_ptr, xslice_len[xit_kter]);
+        XVERIFY(X_NULL != xmem_slice[xit_kter]);
+    }
+
+    // 按字节采样：大小为 s 的分片被采样的概率为 1 - exp(-s / 256)，
+    // 此处的平均大小约为 512，期望的采样数约为分片数量的 80%
+    XVERIFY(xmprof_live_count(xmprof_ptr) > 0);
+    XVERIFY(xmprof_live_count(xmprof_ptr) <= (x_uint32_t)xit_alloc_count);
+    XVERIFY(xmprof_live_size(xmprof_ptr) <= xut_size);
+    if (xit_alloc_count >= 100)
+    {
+        XVERIFY(xmprof_live_count(xmprof_ptr) > (x_uint32_t)xit_alloc_count / 2);
+    }
+
+    // 输出文件的首行汇总了所有被跟踪的分片
+    XVERIFY(XMEM_ERR_OK == xmprof_dump(xmprof_ptr, xpath_ptr));
+    {
+        FILE * xfile_ptr = fopen(xpath_ptr, "r");
+        unsigned int       xut_count = 0;
+        unsigned long long xut_bytes = 0;
+        unsigned int       xut_step  = 0;
+        XVERIFY(X_NULL != xfile_ptr);
+        XVERIFY(3 == fscanf(xfile_ptr, "heap profile: %u: %llu [%*u: %*u] @ heap_v2/%u",
+                            &xut_count, &xut_bytes, &xut_step));
+        XVERIFY(xut_count == xmprof_live_count(xmprof_ptr));
+        XVERIFY(xut_bytes == xmprof_live_size(xmprof_ptr));
+        XVERIFY(256 == xut_step);
+        fclose(xfile_ptr);
+        remove(xpath_ptr);
+    }
+
+    for (xit_kter = 0; xit_kter < xit_alloc_count / 2; ++xit_kter)
+    {
+        XVERIFY(XMEM_ERR_OK == xmpool_recyc(xmpool_ptr, xmem_slice[xit_kter]));
+    }
+
+    std::thread([&]() -> void
+    {
+        for (x_int32_t xit_jter = xit_alloc_count / 2; xit_jter < xit_alloc_count; ++xit_jter)
+        {
+            XVERIFY(XMEM_ERR_OK == xmpool_recyc(xmpool_ptr, xmem_slice[xit_jter]));
+        }
+    }).join();
+
+    // 其他线程回收的分片，由工作线程取回时删除其记录
+    xmpool_release_unused(xmpool_ptr);
+    XVERIFY(0 == xmprof_live_count(xmprof_ptr));
+    XVERIFY(0 == xmprof_live_size(xmprof_ptr));
+
+    //======================================
+    // 大块分片，以及解除剖析器时一并删除的记录
+
+    xmem_slice[0] = xmpool_alloc(xmpool_ptr, 256 * 1024);
+    XVERIFY(X_NULL != xmem_slice[0]);
+    XVERIFY(1 == xmprof_live_count(xmprof_ptr));
+    XVERIFY(XMEM_ERR_OK == xmpool_recyc(xmpool_ptr, xmem_slice[0]));
+    XVERIFY(0 == xmprof_live_count(xmprof_ptr));
+
+    xmem_slice[0] = xmpool_alloc(xmpool_ptr, 256 * 1024);
+    XVERIFY(1 == xmprof_live_count(xmprof_ptr));
+    xmpool_set_profiler(xmpool_ptr, X_NULL);
+    XVERIFY(0 == xmprof_live_count(xmprof_ptr));
+    XVERIFY(XMEM_ERR_OK == xmpool_recyc(xmpool_ptr, xmem_slice[0]));
+
+    xmpool_release_unused(xmpool_ptr);
+    xmpool_destroy(xmpool_ptr);
+    xmprof_destroy(xmprof_ptr);
+    free(xslice_len);
+    free(xmem_slice);
+}
+
+void test_xmpool_lifo(x_int32_t xit_test_count, x_int32_t xit_test_size, x_bool_t xbt_lifo)
+{
+    x_int32_t    xit_iter  = 0;
+    x_int32_t    xit_kter  = 0;
+    x_int64_t    xit_miss  = 0;
+    xmem_slice_t xslice_a  = X_NULL;
+    xmem_slice_t xslice_b  = X_NULL;
+    xmem_slice_t xslice_c  = X_NULL;
+
+    const x_uint32_t XSLICE_SIZE  = 128;
+    const x_int32_t  XSLICE_COUNT = 32768;
+    const x_int32_t  XBURST_COUNT = 8;
+
+    xmem_slice_t  * xmem_slice = (xmem_slice_t *)calloc(XSLICE_COUNT, sizeof(xmem_slice_t));
+    xmem_slice_t    xburst_vec[XBURST_COUNT];
+    xmem_slice_t    xburst_bak[XBURST_COUNT];
+    xcache_miss_t   xcache_miss;
+    xmpool_handle_t xmpool_ptr = xmpool_create_ex(X_NULL, X_NULL, X_NULL,
+                                    xbt_lifo ? XMPOOL_FLAG_LIFO : XMPOOL_FLAG_NONE);
+    XVERIFY(X_NULL != xmpool_ptr);
+
+    XVERIFY(xmpool_set_lifo(xmpool_ptr, XSLICE_SIZE, xbt_lifo));
+    XVERIFY(!xmpool_set_lifo(xmpool_ptr, 1024 * 1024, xbt_lifo));
+
+    //======================================
+    // 依次回收 a、b 后再申请：先进先出 取回 a，后进先出 取回 b
+
+    xslice_a = xmpool_alloc(xmpool_ptr, XSLICE_SIZE);
+    xslice_b = xmpool_alloc(xmpool_ptr, XSLICE_SIZE);
+    xslice_c = xmpool_alloc(xmpool_ptr, XSLICE_SIZE);
+    XVERIFY((X_NULL != xslice_a) && (X_NULL != xslice_b) && (X_NULL != xslice_c));
+    XVERIFY(XMEM_ERR_OK == xmpool_recyc(xmpool_ptr, xslice_a));
+    XVERIFY(XMEM_ERR_OK == xmpool_recyc(xmpool_ptr, xslice_b));
+    XVERIFY((xbt_lifo ? xslice_b : xslice_a) == xmpool_alloc(xmpool_ptr, XSLICE_SIZE));
+    XVERIFY((xbt_lifo ? xslice_a : xslice_b) == xmpool_alloc(xmpool_ptr, XSLICE_SIZE));
+    XVERIFY(XMEM_ERR_OK == xmpool_recyc(xmpool_ptr, xslice_a));
+    XVERIFY(XMEM_ERR_OK == xmpool_recyc(xmpool_ptr, xslice_b));
+    XVERIFY(XMEM_ERR_OK == xmpool_recyc(xmpool_ptr, xslice_c));
+
+    //======================================
+    // 先占用 4 MB 的分片，再回收其中的一半，使得 chunk 对象的分片队列中有大量空闲分片
+
+    for (xit_iter = 0; xit_iter < XSLICE_COUNT; ++xit_iter)
+    {
+        xmem_slice[xit_iter] = xmpool_alloc(xmpool_ptr, XSLICE_SIZE);
+        XVERIFY(X_NULL != xmem_slice[xit_iter]);
+        memset(xmem_slice[xit_iter], 0, XSLICE_SIZE);
+    }
+
+    for (xit_iter = 1; xit_iter < XSLICE_COUNT; xit_iter += 2)
+    {
+        XVERIFY(XMEM_ERR_OK == xmpool_recyc(xmpool_ptr, xmem_slice[xit_iter]));
+    }
+
+    //======================================
+    // 紧密的 申请/回收 循环：每轮申请 XBURST_COUNT 个分片并写满，再逆序回收
+
+    xtime_point xtm_begin = xtime_clock::now();
+    xcache_miss.start();
+
+    for (xit_iter = 0; xit_iter < xit_test_count * xit_test_size; ++xit_iter)
+    {
+        for (xit_kter = 0; xit_kter < XBURST_COUNT; ++xit_kter)
+        {
+            xburst_vec[xit_kter] = xmpool_alloc(xmpool_ptr, XSLICE_SIZE);
+            XVERIFY(X_NULL != xburst_vec[xit_kter]);
+            memset(xburst_vec[xit_kter], (x_byte_t)xit_iter, XSLICE_SIZE);
+        }
+
+        // 后进先出 时，每轮取回的都是上一轮回收的分片
+        XVERIFY((0 == xit_iter) || !xbt_lifo ||
+                (0 == memcmp(xburst_vec, xburst_bak, sizeof(xburst_vec))));
+        memcpy(xburst_bak, xburst_vec, sizeof(xburst_vec));
+
+        for (xit_kter = XBURST_COUNT - 1; xit_kter >= 0; --xit_kter)
+        {
+            XVERIFY(XMEM_ERR_OK == xmpool_recyc(xmpool_ptr, xburst_vec[xit_kter]));
+        }
+    }
+
+    xit_miss = xcache_miss.stop();
+    xtime_value xtm_value = xtime_dcast(xtime_clock::now() - xtm_begin);
+
+    const x_lfloat_t xlft_ops = 2.0 * XBURST_COUNT * xit_test_count * xit_test_size;
+    if (xit_miss >= 0)
+    {
+        printf("[LIFO   ] %s : alloc/free : %10.3lf ns, L1D read misses : %8.3lf /op\n",
+               xbt_lifo ? "lifo" : "fifo", xtm_value.count() / xlft_ops, xit_miss / xlft_ops);
+    }
+    else
+    {
+        printf("[LIFO   ] %s : alloc/free : %10.3lf ns, L1D read misses :      n/a\n",
+               xbt_lifo ? "lifo" : "fifo", xtm_value.count() / xlft_ops);
+    }
+
+    for (xit_iter = 0; xit_iter < XSLICE_COUNT; xit_iter += 2)
+    {
+        XVERIFY(XMEM_ERR_OK == xmpool_recyc(xmpool_ptr, xmem_slice[xit_iter]));
+    }
+
+    xmpool_destroy(xmpool_ptr);
+    free(xmem_slice);
+}
+
+void test_xmem_malloc(x_int32_t xit_test_count, x_int32_t xit_alloc_count, x_int32_t xit_test_size)
+{
+    const x_int32_t XTHREAD_COUNT = 4;
+
+    x_int32_t xit_iter = 0;
+    x_int32_t xit_tter = 0;
+
+    xtime_point xtm_begin;
+    xtime_value xtm_value;
+
+    std::thread xthread_array[XTHREAD_COUNT];
+
+    x_byte_t ** xmem_slice = (x_byte_t **)calloc(XTHREAD_COUNT * xit_alloc_count, sizeof(x_byte_t *));
+
+    //======================================
+    // 各线程申请（调整）内存，再由相邻的线程释放
+
+    xtm_begin = xtime_clock::now();
+    for (xit_iter = 0; xit_iter < xit_test_count; ++xit_iter)
+    {
+        for (xit_tter = 0; xit_tter < XTHREAD_COUNT; ++xit_tter)
+        {
+            xthread_array[xit_tter] = std::thread([&, xit_tter]() -> void
+            {
+                x_byte_t ** xslice_aptr = xmem_slice + xit_tter * xit_alloc_count;
+
+                for (x_int32_t xit_kter = 0; xit_kter < xit_alloc_count; ++xit_kter)
+                {
+                    x_size_t xst_size = 1 + (xit_kter % xit_test_size);
+
+                    if (0 == (xit_kter % 3))
+                    {
+                        xslice_aptr[xit_kter] = (x_byte_t *)xmem_calloc(1, xst_size);
+                        XVERIFY(X_NULL != xslice_aptr[xit_kter]);
+                        XVERIFY(0 == xslice_aptr[xit_kter][xst_size - 1]);
+                    }
+                    else
+                    {
+                        xslice_aptr[xit_kter] = (x_byte_t *)xmem_malloc(xst_size);
+                        XVERIFY(X_NULL != xslice_aptr[xit_kter]);
+                    }
+
+                    XVERIFY(xmem_usable_size(xslice_aptr[xit_kter]) >= xst_size);
+                    xslice_aptr[xit_kter][0] = (x_byte_t)xit_kter;
+
+                    if (1 == (xit_kter % 3))
+                    {
+                        xslice_aptr[xit_kter] = (x_byte_t *)xmem_realloc(xslice_aptr[xit_kter], 2 * xst_size);
+                        XVERIFY(X_NULL != xslice_aptr[xit_kter]);
+                        XVERIFY((x_byte_t)xit_kter == xslice_aptr[xit_kter][0]);
+                    }
+                }
+            });
+        }
+
+        for (xit_tter = 0; xit_tter < XTHREAD_COUNT; ++xit_tter)
+        {
+            xthread_array[xit_tter].join();
+        }
+
+        for (xit_tter = 0; xit_tter < XTHREAD_COUNT; ++xit_tter)
+        {
+            xthread_array[xit_tter] = std::thread([&, xit_tter]() -> void
+            {
+                x_byte_t ** xslice_aptr = xmem_slice + ((xit_tter + 1) % XTHREAD_COUNT) * xit_alloc_count;
+
+                for (x_int32_t xit_kter = 0; xit_kter < xit_alloc_count; ++xit_kter)
+                {
+                    XVERIFY((x_byte_t)xit_kter == xslice_aptr[xit_kter][0]);
+                    xmem_free(xslice_aptr[xit_kter]);
+                    xslice_aptr[xit_kter] = X_NULL;
+                }
+            });
+        }
+
+        for (xit_tter = 0; xit_tter < XTHREAD_COUNT; ++xit_tter)
+        {
+            xthread_array[xit_tter].join();
+        }
+    }
+
+    xtm_value = xtime_dcast(xtime_clock::now() - xtm_begin);
+    printf("[MALLOC ] time cost : %12" PRId64 " ns\n", xtm_value.count());
+    printf("[MALLOC ] alloc/free: %12.6lf ns\n", xtm_value.count() / (1.0 * xit_test_count * XTHREAD_COUNT * xit_alloc_count));
+
+    //======================================
+
+    free(xmem_slice);
+}
+
+#ifndef _MSC_VER
+
+void test_xmem_fork(x_int32_t xit_test_count)
+{
+    const x_int32_t XTHREAD_COUNT = 4;
+    const x_int32_t XHANDOFF_SLOTS = 64;
+
+    x_int32_t xit_iter = 0;
+    x_int32_t xit_wait = 0;
+    x_int32_t xit_stat = 0;
+    pid_t     xpid_child = 0;
+
+    std::atomic< x_void_t * > xmem_slot[XHANDOFF_SLOTS];
+    std::atomic< bool > xbt_stop(false);
+    std::thread xthread_array[XTHREAD_COUNT];
+
+    for (xit_iter = 0; xit_iter < XHANDOFF_SLOTS; ++xit_iter)
+    {
+        xmem_slot[xit_iter].store(X_NULL);
+    }
+
+    //======================================
+    // 多个线程不停地 申请/释放（含跨线程释放）内存的同时，主线程反复 fork()，
+    // 子进程中继续 申请/释放 内存（含释放父进程中其他线程申请的内存），不应死锁
+
+    for (x_int32_t xit_tter = 0; xit_tter < XTHREAD_COUNT; ++xit_tter)
+    {
+        xthread_array[xit_tter] = std::thread([&, xit_tter]() -> void
+        {
+            x_void_t * xmem_ptr = X_NULL;
+            x_int32_t  xit_kter = xit_tter;
+
+            while (!xbt_stop.load())
+            {
+                xit_kter = (xit_kter + 7) % XHANDOFF_SLOTS;
+                xmem_ptr = xmem_slot[xit_kter].exchange(
+                    xmem_malloc(1 + ((xit_kter * 131) % (256 * 1024))));
+                xmem_free(xmem_ptr);
+            }
+        });
+    }
+
+    for (xit_iter = 0; xit_iter < xit_test_count; ++xit_iter)
+    {
+        xpid_child = fork();
+        XVERIFY(xpid_child >= 0);
+
+        if (0 == xpid_child)
+        {
+            for (x_int32_t xit_kter = 0; xit_kter < XHANDOFF_SLOTS; ++xit_kter)
+            {
+                xmem_free(xmem_slot[xit_kter].exchange(X_NULL));
+                xmem_free(xmem_malloc(1 + xit_kter * 1024));
+            }
+
+            _exit(0);
+        }
+
+        // 子进程 5 秒内未退出，视为死锁
+        for (xit_wait = 0; xit_wait < 5000; ++xit_wait)
+        {
+            if (xpid_child == waitpid(xpid_child, &xit_stat, WNOHANG))
+                break;
+            usleep(1000);
+        }
+
+        if (5000 == xit_wait)
+        {
+            kill(xpid_child, SIGKILL);
+            waitpid(xpid_child, &xit_stat, 0);
+            XVERIFY(X_FALSE);
+        }
+
+        XVERIFY(WIFEXITED(xit_stat) && (0 == WEXITSTATUS(xit_stat)));
+    }
+
+    xbt_stop.store(true);
+    for (x_int32_t xit_tter = 0; xit_tter < XTHREAD_COUNT; ++xit_tter)
+    {
+        xthread_array[xit_tter].join();
+    }
+
+    for (xit_iter = 0; xit_iter < XHANDOFF_SLOTS; ++xit_iter)
+    {
+        xmem_free(xmem_slot[xit_iter].exchange(X_NULL));
+    }
+
+    printf("[FORK   ] %d forks ok\n", xit_test_count);
+}
+
+#endif // _MSC_VER
+
+//====================================================================
+
+void test_xmem_align_size(x_int32_t xit_test_count)
+{
+    x_int32_t  xit_iter = 0;
+    x_uint32_t xut_size = 0;
+    x_uint64_t xut_sum  = 0;
+
+    xtime_point xtm_begin;
+    xtime_value xtm_value;
+
+    //======================================
+    // 覆盖 [1, 65536] 全部区间的 大小 => 分类 映射开销
+
+    xtm_begin = xtime_clock::now();
+    for (xit_iter = 0; xit_iter < xit_test_count; ++xit_iter)
+    {
+        for (xut_size = 1; xut_size <= 65536; ++xut_size)
+        {
+            xut_sum += xmem_align_size(xut_size);
+        }
+    }
+
+    xtm_value = xtime_dcast(xtime_clock::now() - xtm_begin);
+    printf("[CLASS  ] time cost : %12" PRId64 " ns, checksum : %llu\n", xtm_value.count(), (unsigned long long)xut_sum);
+    printf("[CLASS  ] size2class: %12.6lf ns\n", xtm_value.count() / (65536.0 * xit_test_count));
+
+    //======================================
+
+    for (xut_size = 1; xut_size <= 65536; ++xut_size)
+    {
+        XVERIFY(xmem_align_size(xut_size) >= xut_size);
+        XVERIFY(xmem_align_size(xmem_align_size(xut_size)) == xmem_align_size(xut_size));
+    }
+}
+
+void test_xmpool_classes(x_int32_t xit_test_count)
+{
+    x_int32_t  xit_iter = 0;
+    x_int32_t  xit_kter = 0;
+    x_uint32_t xut_size = 0;
+
+    // 申请大小集中在 40、72、200、1000、3000 字节附近的负载
+    const x_uint32_t xut_sizes[] = { 36, 40, 68, 72, 196, 200, 1000, 3000 };
+    const x_int32_t  XSIZE_COUNT = (x_int32_t)(sizeof(xut_sizes) / sizeof(xut_sizes[0]));
+    const x_int32_t  XALLOC_EACH = 4096;
+
+    const xmpool_class_t xclass_table[] =
+    {
+        {   40,          0 },
+        {   72,          0 },
+        {  200, 64 * 1024  },
+        { 1000,          0 },
+        { 3000,          0 },
+    };
+
+    xtime_point xtm_begin;
+    xtime_value xtm_value;
+
+    xmem_slice_t * xslice_vec = (xmem_slice_t *)calloc(XSIZE_COUNT * XALLOC_EACH, sizeof(xmem_slice_t));
+    xmem_slice_t   xmem_slice = X_NULL;
+
+    //======================================
+    // 无效的分类表
+
+    const xmpool_class_t xclass_desc[] = { { 72, 0 }, { 40, 0 } };
+    const xmpool_class_t xclass_odd [] = { { 36, 0 } };
+    const xmpool_class_t xclass_huge[] = { { XMPOOL_CLASS_MAX_SIZE + 8, 0 } };
+    const xmpool_class_t xclass_chunk[] = { { 4096, 4096 } };
+
+    XVERIFY(X_NULL == xmpool_create_classes(X_NULL, X_NULL, X_NULL, XMPOOL_FLAG_NONE, xclass_desc , 2));
+    XVERIFY(X_NULL == xmpool_create_classes(X_NULL, X_NULL, X_NULL, XMPOOL_FLAG_NONE, xclass_odd  , 1));
+    XVERIFY(X_NULL == xmpool_create_classes(X_NULL, X_NULL, X_NULL, XMPOOL_FLAG_NONE, xclass_huge , 1));
+    XVERIFY(X_NULL == xmpool_create_classes(X_NULL, X_NULL, X_NULL, XMPOOL_FLAG_NONE, xclass_chunk, 1));
+    XVERIFY(X_NULL == xmpool_create_classes(X_NULL, X_NULL, X_NULL, XMPOOL_FLAG_NONE, xclass_table, 0));
+    XVERIFY(X_NULL == xmpool_create_classes(X_NULL, X_NULL, X_NULL, XMPOOL_FLAG_CACHE_ALIGN, xclass_table, 5));
+
+    //======================================
+    // 可加载的分类表文本（xmem_classgen 的输出格式）与 chunk 方案
+
+    xmpool_class_t xclass_parse[XMPOOL_CLASS_MAX_COUNT];
+    x_uint32_t     xchunk_size = 0;
+    x_uint32_t     xut_unused  = 0;
+    x_uint32_t     xut_capacity = 0;
+
+    XVERIFY(5 == xmpool_parse_classes("# slice_size chunk_size\n40\n72 0\n  200 65536\n\n1000\n3000 0\n",
+                                      xclass_parse, XMPOOL_CLASS_MAX_COUNT));
+    XVERIFY((200 == xclass_parse[2].xslice_size) && ((64 * 1024) == xclass_parse[2].xchunk_size));
+    XVERIFY((3000 == xclass_parse[4].xslice_size) && (0 == xclass_parse[4].xchunk_size));
+    XVERIFY(0 == xmpool_parse_classes("40\n72 abc\n", xclass_parse, XMPOOL_CLASS_MAX_COUNT));
+    XVERIFY(0 == xmpool_parse_classes("40\n72\n", xclass_parse, 1));
+
+    xmpool_handle_t xmpool_parse = xmpool_create_classes(X_NULL, X_NULL, X_NULL, XMPOOL_FLAG_NONE, xclass_parse,
+        xmpool_parse_classes("40\n72\n200 65536\n1000\n3000\n", xclass_parse, XMPOOL_CLASS_MAX_COUNT));
+    XVERIFY(X_NULL != xmpool_parse);
+    XVERIFY(1000 == xmpool_align_size(xmpool_parse, 999));
+    xmpool_destroy(xmpool_parse);
+
+    XVERIFY(0 == xmem_chunk_layout(0, &xchunk_size, &xut_unused));
+    XVERIFY(0 == xmem_chunk_layout(XMPOOL_CLASS_MAX_SIZE + 8, &xchunk_size, &xut_unused));
+    for (xut_size = 8; xut_size <= XMPOOL_CLASS_MAX_SIZE; xut_size += 8)
+    {
+        xut_capacity = xmem_chunk_layout(xut_size, &xchunk_size, &xut_unused);
+        XVERIFY((xut_capacity > 0) && (xut_capacity <= 0x7FFF));
+        XVERIFY((xchunk_size >= 256 * 1024) && (xchunk_size <= 1024 * 1024));
+        XVERIFY(xut_unused < xchunk_size);
+    }
+
+    //======================================
+
+    for (x_int32_t xit_custom = 0; xit_custom < 2; ++xit_custom)
+    {
+        xmpool_handle_t xmpool_ptr = xit_custom ?
+            xmpool_create_classes(X_NULL, X_NULL, X_NULL, XMPOOL_FLAG_NONE, xclass_table, 5) :
+            xmpool_create_ex(X_NULL, X_NULL, X_NULL, XMPOOL_FLAG_NONE);
+        XVERIFY(X_NULL != xmpool_ptr);
+
+        if (xit_custom)
+        {
+            XVERIFY(  40 == xmpool_align_size(xmpool_ptr,    1));
+            XVERIFY(  40 == xmpool_align_size(xmpool_ptr,   40));
+            XVERIFY(  72 == xmpool_align_size(xmpool_ptr,   41));
+            XVERIFY( 200 == xmpool_align_size(xmpool_ptr,  196));
+            XVERIFY(3000 == xmpool_align_size(xmpool_ptr, 2999));
+            XVERIFY(4096 == xmpool_align_size(xmpool_ptr, 3001));
+
+            // 指定的 chunk 大小
+            xmem_slice = xmpool_alloc(xmpool_ptr, 200);
+            XVERIFY(X_NULL != xmem_slice);
+            XVERIFY((64 * 1024) == xmpool_cached_size(xmpool_ptr));
+            XVERIFY(XMEM_ERR_OK == xmpool_recyc(xmpool_ptr, xmem_slice));
+
+            // 大于最大分类的申请按大块分片管理
+            xmem_slice = xmpool_alloc(xmpool_ptr, 3001);
+            XVERIFY(X_NULL != xmem_slice);
+            XVERIFY(xmpool_slice_size(xmpool_ptr, xmem_slice) >= 3001);
+            XVERIFY(XMEM_ERR_OK == xmpool_recyc(xmpool_ptr, xmem_slice));
+
+            // 没有分片大小为 64 整数倍的分类时，对齐申请按大块分片管理
+            xmem_slice = xmpool_alloc_aligned(xmpool_ptr, 100, 64);
+            XVERIFY((X_NULL != xmem_slice) && (0 == ((x_size_t)xmem_slice & 63)));
+            XVERIFY(XMEM_ERR_OK == xmpool_recyc(xmpool_ptr, xmem_slice));
+
+            xmem_slice = xmpool_alloc_aligned(xmpool_ptr, 30, 8);
+            XVERIFY(40 == xmpool_slice_size(xmpool_ptr, xmem_slice));
+            XVERIFY(XMEM_ERR_OK == xmpool_recyc_sized(xmpool_ptr, xmem_slice, 30));
+        }
+        else
+        {
+            for (xut_size = 1; xut_size <= 65536; ++xut_size)
+            {
+                XVERIFY(xmem_align_size(xut_size) == xmpool_align_size(xmpool_ptr, xut_size));
+            }
+        }
+
+        xmpool_release_unused(xmpool_ptr);
+
+        //======================================
+
+        xtm_begin = xtime_clock::now();
+        for (xit_iter = 0; xit_iter < xit_test_count; ++xit_iter)
+        {
+            for (xit_kter = 0; xit_kter < XSIZE_COUNT; ++xit_kter)
+            {
+                XVERIFY(XALLOC_EACH == (x_int32_t)xmpool_alloc_batch(
+                            xmpool_ptr, xut_sizes[xit_kter], XALLOC_EACH, xslice_vec + xit_kter * XALLOC_EACH));
+            }
+
+            if (xit_iter + 1 < xit_test_count)
+            {
+                XVERIFY((x_uint32_t)(XSIZE_COUNT * XALLOC_EACH) ==
+                        xmpool_recyc_batch(xmpool_ptr, xslice_vec, XSIZE_COUNT * XALLOC_EACH));
+            }
+        }
+        xtm_value = xtime_dcast(xtime_clock::now() - xtm_begin);
+
+        printf("[CLASSES] %s : %12.6lf ns, using : %10.3lf KB, cached : %10.3lf KB\n",
+               xit_custom ? "custom   " : "default  ",
+               xtm_value.count() / (1.0 * xit_test_count * XSIZE_COUNT * XALLOC_EACH),
+               xmpool_using_size(xmpool_ptr) / 1024.0,
+               xmpool_cached_size(xmpool_ptr) / 1024.0);
+
+        for (xit_kter = 0; xit_kter < XSIZE_COUNT; ++xit_kter)
+        {
+            xmem_slice = xslice_vec[xit_kter * XALLOC_EACH];
+            XVERIFY(xmpool_align_size(xmpool_ptr, xut_sizes[xit_kter]) == xmpool_slice_size(xmpool_ptr, xmem_slice));
+
+            xmem_slice = xmpool_realloc(xmpool_ptr, xmem_slice, xut_sizes[xit_kter] + 1);
+            XVERIFY(X_NULL != xmem_slice);
+            xslice_vec[xit_kter * XALLOC_EACH] = xmem_slice;
+        }
+
+        XVERIFY((x_uint32_t)(XSIZE_COUNT * XALLOC_EACH) ==
+                xmpool_recyc_batch(xmpool_ptr, xslice_vec, XSIZE_COUNT * XALLOC_EACH));
+        XVERIFY(0 == xmpool_using_size(xmpool_ptr));
+
+        xmpool_release_unused(xmpool_ptr);
+        XVERIFY(0 == xmpool_cached_size(xmpool_ptr));
+        xmpool_destroy(xmpool_ptr);
+    }
+
+    free(xslice_vec);
+}
+
+//====================================================================
+
+int main(int argc, char * argv[])
+{
+    x_int32_t xit_test_count  = 100;
+    x_int32_t xit_alloc_count = 0;
+    x_int32_t xit_test_size   = (32 * 1024);
+    x_int32_t xit_first_test  = 0;
+
+    printf("Usage: \n%s < test count > < alloc count [0] > < test size[32768] > < first_test [0] : 0 or 1 >\n\n", argv[0]);
+
+    if (argc >= 2) xit_test_count  = atoi(argv[1]);
+    if (argc >= 3) xit_alloc_count = atoi(argv[2]);
+    if (argc >= 4) xit_test_size   = atoi(argv[3]);
+    if (argc >= 5) xit_first_test  = atoi(argv[4]);
+
+    printf("test  count: %10d\n", xit_test_count );
+    printf("alloc count: %10d\n", xit_alloc_count);
+    printf("test  size : %10d\n", xit_test_size  );
+
+    if (xit_alloc_count > 0)
+        printf("Tatol count: %10d\n", xit_test_count * xit_alloc_count * xit_test_size);
+    else
+        printf("Tatol count: %10d\n", xit_test_count * xit_test_size);
+
+    printf("//======================================\n");
+
+    if (0 != xit_first_test)
+    {
+        if (xit_alloc_count > 0)
+        {
+            test_xmpool2(xit_test_count, xit_alloc_count, xit_test_size);
+            test_malloc2(xit_test_count, xit_alloc_count, xit_test_size);
+        }
+        else
+        {
+            test_xmpool1(xit_test_count, xit_test_size);
+            test_malloc1(xit_test_count, xit_test_size);
+        }
+    }
+    else
+    {
+        if (xit_alloc_count > 0)
+        {
+            test_malloc2(xit_test_count, xit_alloc_count, xit_test_size);
+            test_xmpool2(xit_test_count, xit_alloc_count, xit_test_size);
+        }
+        else
+        {
+            test_malloc1(xit_test_count, xit_test_size);
+            test_xmpool1(xit_test_count, xit_test_size);
+        }
+    }
+
+    printf("//======================================\n");
+
+    test_xmem_align_size(xit_test_count);
+    test_xmpool_classes(xit_test_count);
+    printf("//======================================\n");
+
+    if (xit_alloc_count > 0)
+    {
+        test_xmpool_remote(xit_test_count, xit_alloc_count, xit_test_size);
+        test_xmpool_remote_churn(xit_test_count, xit_alloc_count, xit_test_size, XMPOOL_FLAG_NONE);
+        test_xmpool_remote_churn(xit_test_count, xit_alloc_count, xit_test_size, XMPOOL_FLAG_ALIGN_CHUNK);
+        printf("//======================================\n");
+        test_xmpool_random(xit_test_count, xit_alloc_count, xit_test_size, XMPOOL_FLAG_NONE);
+        test_xmpool_random(xit_test_count, xit_alloc_count, xit_test_size, XMPOOL_FLAG_ALIGN_CHUNK);
+        test_xmpool_random(xit_test_count, xit_alloc_count, xit_test_size, XMPOOL_FLAG_MAGAZINE);
+        test_xmpool_mask_large();
+        printf("//======================================\n");
+        test_xmpool_retain(xit_test_count, xit_alloc_count, xit_test_size);
+        test_xmpool_decay(xit_test_count, xit_alloc_count, xit_test_size);
+        test_xmpool_purge_pages(xit_alloc_count);
+        printf("//======================================\n");
+        test_xmpool_aligned(xit_test_count, xit_alloc_count, xit_test_size);
+        printf("//======================================\n");
+        test_xmpool_realloc(xit_test_count, X_FALSE);
+        test_xmpool_realloc(xit_test_count, X_TRUE);
+        printf("//======================================\n");
+        test_xmpool_large(xit_test_count, X_FALSE);
+        test_xmpool_large(xit_test_count, X_TRUE);
+        printf("//======================================\n");
+        test_xmpool_hugepage(xit_test_count, XMHEAP_FLAG_NONE);
+        test_xmpool_hugepage(xit_test_count, XMHEAP_FLAG_HUGE_PAGE);
+        test_xmpool_hugepage(xit_test_count, XMHEAP_FLAG_HUGETLB);
+        printf("//======================================\n");
+        test_xmpool_numa(xit_test_count);
+        printf("//======================================\n");
+        test_xmpool_sized(xit_test_count, xit_alloc_count, xit_test_size, X_FALSE);
+        test_xmpool_sized(xit_test_count, xit_alloc_count, xit_test_size, X_TRUE);
+        printf("//======================================\n");
+        test_xmpool_batch(xit_test_count, xit_alloc_count, xit_test_size);
+        printf("//======================================\n");
+        test_xmpool_magazine(xit_test_count, xit_alloc_count, XMPOOL_FLAG_NONE);
+        test_xmpool_magazine(xit_test_count, xit_alloc_count, XMPOOL_FLAG_MAGAZINE);
+        printf("//======================================\n");
+        test_xmpool_stats(xit_test_count, xit_alloc_count, XMPOOL_FLAG_NONE);
+        test_xmpool_stats(xit_test_count, xit_alloc_count, XMPOOL_FLAG_MAGAZINE);
+        printf("//======================================\n");
+        test_xmpool_grow(XMPOOL_FLAG_NONE);
+        test_xmpool_grow(XMPOOL_FLAG_ALIGN_CHUNK);
+        printf("//======================================\n");
+        test_xmpool_lifo(xit_test_count, xit_test_size, X_FALSE);
+        test_xmpool_lifo(xit_test_count, xit_test_size, X_TRUE);
+        printf("//======================================\n");
+        test_xmpool_prof(xit_test_count, xit_alloc_count, XMPOOL_FLAG_NONE);
+        test_xmpool_prof(xit_test_count, xit_alloc_count, XMPOOL_FLAG_MAGAZINE);
+        printf("//======================================\n");
+        test_xmem_malloc(xit_test_count, xit_alloc_count, xit_test_size);
+#ifndef _MSC_VER
+        test_xmem_fork(16 * xit_test_count);
+#endif // _MSC_VER
+        printf("//======================================\n");
+    }
 
 	return 0;
 }
@@ -0,0 +1,628 @@
+﻿/**
+ * @file    xmem_classgen.c
+ * <pre>
+ * Copyright (c) 2019, Gaaagaa All rights reserved.
+ *
+ * 文件名称：xmem_classgen.c
+ * 创建日期：2026年10月18日
+ * 文件标识：
+ * 文件摘要：按记录的申请大小分布，离线生成内存池分类表（参看 xmpool_create_classes()）的工具。
+ *
+ * 编译方式：
+ *   gcc -O2 -o xmem_classgen xmem_classgen.c xmem_pool.c xmem_prof.c xrbtree.c
+ *
+ * 使用方式：
+ *   xmem_classgen [-n 最大分类数] [-c] [-o 头文件] [-t 分类表文件] [-p 名称] [输入文件]
+ *   - 输入（文件或标准输入）每行为“大小 次数”（直方图）或“大小”（申请记录，次数为 1），
+ *     以 '#' 开头的行为注释；大于 XMPOOL_CLASS_MAX_SIZE 的大小按大块分片管理，不参与计算；
+ *   - -n : 最大分类数（默认 32，不大于 XMPOOL_CLASS_MAX_COUNT）；
+ *   - -c : 生成适用于 XMPOOL_FLAG_CACHE_ALIGN 模式的分类表；
+ *   - -o : 输出 C 头文件（定义 xmpool_class_t 数组，可直接传给 xmpool_create_classes()）；
+ *   - -t : 输出可在运行时加载的分类表（参看 xmpool_parse_classes()）；
+ *   - -p : 头文件中数组与宏的名称（默认 xmem_classes）；
+ *   未指定 -o 与 -t 时，可加载的分类表输出到标准输出；统计报告输出到标准错误。
+ *
+ * 当前版本：1.0.0.0
+ * 作    者：
+ * 完成日期：2026年10月18日
+ * 版本摘要：
+ *
+ * 历史版本：
+ * 原作者  ：
+ * 完成日期：
+ * 版本摘要：
+ * </pre>
+ */
+
+#include "xmem_comm.h"
+
+#include <stdio.h>
+#include <string.h>
+
+////////////////////////////////////////////////////////////////////////////////
+
+/** 默认的最大分类数 */
+#define XCLASSGEN_DEFAULT_COUNT   32
+
+/** 分类索引表的粒度（分片大小须为其整数倍） */
+#define XCLASSGEN_GRAIN           8
+
+/** 输入行的最大长度 */
+#define XCLASSGEN_LINE_SIZE       256
+
+/**
+ * @struct xclassgen_bucket_t
+ * @brief  候选分片大小（桶）：申请大小按分类索引表的粒度（缓存行模式下，
+ *         不小于 XMPOOL_CACHE_LINE 的按缓存行）向上对齐后的值，及落入其中的申请的统计。
+ */
+typedef struct xclassgen_bucket_t
+{
+    x_uint32_t   xslice_size;  ///< 候选分片大小
+    x_lfloat_t   xreq_count;   ///< 落入该桶的申请次数
+    x_lfloat_t   xreq_bytes;   ///< 落入该桶的申请大小总和
+    x_lfloat_t   xslice_cost;  ///< 以该大小为分类时，每个分片的代价（分片大小 + 均摊的 chunk 尾部浪费）
+    x_uint32_t   xchunk_size;  ///< 以该大小为分类时的 chunk 大小
+    x_uint32_t   xcapacity;    ///< 以该大小为分类时的 chunk 容量
+    x_uint32_t   xut_unused;   ///< 以该大小为分类时，chunk 中未使用到的字节数
+} xclassgen_bucket_t;
+
+/** 申请大小的直方图（下标为申请大小） */
+static x_lfloat_t X_size_hist[XMPOOL_CLASS_MAX_SIZE + 1];
+
+////////////////////////////////////////////////////////////////////////////////
+
+//====================================================================
+
+//
+// internal calls
+//
+
+/**********************************************************/
+/**
+ * @brief 申请大小在（缓存行模式下）分类选取时所使用的对齐值。
+ */
+static x_uint32_t xclassgen_round(x_uint32_t xut_size, x_bool_t xbt_cache)
+{
+    if (xbt_cache && (xut_size >= XMPOOL_CACHE_LINE))
+        return X_ALIGN(xut_size, XMPOOL_CACHE_LINE);
+    return X_ALIGN(xut_size, XCLASSGEN_GRAIN);
+}
+
+/**********************************************************/
+/**
+ * @brief 读取输入的直方图（或申请记录）。
+ *
+ * @param [in ] xfile_ptr   : 输入文件。
+ * @param [out] xlarge_ptr  : 返回大于 XMPOOL_CLASS_MAX_SIZE 的申请次数。
+ *
+ * @return x_lfloat_t
+ *         - 返回参与计算的申请次数；格式错误时，返回 -1。
+ */
+static x_lfloat_t xclassgen_read(FILE * xfile_ptr, x_lfloat_t * xlarge_ptr)
+{
+    x_char_t   xline_buf[XCLASSGEN_LINE_SIZE];
+    x_char_t * xiter_ptr = X_NULL;
+    x_char_t * xnext_ptr = X_NULL;
+    x_uint64_t xut_size  = 0;
+    x_uint64_t xut_count = 0;
+    x_lfloat_t xlft_total = 0.0;
+    x_uint32_t xut_line  = 0;
+
+    *xlarge_ptr = 0.0;
+
+    while (X_NULL != fgets(xline_buf, sizeof(xline_buf), xfile_ptr))
+    {
+        xut_line += 1;
+
+        xiter_ptr = xline_buf;
+        while ((' ' == *xiter_ptr) || ('\t' == *xiter_ptr))
+            ++xiter_ptr;
+
+        if (('#' == *xiter_ptr) || ('\r' == *xiter_ptr) ||
+            ('\n' == *xiter_ptr) || ('\0' == *xiter_ptr))
+        {
+            continue;
+        }
+
+        xut_size = strtoull(xiter_ptr, &xnext_ptr, 10);
+        if (xnext_ptr == xiter_ptr)
+        {
+            fprintf(stderr, "line %u: invalid size\n", xut_line);
+            return -1.0;
+        }
+
+        xiter_ptr = xnext_ptr;
+        xut_count = strtoull(xiter_ptr, &xnext_ptr, 10);
+        if (xnext_ptr == xiter_ptr)
+        {
+            xut_count = 1;
+        }
+
+        if ((0 == xut_size) || (0 == xut_count))
+        {
+            continue;
+        }
+
+        if (xut_size > XMPOOL_CLASS_MAX_SIZE)
+        {
+            *xlarge_ptr += (x_lfloat_t)xut_count;
+            continue;
+        }
+
+        X_size_hist[xut_size] += (x_lfloat_t)xut_count;
+        xlft_total += (x_lfloat_t)xut_count;
+    }
+
+    return xlft_total;
+}
+
+/**********************************************************/
+/**
+ * @brief 由直方图生成候选分片大小（桶）数组。
+ *
+ * @return x_uint32_t
+ *         - 返回桶的数量。
+ */
+static x_uint32_t xclassgen_buckets(xclassgen_bucket_t * xbucket_ptr, x_bool_t xbt_cache)
+{
+    x_uint32_t xut_size  = 0;
+    x_uint32_t xut_round = 0;
+    x_uint32_t xut_count = 0;
+
+    for (xut_size = 1; xut_size <= XMPOOL_CLASS_MAX_SIZE; ++xut_size)
+    {
+        if (X_size_hist[xut_size] <= 0.0)
+        {
+            continue;
+        }
+
+        // 按大小递增遍历，对齐后的值也单调不减，相同的值归入同一个桶
+        xut_round = xclassgen_round(xut_size, xbt_cache);
+        if ((0 == xut_count) || (xbucket_ptr[xut_count - 1].xslice_size != xut_round))
+        {
+            xmem_clear(&xbucket_ptr[xut_count], sizeof(xclassgen_bucket_t));
+            xbucket_ptr[xut_count].xslice_size = xut_round;
+            xbucket_ptr[xut_count].xcapacity   =
+                xmem_chunk_layout(xut_round,
+                                  &xbucket_ptr[xut_count].xchunk_size,
+                                  &xbucket_ptr[xut_count].xut_unused);
+            xbucket_ptr[xut_count].xslice_cost =
+                (x_lfloat_t)xut_round +
+                (x_lfloat_t)xbucket_ptr[xut_count].xut_unused /
+                (x_lfloat_t)xbucket_ptr[xut_count].xcapacity;
+            xut_count += 1;
+        }
+
+        xbucket_ptr[xut_count - 1].xreq_count += X_size_hist[xut_size];
+        xbucket_ptr[xut_count - 1].xreq_bytes += X_size_hist[xut_size] * xut_size;
+    }
+
+    return xut_count;
+}
+
+/**********************************************************/
+/**
+ * @brief 按代价最小的原则，从候选分片大小中选取（不超过 xut_max 个）分类。
+ * @note
+ * 代价 = 内部碎片（分片大小 - 申请大小）+ 均摊到每个分片的 chunk 尾部浪费（unused / capacity）。
+ * 每个桶中的申请都落到不小于它的最小分类，且最大的桶必须是一个分类，
+ * 因此以动态规划求解：xdp[k][j] 为前 j + 1 个桶使用 k + 1 个分类（最后一个为桶 j）的最小代价，
+ * 时间复杂度为 O(xut_max * 桶数^2)。
+ *
+ * @param [in ] xbucket_ptr : 候选分片大小（桶）数组。
+ * @param [in ] xut_count   : 桶的数量。
+ * @param [in ] xut_max     : 最大分类数。
+ * @param [out] xclass_vec  : 返回所选分类对应的桶索引号（升序）。
+ * @param [out] xlft_cost   : 返回最小代价。
+ *
+ * @return x_uint32_t
+ *         - 返回所选分类的数量；内存不足时，返回 0。
+ */
+static x_uint32_t xclassgen_optimize(const xclassgen_bucket_t * xbucket_ptr,
+                                     x_uint32_t xut_count,
+                                     x_uint32_t xut_max,
+                                     x_uint32_t * xclass_vec,
+                                     x_lfloat_t * xlft_cost)
+{
+    x_lfloat_t * xprev_dp = X_NULL;
+    x_lfloat_t * xcurr_dp = X_NULL;
+    x_lfloat_t * xswap_dp = X_NULL;
+    x_lfloat_t * xpsum_cnt = X_NULL;
+    x_lfloat_t * xpsum_len = X_NULL;
+    x_uint32_t * xparent   = X_NULL;
+
+    x_lfloat_t xlft_best = 0.0;
+    x_lfloat_t xlft_test = 0.0;
+    x_uint32_t xut_best  = 0;
+    x_uint32_t xut_kter  = 0;
+    x_uint32_t xut_iter  = 0;
+    x_uint32_t xut_jter  = 0;
+    x_uint32_t xut_used  = 0;
+
+    /** 桶 (xut_i, xut_j] 中的申请都落到分类 xut_j 时的代价 */
+#define XCOST(xut_i, xut_j)                                                         \
+    ((xpsum_cnt[(xut_j) + 1] - xpsum_cnt[(xut_i) + 1]) * xbucket_ptr[xut_j].xslice_cost - \
+     (xpsum_len[(xut_j) + 1] - xpsum_len[(xut_i) + 1]))
+
+    if (xut_max > xut_count)
+        xut_max = xut_count;
+
+    xprev_dp  = (x_lfloat_t *)calloc(xut_count, sizeof(x_lfloat_t));
+    xcurr_dp  = (x_lfloat_t *)calloc(xut_count, sizeof(x_lfloat_t));
+    xpsum_cnt = (x_lfloat_t *)calloc(xut_count + 1, sizeof(x_lfloat_t));
+    xpsum_len = (x_lfloat_t *)calloc(xut_count + 1, sizeof(x_lfloat_t));
+    xparent   = (x_uint32_t *)calloc((x_size_t)xut_max * xut_count, sizeof(x_uint32_t));
+    if ((X_NULL == xprev_dp ) || (X_NULL == xcurr_dp ) ||
+        (X_NULL == xpsum_cnt) || (X_NULL == xpsum_len) || (X_NULL == xparent))
+    {
+        xut_used = 0;
+        goto __EXIT_FUNC__;
+    }
+
+    for (xut_iter = 0; xut_iter < xut_count; ++xut_iter)
+    {
+        xpsum_cnt[xut_iter + 1] = xpsum_cnt[xut_iter] + xbucket_ptr[xut_iter].xreq_count;
+        xpsum_len[xut_iter + 1] = xpsum_len[xut_iter] + xbucket_ptr[xut_iter].xreq_bytes;
+    }
+
+    //======================================
+    // 只用一个分类：桶 [0, j] 全部落到分类 j
+
+    for (xut_jter = 0; xut_jter < xut_count; ++xut_jter)
+    {
+        xprev_dp[xut_jter] =
+            xpsum_cnt[xut_jter + 1] * xbucket_ptr[xut_jter].xslice_cost - xpsum_len[xut_jter + 1];
+        xparent[xut_jter] = xut_count;
+    }
+
+    xlft_best = xprev_dp[xut_count - 1];
+    xut_best  = 0;
+
+    //======================================
+
+    for (xut_kter = 1; xut_kter < xut_max; ++xut_kter)
+    {
+        for (xut_jter = 0; xut_jter < xut_count; ++xut_jter)
+        {
+            xcurr_dp[xut_jter] = xprev_dp[xut_jter];
+            xparent[xut_kter * xut_count + xut_jter] = xut_count;
+
+            for (xut_iter = xut_kter - 1; xut_iter < xut_jter; ++xut_iter)
+            {
+                xlft_test = xprev_dp[xut_iter] + XCOST(xut_iter, xut_jter);
+                if (xlft_test < xcurr_dp[xut_jter])
+                {
+                    xcurr_dp[xut_jter] = xlft_test;
+                    xparent[xut_kter * xut_count + xut_jter] = xut_iter;
+                }
+            }
+        }
+
+        if (xcurr_dp[xut_count - 1] < xlft_best)
+        {
+            xlft_best = xcurr_dp[xut_count - 1];
+            xut_best  = xut_kter;
+        }
+
+        xswap_dp = xprev_dp;
+        xprev_dp = xcurr_dp;
+        xcurr_dp = xswap_dp;
+    }
+
+    //======================================
+    // 回溯所选分类（xparent 为 xut_count 时，表示该层沿用上一层的结果）
+
+    xut_jter = xut_count - 1;
+    xut_kter = xut_best;
+    xut_used = 0;
+    for (;;)
+    {
+        xut_iter = xparent[xut_kter * xut_count + xut_jter];
+        if (xut_count == xut_iter)
+        {
+            if (0 == xut_kter)
+            {
+                xclass_vec[xut_used++] = xut_jter;
+                break;
+            }
+
+            xut_kter -= 1;
+            continue;
+        }
+
+        xclass_vec[xut_used++] = xut_jter;
+        xut_jter  = xut_iter;
+        xut_kter -= 1;
+    }
+
+    // 回溯所得为降序，翻转为升序
+    for (xut_iter = 0; xut_iter < xut_used / 2; ++xut_iter)
+    {
+        xut_jter = xclass_vec[xut_iter];
+        xclass_vec[xut_iter] = xclass_vec[xut_used - 1 - xut_iter];
+        xclass_vec[xut_used - 1 - xut_iter] = xut_jter;
+    }
+
+    *xlft_cost = xlft_best;
+
+__EXIT_FUNC__:
+    free(xprev_dp );
+    free(xcurr_dp );
+    free(xpsum_cnt);
+    free(xpsum_len);
+    free(xparent  );
+
+#undef XCOST
+
+    return xut_used;
+}
+
+/**********************************************************/
+/**
+ * @brief 计算默认分类表下（参看 xmem_align_size()）的代价，用于对比。
+ */
+static x_lfloat_t xclassgen_default_cost(x_bool_t xbt_cache)
+{
+    x_uint32_t xut_size  = 0;
+    x_uint32_t xut_class = 0;
+    x_uint32_t xut_unused = 0;
+    x_uint32_t xut_capacity = 0;
+    x_lfloat_t xlft_cost = 0.0;
+
+    for (xut_size = 1; xut_size <= XMPOOL_CLASS_MAX_SIZE; ++xut_size)
+    {
+        if (X_size_hist[xut_size] <= 0.0)
+        {
+            continue;
+        }
+
+        xut_class = xmem_align_size(xbt_cache ? xclassgen_round(xut_size, X_TRUE) : xut_size);
+        xut_capacity = xmem_chunk_layout(xut_class, X_NULL, &xut_unused);
+        xlft_cost += X_size_hist[xut_size] *
+                     ((x_lfloat_t)(xut_class - xut_size) +
+                      (x_lfloat_t)xut_unused / (x_lfloat_t)xut_capacity);
+    }
+
+    return xlft_cost;
+}
+
+/**********************************************************/
+/**
+ * @brief 输出可在运行时加载的分类表（参看 xmpool_parse_classes()）。
+ */
+static x_void_t xclassgen_write_table(FILE * xfile_ptr,
+                                      const xclassgen_bucket_t * xbucket_ptr,
+                                      const x_uint32_t * xclass_vec,
+                                      x_uint32_t xut_used)
+{
+    x_uint32_t xut_iter = 0;
+
+    fprintf(xfile_ptr, "# generated by xmem_classgen : %u classes\n", xut_used);
+    fprintf(xfile_ptr, "# slice_size chunk_size\n");
+    for (xut_iter = 0; xut_iter < xut_used; ++xut_iter)
+    {
+        fprintf(xfile_ptr, "%u %u\n",
+                xbucket_ptr[xclass_vec[xut_iter]].xslice_size,
+                xbucket_ptr[xclass_vec[xut_iter]].xchunk_size);
+    }
+}
+
+/**********************************************************/
+/**
+ * @brief 输出 C 头文件。
+ */
+static x_void_t xclassgen_write_header(FILE * xfile_ptr,
+                                       const x_char_t * xname_ptr,
+                                       const xclassgen_bucket_t * xbucket_ptr,
+                                       const x_uint32_t * xclass_vec,
+                                       x_uint32_t xut_used,
+                                       x_bool_t xbt_cache)
+{
+    x_char_t   xmacro_buf[XCLASSGEN_LINE_SIZE];
+    x_uint32_t xut_iter = 0;
+
+    for (xut_iter = 0; ('\0' != xname_ptr[xut_iter]) && (xut_iter + 1 < sizeof(xmacro_buf)); ++xut_iter)
+    {
+        xmacro_buf[xut_iter] = (x_char_t)(((xname_ptr[xut_iter] >= 'a') && (xname_ptr[xut_iter] <= 'z')) ?
+                                          (xname_ptr[xut_iter] - 'a' + 'A') : xname_ptr[xut_iter]);
+    }
+    xmacro_buf[xut_iter] = '\0';
+
+    fprintf(xfile_ptr, "/**\n");
+    fprintf(xfile_ptr, " * @brief generated by xmem_classgen%s, pass to xmpool_create_classes().\n",
+            xbt_cache ? " (XMPOOL_FLAG_CACHE_ALIGN)" : "");
+    fprintf(xfile_ptr, " */\n\n");
+    fprintf(xfile_ptr, "#ifndef __%s_H__\n", xmacro_buf);
+    fprintf(xfile_ptr, "#define __%s_H__\n\n", xmacro_buf);
+    fprintf(xfile_ptr, "#define %s_COUNT %u\n\n", xmacro_buf, xut_used);
+    fprintf(xfile_ptr, "static const xmpool_class_t %s[%s_COUNT] =\n{\n", xname_ptr, xmacro_buf);
+    for (xut_iter = 0; xut_iter < xut_used; ++xut_iter)
+    {
+        fprintf(xfile_ptr, "    { %6u, %8u }, // capacity : %6u, unused : %6u\n",
+                xbucket_ptr[xclass_vec[xut_iter]].xslice_size,
+                xbucket_ptr[xclass_vec[xut_iter]].xchunk_size,
+                xbucket_ptr[xclass_vec[xut_iter]].xcapacity,
+                xbucket_ptr[xclass_vec[xut_iter]].xut_unused);
+    }
+    fprintf(xfile_ptr, "};\n\n");
+    fprintf(xfile_ptr, "#endif // __%s_H__\n", xmacro_buf);
+}
+
+/**********************************************************/
+/**
+ * @brief 输出统计报告（格式同 README.md 中的分类方案表）。
+ */
+static x_void_t xclassgen_report(const xclassgen_bucket_t * xbucket_ptr,
+                                 const x_uint32_t * xclass_vec,
+                                 x_uint32_t xut_used,
+                                 x_lfloat_t xlft_total,
+                                 x_lfloat_t xlft_large,
+                                 x_lfloat_t xlft_cost,
+                                 x_lfloat_t xlft_default)
+{
+    x_uint32_t xut_iter = 0;
+    x_uint32_t xut_from = 0;
+    x_lfloat_t xlft_reqs = 0.0;
+
+    fprintf(stderr, "|  NO. | slice size (B) | chunk size (KB) | capacity | unused (B) |     requests |\n");
+    fprintf(stderr, "| ---: | -------------: | --------------: | -------: | ---------: | -----------: |\n");
+
+    for (xut_iter = 0; xut_iter < xut_used; ++xut_iter)
+    {
+        for (xlft_reqs = 0.0; xut_from <= xclass_vec[xut_iter]; ++xut_from)
+            xlft_reqs += xbucket_ptr[xut_from].xreq_count;
+
+        fprintf(stderr, "| [%02u] | %14u | %15u | %8u | %10u | %12.0lf |\n",
+                xut_iter + 1,
+                xbucket_ptr[xclass_vec[xut_iter]].xslice_size,
+                xbucket_ptr[xclass_vec[xut_iter]].xchunk_size / 1024,
+                xbucket_ptr[xclass_vec[xut_iter]].xcapacity,
+                xbucket_ptr[xclass_vec[xut_iter]].xut_unused,
+                xlft_reqs);
+    }
+
+    fprintf(stderr, "\n");
+    fprintf(stderr, "requests          : %.0lf (larger than %u : %.0lf)\n",
+            xlft_total, XMPOOL_CLASS_MAX_SIZE, xlft_large);
+    fprintf(stderr, "waste per request : %10.3lf B (default table : %10.3lf B)\n",
+            xlft_cost / xlft_total, xlft_default / xlft_total);
+}
+
+/**********************************************************/
+/**
+ * @brief 打开输出文件（失败时输出错误信息）。
+ */
+static FILE * xclassgen_open(const x_char_t * xpath_ptr)
+{
+    FILE * xfile_ptr = fopen(xpath_ptr, "w");
+    if (X_NULL == xfile_ptr)
+        fprintf(stderr, "failed to open %s\n", xpath_ptr);
+    return xfile_ptr;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+int main(int argc, char * argv[])
+{
+    const x_char_t * xinput_ptr  = X_NULL;
+    const x_char_t * xheader_ptr = X_NULL;
+    const x_char_t * xtable_ptr  = X_NULL;
+    const x_char_t * xname_ptr   = "xmem_classes";
+
+    x_uint32_t xut_max   = XCLASSGEN_DEFAULT_COUNT;
+    x_bool_t   xbt_cache = X_FALSE;
+    x_int32_t  xit_iter  = 0;
+
+    FILE     * xfile_ptr = X_NULL;
+    x_lfloat_t xlft_total = 0.0;
+    x_lfloat_t xlft_large = 0.0;
+    x_lfloat_t xlft_cost  = 0.0;
+
+    xclassgen_bucket_t * xbucket_ptr = X_NULL;
+    x_uint32_t           xut_count   = 0;
+    x_uint32_t           xclass_vec[XMPOOL_CLASS_MAX_COUNT];
+    x_uint32_t           xut_used    = 0;
+
+    //======================================
+
+    for (xit_iter = 1; xit_iter < argc; ++xit_iter)
+    {
+        if ((0 == strcmp(argv[xit_iter], "-n")) && (xit_iter + 1 < argc))
+            xut_max = (x_uint32_t)atoi(argv[++xit_iter]);
+        else if (0 == strcmp(argv[xit_iter], "-c"))
+            xbt_cache = X_TRUE;
+        else if ((0 == strcmp(argv[xit_iter], "-o")) && (xit_iter + 1 < argc))
+            xheader_ptr = argv[++xit_iter];
+        else if ((0 == strcmp(argv[xit_iter], "-t")) && (xit_iter + 1 < argc))
+            xtable_ptr = argv[++xit_iter];
+        else if ((0 == strcmp(argv[xit_iter], "-p")) && (xit_iter + 1 < argc))
+            xname_ptr = argv[++xit_iter];
+        else if ('-' != argv[xit_iter][0])
+            xinput_ptr = argv[xit_iter];
+        else
+        {
+            fprintf(stderr,
+                    "Usage: %s [-n max_classes] [-c] [-o header.h] [-t table.txt] [-p name] [input]\n",
+                    argv[0]);
+            return -1;
+        }
+    }
+
+    if ((xut_max < 1) || (xut_max > XMPOOL_CLASS_MAX_COUNT))
+    {
+        fprintf(stderr, "max classes must be in [1, %u]\n", XMPOOL_CLASS_MAX_COUNT);
+        return -1;
+    }
+
+    //======================================
+
+    xfile_ptr = (X_NULL != xinput_ptr) ? fopen(xinput_ptr, "r") : stdin;
+    if (X_NULL == xfile_ptr)
+    {
+        fprintf(stderr, "failed to open %s\n", xinput_ptr);
+        return -1;
+    }
+
+    xlft_total = xclassgen_read(xfile_ptr, &xlft_large);
+    if (stdin != xfile_ptr)
+        fclose(xfile_ptr);
+
+    if (xlft_total <= 0.0)
+    {
+        fprintf(stderr, "no request size (not larger than %u) found\n", XMPOOL_CLASS_MAX_SIZE);
+        return -1;
+    }
+
+    //======================================
+
+    xbucket_ptr = (xclassgen_bucket_t *)calloc(
+        (XMPOOL_CLASS_MAX_SIZE / XCLASSGEN_GRAIN) + 1, sizeof(xclassgen_bucket_t));
+    if (X_NULL == xbucket_ptr)
+    {
+        return -1;
+    }
+
+    xut_count = xclassgen_buckets(xbucket_ptr, xbt_cache);
+    xut_used  = xclassgen_optimize(xbucket_ptr, xut_count, xut_max, xclass_vec, &xlft_cost);
+    if (0 == xut_used)
+    {
+        free(xbucket_ptr);
+        return -1;
+    }
+
+    xclassgen_report(xbucket_ptr, xclass_vec, xut_used,
+                     xlft_total, xlft_large, xlft_cost, xclassgen_default_cost(xbt_cache));
+
+    //======================================
+
+    if (X_NULL != xheader_ptr)
+    {
+        xfile_ptr = xclassgen_open(xheader_ptr);
+        if (X_NULL != xfile_ptr)
+        {
+            xclassgen_write_header(xfile_ptr, xname_ptr, xbucket_ptr, xclass_vec, xut_used, xbt_cache);
+            fclose(xfile_ptr);
+        }
+    }
+
+    if (X_NULL != xtable_ptr)
+    {
+        xfile_ptr = xclassgen_open(xtable_ptr);
+        if (X_NULL != xfile_ptr)
+        {
+            xclassgen_write_table(xfile_ptr, xbucket_ptr, xclass_vec, xut_used);
+            fclose(xfile_ptr);
+        }
+    }
+
+    if ((X_NULL == xheader_ptr) && (X_NULL == xtable_ptr))
+    {
+        xclassgen_write_table(stdout, xbucket_ptr, xclass_vec, xut_used);
+    }
+
+    free(xbucket_ptr);
+
+    return 0;
+}
+
+////////////////////////////////////////////////////////////////////////////////
@@ -36,6 +36,10 @@
 #include <sys/types.h>
 #include <sys/syscall.h>
 #include <sched.h>
+#include <time.h>
+#if defined(__GLIBC__)
+#include <execinfo.h>
+#endif // defined(__GLIBC__)
 #else
 #error "Unknown platform"
 #endif
@@ -69,9 +73,21 @@
 
 #define XMEM_PAGE_SIZE  (4 * 1024)
 
+/** 大页（透明大页 或 hugetlbfs 大页）的大小 */
+#define XMEM_HUGE_PAGE_SIZE  (2 * 1024 * 1024)
+
+/** 不指定 NUMA 节点（物理内存的归属由系统默认的首次访问策略决定） */
+#define XMEM_NUMA_ANY   (-1)
+
+/** 可绑定的 NUMA 节点编号上限（节点掩码只使用单个 unsigned long） */
+#define XMEM_NUMA_MAX   64
+
 /** 按 (align = 2^n) 的倍数对齐 size */
 #define X_ALIGN(size, align) (((size) + ((align) - 1)) & (~((align) - 1)))
 
+/** 默认的（空闲内存归还系统的）衰减半衰期（毫秒，参看 xmpool_set_decay()/xmheap_set_decay()） */
+#define XMEM_DECAY_MS   10000
+
 ////////////////////////////////////////////////////////////////////////////////
 
 /**
@@ -190,13 +206,17 @@ typedef x_byte_t *  xmem_slice_t;
 /**********************************************************/
 /**
  * @brief 获取当前线程 ID 值。
+ * @note  GNUC 下使用线程局部变量缓存 ID 值，避免每次调用都陷入系统调用。
  */
 static inline x_uint32_t xsys_tid(void)
 {
 #ifdef _MSC_VER
     return (x_uint32_t)GetCurrentThreadId();
 #elif defined(__GNUC__)
-    return (x_uint32_t)syscall(__NR_gettid);
+    static __thread x_uint32_t xut_tid = 0;
+    if (0 == xut_tid)
+        xut_tid = (x_uint32_t)syscall(__NR_gettid);
+    return xut_tid;
 #else
     XASSERT(X_FALSE);
     return 0;
@@ -233,6 +253,25 @@ static inline x_void_t xsys_msleep(x_uint32_t xut_mseconds)
 #endif
 }
 
+/**********************************************************/
+/**
+ * @brief 获取单调递增的系统时钟计数，时间单位为 毫秒。
+ */
+static inline x_uint64_t xsys_msecs(void)
+{
+#ifdef _MSC_VER
+    return (x_uint64_t)GetTickCount64();
+#elif defined(__GNUC__)
+    struct timespec xtm_spec;
+    clock_gettime(CLOCK_MONOTONIC, &xtm_spec);
+    return ((x_uint64_t)xtm_spec.tv_sec * 1000) +
+           ((x_uint64_t)xtm_spec.tv_nsec / 1000000);
+#else
+    XASSERT(X_FALSE);
+    return 0;
+#endif
+}
+
 /**********************************************************/
 /**
  * @brief 从系统中申请堆内存。
@@ -242,12 +281,13 @@ static inline xmem_handle_t xsys_heap_alloc(x_size_t xst_size)
 #ifdef _MSC_VER
     return (xmem_handle_t)HeapAlloc(GetProcessHeap(), 0, xst_size);
 #elif defined(__GNUC__)
-    return (xmem_handle_t)mmap(X_NULL,
-                               xst_size,
-                               PROT_READ | PROT_WRITE,
-                               MAP_PRIVATE | MAP_ANONYMOUS,
-                               -1,
-                               0);
+    xmem_handle_t xmem_ptr = (xmem_handle_t)mmap(X_NULL,
+                                                 xst_size,
+                                                 PROT_READ | PROT_WRITE,
+                                                 MAP_PRIVATE | MAP_ANONYMOUS,
+                                                 -1,
+                                                 0);
+    return (MAP_FAILED != xmem_ptr) ? xmem_ptr : X_NULL;
 #else
     XASSERT(X_FALSE);
     return X_NULL;
@@ -270,11 +310,465 @@ static inline x_void_t xsys_heap_free(
 #endif
 }
 
+/**********************************************************/
+/**
+ * @brief 原地（不移动起始地址）调整 xsys_heap_alloc()/xsys_heap_alloc_aligned()
+ *        所申请的堆内存的大小。
+ * @note
+ * Linux 下使用 mremap()（不带 MREMAP_MAYMOVE），只有紧随其后的地址空间
+ * 未被占用时，才能原地扩展；其他平台只支持 xsys_heap_alloc() 的内存
+ * （Windows 下为 HeapReAlloc(HEAP_REALLOC_IN_PLACE_ONLY)）或 收缩。
+ *
+ * @param [in ] xblock_ptr  : 堆内存地址。
+ * @param [in ] xst_size    : 堆内存当前的大小。
+ * @param [in ] xst_resize  : 调整后的大小。
+ * @param [in ] xbt_aligned : 堆内存是否由 xsys_heap_alloc_aligned() 申请。
+ *
+ * @return x_bool_t
+ *         - 成功，返回 X_TRUE；
+ *         - 失败，返回 X_FALSE，堆内存保持不变。
+ */
+static inline x_bool_t xsys_heap_resize(
+    xmem_handle_t xblock_ptr, x_size_t xst_size,
+    x_size_t xst_resize, x_bool_t xbt_aligned)
+{
+#ifdef _MSC_VER
+    if (xbt_aligned)
+        return X_FALSE;
+    return (X_NULL != HeapReAlloc(GetProcessHeap(),
+                                  HEAP_REALLOC_IN_PLACE_ONLY,
+                                  xblock_ptr,
+                                  xst_resize));
+#elif defined(__linux__)
+    // 直接发起系统调用，免去对 _GNU_SOURCE 的依赖
+    return (xblock_ptr == (xmem_handle_t)syscall(SYS_mremap,
+                                                 xblock_ptr,
+                                                 xst_size,
+                                                 xst_resize,
+                                                 0));
+#elif defined(__GNUC__)
+    if (xst_resize > xst_size)
+        return X_FALSE;
+    if (xst_resize < xst_size)
+        munmap((x_byte_t *)xblock_ptr + xst_resize, xst_size - xst_resize);
+    return X_TRUE;
+#else
+    XASSERT(X_FALSE);
+    return X_FALSE;
+#endif
+}
+
+/**********************************************************/
+/**
+ * @brief 从系统中申请（起始地址按 xst_align 对齐的）堆内存。
+ * @note
+ * xst_align 须为 2 的幂，且为页大小的整数倍；
+ * 实现方式为：多申请 xst_align 大小的地址空间，再裁剪掉首尾未对齐的部分。
+ * 返回的内存须使用 xsys_heap_free_aligned() 释放。
+ */
+static inline xmem_handle_t xsys_heap_alloc_aligned(
+    x_size_t xst_size, x_size_t xst_align)
+{
+#ifdef _MSC_VER
+    xmem_handle_t xmem_ptr = X_NULL;
+    x_int32_t     xit_iter = 0;
+
+    // 先保留足够大的地址空间以找到对齐地址，释放后再于该地址处申请，
+    // 期间地址可能被其他线程占用，故需重试
+    for (xit_iter = 0; (X_NULL == xmem_ptr) && (xit_iter < 8); ++xit_iter)
+    {
+        xmem_ptr = (xmem_handle_t)VirtualAlloc(
+            X_NULL, xst_size + xst_align, MEM_RESERVE, PAGE_NOACCESS);
+        if (X_NULL == xmem_ptr)
+            break;
+        VirtualFree(xmem_ptr, 0, MEM_RELEASE);
+
+        xmem_ptr = (xmem_handle_t)VirtualAlloc(
+            (x_void_t *)X_ALIGN((x_size_t)xmem_ptr, xst_align),
+            xst_size,
+            MEM_RESERVE | MEM_COMMIT,
+            PAGE_READWRITE);
+    }
+
+    return xmem_ptr;
+#elif defined(__GNUC__)
+    x_size_t      xst_head = 0;
+    xmem_handle_t xmem_ptr = (xmem_handle_t)mmap(X_NULL,
+                                                 xst_size + xst_align,
+                                                 PROT_READ | PROT_WRITE,
+                                                 MAP_PRIVATE | MAP_ANONYMOUS,
+                                                 -1,
+                                                 0);
+    if (MAP_FAILED == xmem_ptr)
+    {
+        return X_NULL;
+    }
+
+    xst_head = X_ALIGN((x_size_t)xmem_ptr, xst_align) - (x_size_t)xmem_ptr;
+    if (xst_head > 0)
+    {
+        munmap(xmem_ptr, xst_head);
+    }
+
+    if (xst_align > xst_head)
+    {
+        munmap((x_byte_t *)xmem_ptr + xst_head + xst_size, xst_align - xst_head);
+    }
+
+    return (xmem_handle_t)((x_byte_t *)xmem_ptr + xst_head);
+#else
+    XASSERT(X_FALSE);
+    return X_NULL;
+#endif
+}
+
+/**********************************************************/
+/**
+ * @brief 释放 xsys_heap_alloc_aligned() 申请的堆内存。
+ */
+static inline x_void_t xsys_heap_free_aligned(
+    xmem_handle_t xblock_ptr, x_size_t xst_size)
+{
+#ifdef _MSC_VER
+    VirtualFree(xblock_ptr, 0, MEM_RELEASE);
+#elif defined(__GNUC__)
+    munmap(xblock_ptr, xst_size);
+#else
+    XASSERT(X_FALSE);
+#endif
+}
+
+/**********************************************************/
+/**
+ * @brief 从系统中申请以大页为后备的堆内存（起始地址按 XMEM_HUGE_PAGE_SIZE 对齐）。
+ * @note
+ * xst_size 向上对齐到 XMEM_HUGE_PAGE_SIZE 的整数倍。
+ * xbt_hugetlb 为 X_TRUE 时，先尝试 mmap(MAP_HUGETLB)（使用 hugetlbfs 预留的大页），
+ * 系统未预留足够的大页时，退回到普通映射；普通映射会以 madvise(MADV_HUGEPAGE)
+ * 建议系统使用透明大页（是否生效取决于系统的 THP 配置）。
+ * 其他平台只保证对齐，不使用大页。返回的内存须使用 xsys_heap_free_aligned() 释放。
+ * 
+ * @param [in ] xst_size    : 堆内存大小。
+ * @param [in ] xbt_hugetlb : 是否优先使用 hugetlbfs 预留的大页。
+ * 
+ * @return xmem_handle_t
+ *         - 成功，返回 堆内存地址；
+ *         - 失败，返回 X_NULL。
+ */
+static inline xmem_handle_t xsys_heap_alloc_huge(
+    x_size_t xst_size, x_bool_t xbt_hugetlb)
+{
+    xmem_handle_t xmem_ptr = X_NULL;
+
+    xst_size = X_ALIGN(xst_size, XMEM_HUGE_PAGE_SIZE);
+
+#ifdef _MSC_VER
+    xmem_ptr = xsys_heap_alloc_aligned(xst_size, XMEM_HUGE_PAGE_SIZE);
+#elif defined(__GNUC__)
+#ifdef MAP_HUGETLB
+    if (xbt_hugetlb)
+    {
+        xmem_ptr = (xmem_handle_t)mmap(X_NULL,
+                                       xst_size,
+                                       PROT_READ | PROT_WRITE,
+                                       MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB,
+                                       -1,
+                                       0);
+        if (MAP_FAILED != xmem_ptr)
+            return xmem_ptr;
+    }
+#endif // MAP_HUGETLB
+
+    xmem_ptr = xsys_heap_alloc_aligned(xst_size, XMEM_HUGE_PAGE_SIZE);
+#ifdef MADV_HUGEPAGE
+    if (X_NULL != xmem_ptr)
+        madvise(xmem_ptr, xst_size, MADV_HUGEPAGE);
+#endif // MADV_HUGEPAGE
+#else
+    XASSERT(X_FALSE);
+#endif
+
+    return xmem_ptr;
+}
+
+/**********************************************************/
+/**
+ * @brief 将（仍保留地址映射的）堆内存中，完整分页的物理内存归还给系统。
+ * @note
+ * 只处理 [xmem_ptr, xmem_ptr + xst_size) 内按 XMEM_PAGE_SIZE 对齐的完整分页，
+ * 之后再次访问时，内容为 0 或保持原值（由系统决定），地址仍然有效。
+ * Linux 下优先使用 madvise(MADV_FREE)（延迟回收，开销更低），
+ * 不支持时使用 madvise(MADV_DONTNEED)；Windows 下使用 VirtualAlloc(MEM_RESET)。
+ * 
+ * @param [in ] xmem_ptr : 堆内存地址。
+ * @param [in ] xst_size : 堆内存大小。
+ * 
+ * @return x_bool_t
+ *         - 成功，返回 X_TRUE；
+ *         - 失败（或不足一个完整分页），返回 X_FALSE。
+ */
+static inline x_bool_t xsys_heap_purge(
+    xmem_handle_t xmem_ptr, x_size_t xst_size)
+{
+    x_size_t xst_lpos = X_ALIGN((x_size_t)xmem_ptr, XMEM_PAGE_SIZE);
+    x_size_t xst_rpos = ((x_size_t)xmem_ptr + xst_size) & ~((x_size_t)XMEM_PAGE_SIZE - 1);
+
+    if (xst_rpos <= xst_lpos)
+    {
+        return X_FALSE;
+    }
+
+#ifdef _MSC_VER
+    return (X_NULL != VirtualAlloc((x_void_t *)xst_lpos,
+                                   xst_rpos - xst_lpos,
+                                   MEM_RESET,
+                                   PAGE_READWRITE));
+#elif defined(__GNUC__)
+#ifdef MADV_FREE
+    if (0 == madvise((x_void_t *)xst_lpos, xst_rpos - xst_lpos, MADV_FREE))
+        return X_TRUE;
+#endif // MADV_FREE
+    return (0 == madvise((x_void_t *)xst_lpos, xst_rpos - xst_lpos, MADV_DONTNEED));
+#else
+    XASSERT(X_FALSE);
+    return X_FALSE;
+#endif
+}
+
+/**********************************************************/
+/**
+ * @brief 立即丢弃（仍保留地址映射的）堆内存中，完整分页的物理内存。
+ * @note
+ * 与 xsys_heap_purge() 不同，Linux 下直接使用 madvise(MADV_DONTNEED)，
+ * 物理内存（RSS）立即归还，之后再次访问时，内容为 0；
+ * Windows 下使用 VirtualAlloc(MEM_RESET)，由系统决定何时回收。
+ * 
+ * @param [in ] xmem_ptr : 堆内存地址。
+ * @param [in ] xst_size : 堆内存大小。
+ * 
+ * @return x_bool_t
+ *         - 成功，返回 X_TRUE；
+ *         - 失败（或不足一个完整分页），返回 X_FALSE。
+ */
+static inline x_bool_t xsys_heap_discard(
+    xmem_handle_t xmem_ptr, x_size_t xst_size)
+{
+    x_size_t xst_lpos = X_ALIGN((x_size_t)xmem_ptr, XMEM_PAGE_SIZE);
+    x_size_t xst_rpos = ((x_size_t)xmem_ptr + xst_size) & ~((x_size_t)XMEM_PAGE_SIZE - 1);
+
+    if (xst_rpos <= xst_lpos)
+    {
+        return X_FALSE;
+    }
+
+#ifdef _MSC_VER
+    return (X_NULL != VirtualAlloc((x_void_t *)xst_lpos,
+                                   xst_rpos - xst_lpos,
+                                   MEM_RESET,
+                                   PAGE_READWRITE));
+#elif defined(__GNUC__)
+    return (0 == madvise((x_void_t *)xst_lpos, xst_rpos - xst_lpos, MADV_DONTNEED));
+#else
+    XASSERT(X_FALSE);
+    return X_FALSE;
+#endif
+}
+
+/**********************************************************/
+/**
+ * @brief 获取系统的 NUMA 节点数量（最大节点编号 + 1）。
+ * @note
+ * Linux 下直接使用 get_mempolicy(MPOL_F_MEMS_ALLOWED) 系统调用（不依赖 libnuma），
+ * 系统不支持 NUMA 时，返回 1。
+ */
+static inline x_int32_t xsys_numa_count(void)
+{
+#ifdef _MSC_VER
+    ULONG xul_highest = 0;
+    if (!GetNumaHighestNodeNumber(&xul_highest))
+        return 1;
+    return (x_int32_t)xul_highest + 1;
+#elif defined(__GNUC__)
+#if defined(__linux__) && defined(SYS_get_mempolicy)
+    // 系统调用要求节点掩码的位数不小于内核支持的节点数量
+    unsigned long xmask_ptr[1024 / (8 * sizeof(unsigned long))] = { 0 };
+    x_int32_t     xit_iter  = 0;
+    x_int32_t     xit_count = 1;
+
+    if (0 != syscall(SYS_get_mempolicy,
+                     X_NULL,
+                     xmask_ptr,
+                     (unsigned long)1024,
+                     X_NULL,
+                     (unsigned long)(1 << 2) /* MPOL_F_MEMS_ALLOWED */))
+    {
+        return 1;
+    }
+
+    for (xit_iter = 0; xit_iter < 1024; ++xit_iter)
+    {
+        if (xmask_ptr[xit_iter / (8 * sizeof(unsigned long))] &
+            (1UL << (xit_iter % (8 * sizeof(unsigned long)))))
+        {
+            xit_count = xit_iter + 1;
+        }
+    }
+
+    return xit_count;
+#else // !(defined(__linux__) && defined(SYS_get_mempolicy))
+    return 1;
+#endif // defined(__linux__) && defined(SYS_get_mempolicy)
+#else
+    XASSERT(X_FALSE);
+    return 1;
+#endif
+}
+
+/**********************************************************/
+/**
+ * @brief 获取当前线程所运行的 CPU 所隶属的 NUMA 节点编号。
+ * @note  Linux 下使用 getcpu 系统调用；失败（或系统不支持 NUMA）时，返回 0。
+ */
+static inline x_int32_t xsys_numa_node(void)
+{
+#ifdef _MSC_VER
+    PROCESSOR_NUMBER xproc_num;
+    USHORT           xus_node = 0;
+    GetCurrentProcessorNumberEx(&xproc_num);
+    if (!GetNumaProcessorNodeEx(&xproc_num, &xus_node) || (0xFFFF == xus_node))
+        return 0;
+    return (x_int32_t)xus_node;
+#elif defined(__GNUC__)
+#if defined(__linux__) && defined(SYS_getcpu)
+    unsigned int xut_cpu  = 0;
+    unsigned int xut_node = 0;
+    if (0 != syscall(SYS_getcpu, &xut_cpu, &xut_node, X_NULL))
+        return 0;
+    return (x_int32_t)xut_node;
+#else // !(defined(__linux__) && defined(SYS_getcpu))
+    return 0;
+#endif // defined(__linux__) && defined(SYS_getcpu)
+#else
+    XASSERT(X_FALSE);
+    return 0;
+#endif
+}
+
+/**********************************************************/
+/**
+ * @brief 设置（尚未访问过的）堆内存优先从指定的 NUMA 节点上分配物理内存。
+ * @note
+ * Linux 下直接使用 mbind(MPOL_PREFERRED) 系统调用（不依赖 libnuma），
+ * 须在首次访问该内存之前调用，已分配的物理页不会被迁移；
+ * 指定节点的内存不足时，系统会从其他节点上分配，而不会失败。
+ * 其他平台不支持事后绑定，直接返回 X_FALSE。
+ * 
+ * @param [in ] xmem_ptr : 堆内存地址（须按 XMEM_PAGE_SIZE 对齐）。
+ * @param [in ] xst_size : 堆内存大小。
+ * @param [in ] xit_node : NUMA 节点编号（取值范围 [0, XMEM_NUMA_MAX)）。
+ * 
+ * @return x_bool_t
+ *         - 成功，返回 X_TRUE；
+ *         - 失败，返回 X_FALSE。
+ */
+static inline x_bool_t xsys_numa_bind(
+    xmem_handle_t xmem_ptr, x_size_t xst_size, x_int32_t xit_node)
+{
+    if ((xit_node < 0) || (xit_node >= XMEM_NUMA_MAX))
+    {
+        return X_FALSE;
+    }
+
+#ifdef _MSC_VER
+    return X_FALSE;
+#elif defined(__GNUC__)
+#if defined(__linux__) && defined(SYS_mbind)
+    unsigned long xul_mask = 1UL << xit_node;
+
+    // 内核按 (maxnode - 1) 位读取节点掩码
+    return (0 == syscall(SYS_mbind,
+                         xmem_ptr,
+                         (unsigned long)xst_size,
+                         1 /* MPOL_PREFERRED */,
+                         &xul_mask,
+                         (unsigned long)(8 * sizeof(xul_mask) + 1),
+                         0));
+#else // !(defined(__linux__) && defined(SYS_mbind))
+    return X_FALSE;
+#endif // defined(__linux__) && defined(SYS_mbind)
+#else
+    XASSERT(X_FALSE);
+    return X_FALSE;
+#endif
+}
+
+/**********************************************************/
+/**
+ * @brief 获取当前线程的调用栈（返回地址数组，首项为调用者自身）。
+ * @note
+ * Windows 下使用 CaptureStackBackTrace()，glibc 下使用 backtrace()
+ * （首次调用时可能会加载 libgcc_s 并申请内存，可预先调用一次以完成初始化）；
+ * 其他平台不支持，返回 0。
+ * 
+ * @param [out] xframe_vec : 存放返回地址的数组。
+ * @param [in ] xit_depth  : 数组的容量。
+ * 
+ * @return x_int32_t
+ *         - 返回获取到的返回地址数量。
+ */
+static inline x_int32_t xsys_backtrace(x_void_t ** xframe_vec, x_int32_t xit_depth)
+{
+#ifdef _MSC_VER
+    return (x_int32_t)CaptureStackBackTrace(0, (DWORD)xit_depth, xframe_vec, X_NULL);
+#elif defined(__GNUC__)
+#if defined(__GLIBC__)
+    return (x_int32_t)backtrace(xframe_vec, (int)xit_depth);
+#else // !defined(__GLIBC__)
+    return 0;
+#endif // defined(__GLIBC__)
+#else
+    XASSERT(X_FALSE);
+    return 0;
+#endif
+}
+
+/**********************************************************/
+/**
+ * @brief 计算按半衰期衰减后的内存大小。
+ * @note
+ * 整数个半衰期逐次减半，余下不足一个半衰期的部分按线性插值近似（1 - 0.5 * t），
+ * 避免依赖 libm 的 exp2()。
+ * 
+ * @param [in ] xsize_bytes : 衰减前的内存大小。
+ * @param [in ] xut_elapsed : 经过的时间（毫秒）。
+ * @param [in ] xut_decay   : 半衰期（毫秒，须大于 0）。
+ * 
+ * @return x_uint64_t
+ *         - 返回衰减后的内存大小。
+ */
+static inline x_uint64_t xmem_decay_size(
+    x_uint64_t xsize_bytes, x_uint64_t xut_elapsed, x_uint64_t xut_decay)
+{
+    XASSERT(xut_decay > 0);
+
+    if ((xut_elapsed / xut_decay) >= 64)
+    {
+        return 0;
+    }
+
+    xsize_bytes >>= (xut_elapsed / xut_decay);
+    xut_elapsed  %= xut_decay;
+
+    // 向下取整，保证持续衰减时最终可降至 0
+    return (x_uint64_t)((double)xsize_bytes *
+                        (1.0 - 0.5 * ((double)xut_elapsed / (double)xut_decay)));
+}
+
 /**********************************************************/
 /**
  * @brief 使用 C 标准库的接口申请内存。
  */
-static inline xmem_handle_t xmem_alloc(x_size_t xst_size)
+static inline xmem_handle_t xsys_malloc(x_size_t xst_size)
 {
     return malloc(xst_size);
 }
@@ -283,7 +777,7 @@ static inline xmem_handle_t xmem_alloc(x_size_t xst_size)
 /**
  * @brief 使用 C 标准库的接口释放内存。
  */
-static inline x_void_t xmem_free(xmem_handle_t xmem_ptr)
+static inline x_void_t xsys_free(xmem_handle_t xmem_ptr)
 {
     free(xmem_ptr);
 }
@@ -298,6 +792,23 @@ static inline xmem_handle_t xmem_clear(
     return memset(xmem_ptr, 0, xut_size);
 }
 
+/**********************************************************/
+/**
+ * @brief 原子操作：读取指针（acquire 语义）。
+ * @note  用于读取其他线程以原子操作更新的指针变量。
+ */
+static inline x_void_t * xatomic_load_ptr(x_void_t * volatile * xsrc_ptr)
+{
+#ifdef _MSC_VER
+    return InterlockedCompareExchangePointer(xsrc_ptr, X_NULL, X_NULL);
+#elif defined(__GNUC__)
+    return __atomic_load_n(xsrc_ptr, __ATOMIC_ACQUIRE);
+#else
+    XASSERT(X_FALSE);
+    return *xsrc_ptr;
+#endif
+}
+
 /**********************************************************/
 /**
  * @brief 原子操作：比较成功后赋值。
@@ -312,7 +823,7 @@ static inline x_void_t * xatomic_xchg_ptr(
     x_void_t * xold_ptr;
     do 
     {
-        xold_ptr = *xdst_ptr;
+        xold_ptr = xatomic_load_ptr(xdst_ptr);
     } while (!__sync_bool_compare_and_swap(xdst_ptr, xold_ptr, xchg_ptr));
     return xold_ptr;
 #else 
@@ -323,6 +834,28 @@ static inline x_void_t * xatomic_xchg_ptr(
 #endif
 }
 
+/**********************************************************/
+/**
+ * @brief 原子操作：指针比较成功后赋值。
+ * @note  返回目标变量的旧值。
+ */
+static inline x_void_t * xatomic_cmpxchg_ptr(
+                                x_void_t * volatile * xdst_ptr,
+                                x_void_t * xchg_ptr,
+                                x_void_t * xcmp_ptr)
+{
+#ifdef _MSC_VER
+    return InterlockedCompareExchangePointer(xdst_ptr, xchg_ptr, xcmp_ptr);
+#elif defined(__GNUC__)
+    return __sync_val_compare_and_swap(xdst_ptr, xcmp_ptr, xchg_ptr);
+#else
+    XASSERT(X_FALSE);
+    x_void_t * xold_ptr = *xdst_ptr;
+    if (*xdst_ptr == xcmp_ptr) *xdst_ptr = xchg_ptr;
+    return xold_ptr;
+#endif
+}
+
 /**********************************************************/
 /**
  * @brief 原子操作：比较成功后赋值。
@@ -406,8 +939,10 @@ static inline x_void_t xatomic_spin_unlock(xatomic_lock_t * xspinlock)
 
 ////////////////////////////////////////////////////////////////////////////////
 
+#include "xmem_prof.h"
 #include "xmem_heap.h"
 #include "xmem_pool.h"
+#include "xmem_malloc.h"
 
 ////////////////////////////////////////////////////////////////////////////////
 
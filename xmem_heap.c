@@ -80,9 +80,21 @@ typedef struct xmem_block_t
 
     x_uint32_t      xmpage_offset; ///< 分页起始地址的偏移量
     x_uint32_t      xmpage_cursor; ///< 分页 申请/释放 操作时的游标位置
+    x_uint32_t      xmpage_state;  ///< 按时间衰减归还系统时的状态（参看 @see xblock_state）
     x_byte_t        xmpage_bit[0]; ///< 分页是否被（分配出去）占用的位标识数组
 } xmem_block_t;
 
+/**
+ * @enum  xblock_state
+ * @brief 堆内存区块 按时间衰减归还系统时的状态值（参看 xmheap_tick()）。
+ */
+typedef enum xblock_state
+{
+    XBLOCK_STATE_BUSY   = 0, ///< 有分页被分配出去（或尚未被衰减操作检查到空闲）
+    XBLOCK_STATE_DIRTY  = 1, ///< 所有分页空闲，物理内存尚未归还系统
+    XBLOCK_STATE_PURGED = 2, ///< 所有分页空闲，物理内存已归还系统
+} xblock_state;
+
 /** 获取 xmem_block_t 的起始分页地址 */
 #define XBLOCK_PAGE_BEGIN(xblock_ptr) \
     ((xmem_slice_t)(xblock_ptr) + (xblock_ptr)->xmpage_offset)
@@ -121,6 +133,7 @@ typedef struct xblock_alias_t
 typedef struct xchunk_context_t
 {
     x_uint32_t      xchunk_size;   ///< 对应的 chunk 大小
+    x_uint32_t      xut_sampled;   ///< 标识 chunk 是否已被剖析器采样（参看 xmheap_set_profiler()）
     xchunk_memptr_t xchunk_ptr;    ///< 指向对应的 chunk 地址
     xowner_handle_t xowner_ptr;    ///< 持有该 chunk 的标识句柄
     xblock_handle_t xblock_ptr;    ///< chunk 缓存所在的 block
@@ -200,6 +213,8 @@ typedef struct xarray_alias_t
 typedef struct xmem_heap_t
 {
     xatomic_lock_t  xmheap_lock;   ///< 访问操作的原子旋转锁
+    x_uint32_t      xut_flags;     ///< 工作模式标识位（参看 @see xmheap_flags）
+    x_int32_t       xit_node;      ///< 堆内存区块绑定的 NUMA 节点（XMEM_NUMA_ANY 表示不绑定）
     x_uint32_t      xsize_block;   ///< 申请单个堆内存区块的建议大小
     x_uint64_t      xsize_ulimit;  ///< 可申请堆内存大小的总和上限
     x_uint64_t      xsize_cached;  ///< 总共申请的堆内存大小
@@ -228,6 +243,19 @@ typedef struct xmem_heap_t
 
     xarray_ctxptr_t xarray_cptr;   ///< 当前使用的 堆数组区块 对象
 
+    /**
+     * @brief 空闲 堆内存区块 按时间衰减归还系统的状态信息（参看 xmheap_tick()）。
+     */
+    x_uint32_t      xdecay_ms;     ///< 衰减的半衰期（毫秒，为 0 时不进行衰减归还）
+    x_uint64_t      xdecay_tick;   ///< 上次衰减操作的时间点（毫秒）
+    x_uint64_t      xdecay_dirty;  ///< 允许保留的（未归还物理内存的）空闲 堆内存区块 总大小
+    x_uint64_t      xdecay_muzzy;  ///< 允许保留的（已归还物理内存的）空闲 堆内存区块 总大小
+    x_uint64_t      xmuzzy_added;  ///< 上次衰减操作后，新归还物理内存的 堆内存区块 总大小
+
+    xmprof_handle_t xprof_ptr;     ///< 堆内存剖析器（参看 xmheap_set_profiler()），为 X_NULL 时不采样
+    x_int64_t       xprof_left;    ///< 距离下一次采样的字节数
+    x_uint64_t      xprof_seed;    ///< 采样间隔的随机数状态
+
     /**
      * @brief 记录所有分配出去的 chunk 上下文信息（xchunk_context_t）的红黑树。
      */
@@ -280,6 +308,14 @@ typedef struct xmem_heap_t
 /** 存储 xchunk_context_t 的红黑树 */
 #define XMHEAP_RBTREE(xmheap_ptr) ((x_rbtree_ptr)(xmheap_ptr)->xrbtree.xbt_ptr)
 
+/** 判断堆内存管理对象是否工作在 XMHEAP_FLAG_HUGE_PAGE 模式下 */
+#define XMHEAP_IS_HUGE_PAGE(xmheap_ptr) \
+    (0 != ((xmheap_ptr)->xut_flags & XMHEAP_FLAG_HUGE_PAGE))
+
+/** 堆内存区块大小的对齐值（XMHEAP_FLAG_HUGE_PAGE 模式下为大页大小） */
+#define XMHEAP_BLOCK_ALIGN(xmheap_ptr) \
+    (XMHEAP_IS_HUGE_PAGE(xmheap_ptr) ? XMEM_HUGE_PAGE_SIZE : XMHEAP_PAGE_SIZE)
+
 ////////////////////////////////////////////////////////////////////////////////
 // 函数前置声明
 
@@ -1130,13 +1166,30 @@ static xblock_handle_t xmheap_alloc_block(
 
     x_uint32_t xmpage_nums = xmem_block_page_nums(xblock_size);
 
-    xblock_handle_t xblock_ptr =
-        (xblock_handle_t)xsys_heap_alloc(xblock_size);
+    xblock_handle_t xblock_ptr = X_NULL;
+
+    if (XMHEAP_IS_HUGE_PAGE(xmheap_ptr))
+    {
+        XASSERT(xblock_size == X_ALIGN(xblock_size, XMEM_HUGE_PAGE_SIZE));
+        xblock_ptr = (xblock_handle_t)xsys_heap_alloc_huge(
+            xblock_size, (0 != (xmheap_ptr->xut_flags & XMHEAP_FLAG_HUGETLB)));
+    }
+    else
+    {
+        xblock_ptr = (xblock_handle_t)xsys_heap_alloc(xblock_size);
+    }
+
     if (X_NULL == xblock_ptr)
     {
         return X_NULL;
     }
 
+    // 须在写入区块头部信息（首次访问）之前绑定 NUMA 节点
+    if (XMEM_NUMA_ANY != xmheap_ptr->xit_node)
+    {
+        xsys_numa_bind(xblock_ptr, xblock_size, xmheap_ptr->xit_node);
+    }
+
     xmheap_ptr->xsize_valid  += (xmpage_nums * XMHEAP_PAGE_SIZE);
     xmheap_ptr->xsize_cached += xblock_size;
 
@@ -1149,6 +1202,7 @@ static xblock_handle_t xmheap_alloc_block(
     xblock_ptr->xmpage_rems   = xmpage_nums;
     xblock_ptr->xmpage_offset = xblock_size - (xmpage_nums * XMHEAP_PAGE_SIZE);
     xblock_ptr->xmpage_cursor = 0;
+    xblock_ptr->xmpage_state  = XBLOCK_STATE_BUSY;
 
     xmem_clear(xblock_ptr->xmpage_bit, ((xmpage_nums + 7) / 8));
 
@@ -1169,7 +1223,11 @@ static x_void_t xmheap_free_block(
     xmheap_ptr->xsize_cached -= xblock_ptr->xblock_size;
 
     xmheap_block_list_erase(xmheap_ptr, xblock_ptr);
-    xsys_heap_free(xblock_ptr, xblock_ptr->xblock_size);
+
+    if (XMHEAP_IS_HUGE_PAGE(xmheap_ptr))
+        xsys_heap_free_aligned(xblock_ptr, xblock_ptr->xblock_size);
+    else
+        xsys_heap_free(xblock_ptr, xblock_ptr->xblock_size);
 }
 
 /**********************************************************/
@@ -1196,6 +1254,63 @@ static x_void_t xmheap_free_unused_block(xmheap_handle_t xmheap_ptr)
     }
 }
 
+/**********************************************************/
+/**
+ * @brief 按衰减操作计算出的超出量，将 空闲 堆内存区块 归还给系统。
+ * @note  以 堆内存区块 为单位（剩余超出量不小于其一半时）进行处理。
+ * 
+ * @param [in ] xmheap_ptr   : 堆管理对象。
+ * @param [in ] xsize_excess : 超出允许保留大小的部分。
+ * @param [in ] xut_state    : 为 XBLOCK_STATE_PURGED 时，释放已归还物理内存的 堆内存区块；
+ *                             为 XBLOCK_STATE_DIRTY 时，归还 堆内存区块 分页部分的物理内存。
+ * 
+ * @return x_uint64_t
+ *         - 返回归还给系统的内存大小。
+ */
+static x_uint64_t xmheap_decay_block(
+                        xmheap_handle_t xmheap_ptr,
+                        x_uint64_t xsize_excess,
+                        x_uint32_t xut_state)
+{
+    xblock_handle_t xblock_tmp = X_NULL;
+    xblock_handle_t xblock_ptr = XMHEAP_BLOCK_LIST_FRONT(xmheap_ptr);
+    x_uint64_t      xsize_free = 0;
+
+    while ((xblock_ptr != XMHEAP_BLOCK_LIST_TAIL(xmheap_ptr)) && (xsize_excess > 0))
+    {
+        xblock_tmp = xblock_ptr->xlist_node.xblock_next;
+
+        if ((xut_state == xblock_ptr->xmpage_state) &&
+            (xsize_excess >= (xblock_ptr->xblock_size / 2)))
+        {
+            XASSERT(xblock_ptr->xmpage_nums == xblock_ptr->xmpage_rems);
+
+            xsize_excess -= (xsize_excess > xblock_ptr->xblock_size) ?
+                                xblock_ptr->xblock_size : xsize_excess;
+            xsize_free   += xblock_ptr->xblock_size;
+
+            if (XBLOCK_STATE_PURGED == xut_state)
+            {
+                xmheap_free_block(xmheap_ptr, xblock_ptr);
+            }
+            else
+            {
+                // 只归还分页部分，区块头部（含分页位标识数组）须保持有效
+                xsys_heap_purge(XBLOCK_PAGE_BEGIN(xblock_ptr),
+                                (x_size_t)(XBLOCK_PAGE_END(xblock_ptr) -
+                                           XBLOCK_PAGE_BEGIN(xblock_ptr)));
+
+                xblock_ptr->xmpage_state  = XBLOCK_STATE_PURGED;
+                xmheap_ptr->xmuzzy_added += xblock_ptr->xblock_size;
+            }
+        }
+
+        xblock_ptr = xblock_tmp;
+    }
+
+    return xsize_free;
+}
+
 /**********************************************************/
 /**
  * @brief 申请堆数组区块对象（用于缓存 xchunk_context_t 对象）。
@@ -1324,6 +1439,9 @@ static xchunk_memptr_t xmheap_alloc_chunk(
         xchunk_ptr = xblock_alloc_chunk(xblock_iptr, xchunk_size);
         if (X_NULL != xchunk_ptr)
         {
+            // 已归还物理内存的分页，再次访问时由系统重新提供
+            xblock_iptr->xmpage_state = XBLOCK_STATE_BUSY;
+
             *xblock_pptr = xblock_iptr;
             return xchunk_ptr;
         }
@@ -1352,7 +1470,7 @@ static xchunk_memptr_t xmheap_alloc_chunk(
         xblock_size = sizeof(xmem_block_t) +
                       (((xchunk_size / XMHEAP_PAGE_SIZE) + 7) >> 3) +
                       xchunk_size;
-        xblock_size = X_ALIGN(xblock_size, XMHEAP_PAGE_SIZE);
+        xblock_size = X_ALIGN(xblock_size, XMHEAP_BLOCK_ALIGN(xmheap_ptr));
     }
 
     // 若超过上限值，则直接取消申请操作
@@ -1625,9 +1743,35 @@ static xrbt_bool_t xrbtree_cctxt_compare(
  *         - 堆内存管理对象。
  */
 xmheap_handle_t xmheap_create(x_uint32_t xsize_block, x_uint64_t xsize_ulimit)
+{
+    return xmheap_create_ex(xsize_block, xsize_ulimit, XMHEAP_FLAG_NONE, XMEM_NUMA_ANY);
+}
+
+/**********************************************************/
+/**
+ * @brief 以指定的工作模式创建堆内存管理对象。
+ * @note
+ * XMHEAP_FLAG_HUGE_PAGE 模式下，所有 size 参数都按 XMEM_HUGE_PAGE_SIZE 对齐，
+ * XMHEAP_FLAG_HUGETLB 隐含 XMHEAP_FLAG_HUGE_PAGE 。
+ * xit_node 不为 XMEM_NUMA_ANY 时，每个新申请的堆内存区块，
+ * 在首次访问前都以 xsys_numa_bind() 绑定到该 NUMA 节点。
+ *
+ * @param [in ] xsize_block  : 申请单个堆内存区块的建议大小。
+ * @param [in ] xsize_ulimit : 可申请堆内存大小的总和上限。
+ * @param [in ] xut_flags    : 工作模式标识位（参看 @see xmheap_flags）。
+ * @param [in ] xit_node     : 绑定的 NUMA 节点编号（或 XMEM_NUMA_ANY）。
+ *
+ * @return xmheap_handle_t
+ *         - 堆内存管理对象。
+ */
+xmheap_handle_t xmheap_create_ex(x_uint32_t xsize_block,
+                                 x_uint64_t xsize_ulimit,
+                                 x_uint32_t xut_flags,
+                                 x_int32_t  xit_node)
 {
     XASSERT(xsize_block  >= (512 * XMHEAP_PAGE_SIZE));
     XASSERT(xsize_ulimit >= (x_uint64_t)(2 * xsize_block));
+    XASSERT((XMEM_NUMA_ANY == xit_node) || ((xit_node >= 0) && (xit_node < XMEM_NUMA_MAX)));
 
     //======================================
 
@@ -1644,8 +1788,11 @@ xmheap_handle_t xmheap_create(x_uint32_t xsize_block, x_uint64_t xsize_ulimit)
     //======================================
 
     xmheap_handle_t xmheap_ptr =
-            (xmheap_handle_t)xmem_alloc(sizeof(xmem_heap_t));
-    XASSERT(X_NULL != xmheap_ptr);
+            (xmheap_handle_t)xsys_heap_alloc(sizeof(xmem_heap_t));
+    if (X_NULL == xmheap_ptr)
+    {
+        return X_NULL;
+    }
 
     xmem_clear(xmheap_ptr, sizeof(xmem_heap_t));
 
@@ -1656,6 +1803,16 @@ xmheap_handle_t xmheap_create(x_uint32_t xsize_block, x_uint64_t xsize_ulimit)
 
     xmheap_ptr->xarray_cptr = X_NULL;
 
+    if (0 != (xut_flags & XMHEAP_FLAG_HUGETLB))
+    {
+        xut_flags |= XMHEAP_FLAG_HUGE_PAGE;
+    }
+
+    xmheap_ptr->xut_flags   = xut_flags;
+    xmheap_ptr->xit_node    = xit_node;
+    xmheap_ptr->xdecay_ms   = XMEM_DECAY_MS;
+    xmheap_ptr->xdecay_tick = xsys_msecs();
+
     xrbtree_emplace_create(XMHEAP_RBTREE(xmheap_ptr),
                            sizeof(xchunk_ctxptr_t),
                            &xcallback);
@@ -1667,8 +1824,8 @@ xmheap_handle_t xmheap_create(x_uint32_t xsize_block, x_uint64_t xsize_ulimit)
         xsize_block = (512 * XMHEAP_PAGE_SIZE);
     }
 
-    xmheap_ptr->xsize_block  = X_ALIGN(xsize_block , XMHEAP_PAGE_SIZE);
-    xmheap_ptr->xsize_ulimit = X_ALIGN(xsize_ulimit, XMHEAP_PAGE_SIZE);
+    xmheap_ptr->xsize_block  = X_ALIGN(xsize_block , XMHEAP_BLOCK_ALIGN(xmheap_ptr));
+    xmheap_ptr->xsize_ulimit = X_ALIGN(xsize_ulimit, XMHEAP_BLOCK_ALIGN(xmheap_ptr));
 
     if (xmheap_ptr->xsize_ulimit < (x_uint64_t)(2 * xmheap_ptr->xsize_block))
     {
@@ -1691,6 +1848,12 @@ x_void_t xmheap_destroy(xmheap_handle_t xmheap_ptr)
 
     //======================================
 
+    if (X_NULL != xmheap_ptr->xprof_ptr)
+    {
+        xmprof_erase_owner(xmheap_ptr->xprof_ptr, (x_handle_t)xmheap_ptr);
+        xmheap_ptr->xprof_ptr = X_NULL;
+    }
+
     xrbtree_emplace_destroy(XMHEAP_RBTREE(xmheap_ptr));
     xmheap_array_list_release(xmheap_ptr);
     xmheap_block_list_release(xmheap_ptr);
@@ -1698,7 +1861,7 @@ x_void_t xmheap_destroy(xmheap_handle_t xmheap_ptr)
     //======================================
 
     xatomic_spin_unlock(&xmheap_ptr->xmheap_lock);
-    xmem_free(xmheap_ptr);
+    xsys_heap_free(xmheap_ptr, sizeof(xmem_heap_t));
 }
 
 /**********************************************************/
@@ -1731,6 +1894,16 @@ x_uint64_t xmheap_using_size(xmheap_handle_t xmheap_ptr)
     return xmheap_ptr->xsize_using;
 }
 
+/**********************************************************/
+/**
+ * @brief 堆内存管理对象所绑定的 NUMA 节点编号（未绑定时为 XMEM_NUMA_ANY）。
+ */
+x_int32_t xmheap_numa_node(xmheap_handle_t xmheap_ptr)
+{
+    XASSERT(X_NULL != xmheap_ptr);
+    return xmheap_ptr->xit_node;
+}
+
 /**********************************************************/
 /**
  * @brief 申请内存块。
@@ -1782,6 +1955,16 @@ xchunk_memptr_t xmheap_alloc(xmheap_handle_t xmheap_ptr,
             xblock_recyc_chunk(xblock_ptr, xchunk_ptr, xchunk_size);
             xchunk_ptr = X_NULL;
         }
+        else if ((X_NULL != xmheap_ptr->xprof_ptr) &&
+                 ((xmheap_ptr->xprof_left -= xchunk_size) < 0))
+        {
+            // 堆内存管理对象的申请频率较低，直接在锁内记录（略去 xmheap_alloc() 的栈帧）
+            xmheap_ptr->xprof_left =
+                xmprof_next_sample(xmheap_ptr->xprof_ptr, &xmheap_ptr->xprof_seed);
+            xcctxt_ptr->xut_sampled =
+                xmprof_record(xmheap_ptr->xprof_ptr, (x_handle_t)xmheap_ptr,
+                              xchunk_ptr, xchunk_size, 1);
+        }
     }
 
     //======================================
@@ -1834,6 +2017,11 @@ x_int32_t xmheap_recyc(xmheap_handle_t xmheap_ptr,
 
         xmheap_ptr->xsize_using -= xcctxt_ptr->xchunk_size;
 
+        if ((0 != xcctxt_ptr->xut_sampled) && (X_NULL != xmheap_ptr->xprof_ptr))
+        {
+            xmprof_erase(xmheap_ptr->xprof_ptr, xchunk_ptr);
+        }
+
         // 从红黑树中删除对应的节点
         xiter_node = (x_rbnode_iter)xcctxt_ptr->xtree_node.xbt_ptr;
         XASSERT(xrbtree_iter_cctxt(xiter_node) == xcctxt_ptr);
@@ -1877,6 +2065,161 @@ x_void_t xmheap_release_unused(xmheap_handle_t xmheap_ptr)
     xatomic_spin_unlock(&xmheap_ptr->xmheap_lock);
 }
 
+/**********************************************************/
+/**
+ * @brief 设置 堆内存管理对象 空闲 堆内存区块 按时间衰减归还系统的半衰期。
+ */
+x_void_t xmheap_set_decay(xmheap_handle_t xmheap_ptr, x_uint32_t xut_decay_ms)
+{
+    XASSERT(X_NULL != xmheap_ptr);
+
+    xatomic_spin_lock(&xmheap_ptr->xmheap_lock);
+    xmheap_ptr->xdecay_ms   = xut_decay_ms;
+    xmheap_ptr->xdecay_tick = xsys_msecs();
+    xatomic_spin_unlock(&xmheap_ptr->xmheap_lock);
+}
+
+/**********************************************************/
+/**
+ * @brief 在 fork() 之前，锁定 堆内存管理对象 的访问锁。
+ */
+x_void_t xmheap_fork_lock(xmheap_handle_t xmheap_ptr)
+{
+    XASSERT(X_NULL != xmheap_ptr);
+    xatomic_spin_lock(&xmheap_ptr->xmheap_lock);
+}
+
+/**********************************************************/
+/**
+ * @brief 在 fork() 之后，解除 xmheap_fork_lock() 的锁定。
+ */
+x_void_t xmheap_fork_unlock(xmheap_handle_t xmheap_ptr)
+{
+    XASSERT(X_NULL != xmheap_ptr);
+    xatomic_spin_unlock(&xmheap_ptr->xmheap_lock);
+}
+
+/**********************************************************/
+/**
+ * @brief 设置 堆内存管理对象 所使用的堆内存剖析器（为 X_NULL 时停止采样）。
+ */
+x_void_t xmheap_set_profiler(xmheap_handle_t xmheap_ptr, xmprof_handle_t xmprof_ptr)
+{
+    XASSERT(X_NULL != xmheap_ptr);
+
+    xatomic_spin_lock(&xmheap_ptr->xmheap_lock);
+
+    if (xmprof_ptr != xmheap_ptr->xprof_ptr)
+    {
+        if (X_NULL != xmheap_ptr->xprof_ptr)
+        {
+            xmprof_erase_owner(xmheap_ptr->xprof_ptr, (x_handle_t)xmheap_ptr);
+        }
+
+        xmheap_ptr->xprof_ptr  = xmprof_ptr;
+        xmheap_ptr->xprof_left = (X_NULL != xmprof_ptr) ?
+            xmprof_next_sample(xmprof_ptr, &xmheap_ptr->xprof_seed) : 0;
+    }
+
+    xatomic_spin_unlock(&xmheap_ptr->xmheap_lock);
+}
+
+/**********************************************************/
+/**
+ * @brief 按时间衰减策略，将 空闲的 堆内存区块 逐步归还给系统。
+ */
+x_uint64_t xmheap_tick(xmheap_handle_t xmheap_ptr, x_uint64_t xut_now)
+{
+    XASSERT(X_NULL != xmheap_ptr);
+
+    xblock_handle_t xblock_ptr  = X_NULL;
+    x_uint64_t      xut_elapsed = 0;
+    x_uint64_t      xsize_dirty = 0;
+    x_uint64_t      xsize_purge = 0;
+    x_uint64_t      xsize_added = 0;
+    x_uint64_t      xsize_free  = 0;
+
+    xatomic_spin_lock(&xmheap_ptr->xmheap_lock);
+
+    //======================================
+
+    do
+    {
+        if (0 == xmheap_ptr->xdecay_ms)
+        {
+            break;
+        }
+
+        if (xut_now > xmheap_ptr->xdecay_tick)
+        {
+            xut_elapsed = xut_now - xmheap_ptr->xdecay_tick;
+            xmheap_ptr->xdecay_tick = xut_now;
+        }
+
+        // 统计所有空闲的 堆内存区块，新检查到空闲的，转入 XBLOCK_STATE_DIRTY 状态
+        for (xblock_ptr  = XMHEAP_BLOCK_LIST_FRONT(xmheap_ptr);
+             xblock_ptr != XMHEAP_BLOCK_LIST_TAIL(xmheap_ptr);
+             xblock_ptr  = xblock_ptr->xlist_node.xblock_next)
+        {
+            if (xblock_ptr->xmpage_nums != xblock_ptr->xmpage_rems)
+            {
+                xblock_ptr->xmpage_state = XBLOCK_STATE_BUSY;
+                continue;
+            }
+
+            if (XBLOCK_STATE_BUSY == xblock_ptr->xmpage_state)
+            {
+                xblock_ptr->xmpage_state = XBLOCK_STATE_DIRTY;
+                xsize_added += xblock_ptr->xblock_size;
+            }
+
+            if (XBLOCK_STATE_DIRTY == xblock_ptr->xmpage_state)
+                xsize_dirty += xblock_ptr->xblock_size;
+            else
+                xsize_purge += xblock_ptr->xblock_size;
+        }
+
+        //======================================
+        // 已归还物理内存的，超出允许保留大小的部分，释放其地址空间
+
+        xmheap_ptr->xdecay_muzzy =
+            xmem_decay_size(xmheap_ptr->xdecay_muzzy, xut_elapsed, xmheap_ptr->xdecay_ms) +
+            xmheap_ptr->xmuzzy_added;
+        xmheap_ptr->xmuzzy_added = 0;
+
+        if (xmheap_ptr->xdecay_muzzy > xsize_purge)
+        {
+            xmheap_ptr->xdecay_muzzy = xsize_purge;
+        }
+
+        xsize_free += xmheap_decay_block(xmheap_ptr,
+                                         xsize_purge - xmheap_ptr->xdecay_muzzy,
+                                         XBLOCK_STATE_PURGED);
+
+        //======================================
+        // 未归还物理内存的，超出允许保留大小的部分，归还其物理内存
+
+        xmheap_ptr->xdecay_dirty =
+            xmem_decay_size(xmheap_ptr->xdecay_dirty, xut_elapsed, xmheap_ptr->xdecay_ms) +
+            xsize_added;
+
+        if (xmheap_ptr->xdecay_dirty > xsize_dirty)
+        {
+            xmheap_ptr->xdecay_dirty = xsize_dirty;
+        }
+
+        xsize_free += xmheap_decay_block(xmheap_ptr,
+                                         xsize_dirty - xmheap_ptr->xdecay_dirty,
+                                         XBLOCK_STATE_DIRTY);
+    } while (0);
+
+    //======================================
+
+    xatomic_spin_unlock(&xmheap_ptr->xmheap_lock);
+
+    return xsize_free;
+}
+
 /**********************************************************/
 /**
  * @brief 使用内存分片 HIT 测试操作，查询其所在的 chunk 快照信息。
@@ -48,6 +48,17 @@ struct xmem_heap_t;
 /** 堆内存管理的操作句柄类型定义 */
 typedef struct xmem_heap_t * xmheap_handle_t;
 
+/**
+ * @enum  xmheap_flags
+ * @brief 创建堆内存管理对象时可选的标识位（参看 @see xmheap_create_ex()）。
+ */
+typedef enum xmheap_flags
+{
+    XMHEAP_FLAG_NONE      = 0x00000000, ///< 默认模式（普通分页）
+    XMHEAP_FLAG_HUGE_PAGE = 0x00000001, ///< 堆内存区块按大页对齐，并建议系统使用透明大页
+    XMHEAP_FLAG_HUGETLB   = 0x00000002, ///< 优先使用 hugetlbfs 预留的大页（包含 XMHEAP_FLAG_HUGE_PAGE）
+} xmheap_flags;
+
 /**
  * @struct xchunk_snapshoot_t
  * @brief 从堆内存管理中分配出去的内存块快照信息。
@@ -75,6 +86,36 @@ typedef struct xchunk_snapshoot_t
  */
 xmheap_handle_t xmheap_create(x_uint32_t xsize_block, x_uint64_t xsize_ulimit);
 
+/**********************************************************/
+/**
+ * @brief 以指定的工作模式创建堆内存管理对象。
+ * @note
+ * 指定 XMHEAP_FLAG_HUGE_PAGE 时，xsize_block、xsize_ulimit 以及单独申请的
+ * （超大内存块所需的）堆内存区块，均向上对齐到 XMEM_HUGE_PAGE_SIZE 的整数倍，
+ * 并使用 xsys_heap_alloc_huge() 申请，以减少大量访问时的 TLB 缺失；
+ * 另外指定 XMHEAP_FLAG_HUGETLB 时，优先使用 hugetlbfs 预留的大页，
+ * 预留的大页不足时，退回到透明大页。
+ * hugetlbfs 大页无法按普通分页归还物理内存，衰减操作（参看 xmheap_tick()）
+ * 只能在释放整个 堆内存区块 时归还。
+ * 
+ * xit_node 指定 NUMA 节点时，新申请的堆内存区块在首次访问（写入区块头部）之前，
+ * 以 mbind(MPOL_PREFERRED) 绑定到该节点（参看 xsys_numa_bind()），
+ * 物理内存不再取决于哪个线程首次访问了区块；该节点内存不足时，由系统从其他节点分配。
+ * 
+ * @param [in ] xsize_block  : 申请单个堆内存区块的建议大小。
+ * @param [in ] xsize_ulimit : 可申请堆内存大小的总和上限。
+ * @param [in ] xut_flags    : 工作模式标识位（参看 @see xmheap_flags）。
+ * @param [in ] xit_node     : 绑定的 NUMA 节点编号（取值范围 [0, XMEM_NUMA_MAX)），
+ *                             XMEM_NUMA_ANY 表示不绑定。
+ * 
+ * @return xmheap_handle_t
+ *         - 堆内存管理对象。
+ */
+xmheap_handle_t xmheap_create_ex(x_uint32_t xsize_block,
+                                 x_uint64_t xsize_ulimit,
+                                 x_uint32_t xut_flags,
+                                 x_int32_t  xit_node);
+
 /**********************************************************/
 /**
  * @brief 销毁堆内存管理对象。
@@ -99,6 +140,12 @@ x_uint64_t xmheap_valid_size(xmheap_handle_t xmheap_ptr);
  */
 x_uint64_t xmheap_using_size(xmheap_handle_t xmheap_ptr);
 
+/**********************************************************/
+/**
+ * @brief 堆内存管理对象所绑定的 NUMA 节点编号（未绑定时为 XMEM_NUMA_ANY）。
+ */
+x_int32_t xmheap_numa_node(xmheap_handle_t xmheap_ptr);
+
 /**********************************************************/
 /**
  * @brief 申请内存块。
@@ -135,6 +182,60 @@ x_int32_t xmheap_recyc(xmheap_handle_t xmheap_ptr,
  */
 x_void_t xmheap_release_unused(xmheap_handle_t xmheap_ptr);
 
+/**********************************************************/
+/**
+ * @brief 设置 堆内存管理对象 空闲 堆内存区块 按时间衰减归还系统的半衰期。
+ * @note  创建时默认为 XMEM_DECAY_MS；设置为 0 时，xmheap_tick() 不做任何操作。
+ * 
+ * @param [in ] xmheap_ptr   : 堆内存管理对象。
+ * @param [in ] xut_decay_ms : 半衰期（毫秒）。
+ */
+x_void_t xmheap_set_decay(xmheap_handle_t xmheap_ptr, x_uint32_t xut_decay_ms);
+
+/**********************************************************/
+/**
+ * @brief 在 fork() 之前，锁定 堆内存管理对象 的访问锁。
+ * @note
+ * 使子进程得到的 堆内存管理对象 处于一致的状态（参看 pthread_atfork()），
+ * 之后须在父进程与子进程中分别调用 xmheap_fork_unlock()。
+ */
+x_void_t xmheap_fork_lock(xmheap_handle_t xmheap_ptr);
+
+/**********************************************************/
+/**
+ * @brief 在 fork() 之后，解除 xmheap_fork_lock() 的锁定。
+ */
+x_void_t xmheap_fork_unlock(xmheap_handle_t xmheap_ptr);
+
+/**********************************************************/
+/**
+ * @brief 设置 堆内存管理对象 所使用的堆内存剖析器（参看 xmem_prof.h），为 X_NULL 时停止采样。
+ * @note
+ * 设置后，xmheap_alloc() 平均每申请 xmprof_interval() 字节采样一次（以内存块为单位），
+ * xmheap_recyc() 回收被采样的内存块时删除其记录；
+ * 与同一剖析器共用时，注意 内存池对象 的 chunk 也由此申请，会与其分片重复计入。
+ * 
+ * @param [in ] xmheap_ptr : 堆内存管理对象。
+ * @param [in ] xmprof_ptr : 堆内存剖析器。
+ */
+x_void_t xmheap_set_profiler(xmheap_handle_t xmheap_ptr, xmprof_handle_t xmprof_ptr);
+
+/**********************************************************/
+/**
+ * @brief 按时间衰减策略，将 空闲的 堆内存区块 逐步归还给系统。
+ * @note
+ * 与 xmpool_tick() 相同，分两个阶段归还：先归还分页部分的物理内存，再释放整个区块；
+ * 每个阶段允许保留的大小按半衰期随时间衰减。只处理所有分页均空闲的 堆内存区块。
+ * 可在任意线程中调用。
+ * 
+ * @param [in ] xmheap_ptr : 堆内存管理对象。
+ * @param [in ] xut_now    : 当前的时间点（毫秒，通常为 xsys_msecs() 的返回值）。
+ * 
+ * @return x_uint64_t
+ *         - 返回本次归还给系统的（物理内存或地址空间的）内存大小。
+ */
+x_uint64_t xmheap_tick(xmheap_handle_t xmheap_ptr, x_uint64_t xut_now);
+
 /**********************************************************/
 /**
  * @brief 使用内存分片 HIT 测试操作，查询其所在的 chunk 快照信息。
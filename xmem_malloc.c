@@ -0,0 +1,1130 @@
+﻿/**
+ * @file    xmem_malloc.c
+ * <pre>
+ * Copyright (c) 2019, Gaaagaa All rights reserved.
+ * 
+ * 文件名称：xmem_malloc.c
+ * 创建日期：2026年10月18日
+ * 文件标识：
+ * 文件摘要：以线程局部的内存池对象为前端的通用内存分配接口。
+ * 
+ * 当前版本：1.0.0.0
+ * 作    者：
+ * 完成日期：2026年10月18日
+ * 版本摘要：
+ * 
+ * 历史版本：
+ * 原作者  ：
+ * 完成日期：
+ * 版本摘要：
+ * </pre>
+ */
+
+#include "xmem_comm.h"
+
+#ifdef __GNUC__
+#include <pthread.h>
+#endif // __GNUC__
+
+////////////////////////////////////////////////////////////////////////////////
+
+#ifdef __GNUC__
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wunused-function"
+#endif // __GNUC__
+
+////////////////////////////////////////////////////////////////////////////////
+
+/** 每个 NUMA 节点上共用的 堆内存管理对象 申请单个堆内存区块的建议大小 */
+#define XMALLOC_HEAP_BLOCK    (32 * 1024 * 1024)
+
+/** 每个 NUMA 节点上共用的 堆内存管理对象 可申请堆内存大小的总和上限 */
+#define XMALLOC_HEAP_ULIMIT   ((x_uint64_t)64 * 1024 * 1024 * 1024)
+
+/** 单次可申请的内存大小上限（xmpool_alloc() 的参数为 32 位） */
+#define XMALLOC_MAX_SIZE      ((x_size_t)0x7FFFFFFF)
+
+/**
+ * 每个线程的内存池对象大块缓存的总大小上限（参看 xmpool_set_large_cache()），
+ * 远小于 XMPOOL_LARGE_CACHE_BYTES，以免线程数较多时大块缓存的总量过大
+ */
+#define XMALLOC_LARGE_CACHE   (4 * 1024 * 1024)
+
+/**
+ * @struct xmpool_orphan_t
+ * @brief  线程退出时，仍有分片在使用中的（被挂起的）内存池对象的链表节点。
+ * @note   节点本身是从被挂起的内存池对象中申请的分片。
+ */
+typedef struct xmpool_orphan_t
+{
+    xmpool_handle_t          xmpool_ptr;  ///< 被挂起的内存池对象
+    xmheap_handle_t          xmheap_ptr;  ///< 内存池对象所使用的堆内存管理对象
+    struct xmpool_orphan_t * xnext_ptr;   ///< 后继节点
+} xmpool_orphan_t;
+
+/**
+ * @struct xmpool_entry_t
+ * @brief  所有（含被挂起的）内存池对象的登记链表节点，供 fork() 前后锁定/解锁各个内存池对象。
+ * @note   节点从 xsys_heap_alloc() 申请的分页中切分，不再归还，释放的节点留待复用。
+ */
+typedef struct xmpool_entry_t
+{
+    xmpool_handle_t         xmpool_ptr;  ///< 登记的内存池对象
+    struct xmpool_entry_t * xnext_ptr;   ///< 后继节点
+} xmpool_entry_t;
+
+static xatomic_lock_t    X_malloc_lock = 0;      ///< 全局数据的同步旋转锁
+static xmpool_orphan_t * X_orphan_list = X_NULL; ///< 被挂起的内存池对象链表
+static xmpool_entry_t  * X_mpool_list  = X_NULL; ///< 内存池对象的登记链表
+static xmpool_entry_t  * X_entry_free  = X_NULL; ///< 空闲的登记链表节点
+static volatile x_uint32_t X_fork_hook = 0;      ///< 是否已注册 fork() 前后的处理函数
+static x_uint32_t        X_mheap_flags = XMHEAP_FLAG_NONE; ///< 创建共用的 堆内存管理对象 时的工作模式
+static volatile x_int32_t X_numa_count = 0;      ///< NUMA 节点数量（为 0 时，表示尚未初始化）
+
+/** 各个 NUMA 节点上（所在节点线程的内存池对象）共用的堆内存管理对象（单节点系统只使用 [0]） */
+static xmheap_handle_t volatile X_mheap_node[XMEM_NUMA_MAX] = { X_NULL };
+
+static x_uint32_t          X_decay_ms    = XMEM_DECAY_MS; ///< 按时间衰减归还系统的半衰期
+static volatile x_uint64_t X_decay_epoch = 0;             ///< 最近一次 xmem_tick() 的时间点
+static volatile x_uint32_t X_decay_run   = 0;             ///< 后台衰减线程是否在运行
+static x_uint32_t          X_decay_wait  = 0;             ///< 后台衰减线程的调用间隔（毫秒）
+
+/** 堆内存剖析器（参看 xmem_prof_start()），创建后不再销毁，为 X_NULL 时不采样 */
+static xmprof_handle_t volatile X_mprof = X_NULL;
+
+#ifdef _MSC_VER
+static DWORD X_tls_index = FLS_OUT_OF_INDEXES;
+static __declspec(thread) xmpool_handle_t X_tls_mpool = X_NULL;
+static __declspec(thread) x_uint64_t X_tls_epoch = 0;
+static __declspec(thread) xmheap_handle_t X_tls_mheap = X_NULL;
+static __declspec(thread) xmprof_handle_t X_tls_mprof = X_NULL;
+static HANDLE X_decay_thread = X_NULL;
+#elif defined(__GNUC__)
+static pthread_key_t X_tls_index;
+static __thread xmpool_handle_t X_tls_mpool = X_NULL;
+static __thread x_uint64_t X_tls_epoch = 0;
+static __thread xmheap_handle_t X_tls_mheap = X_NULL;
+static __thread xmprof_handle_t X_tls_mprof = X_NULL;
+static pthread_t X_decay_thread;
+#endif // _MSC_VER
+
+////////////////////////////////////////////////////////////////////////////////
+
+//====================================================================
+
+// 
+// internal calls
+// 
+
+/**********************************************************/
+/**
+ * @brief 内存池对象 申请 chunk 内存块的回调接口（从共用的堆内存管理对象中申请）。
+ */
+static x_void_t * xmalloc_chunk_alloc(x_size_t xst_size,
+                                      x_handle_t xht_owner,
+                                      x_handle_t xht_context)
+{
+    return xmheap_alloc((xmheap_handle_t)xht_context,
+                        (x_uint32_t)xst_size,
+                        (xowner_handle_t)xht_owner);
+}
+
+/**********************************************************/
+/**
+ * @brief 内存池对象 释放 chunk 内存块的回调接口。
+ */
+static x_void_t xmalloc_chunk_free(x_void_t * xchunk_ptr,
+                                   x_size_t xst_size,
+                                   x_handle_t xht_owner,
+                                   x_handle_t xht_context)
+{
+    if (XMEM_ERR_OK != xmheap_recyc((xmheap_handle_t)xht_context, xchunk_ptr))
+    {
+        XASSERT(X_FALSE);
+    }
+}
+
+/**********************************************************/
+/**
+ * @brief 登记内存池对象（须在 X_malloc_lock 的保护下调用）。
+ * 
+ * @return x_bool_t
+ *         - 成功，返回 X_TRUE；
+ *         - 无法申请登记节点时，返回 X_FALSE。
+ */
+static x_bool_t xmalloc_pool_register(xmpool_handle_t xmpool_ptr)
+{
+    xmpool_entry_t * xentry_ptr = X_NULL;
+    x_uint32_t       xut_iter   = 0;
+
+    if (X_NULL == X_entry_free)
+    {
+        xentry_ptr = (xmpool_entry_t *)xsys_heap_alloc(XMEM_PAGE_SIZE);
+        if (X_NULL == xentry_ptr)
+        {
+            return X_FALSE;
+        }
+
+        for (xut_iter = 0; xut_iter < XMEM_PAGE_SIZE / sizeof(xmpool_entry_t); ++xut_iter)
+        {
+            xentry_ptr[xut_iter].xnext_ptr = X_entry_free;
+            X_entry_free = &xentry_ptr[xut_iter];
+        }
+    }
+
+    xentry_ptr   = X_entry_free;
+    X_entry_free = xentry_ptr->xnext_ptr;
+
+    xentry_ptr->xmpool_ptr = xmpool_ptr;
+    xentry_ptr->xnext_ptr  = X_mpool_list;
+    X_mpool_list = xentry_ptr;
+
+    return X_TRUE;
+}
+
+/**********************************************************/
+/**
+ * @brief 注销内存池对象的登记（须在 X_malloc_lock 的保护下调用）。
+ */
+static x_void_t xmalloc_pool_unregister(xmpool_handle_t xmpool_ptr)
+{
+    xmpool_entry_t ** xlink_ptr  = &X_mpool_list;
+    xmpool_entry_t  * xentry_ptr = X_NULL;
+
+    while (X_NULL != (xentry_ptr = *xlink_ptr))
+    {
+        if (xentry_ptr->xmpool_ptr == xmpool_ptr)
+        {
+            *xlink_ptr = xentry_ptr->xnext_ptr;
+            xentry_ptr->xmpool_ptr = X_NULL;
+            xentry_ptr->xnext_ptr  = X_entry_free;
+            X_entry_free = xentry_ptr;
+            return;
+        }
+
+        xlink_ptr = &xentry_ptr->xnext_ptr;
+    }
+
+    XASSERT(X_FALSE);
+}
+
+#ifdef __GNUC__
+
+/**********************************************************/
+/**
+ * @brief fork() 之前，依次锁定全局数据、各个内存池对象、各个堆内存管理对象、堆内存剖析器。
+ * @note
+ * 加锁次序与正常执行时的嵌套次序一致（内存池对象释放 chunk 时，在其旋转锁内
+ * 访问堆内存管理对象；堆内存管理对象在其访问锁内访问剖析器），以免死锁。
+ */
+static x_void_t xmalloc_fork_prepare(void)
+{
+    xmpool_entry_t * xentry_ptr = X_NULL;
+    x_int32_t        xit_node   = 0;
+
+    xatomic_spin_lock(&X_malloc_lock);
+
+    for (xentry_ptr = X_mpool_list; X_NULL != xentry_ptr; xentry_ptr = xentry_ptr->xnext_ptr)
+    {
+        xmpool_fork_lock(xentry_ptr->xmpool_ptr);
+    }
+
+    for (xit_node = 0; xit_node < XMEM_NUMA_MAX; ++xit_node)
+    {
+        if (X_NULL != X_mheap_node[xit_node])
+            xmheap_fork_lock(X_mheap_node[xit_node]);
+    }
+
+    if (X_NULL != X_mprof)
+    {
+        xmprof_fork_lock(X_mprof);
+    }
+}
+
+/**********************************************************/
+/**
+ * @brief fork() 之后（父进程中），按相反的次序解除 xmalloc_fork_prepare() 的锁定。
+ */
+static x_void_t xmalloc_fork_parent(void)
+{
+    xmpool_entry_t * xentry_ptr = X_NULL;
+    x_int32_t        xit_node   = 0;
+
+    if (X_NULL != X_mprof)
+    {
+        xmprof_fork_unlock(X_mprof);
+    }
+
+    for (xit_node = 0; xit_node < XMEM_NUMA_MAX; ++xit_node)
+    {
+        if (X_NULL != X_mheap_node[xit_node])
+            xmheap_fork_unlock(X_mheap_node[xit_node]);
+    }
+
+    for (xentry_ptr = X_mpool_list; X_NULL != xentry_ptr; xentry_ptr = xentry_ptr->xnext_ptr)
+    {
+        xmpool_fork_unlock(xentry_ptr->xmpool_ptr);
+    }
+
+    xatomic_spin_unlock(&X_malloc_lock);
+}
+
+/**********************************************************/
+/**
+ * @brief fork() 之后（子进程中），解除锁定，并丢弃已不存在的线程的状态。
+ * @note
+ * 子进程中只有调用 fork() 的线程，其他线程的内存池对象（fork() 时可能正在操作中）
+ * 不再有工作线程：将其工作线程 ID 置为 0，之后在子进程中回收其分片时，
+ * 只会压入各个 chunk 对象的待回收分片栈，不会访问其内部状态；
+ * 后台衰减线程也不会被复制到子进程中。
+ */
+static x_void_t xmalloc_fork_child(void)
+{
+    xmpool_entry_t * xentry_ptr = X_NULL;
+
+    for (xentry_ptr = X_mpool_list; X_NULL != xentry_ptr; xentry_ptr = xentry_ptr->xnext_ptr)
+    {
+        if (xentry_ptr->xmpool_ptr != X_tls_mpool)
+        {
+            xmpool_set_worktid(xentry_ptr->xmpool_ptr, 0);
+        }
+    }
+
+    X_decay_run = 0;
+
+    xmalloc_fork_parent();
+}
+
+#endif // __GNUC__
+
+/**********************************************************/
+/**
+ * @brief 线程退出时，处理其所持有的内存池对象。
+ * @note
+ * 若内存池对象中已无分片在使用，且 xmpool_release_unused() 之后已无缓存，则直接销毁；
+ * 否则将其挂起，由之后新创建的线程接管，期间其他线程仍可回收其分片。
+ * 其他线程的回收操作尚未完成时（分片已被取回，但 chunk 对象尚未挂入待处理链表），
+ * 该 chunk 对象不会被释放，仍计入缓存大小，故此时内存池对象也只能挂起。
+ */
+static x_void_t xmalloc_thread_exit(x_void_t * xht_value)
+{
+    xmpool_handle_t   xmpool_ptr  = (xmpool_handle_t)xht_value;
+    xmpool_orphan_t * xorphan_ptr = X_NULL;
+
+    if (X_NULL == xmpool_ptr)
+    {
+        return;
+    }
+
+    X_tls_mpool = X_NULL;
+
+    xmpool_release_unused(xmpool_ptr);
+    if ((0 == xmpool_using_size(xmpool_ptr)) &&
+        (0 == xmpool_cached_size(xmpool_ptr)))
+    {
+        xatomic_spin_lock(&X_malloc_lock);
+        xmalloc_pool_unregister(xmpool_ptr);
+        xatomic_spin_unlock(&X_malloc_lock);
+
+        xmpool_destroy(xmpool_ptr);
+        return;
+    }
+
+    xorphan_ptr = (xmpool_orphan_t *)xmpool_alloc(
+                        xmpool_ptr, sizeof(xmpool_orphan_t));
+    XASSERT(X_NULL != xorphan_ptr);
+    if (X_NULL == xorphan_ptr)
+    {
+        xmpool_set_worktid(xmpool_ptr, 0);
+        return;
+    }
+
+    xorphan_ptr->xmpool_ptr = xmpool_ptr;
+    xorphan_ptr->xmheap_ptr = X_tls_mheap;
+    xmpool_set_worktid(xmpool_ptr, 0);
+
+    xatomic_spin_lock(&X_malloc_lock);
+    xorphan_ptr->xnext_ptr = X_orphan_list;
+    X_orphan_list = xorphan_ptr;
+    xatomic_spin_unlock(&X_malloc_lock);
+}
+
+#ifdef _MSC_VER
+static VOID WINAPI xmalloc_fls_callback(PVOID xht_value)
+{
+    xmalloc_thread_exit(xht_value);
+}
+#endif // _MSC_VER
+
+/**********************************************************/
+/**
+ * @brief 获取当前线程所在 NUMA 节点上共用的堆内存管理对象（若不存在，则创建）。
+ * @note
+ * 须在 X_malloc_lock 的保护下调用。多节点系统中，各个节点的堆内存管理对象
+ * 都绑定到对应的节点（参看 xmheap_create_ex()），单节点系统中不进行绑定。
+ */
+static xmheap_handle_t xmalloc_node_heap(void)
+{
+    x_int32_t       xit_node   = 0;
+    xmheap_handle_t xmheap_ptr = X_NULL;
+
+    if (0 == X_numa_count)
+    {
+#ifdef _MSC_VER
+        X_tls_index = FlsAlloc(&xmalloc_fls_callback);
+        XASSERT(FLS_OUT_OF_INDEXES != X_tls_index);
+#elif defined(__GNUC__)
+        if (0 != pthread_key_create(&X_tls_index, &xmalloc_thread_exit))
+        {
+            XASSERT(X_FALSE);
+        }
+#endif // _MSC_VER
+
+        X_numa_count = xsys_numa_count();
+        if (X_numa_count > XMEM_NUMA_MAX)
+            X_numa_count = XMEM_NUMA_MAX;
+    }
+
+    if (X_numa_count > 1)
+    {
+        xit_node = xsys_numa_node();
+        if ((xit_node < 0) || (xit_node >= X_numa_count))
+            xit_node = 0;
+    }
+
+    xmheap_ptr = X_mheap_node[xit_node];
+    if (X_NULL == xmheap_ptr)
+    {
+        xmheap_ptr = xmheap_create_ex(XMALLOC_HEAP_BLOCK,
+                                      XMALLOC_HEAP_ULIMIT,
+                                      X_mheap_flags,
+                                      (X_numa_count > 1) ? xit_node : XMEM_NUMA_ANY);
+        if (X_NULL != xmheap_ptr)
+        {
+            xmheap_set_decay(xmheap_ptr, X_decay_ms);
+            X_mheap_node[xit_node] = xmheap_ptr;
+        }
+    }
+
+    return xmheap_ptr;
+}
+
+/**********************************************************/
+/**
+ * @brief 为当前线程绑定内存池对象（优先接管同一 NUMA 节点上被挂起的内存池对象）。
+ * @note
+ * 内存池对象从线程首次申请内存时所在节点的堆内存管理对象中申请 chunk 内存块，
+ * 之后线程被调度到其他节点时，仍继续使用该内存池对象。
+ */
+static xmpool_handle_t xmalloc_attach_pool(void)
+{
+    xmpool_handle_t   xmpool_ptr   = X_NULL;
+    xmheap_handle_t   xmheap_ptr   = X_NULL;
+    xmpool_orphan_t * xorphan_ptr  = X_NULL;
+    xmpool_orphan_t * xprev_ptr    = X_NULL;
+    x_bool_t          xbt_register = X_FALSE;
+
+    //======================================
+
+    xatomic_spin_lock(&X_malloc_lock);
+
+    xmheap_ptr = xmalloc_node_heap();
+    if (X_NULL == xmheap_ptr)
+    {
+        xatomic_spin_unlock(&X_malloc_lock);
+        return X_NULL;
+    }
+
+    for (xorphan_ptr = X_orphan_list;
+         X_NULL != xorphan_ptr;
+         xorphan_ptr = xorphan_ptr->xnext_ptr)
+    {
+        if (xorphan_ptr->xmheap_ptr == xmheap_ptr)
+        {
+            if (X_NULL == xprev_ptr)
+                X_orphan_list = xorphan_ptr->xnext_ptr;
+            else
+                xprev_ptr->xnext_ptr = xorphan_ptr->xnext_ptr;
+            break;
+        }
+
+        xprev_ptr = xorphan_ptr;
+    }
+
+    xatomic_spin_unlock(&X_malloc_lock);
+
+    //======================================
+
+    if (X_NULL != xorphan_ptr)
+    {
+        xmpool_ptr = xorphan_ptr->xmpool_ptr;
+        xmpool_set_worktid(xmpool_ptr, xsys_tid());
+        if (XMEM_ERR_OK != xmpool_recyc(xmpool_ptr, (xmem_slice_t)xorphan_ptr))
+        {
+            XASSERT(X_FALSE);
+        }
+    }
+    else
+    {
+        xmpool_ptr = xmpool_create_ex(&xmalloc_chunk_alloc,
+                                      &xmalloc_chunk_free,
+                                      (x_handle_t)xmheap_ptr,
+                                      XMPOOL_FLAG_MAGAZINE);
+        if (X_NULL == xmpool_ptr)
+        {
+            return X_NULL;
+        }
+
+        xatomic_spin_lock(&X_malloc_lock);
+        xbt_register = xmalloc_pool_register(xmpool_ptr);
+        xatomic_spin_unlock(&X_malloc_lock);
+
+        if (!xbt_register)
+        {
+            xmpool_destroy(xmpool_ptr);
+            return X_NULL;
+        }
+
+        xmpool_set_large_cache(xmpool_ptr, XMALLOC_LARGE_CACHE);
+    }
+
+    xmpool_set_decay(xmpool_ptr, X_decay_ms);
+    xmpool_set_profiler(xmpool_ptr, X_mprof);
+
+    //======================================
+
+    X_tls_mpool = xmpool_ptr;
+    X_tls_mheap = xmheap_ptr;
+    X_tls_epoch = X_decay_epoch;
+    X_tls_mprof = X_mprof;
+
+#ifdef _MSC_VER
+    FlsSetValue(X_tls_index, xmpool_ptr);
+#elif defined(__GNUC__)
+    pthread_setspecific(X_tls_index, xmpool_ptr);
+
+    // 须在 X_malloc_lock 之外、当前线程已绑定内存池对象之后注册：
+    // pthread_atfork() 内部可能申请内存，届时直接使用当前线程的内存池对象
+    if (0 == xatomic_cmpxchg_32(&X_fork_hook, 1, 0))
+    {
+        if (0 != pthread_atfork(&xmalloc_fork_prepare,
+                                &xmalloc_fork_parent,
+                                &xmalloc_fork_child))
+        {
+            XASSERT(X_FALSE);
+        }
+    }
+#endif // _MSC_VER
+
+    return xmpool_ptr;
+}
+
+/**********************************************************/
+/**
+ * @brief 获取当前线程的内存池对象（若不存在，则创建）。
+ * @note
+ * xmem_tick() 只能对调用线程自身的内存池对象进行衰减操作，
+ * 其他线程在此处发现有新的 xmem_tick() 时间点后，再（惰性地）补做衰减操作；
+ * xmem_prof_start() 创建的剖析器，同样在此处（惰性地）设置到各个线程的内存池对象。
+ */
+static inline xmpool_handle_t xmalloc_local_pool(void)
+{
+    if (X_NULL != X_tls_mpool)
+    {
+        if (X_tls_epoch != X_decay_epoch)
+        {
+            X_tls_epoch = X_decay_epoch;
+            xmpool_tick(X_tls_mpool, X_tls_epoch);
+        }
+
+        if (X_tls_mprof != X_mprof)
+        {
+            X_tls_mprof = X_mprof;
+            xmpool_set_profiler(X_tls_mpool, X_tls_mprof);
+        }
+
+        return X_tls_mpool;
+    }
+
+    return xmalloc_attach_pool();
+}
+
+/**********************************************************/
+/**
+ * @brief 后台衰减线程的执行流程。
+ */
+#ifdef _MSC_VER
+static DWORD WINAPI xmalloc_decay_proc(LPVOID xht_param)
+#elif defined(__GNUC__)
+static x_void_t * xmalloc_decay_proc(x_void_t * xht_param)
+#endif // _MSC_VER
+{
+    while (X_decay_run)
+    {
+        xsys_msleep(X_decay_wait);
+        xmem_tick(xsys_msecs());
+    }
+
+    return 0;
+}
+
+/**********************************************************/
+/**
+ * @brief 通过（各个 NUMA 节点上）共用的堆内存管理对象，查询内存地址所隶属的内存池对象。
+ * @note  优先查询当前线程所使用的堆内存管理对象。
+ */
+static xmpool_handle_t xmalloc_owner_pool(x_void_t * xmem_ptr)
+{
+    xchunk_snapshoot_t xsnapshoot;
+    xmheap_handle_t    xmheap_ptr = X_NULL;
+    x_int32_t          xit_iter   = 0;
+
+    if ((X_NULL != X_tls_mheap) &&
+        (XMEM_ERR_OK == xmheap_hit_chunk(
+                            X_tls_mheap, (xmem_slice_t)xmem_ptr, &xsnapshoot)))
+    {
+        return (xmpool_handle_t)xsnapshoot.xowner_ptr;
+    }
+
+    for (xit_iter = 0; xit_iter < X_numa_count; ++xit_iter)
+    {
+        xmheap_ptr = X_mheap_node[xit_iter];
+        if ((X_NULL == xmheap_ptr) || (xmheap_ptr == X_tls_mheap))
+        {
+            continue;
+        }
+
+        if (XMEM_ERR_OK == xmheap_hit_chunk(
+                                xmheap_ptr, (xmem_slice_t)xmem_ptr, &xsnapshoot))
+        {
+            return (xmpool_handle_t)xsnapshoot.xowner_ptr;
+        }
+    }
+
+    return X_NULL;
+}
+
+/**********************************************************/
+/**
+ * @brief 将内存回收至内存池对象。
+ * @note  xmem_memalign() 返回的可能是分片内部的地址，需换算为分片起始地址。
+ */
+static x_int32_t xmalloc_recyc(xmpool_handle_t xmpool_ptr, x_void_t * xmem_ptr)
+{
+    xmem_slice_t xmem_slice = X_NULL;
+    x_int32_t    xit_error  = xmpool_recyc(xmpool_ptr, (xmem_slice_t)xmem_ptr);
+
+    if (XMEM_ERR_UNALIGNED == xit_error)
+    {
+        xmem_slice = xmpool_slice_head(xmpool_ptr, (xmem_slice_t)xmem_ptr);
+        if (X_NULL != xmem_slice)
+        {
+            xit_error = xmpool_recyc(xmpool_ptr, xmem_slice);
+        }
+    }
+
+    return xit_error;
+}
+
+/**********************************************************/
+/**
+ * @brief 查询内存地址在内存池对象中（从该地址起）可使用的容量大小。
+ */
+static x_size_t xmalloc_usable_size(xmpool_handle_t xmpool_ptr, x_void_t * xmem_ptr)
+{
+    xmem_slice_t xmem_slice =
+        xmpool_slice_head(xmpool_ptr, (xmem_slice_t)xmem_ptr);
+
+    if (X_NULL == xmem_slice)
+    {
+        return 0;
+    }
+
+    return (x_size_t)(xmpool_slice_size(xmpool_ptr, xmem_slice) -
+                      ((xmem_slice_t)xmem_ptr - xmem_slice));
+}
+
+//====================================================================
+
+// 
+// public interfaces
+// 
+
+/**********************************************************/
+/**
+ * @brief 申请内存。
+ * @note
+ * 首次调用时，为当前线程（惰性）创建 内存池对象，
+ * 所有线程的内存池对象共用同一个 堆内存管理对象。
+ * 
+ * @param [in ] xst_size : 申请的内存大小。
+ * 
+ * @return x_void_t *
+ *         - 成功，返回 内存地址；
+ *         - 失败，返回 X_NULL。
+ */
+x_void_t * xmem_malloc(x_size_t xst_size)
+{
+    xmpool_handle_t xmpool_ptr = xmalloc_local_pool();
+
+    if ((X_NULL == xmpool_ptr) || (xst_size > XMALLOC_MAX_SIZE))
+    {
+        return X_NULL;
+    }
+
+    // 与 malloc(0) 的行为保持一致，返回可释放的有效地址
+    if (0 == xst_size)
+    {
+        xst_size = 1;
+    }
+
+    return xmpool_alloc(xmpool_ptr, (x_uint32_t)xst_size);
+}
+
+/**********************************************************/
+/**
+ * @brief 释放内存。
+ * @note  允许在任意线程中释放，内存会被回收至其所隶属的内存池对象。
+ * 
+ * @param [in ] xmem_ptr : 待释放的内存地址（可为 X_NULL）。
+ */
+x_void_t xmem_free(x_void_t * xmem_ptr)
+{
+    x_int32_t       xit_error  = XMEM_ERR_UNKNOW;
+    xmpool_handle_t xmpool_ptr = X_tls_mpool;
+
+    if (X_NULL == xmem_ptr)
+    {
+        return;
+    }
+
+    // 先尝试回收至当前线程的内存池对象（最常见的情况）
+    if (X_NULL != xmpool_ptr)
+    {
+        xit_error = xmalloc_recyc(xmpool_ptr, xmem_ptr);
+        if (XMEM_ERR_NOT_FOUND != xit_error)
+        {
+            XASSERT(XMEM_ERR_OK == xit_error);
+            return;
+        }
+    }
+
+    // 由 chunk 的持有者（内存池对象）回收
+    xmpool_ptr = xmalloc_owner_pool(xmem_ptr);
+    if (X_NULL == xmpool_ptr)
+    {
+        XASSERT(X_FALSE);
+        return;
+    }
+
+    if (XMEM_ERR_OK != xmalloc_recyc(xmpool_ptr, xmem_ptr))
+    {
+        XASSERT(X_FALSE);
+    }
+}
+
+/**********************************************************/
+/**
+ * @brief 申请 xst_count * xst_size 大小的内存，并清零。
+ * 
+ * @param [in ] xst_count : 元素数量。
+ * @param [in ] xst_size  : 元素大小。
+ * 
+ * @return x_void_t *
+ *         - 成功，返回 内存地址；
+ *         - 失败，返回 X_NULL。
+ */
+x_void_t * xmem_calloc(x_size_t xst_count, x_size_t xst_size)
+{
+    x_void_t * xmem_ptr = X_NULL;
+
+    if ((0 != xst_size) && (xst_count > (XMALLOC_MAX_SIZE / xst_size)))
+    {
+        return X_NULL;
+    }
+
+    xmem_ptr = xmem_malloc(xst_count * xst_size);
+    if (X_NULL != xmem_ptr)
+    {
+        memset(xmem_ptr, 0, xst_count * xst_size);
+    }
+
+    return xmem_ptr;
+}
+
+/**********************************************************/
+/**
+ * @brief 重新调整内存大小。
+ * 
+ * @param [in ] xmem_ptr : 原内存地址（为 X_NULL 时，等同于 xmem_malloc()）。
+ * @param [in ] xst_size : 新的内存大小（为 0 时，等同于 xmem_free()）。
+ * 
+ * @return x_void_t *
+ *         - 成功，返回 内存地址（可能与 xmem_ptr 相同）；
+ *         - 失败，返回 X_NULL，此时 xmem_ptr 仍然有效。
+ */
+x_void_t * xmem_realloc(x_void_t * xmem_ptr, x_size_t xst_size)
+{
+    x_void_t * xnew_ptr = X_NULL;
+    x_size_t   xst_used = 0;
+
+    if (X_NULL == xmem_ptr)
+    {
+        return xmem_malloc(xst_size);
+    }
+
+    if (0 == xst_size)
+    {
+        xmem_free(xmem_ptr);
+        return X_NULL;
+    }
+
+    xst_used = xmem_usable_size(xmem_ptr);
+    XASSERT(xst_used > 0);
+
+    // 容量足够，且收缩后不会浪费过半的空间时，原地返回
+    if ((xst_size <= xst_used) && (xst_size >= (xst_used / 2)))
+    {
+        return xmem_ptr;
+    }
+
+    xnew_ptr = xmem_malloc(xst_size);
+    if (X_NULL != xnew_ptr)
+    {
+        memcpy(xnew_ptr, xmem_ptr, (xst_size < xst_used) ? xst_size : xst_used);
+        xmem_free(xmem_ptr);
+    }
+
+    return xnew_ptr;
+}
+
+/**********************************************************/
+/**
+ * @brief 查询内存的（实际可使用的）容量大小。
+ * 
+ * @param [in ] xmem_ptr : 所查询的内存地址。
+ * 
+ * @return x_size_t
+ *         - 成功，返回 容量大小；
+ *         - 失败，返回 0。
+ */
+x_size_t xmem_usable_size(x_void_t * xmem_ptr)
+{
+    x_size_t        xst_size   = 0;
+    xmpool_handle_t xmpool_ptr = X_tls_mpool;
+
+    if (X_NULL == xmem_ptr)
+    {
+        return 0;
+    }
+
+    if (X_NULL != xmpool_ptr)
+    {
+        xst_size = xmalloc_usable_size(xmpool_ptr, xmem_ptr);
+    }
+
+    if (0 == xst_size)
+    {
+        xmpool_ptr = xmalloc_owner_pool(xmem_ptr);
+        if (X_NULL != xmpool_ptr)
+        {
+            xst_size = xmalloc_usable_size(xmpool_ptr, xmem_ptr);
+        }
+    }
+
+    return xst_size;
+}
+
+/**********************************************************/
+/**
+ * @brief 设置共用的 堆内存管理对象 使用大页的工作模式。
+ * @note  只在首次申请内存（创建共用的 堆内存管理对象）之前调用有效。
+ * 
+ * @param [in ] xut_flags : XMHEAP_FLAG_NONE、XMHEAP_FLAG_HUGE_PAGE 或 XMHEAP_FLAG_HUGETLB 。
+ * 
+ * @return x_bool_t
+ *         - 成功，返回 X_TRUE；
+ *         - 共用的 堆内存管理对象 已创建时，返回 X_FALSE。
+ */
+x_bool_t xmem_set_huge_page(x_uint32_t xut_flags)
+{
+    x_bool_t xbt_done = X_FALSE;
+
+    xatomic_spin_lock(&X_malloc_lock);
+    if (0 == X_numa_count)
+    {
+        X_mheap_flags = xut_flags;
+        xbt_done      = X_TRUE;
+    }
+    xatomic_spin_unlock(&X_malloc_lock);
+
+    return xbt_done;
+}
+
+/**********************************************************/
+/**
+ * @brief 设置空闲内存按时间衰减归还系统的半衰期。
+ * @note
+ * 立即作用于（各个 NUMA 节点上）共用的 堆内存管理对象 与当前线程的内存池对象，
+ * 之后新创建（或接管）内存池对象的线程也使用该值。
+ * 
+ * @param [in ] xut_decay_ms : 半衰期（毫秒，为 0 时不进行衰减归还）。
+ */
+x_void_t xmem_set_decay(x_uint32_t xut_decay_ms)
+{
+    x_int32_t xit_iter = 0;
+
+    X_decay_ms = xut_decay_ms;
+
+    for (xit_iter = 0; xit_iter < X_numa_count; ++xit_iter)
+    {
+        if (X_NULL != X_mheap_node[xit_iter])
+        {
+            xmheap_set_decay(X_mheap_node[xit_iter], xut_decay_ms);
+        }
+    }
+
+    if (X_NULL != X_tls_mpool)
+    {
+        xmpool_set_decay(X_tls_mpool, xut_decay_ms);
+    }
+}
+
+/**********************************************************/
+/**
+ * @brief 按时间衰减策略，将空闲的内存逐步归还给系统。
+ * @note
+ * 立即处理（各个 NUMA 节点上）共用的 堆内存管理对象 与当前线程的内存池对象，
+ * 其他线程的内存池对象，在其下次申请内存时补做衰减操作。
+ * 
+ * @param [in ] xut_now : 当前的时间点（毫秒，通常为 xsys_msecs() 的返回值）。
+ * 
+ * @return x_uint64_t
+ *         - 返回本次（在调用线程中）归还给系统的内存大小。
+ */
+x_uint64_t xmem_tick(x_uint64_t xut_now)
+{
+    x_uint64_t xsize_free = 0;
+    x_int32_t  xit_iter   = 0;
+
+    X_decay_epoch = xut_now;
+
+    if (X_NULL != X_tls_mpool)
+    {
+        X_tls_epoch = xut_now;
+        xsize_free += xmpool_tick(X_tls_mpool, xut_now);
+    }
+
+    for (xit_iter = 0; xit_iter < X_numa_count; ++xit_iter)
+    {
+        if (X_NULL != X_mheap_node[xit_iter])
+        {
+            xsize_free += xmheap_tick(X_mheap_node[xit_iter], xut_now);
+        }
+    }
+
+    return xsize_free;
+}
+
+/**********************************************************/
+/**
+ * @brief 启动后台衰减线程，周期性地调用 xmem_tick()。
+ * 
+ * @param [in ] xut_interval_ms : 调用间隔（毫秒）。
+ * 
+ * @return x_bool_t
+ *         - 成功（或已在运行），返回 X_TRUE；
+ *         - 失败，返回 X_FALSE。
+ */
+x_bool_t xmem_decay_start(x_uint32_t xut_interval_ms)
+{
+    x_bool_t xbt_start = X_TRUE;
+
+    xatomic_spin_lock(&X_malloc_lock);
+
+    if (0 == X_decay_run)
+    {
+        X_decay_wait = (xut_interval_ms > 0) ? xut_interval_ms : 1;
+        X_decay_run  = 1;
+
+#ifdef _MSC_VER
+        X_decay_thread = CreateThread(X_NULL, 0, &xmalloc_decay_proc, X_NULL, 0, X_NULL);
+        xbt_start = (X_NULL != X_decay_thread);
+#elif defined(__GNUC__)
+        xbt_start = (0 == pthread_create(&X_decay_thread, X_NULL, &xmalloc_decay_proc, X_NULL));
+#endif // _MSC_VER
+
+        if (!xbt_start)
+        {
+            X_decay_run = 0;
+        }
+    }
+
+    xatomic_spin_unlock(&X_malloc_lock);
+
+    return xbt_start;
+}
+
+/**********************************************************/
+/**
+ * @brief 停止后台衰减线程（等待其退出）。
+ */
+x_void_t xmem_decay_stop(void)
+{
+    xatomic_spin_lock(&X_malloc_lock);
+
+    if (0 == X_decay_run)
+    {
+        xatomic_spin_unlock(&X_malloc_lock);
+        return;
+    }
+
+    X_decay_run = 0;
+    xatomic_spin_unlock(&X_malloc_lock);
+
+#ifdef _MSC_VER
+    WaitForSingleObject(X_decay_thread, INFINITE);
+    CloseHandle(X_decay_thread);
+    X_decay_thread = X_NULL;
+#elif defined(__GNUC__)
+    pthread_join(X_decay_thread, X_NULL);
+#endif // _MSC_VER
+}
+
+/**********************************************************/
+/**
+ * @brief 按指定的对齐方式申请内存。
+ * @note
+ * 对齐值大于 8 时，从（加上对齐余量的）分片中返回对齐后的内部地址，
+ * xmem_free()/xmem_realloc()/xmem_usable_size() 均可直接使用该地址。
+ * 
+ * @param [in ] xst_align : 对齐值（须为 2 的幂）。
+ * @param [in ] xst_size  : 申请的内存大小。
+ * 
+ * @return x_void_t *
+ *         - 成功，返回 内存地址；
+ *         - 失败，返回 X_NULL。
+ */
+x_void_t * xmem_memalign(x_size_t xst_align, x_size_t xst_size)
+{
+    x_byte_t * xmem_ptr = X_NULL;
+
+    if ((0 == xst_align) || (0 != (xst_align & (xst_align - 1))))
+    {
+        return X_NULL;
+    }
+
+    if (xst_align <= sizeof(x_uint64_t))
+    {
+        return xmem_malloc(xst_size);
+    }
+
+    if (xst_size > (XMALLOC_MAX_SIZE - xst_align))
+    {
+        return X_NULL;
+    }
+
+    // 不大于页大小的对齐值，由内存池直接选取满足对齐的分类，无需对齐余量
+    if (xst_align <= XMEM_PAGE_SIZE)
+    {
+        xmpool_handle_t xmpool_ptr = xmalloc_local_pool();
+        if (X_NULL == xmpool_ptr)
+        {
+            return X_NULL;
+        }
+
+        return xmpool_alloc_aligned(xmpool_ptr,
+                                    (0 == xst_size) ? 1 : (x_uint32_t)xst_size,
+                                    (x_uint32_t)xst_align);
+    }
+
+    xmem_ptr = (x_byte_t *)xmem_malloc(xst_size + xst_align);
+    if (X_NULL == xmem_ptr)
+    {
+        return X_NULL;
+    }
+
+    return (x_void_t *)X_ALIGN((x_size_t)xmem_ptr, xst_align);
+}
+
+/**********************************************************/
+/**
+ * @brief 启动（或调整）堆内存采样剖析。
+ * @note
+ * 首次调用时创建全局的堆内存剖析器（之后不再销毁），各个线程的内存池对象
+ * 在其下次申请内存时（惰性地）开始采样；只对内存池对象的分片采样，
+ * 共用的 堆内存管理对象 不再重复采样其 chunk 内存块。
+ * 
+ * @param [in ] xut_interval : 平均采样间隔（字节，为 0 时暂停采样）。
+ * 
+ * @return x_bool_t
+ *         - 成功，返回 X_TRUE；
+ *         - 失败，返回 X_FALSE。
+ */
+x_bool_t xmem_prof_start(x_uint32_t xut_interval)
+{
+    xmprof_handle_t xmprof_ptr = X_NULL;
+
+    if (X_NULL != X_mprof)
+    {
+        xmprof_set_interval(X_mprof, xut_interval);
+        return X_TRUE;
+    }
+
+    if (0 == xut_interval)
+    {
+        return X_TRUE;
+    }
+
+    // xmprof_create() 初始化 xsys_backtrace() 时可能申请内存，不可在 X_malloc_lock 内调用
+    xmprof_ptr = xmprof_create(xut_interval);
+    if (X_NULL == xmprof_ptr)
+    {
+        return X_FALSE;
+    }
+
+    xatomic_spin_lock(&X_malloc_lock);
+    if (X_NULL == X_mprof)
+    {
+        X_mprof    = xmprof_ptr;
+        xmprof_ptr = X_NULL;
+    }
+    xatomic_spin_unlock(&X_malloc_lock);
+
+    // 其他线程已先行创建
+    if (X_NULL != xmprof_ptr)
+    {
+        xmprof_destroy(xmprof_ptr);
+        xmprof_set_interval(X_mprof, xut_interval);
+    }
+
+    return X_TRUE;
+}
+
+/**********************************************************/
+/**
+ * @brief 将当前仍在使用中的被采样内存，按调用栈汇总输出至文件（pprof 格式，参看 xmprof_dump()）。
+ * 
+ * @param [in ] xpath_ptr : 输出的文件路径。
+ * 
+ * @return x_int32_t
+ *         - 成功，返回 XMEM_ERR_OK；
+ *         - 失败，返回 错误码（未启动采样时，返回 XMEM_ERR_NOT_FOUND）。
+ */
+x_int32_t xmem_prof_dump(const x_char_t * xpath_ptr)
+{
+    if (X_NULL == X_mprof)
+    {
+        return XMEM_ERR_NOT_FOUND;
+    }
+
+    return xmprof_dump(X_mprof, xpath_ptr);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+#ifdef __GNUC__
+#pragma GCC diagnostic pop
+#endif // __GNUC__
+
+////////////////////////////////////////////////////////////////////////////////
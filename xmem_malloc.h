@@ -0,0 +1,211 @@
+﻿/**
+ * @file    xmem_malloc.h
+ * <pre>
+ * Copyright (c) 2019, Gaaagaa All rights reserved.
+ * 
+ * 文件名称：xmem_malloc.h
+ * 创建日期：2026年10月18日
+ * 文件标识：
+ * 文件摘要：以线程局部的内存池对象为前端的通用内存分配接口。
+ * 
+ * 当前版本：1.0.0.0
+ * 作    者：
+ * 完成日期：2026年10月18日
+ * 版本摘要：
+ * 
+ * 历史版本：
+ * 原作者  ：
+ * 完成日期：
+ * 版本摘要：
+ * </pre>
+ */
+
+#ifndef __XMEM_MALLOC_H__
+#define __XMEM_MALLOC_H__
+
+#ifndef __XMEM_COMM_H__
+#error "Please include xmem_comm.h"
+#endif // __XMEM_COMM_H__
+
+////////////////////////////////////////////////////////////////////////////////
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif // __cplusplus
+
+////////////////////////////////////////////////////////////////////////////////
+
+/**********************************************************/
+/**
+ * @brief 申请内存。
+ * @note
+ * 首次调用时，为当前线程（惰性）创建 内存池对象，
+ * 同一 NUMA 节点上所有线程的内存池对象共用同一个（绑定到该节点的）堆内存管理对象，
+ * 单节点系统中，所有线程共用同一个 堆内存管理对象。
+ * 
+ * @param [in ] xst_size : 申请的内存大小。
+ * 
+ * @return x_void_t *
+ *         - 成功，返回 内存地址；
+ *         - 失败，返回 X_NULL。
+ */
+x_void_t * xmem_malloc(x_size_t xst_size);
+
+/**********************************************************/
+/**
+ * @brief 释放内存。
+ * @note  允许在任意线程中释放，内存会被回收至其所隶属的内存池对象。
+ * 
+ * @param [in ] xmem_ptr : 待释放的内存地址（可为 X_NULL）。
+ */
+x_void_t xmem_free(x_void_t * xmem_ptr);
+
+/**********************************************************/
+/**
+ * @brief 申请 xst_count * xst_size 大小的内存，并清零。
+ * 
+ * @param [in ] xst_count : 元素数量。
+ * @param [in ] xst_size  : 元素大小。
+ * 
+ * @return x_void_t *
+ *         - 成功，返回 内存地址；
+ *         - 失败，返回 X_NULL。
+ */
+x_void_t * xmem_calloc(x_size_t xst_count, x_size_t xst_size);
+
+/**********************************************************/
+/**
+ * @brief 重新调整内存大小。
+ * 
+ * @param [in ] xmem_ptr : 原内存地址（为 X_NULL 时，等同于 xmem_malloc()）。
+ * @param [in ] xst_size : 新的内存大小（为 0 时，等同于 xmem_free()）。
+ * 
+ * @return x_void_t *
+ *         - 成功，返回 内存地址（可能与 xmem_ptr 相同）；
+ *         - 失败，返回 X_NULL，此时 xmem_ptr 仍然有效。
+ */
+x_void_t * xmem_realloc(x_void_t * xmem_ptr, x_size_t xst_size);
+
+/**********************************************************/
+/**
+ * @brief 查询内存的（实际可使用的）容量大小。
+ * 
+ * @param [in ] xmem_ptr : 所查询的内存地址。
+ * 
+ * @return x_size_t
+ *         - 成功，返回 容量大小；
+ *         - 失败，返回 0。
+ */
+x_size_t xmem_usable_size(x_void_t * xmem_ptr);
+
+/**********************************************************/
+/**
+ * @brief 按指定的对齐方式申请内存。
+ * @note
+ * 对齐值不大于 XMEM_PAGE_SIZE 时，由内存池直接分配满足对齐的分片（参看 xmpool_alloc_aligned()）；
+ * 更大的对齐值，从（加上对齐余量的）分片中返回对齐后的内部地址，
+ * xmem_free()/xmem_realloc()/xmem_usable_size() 均可直接使用该地址。
+ * 
+ * @param [in ] xst_align : 对齐值（须为 2 的幂）。
+ * @param [in ] xst_size  : 申请的内存大小。
+ * 
+ * @return x_void_t *
+ *         - 成功，返回 内存地址；
+ *         - 失败，返回 X_NULL。
+ */
+x_void_t * xmem_memalign(x_size_t xst_align, x_size_t xst_size);
+
+/**********************************************************/
+/**
+ * @brief 设置共用的 堆内存管理对象 使用大页的工作模式（参看 xmheap_create_ex()）。
+ * @note  须在首次申请内存之前调用，之后调用无效。
+ * 
+ * @param [in ] xut_flags : XMHEAP_FLAG_NONE、XMHEAP_FLAG_HUGE_PAGE 或 XMHEAP_FLAG_HUGETLB 。
+ * 
+ * @return x_bool_t
+ *         - 成功，返回 X_TRUE；
+ *         - 已经申请过内存时，返回 X_FALSE。
+ */
+x_bool_t xmem_set_huge_page(x_uint32_t xut_flags);
+
+/**********************************************************/
+/**
+ * @brief 设置空闲内存按时间衰减归还系统的半衰期（默认为 XMEM_DECAY_MS）。
+ * @note
+ * 立即作用于（各个 NUMA 节点上）共用的 堆内存管理对象 与当前线程的内存池对象，
+ * 之后新创建（或接管）内存池对象的线程也使用该值。
+ * 
+ * @param [in ] xut_decay_ms : 半衰期（毫秒，为 0 时不进行衰减归还）。
+ */
+x_void_t xmem_set_decay(x_uint32_t xut_decay_ms);
+
+/**********************************************************/
+/**
+ * @brief 按时间衰减策略，将空闲的内存逐步归还给系统（参看 xmpool_tick()/xmheap_tick()）。
+ * @note
+ * 立即处理（各个 NUMA 节点上）共用的 堆内存管理对象 与当前线程的内存池对象；
+ * 其他线程的内存池对象只能由其自身操作，在其下次申请内存时补做衰减操作。
+ * 
+ * @param [in ] xut_now : 当前的时间点（毫秒，通常为 xsys_msecs() 的返回值）。
+ * 
+ * @return x_uint64_t
+ *         - 返回本次（在调用线程中）归还给系统的内存大小。
+ */
+x_uint64_t xmem_tick(x_uint64_t xut_now);
+
+/**********************************************************/
+/**
+ * @brief 启动后台衰减线程，每隔 xut_interval_ms 毫秒调用一次 xmem_tick(xsys_msecs())。
+ * 
+ * @param [in ] xut_interval_ms : 调用间隔（毫秒）。
+ * 
+ * @return x_bool_t
+ *         - 成功（或已在运行），返回 X_TRUE；
+ *         - 失败，返回 X_FALSE。
+ */
+x_bool_t xmem_decay_start(x_uint32_t xut_interval_ms);
+
+/**********************************************************/
+/**
+ * @brief 停止后台衰减线程（等待其退出）。
+ */
+x_void_t xmem_decay_stop(void);
+
+/**********************************************************/
+/**
+ * @brief 启动（或调整）堆内存采样剖析：平均每申请 xut_interval 字节，记录一次调用栈。
+ * @note
+ * 各个线程的内存池对象在其下次申请内存时开始（或停止）采样；
+ * 未启动时，申请接口的额外开销只有一次指针判断。
+ * 
+ * @param [in ] xut_interval : 平均采样间隔（字节，通常为 XMPROF_INTERVAL，为 0 时暂停采样）。
+ * 
+ * @return x_bool_t
+ *         - 成功，返回 X_TRUE；
+ *         - 失败，返回 X_FALSE。
+ */
+x_bool_t xmem_prof_start(x_uint32_t xut_interval);
+
+/**********************************************************/
+/**
+ * @brief 将当前仍在使用中的被采样内存，按调用栈汇总输出至文件。
+ * @note  输出为 pprof 可读取的 heap 剖析文件（参看 xmprof_dump()），例如 pprof -top ./app heap.prof 。
+ * 
+ * @param [in ] xpath_ptr : 输出的文件路径。
+ * 
+ * @return x_int32_t
+ *         - 成功，返回 XMEM_ERR_OK；
+ *         - 失败，返回 错误码（未启动采样时，返回 XMEM_ERR_NOT_FOUND）。
+ */
+x_int32_t xmem_prof_dump(const x_char_t * xpath_ptr);
+
+////////////////////////////////////////////////////////////////////////////////
+
+#ifdef __cplusplus
+}; // extern "C"
+#endif // __cplusplus
+
+////////////////////////////////////////////////////////////////////////////////
+
+#endif // __XMEM_MALLOC_H__
@@ -34,13 +34,9 @@
 
 struct xmem_chunk_t;
 struct xmem_class_t;
-struct xslice_array_t;
-struct xslice_rqueue_t;
 
 typedef struct xmem_chunk_t    * xchunk_handle_t;
 typedef struct xmem_class_t    * xclass_handle_t;
-typedef struct xslice_array_t  * xslice_arrptr_t;
-typedef struct xslice_rqueue_t * xsrque_handle_t;
 
 /**
  * slice size table: 
@@ -159,12 +155,18 @@ typedef struct xslice_rqueue_t * xsrque_handle_t;
 
 #define XSLICE_TYPE_COUNT   88
 
-#define XCHUNK_MIN_SIZE     (1024 * 256 )
-#define XCHUNK_MAX_SIZE     (1024 * 1024)
+#define XCHUNK_MIN_SIZE     (1024 * 16  )
+#define XCHUNK_MAX_SIZE     (1024 * 1024 * 4)
 #define XCHUNK_INC_SIZE     XMEM_PAGE_SIZE
 
+/** 分类的首个 chunk 对象至少可容纳的分片数量 */
+#define XCHUNK_MIN_SLICES   4
+
+/** 分类的 chunk 大小随 chunk 数量倍增的最大级数（XCHUNK_MIN_SIZE << 8 == XCHUNK_MAX_SIZE） */
+#define XCHUNK_GROW_STEPS   8
+
 /** 所有内存分片大小的数组表 */
-static x_uint32_t X_slice_size_table[XSLICE_TYPE_COUNT] =
+static const x_uint32_t X_slice_size_table[XSLICE_TYPE_COUNT] =
 {
     XSLICE_SIZE_____8,
     XSLICE_SIZE____16,
@@ -256,6 +258,66 @@ static x_uint32_t X_slice_size_table[XSLICE_TYPE_COUNT] =
     XSLICE_SIZE_65536
 };
 
+/** 分类索引表的索引粒度（位移值），即 8 字节 */
+#define XSLICE_INDEX_SHIFT  3
+
+/** 分类索引表的项数：[0, XSLICE_SIZE_65536 >> XSLICE_INDEX_SHIFT] */
+#define XSLICE_INDEX_COUNT  ((XSLICE_SIZE_65536 >> XSLICE_INDEX_SHIFT) + 1)
+
+/** 通过分类索引表，将（不大于 XSLICE_SIZE_65536 的）内存大小映射到分类索引号 */
+#define XSLICE_CLASS_INDEX(xut_size) \
+    X_class_index_table[((xut_size) + (1 << XSLICE_INDEX_SHIFT) - 1) >> XSLICE_INDEX_SHIFT]
+
+#define XINDEX_R1(xindex)   xindex
+#define XINDEX_R2(xindex)   XINDEX_R1(xindex)  , XINDEX_R1(xindex)
+#define XINDEX_R4(xindex)   XINDEX_R2(xindex)  , XINDEX_R2(xindex)
+#define XINDEX_R8(xindex)   XINDEX_R4(xindex)  , XINDEX_R4(xindex)
+#define XINDEX_R16(xindex)  XINDEX_R8(xindex)  , XINDEX_R8(xindex)
+#define XINDEX_R32(xindex)  XINDEX_R16(xindex) , XINDEX_R16(xindex)
+#define XINDEX_R64(xindex)  XINDEX_R32(xindex) , XINDEX_R32(xindex)
+#define XINDEX_R128(xindex) XINDEX_R64(xindex) , XINDEX_R64(xindex)
+#define XINDEX_R256(xindex) XINDEX_R128(xindex), XINDEX_R128(xindex)
+#define XINDEX_R512(xindex) XINDEX_R256(xindex), XINDEX_R256(xindex)
+
+/**
+ * @brief 分类索引表：下标为 (xut_size + 7) >> 3，值为 X_slice_size_table 的索引号。
+ * @note
+ * 各分类所占的表项数 等于 该分类与前一分类的大小差值 除以 8，
+ * 例如 [4097, 4608] 对应 64 个表项，值均为 56（XSLICE_SIZE__4608）。
+ */
+static const x_uint8_t X_class_index_table[XSLICE_INDEX_COUNT] =
+{
+    0, // xut_size == 0
+    XINDEX_R1( 0), XINDEX_R1( 1), XINDEX_R1( 2), XINDEX_R1( 3), XINDEX_R1( 4), XINDEX_R1( 5), XINDEX_R1( 6), XINDEX_R1( 7),
+    XINDEX_R1( 8), XINDEX_R1( 9), XINDEX_R1(10), XINDEX_R1(11), XINDEX_R1(12), XINDEX_R1(13), XINDEX_R1(14), XINDEX_R1(15),
+    XINDEX_R2(16), XINDEX_R2(17), XINDEX_R2(18), XINDEX_R2(19), XINDEX_R2(20), XINDEX_R2(21), XINDEX_R2(22), XINDEX_R2(23),
+    XINDEX_R4(24), XINDEX_R4(25), XINDEX_R4(26), XINDEX_R4(27), XINDEX_R4(28), XINDEX_R4(29), XINDEX_R4(30), XINDEX_R4(31),
+    XINDEX_R8(32), XINDEX_R8(33), XINDEX_R8(34), XINDEX_R8(35), XINDEX_R8(36), XINDEX_R8(37), XINDEX_R8(38), XINDEX_R8(39),
+    XINDEX_R16(40), XINDEX_R16(41), XINDEX_R16(42), XINDEX_R16(43),
+    XINDEX_R16(44), XINDEX_R16(45), XINDEX_R16(46), XINDEX_R16(47),
+    XINDEX_R32(48), XINDEX_R32(49), XINDEX_R32(50), XINDEX_R32(51),
+    XINDEX_R32(52), XINDEX_R32(53), XINDEX_R32(54), XINDEX_R32(55),
+    XINDEX_R64(56), XINDEX_R64(57), XINDEX_R64(58), XINDEX_R64(59),
+    XINDEX_R64(60), XINDEX_R64(61), XINDEX_R64(62), XINDEX_R64(63),
+    XINDEX_R128(64), XINDEX_R128(65), XINDEX_R128(66), XINDEX_R128(67),
+    XINDEX_R128(68), XINDEX_R128(69), XINDEX_R128(70), XINDEX_R128(71),
+    XINDEX_R256(72), XINDEX_R256(73), XINDEX_R256(74), XINDEX_R256(75),
+    XINDEX_R256(76), XINDEX_R256(77), XINDEX_R256(78), XINDEX_R256(79),
+    XINDEX_R512(80), XINDEX_R512(81), XINDEX_R512(82), XINDEX_R512(83),
+    XINDEX_R512(84), XINDEX_R512(85), XINDEX_R512(86), XINDEX_R512(87)
+};
+
+#undef XINDEX_R1
+#undef XINDEX_R2
+#undef XINDEX_R4
+#undef XINDEX_R8
+#undef XINDEX_R16
+#undef XINDEX_R32
+#undef XINDEX_R64
+#undef XINDEX_R128
+#undef XINDEX_R256
+#undef XINDEX_R512
+
 /**
  * @struct xchunk_alias_t
  * @brief  定义伪 chunk 的链表节点结构体，用于 双向链表 的 头部/尾部。
@@ -316,6 +378,45 @@ typedef struct xmem_chunk_t
     xclass_handle_t xclass_ptr;    ///< 当前 chunk 所在的 class 对象
     } xowner;
 
+    /**
+     * @brief 其他线程回收的内存分片所组成的（侵入式）无锁栈。
+     * @note
+     * 分片首部的 sizeof(xmem_slice_t) 字节用于存储栈中后继分片的地址，
+     * 工作线程通过一次原子交换操作将整个栈取回。
+     * 栈顶地址的最低位（XSLICE_RFREE_LINKED）标识 chunk 是否已（或正要）挂入
+     * 内存池的 xchunk_rlist 链表，该位只在工作线程从链表中取回 chunk 时清零。
+     * 因此，只要仍有线程在压栈或挂链的过程中，该字段便不为 X_NULL，
+     * 工作线程据此判断 chunk 对象能否被释放（参看 XCHUNK_RFREE_QUIET）。
+     */
+    volatile xmem_slice_t xslice_rfree;
+    xchunk_handle_t xchunk_rnext;  ///< 在内存池 xchunk_rlist 链表中的后继节点
+
+    /**
+     * @brief 分片切分的高水位线：索引号不小于该值的分片从未被分配过。
+     * @note
+     * 从未被分配过的分片按索引号顺序（bump-pointer 方式）切分出去，
+     * 分片索引号队列只用于存放被回收的分片，故创建 chunk 时无需初始化整个队列。
+     */
+    x_uint16_t      xut_carve;
+
+    /**
+     * @brief 标识 空闲 chunk 对象的物理内存是否已（按衰减策略）归还给系统。
+     * @note  chunk 对象离开 空闲 状态时清零（参看 xclass_idle_leave()）。
+     */
+    x_uint16_t      xut_purged;
+
+    /**
+     * @brief 分片大小不小于 XMEM_PAGE_SIZE 的分类 chunk 对象中，
+     *        被空闲分片完整覆盖、且已归还物理内存的分页数量（参看 xmpool_purge_pages()）。
+     */
+    x_uint16_t      xpage_purged;
+
+    /**
+     * @brief 仍在被剖析器跟踪的（已采样的）分片数量（参看 xmpool_set_profiler()），
+     *        为 0 时，回收分片无需查找采样记录。
+     */
+    x_uint16_t      xut_sampled;
+
     /**
      * @brief 内存分片索引号队列。
      */
@@ -330,60 +431,168 @@ typedef struct xmem_chunk_t
     (XCHUNK_LADDR(xchunk_ptr) + (xchunk_ptr)->xchunk_size)
 
 /**
- * @struct xmem_class_t
- * @brief  内存分类的结构体描述信息。
+ * 非分类管理的（大块）chunk 对象中，分片的起始偏移量，
+ * 按 16 字节对齐，以满足 malloc() 的地址对齐语义。
  */
-typedef struct xmem_class_t
-{
-    x_uint32_t      xchunk_size;   ///< 内存块大小
-    x_uint32_t      xslice_size;   ///< 内存分片大小
+#define XCHUNK_LARGE_OFFSET   X_ALIGN(sizeof(xmem_chunk_t), 16)
 
-    x_uint32_t      xchunk_count;  ///< 内存块数量
-    x_uint32_t      xslice_count;  ///< 可用的（未被分配出去的）内存分片数量
+/** chunk 对象中未被分配出去的分片数量（分片队列中的 + 尚未切分的） */
+#define XCHUNK_FREE_COUNT(xchunk_ptr)                           \
+    ((x_uint32_t)XSLICE_QUEUE_COUNT(xchunk_ptr, x_uint16_t) +   \
+     (x_uint32_t)(XSLICE_QUEUE_CAPACITY(xchunk_ptr) - (xchunk_ptr)->xut_carve))
 
-    xmpool_handle_t xmpool_ptr;    ///< 持有当前 内存分类 对象的 内存池
+/** chunk 对象的所有分片是否都已经被分配出去 */
+#define XCHUNK_IS_BUSY(xchunk_ptr)                                  \
+    (XSLICE_QUEUE_IS_EMPTY(xchunk_ptr) &&                           \
+     ((xchunk_ptr)->xut_carve == XSLICE_QUEUE_CAPACITY(xchunk_ptr)))
 
-    xchunk_alias_t  xlist_head;    ///< 双向链表的头部伪 chunk 节点
-    xchunk_alias_t  xlist_tail;    ///< 双向链表的尾部伪 chunk 节点
-} xmem_class_t;
+/** chunk 对象是否没有任何一个分片被分配出去 */
+#define XCHUNK_IS_IDLE(xchunk_ptr) \
+    (XCHUNK_FREE_COUNT(xchunk_ptr) == XSLICE_QUEUE_CAPACITY(xchunk_ptr))
+
+/** 可按分页归还空闲分片物理内存的分类（分片大小不小于 XMEM_PAGE_SIZE） */
+#define XCHUNK_PAGE_PURGEABLE(xslice_size) ((xslice_size) >= XMEM_PAGE_SIZE)
+
+/**
+ * 已归还物理内存的分页的位标识数组的字数（每字 64 个分页），只有可按分页归还的分类才需要；
+ * 分页按 chunk 对象起始地址（向下对齐到 XMEM_PAGE_SIZE）计算索引号，故多计 1 个分页。
+ */
+#define XCHUNK_PAGE_WORDS(xchunk_size, xslice_size)                 \
+    (XCHUNK_PAGE_PURGEABLE(xslice_size) ?                           \
+     ((((xchunk_size) / XMEM_PAGE_SIZE) + 1 + 63) / 64) : 0)
+
+/** chunk 对象的头部大小（分片索引号队列之外，含分页位标识数组） */
+#define XCHUNK_HEAD_SIZE(xchunk_size, xslice_size)                  \
+    ((x_uint32_t)sizeof(xmem_chunk_t) + (x_uint32_t)sizeof(x_uint64_t) * \
+     XCHUNK_PAGE_WORDS((xchunk_size), (xslice_size)))
+
+/**
+ * chunk 对象的分页位标识数组，紧邻首个分片之前（位于分片索引号队列之后的填充区中）；
+ * 分片被分配出去时，清除其所覆盖分页的标识位（参看 xchunk_page_revive()）。
+ */
+#define XCHUNK_PAGE_BITS(xchunk_ptr)                                \
+    ((x_uint64_t *)XSLICE_QUEUE_BEGIN(xchunk_ptr) -                 \
+     XCHUNK_PAGE_WORDS((xchunk_ptr)->xchunk_size, (xchunk_ptr)->xslice_size))
+
+/** 计算地址在 chunk 对象中的分页索引号 */
+#define XCHUNK_PAGE_INDEX(xchunk_ptr, xmem_addr)                                    \
+    ((x_uint32_t)(((x_size_t)(xmem_addr) -                                          \
+                   ((x_size_t)(xchunk_ptr) & ~((x_size_t)XMEM_PAGE_SIZE - 1))) /    \
+                  XMEM_PAGE_SIZE))
+
+/** 分页位标识数组中，指定索引号的分页是否已归还物理内存 */
+#define XCHUNK_PAGE_IS_PURGED(xpage_bits, xut_page) \
+    (0 != ((xpage_bits)[(xut_page) >> 6] & (1ULL << ((xut_page) & 63))))
+
+/** 待回收分片栈中，分片所存储的后继分片地址 */
+#define XSLICE_RFREE_NEXT(xmem_slice) (*(xmem_slice_t *)(xmem_slice))
+
+/** 待回收分片栈顶地址中，标识 chunk 已挂入 xchunk_rlist 链表的标志位 */
+#define XSLICE_RFREE_LINKED ((x_size_t)1)
+
+/** 去除标志位后的待回收分片栈顶地址 */
+#define XSLICE_RFREE_TOP(xslice_rfree) \
+    ((xmem_slice_t)((x_size_t)(xslice_rfree) & ~XSLICE_RFREE_LINKED))
+
+/** 读取 chunk 对象的待回收分片栈顶地址（其他线程会以原子操作更新该字段） */
+#define XCHUNK_RFREE_LOAD(xchunk_ptr) \
+    ((xmem_slice_t)xatomic_load_ptr((x_void_t * volatile *)&(xchunk_ptr)->xslice_rfree))
+
+/**
+ * chunk 对象是否没有任何其他线程的回收操作在进行中（既无待回收分片，
+ * 也未挂入 xchunk_rlist 链表），只有满足该条件的 chunk 对象才可被释放。
+ */
+#define XCHUNK_RFREE_QUIET(xchunk_ptr) (X_NULL == XCHUNK_RFREE_LOAD(xchunk_ptr))
 
-#define XCLASS_LIST_HEAD(xclass_ptr)  ((xchunk_handle_t)&(xclass_ptr)->xlist_head)
-#define XCLASS_LIST_FRONT(xclass_ptr) ((xclass_ptr)->xlist_head.xlist_node.xchunk_next)
-#define XCLASS_LIST_BACK(xclass_ptr)  ((xclass_ptr)->xlist_tail.xlist_node.xchunk_prev)
-#define XCLASS_LIST_TAIL(xclass_ptr)  ((xchunk_handle_t)&(xclass_ptr)->xlist_tail)
+/**
+ * @enum  xchunk_list_index
+ * @brief 分类管理的 chunk 对象，按其分片队列的状态，分别挂入 class 对象的各个链表。
+ */
+typedef enum xchunk_list_index
+{
+    XCHUNK_LIST_BUSY  = 0, ///< 分片队列为空，即所有分片都已经被分配出去
+    XCHUNK_LIST_PART  = 1, ///< 分片队列非空非满，即仍有部分分片可分配
+    XCHUNK_LIST_IDLE  = 2, ///< 分片队列已满，即没有任何一个分片被分配出去
+    XCHUNK_LIST_COUNT = 3  ///< 链表数量
+} xchunk_list_index;
 
-#define XSLICE_ARRAY_SIZE  \
-    ((XMEM_PAGE_SIZE - (2 * sizeof(xslice_arrptr_t))) / sizeof(xmem_slice_t))
+/** 按 chunk 对象当前分片队列的状态，计算其所应挂入的链表索引号 */
+#define XCHUNK_LIST_STATE(xchunk_ptr)                     \
+    (XCHUNK_IS_BUSY(xchunk_ptr) ? XCHUNK_LIST_BUSY :      \
+     (XCHUNK_IS_IDLE(xchunk_ptr) ? XCHUNK_LIST_IDLE : XCHUNK_LIST_PART))
 
 /**
- * @struct xslice_array_t
- * @brief  分片数组块。其作为 xslice_rqueue_t 的链表节点块。
+ * @struct xchunk_list_t
+ * @brief  chunk 对象的双向链表（首尾为伪 chunk 节点）。
  */
-typedef struct xslice_array_t
+typedef struct xchunk_list_t
 {
-    xslice_arrptr_t  xarray_prev;  ///< 前驱节点
-    xslice_arrptr_t  xarray_next;  ///< 后继节点
-    xmem_slice_t     xslice_aptr[XSLICE_ARRAY_SIZE]; ///< 分片数组
-} xslice_array_t;
+    xchunk_alias_t  xlist_head;    ///< 双向链表的头部伪 chunk 节点
+    xchunk_alias_t  xlist_tail;    ///< 双向链表的尾部伪 chunk 节点
+} xchunk_list_t;
+
+/** 分片弹匣的槽位数量（参看 XMPOOL_FLAG_MAGAZINE） */
+#define XCLASS_MAGAZINE_SLOTS   32
 
-typedef volatile x_uint32_t      xatomic_size_t;
-typedef volatile xslice_arrptr_t xatomic_arrptr_t;
+/** 单个分片弹匣所缓存的分片总大小上限（大分片的分类，弹匣容量相应减少） */
+#define XCLASS_MAGAZINE_BYTES   (32 * 1024)
 
 /**
- * @struct xslice_rqueue_t
- * @brief  用于存储 待回收的内存分片 的队列。
+ * @struct xmem_class_t
+ * @brief  内存分类的结构体描述信息。
  */
-typedef struct xslice_rqueue_t
+typedef struct xmem_class_t
 {
-    xatomic_size_t   xqueue_size;   ///< 队列中的分片数量
-    xatomic_arrptr_t xarray_sptr;   ///< 用于保存临时分片数组块（备用缓存块）
+    x_uint32_t      xchunk_size;   ///< 内存块大小（第 xchunk_step 级的大小，参看 xclass_chunk_size()）
+    x_uint32_t      xslice_size;   ///< 内存分片大小
+
+    x_uint32_t      xchunk_base;   ///< 第 0 级的内存块大小
+    x_uint32_t      xchunk_limit;  ///< 内存块大小的上限（与 xchunk_base 相等时，大小固定）
+    x_uint32_t      xchunk_step;   ///< xchunk_size 所对应的级数
+
+    x_uint32_t      xchunk_count;  ///< 内存块数量
+    x_uint32_t      xslice_count;  ///< 可用的（未被分配出去的）内存分片数量
 
-    x_uint32_t       xarray_bpos;   ///< 队列中的起始位置
-    xslice_arrptr_t  xarray_bptr;   ///< 分片数组块链表的起始块
+    xmpool_handle_t xmpool_ptr;    ///< 持有当前 内存分类 对象的 内存池
+    xchunk_handle_t xchunk_rptr;   ///< 最近一次回收分片的 chunk 对象（供 xmpool_recyc_sized() 优先匹配）
+
+    x_uint32_t      xidle_count;   ///< XCHUNK_LIST_IDLE 链表中的 chunk 对象数量
+    x_bool_t        xbt_lifo;      ///< chunk 对象的分片队列是否按 后进先出 分配（参看 xmpool_set_lifo()）
+    x_uint32_t      xmag_count;    ///< 分片弹匣中的分片数量
+    x_uint32_t      xmag_limit;    ///< 分片弹匣的容量（不大于 XCLASS_MAGAZINE_SLOTS）
+
+    /**
+     * @brief 统计计数（参看 xmpool_stats()）：只在工作线程中更新，不使用原子操作，
+     *        其他线程回收的分片，在工作线程取回时才计入 xstat_free。
+     */
+    x_uint64_t      xstat_alloc;   ///< 累计申请的分片数量
+    x_uint64_t      xstat_free;    ///< 累计回收的分片数量
+    x_uint64_t      xstat_slow;    ///< 申请时 xchunk_cptr 未命中（进入慢速路径）的次数
+    x_uint64_t      xstat_round;   ///< 申请大小向上对齐到分片大小所累计损失的字节数
+
+    xchunk_list_t   xlist[XCHUNK_LIST_COUNT]; ///< 各个状态的 chunk 链表（参看 xchunk_list_index）
+
+    /**
+     * @brief 分片弹匣（栈）：可直接分配的分片，在 chunk 对象中仍标识为“已分配”。
+     */
+    xmem_slice_t    xmag_slice[XCLASS_MAGAZINE_SLOTS];
+} xmem_class_t;
 
-    x_uint32_t       xarray_epos;   ///< 队列中的终点位置
-    xslice_arrptr_t  xarray_eptr;   ///< 分片数组块链表的终点块
-} xslice_rqueue_t;
+/** 更新 class 对象的申请计数（xut_count 个分片，每个的申请大小均为 xut_size） */
+#define XCLASS_STAT_ALLOC(xclass_ptr, xut_count, xut_size)                             \
+    do                                                                                  \
+    {                                                                                   \
+        (xclass_ptr)->xstat_alloc += (xut_count);                                       \
+        (xclass_ptr)->xstat_round +=                                                    \
+            (x_uint64_t)(xut_count) * ((xclass_ptr)->xslice_size - (xut_size));         \
+    } while (0)
+
+#define XCLASS_LIST_HEAD(xclass_ptr, xindex)  ((xchunk_handle_t)&(xclass_ptr)->xlist[xindex].xlist_head)
+#define XCLASS_LIST_FRONT(xclass_ptr, xindex) ((xclass_ptr)->xlist[xindex].xlist_head.xlist_node.xchunk_next)
+#define XCLASS_LIST_BACK(xclass_ptr, xindex)  ((xclass_ptr)->xlist[xindex].xlist_tail.xlist_node.xchunk_prev)
+#define XCLASS_LIST_TAIL(xclass_ptr, xindex)  ((xchunk_handle_t)&(xclass_ptr)->xlist[xindex].xlist_tail)
+#define XCLASS_LIST_EMPTY(xclass_ptr, xindex) \
+    (XCLASS_LIST_FRONT(xclass_ptr, xindex) == XCLASS_LIST_TAIL(xclass_ptr, xindex))
 
 #define XMPOOL_RBTREE_SIZE    (16 * sizeof(x_handle_t))
 
@@ -395,15 +604,59 @@ typedef struct xmem_pool_t
 {
     xfunc_alloc_t   xfunc_alloc;   ///< 申请堆内存块的接口
     xfunc_free_t    xfunc_free;    ///< 释放堆内存块的接口
+    xfunc_resize_t  xfunc_resize;  ///< 原地调整堆内存块大小的接口（可为 X_NULL）
     x_handle_t      xht_context;   ///< 调用 xfunc_alloc/xfunc_free 时回调的上下文句柄
+    x_uint32_t      xut_flags;     ///< 工作模式标识位（参看 @see xmpool_flags 枚举值）
 
     x_uint64_t      xsize_cached;  ///< 总共缓存的内存大小
     x_uint64_t      xsize_valid;   ///< 可使用到的缓存大小
     x_uint64_t      xsize_using;   ///< 正在使用的缓存大小
+    x_uint64_t      xsize_idle;    ///< 所有 空闲 chunk 对象（无分片被分配出去）的总大小
+    x_uint64_t      xsize_pgpurged;///< 非空闲 chunk 对象中，按分页归还了物理内存的总大小（参看 xmpool_purge_pages()）
+
+    x_uint32_t      xidle_chunks;  ///< 每个分类最多保留的 空闲 chunk 对象数量
+    x_uint64_t      xidle_bytes;   ///< 内存池最多保留的 空闲 chunk 对象总大小
+    xclass_handle_t xclass_trim;   ///< 有 chunk 对象新转入 空闲 状态、待检查保留上限的 class 对象
+
+    /**
+     * @brief 空闲 chunk 对象按时间衰减归还系统的状态信息（参看 xmpool_tick()）。
+     * @note
+     * 空闲 chunk 对象分两个阶段归还：先归还物理内存（dirty -> purged），再释放地址空间；
+     * 每个阶段允许保留的大小，都按半衰期 xdecay_ms 随时间衰减，
+     * 上次衰减操作后新进入该阶段的大小，则全部计入允许保留的大小。
+     */
+    x_uint64_t      xsize_purged;  ///< 空闲 chunk 对象中，物理内存已归还系统的总大小
+    x_uint32_t      xdecay_ms;     ///< 衰减的半衰期（毫秒，为 0 时不进行衰减归还）
+    x_uint64_t      xdecay_tick;   ///< 上次衰减操作的时间点（毫秒）
+    x_uint64_t      xdecay_dirty;  ///< 允许保留的（未归还物理内存的）空闲 chunk 对象总大小
+    x_uint64_t      xdecay_muzzy;  ///< 允许保留的（已归还物理内存的）空闲 chunk 对象总大小
+    x_uint64_t      xdirty_added;  ///< 上次衰减操作后，新转入 空闲 状态的 chunk 对象总大小
+    x_uint64_t      xmuzzy_added;  ///< 上次衰减操作后，新归还物理内存的 chunk 对象总大小
+
+    /**
+     * @brief 大块缓存：被回收的（非分类管理的）大块 chunk 对象，
+     *        链表头部为最近回收的，供之后申请大块分片时按最佳适配复用。
+     */
+    xchunk_list_t   xlarge_list;
+    x_uint32_t      xlarge_count;  ///< 大块缓存中的 chunk 对象数量
+    x_uint64_t      xlarge_bytes;  ///< 大块缓存中的 chunk 对象总大小
+    x_uint64_t      xlarge_limit;  ///< 大块缓存的总大小上限（为 0 时不缓存）
+    x_uint64_t      xdecay_large;  ///< 允许保留的大块缓存总大小（按半衰期衰减）
+    x_uint64_t      xlarge_added;  ///< 上次衰减操作后，新放入大块缓存的 chunk 对象总大小
+    x_uint64_t      xstat_lalloc;  ///< 累计申请的大块分片数量（参看 xmpool_stats()）
+    x_uint64_t      xstat_lfree;   ///< 累计回收的大块分片数量（参看 xmpool_stats()）
+
+    xmprof_handle_t xprof_ptr;     ///< 堆内存剖析器（参看 xmpool_set_profiler()），为 X_NULL 时不采样
+    x_int64_t       xprof_left;    ///< 距离下一次采样的字节数
+    x_uint64_t      xprof_seed;    ///< 采样间隔的随机数状态
 
     x_uint32_t      xut_worktid;   ///< 隶属的工作线程 ID
-    xatomic_lock_t  xspinlock_que; ///< 队列操作的同步旋转锁
-    xslice_rqueue_t xslice_rqueue; ///< 待回收的内存分片 的队列
+    xatomic_lock_t  xspinlock_tree;///< 其他线程查找 chunk 时，与红黑树 插入/删除 操作互斥的旋转锁
+
+    /**
+     * @brief 存在待回收分片（由其他线程投递）的 chunk 对象链表（无锁栈）。
+     */
+    volatile xchunk_handle_t xchunk_rlist;
 
     xchunk_handle_t xchunk_cptr;   ///< 记录当前操作的 chunk 对象
 
@@ -415,16 +668,88 @@ typedef struct xmem_pool_t
     x_byte_t xbt_ptr[XMPOOL_RBTREE_SIZE]; ///< 此字段仅起到内存占位的作用
     } xrbtree;
 
-    xmem_class_t    xclass_ptr[XSLICE_TYPE_COUNT]; ///< 各个内存分类
+    /**
+     * @brief 分类表的信息：默认分类表的分类索引表指向 X_class_index_table，
+     *        自定义分类表（参看 xmpool_create_classes()）的则在创建时生成。
+     */
+    x_uint32_t      xclass_count;  ///< 内存分类的数量
+    x_uint32_t      xslice_max;    ///< 最大的分类分片大小（更大的分片按大块 chunk 对象管理）
+    const x_uint8_t * xclass_index;///< 分类索引表（下标为 (xut_size + 7) >> 3，值为分类索引号）
+
+    xmem_class_t    xclass_ptr[XMPOOL_CLASS_MAX_COUNT]; ///< 各个内存分类
 } xmem_pool_t;
 
 #define XMPOOL_RBTREE(xmpool_ptr) ((x_rbtree_ptr)(xmpool_ptr)->xrbtree.xbt_ptr)
 
+/** 判断内存池对象是否工作在 XMPOOL_FLAG_ALIGN_CHUNK 模式下 */
+#define XMPOOL_IS_ALIGNED(xmpool_ptr) \
+    (0 != ((xmpool_ptr)->xut_flags & XMPOOL_FLAG_ALIGN_CHUNK))
+
+/** 判断内存池对象是否工作在 XMPOOL_FLAG_CACHE_ALIGN 模式下 */
+#define XMPOOL_IS_CACHE_ALIGNED(xmpool_ptr) \
+    (0 != ((xmpool_ptr)->xut_flags & XMPOOL_FLAG_CACHE_ALIGN))
+
+/** 判断内存池对象是否工作在 XMPOOL_FLAG_MAGAZINE 模式下 */
+#define XMPOOL_USE_MAGAZINE(xmpool_ptr) \
+    (0 != ((xmpool_ptr)->xut_flags & XMPOOL_FLAG_MAGAZINE))
+
+/** 分片被回收时，删除其采样记录（只在工作线程中调用，chunk 对象无采样分片时不查找） */
+#define XCHUNK_PROF_ERASE(xmpool_ptr, xchunk_ptr, xmem_slice)           \
+    do                                                                  \
+    {                                                                   \
+        if ((0 != (xchunk_ptr)->xut_sampled) &&                         \
+            (X_NULL != (xmpool_ptr)->xprof_ptr) &&                      \
+            xmprof_erase((xmpool_ptr)->xprof_ptr, (xmem_slice)))        \
+        {                                                               \
+            (xchunk_ptr)->xut_sampled -= 1;                             \
+        }                                                               \
+    } while (0)
+
+/**
+ * 内存池对象实际用于选取分类的分片大小：
+ * XMPOOL_FLAG_CACHE_ALIGN 模式下，不小于缓存行的大小向上对齐到缓存行，
+ * 以选中分片大小为缓存行整数倍的分类。
+ */
+#define XMPOOL_CLASS_SIZE(xmpool_ptr, xut_size)                     \
+    ((XMPOOL_IS_CACHE_ALIGNED(xmpool_ptr) &&                        \
+      ((xut_size) >= XMPOOL_CACHE_LINE) &&                          \
+      ((xut_size) <= (xmpool_ptr)->xslice_max)) ?                   \
+        X_ALIGN((xut_size), XMPOOL_CACHE_LINE) : (xut_size))
+
+/** 最大分片大小为 xslice_max 时，分类索引表的项数 */
+#define XMPOOL_INDEX_SLOTS(xslice_max)  (((xslice_max) >> XSLICE_INDEX_SHIFT) + 1)
+
+/** 通过内存池对象的分类索引表，将（不大于 xslice_max 的）内存大小映射到分类索引号 */
+#define XMPOOL_CLASS_INDEX(xmpool_ptr, xut_size)                    \
+    (xmpool_ptr)->xclass_index[((xut_size) + (1 << XSLICE_INDEX_SHIFT) - 1) >> XSLICE_INDEX_SHIFT]
+
+#define XMPOOL_LARGE_HEAD(xmpool_ptr)  ((xchunk_handle_t)&(xmpool_ptr)->xlarge_list.xlist_head)
+#define XMPOOL_LARGE_FRONT(xmpool_ptr) ((xmpool_ptr)->xlarge_list.xlist_head.xlist_node.xchunk_next)
+#define XMPOOL_LARGE_BACK(xmpool_ptr)  ((xmpool_ptr)->xlarge_list.xlist_tail.xlist_node.xchunk_prev)
+#define XMPOOL_LARGE_TAIL(xmpool_ptr)  ((xchunk_handle_t)&(xmpool_ptr)->xlarge_list.xlist_tail)
+
+/**
+ * 大块 chunk 对象是否在大块缓存中（大块 chunk 对象不挂入 class 链表，
+ * 其链表节点只用于大块缓存）。
+ */
+#define XCHUNK_IS_CACHED(xchunk_ptr) (X_NULL != (xchunk_ptr)->xlist_node.xchunk_prev)
+
+/**
+ * 复用大块缓存中的 chunk 对象时，允许的尾部余量（按所需大小的比例，1/4）；
+ * 余量更大时，先尝试经 xfunc_resize 接口原地收缩，否则不复用。
+ */
+#define XMPOOL_LARGE_SLACK(xchunk_size)  ((xchunk_size) / 4)
+
+/** 以地址掩码的方式，计算分片可能所在的（按 XMPOOL_CHUNK_ALIGN 对齐的）chunk 对象 */
+#define XCHUNK_MASKED(xmem_slice) \
+    ((xchunk_handle_t)((x_size_t)(xmem_slice) & ~((x_size_t)XMPOOL_CHUNK_ALIGN - 1)))
+
 ////////////////////////////////////////////////////////////////////////////////
 
 /**********************************************************/
 /**
- * @brief 默认的 堆内存块 申请接口。
+ * @brief 默认的 堆内存块 申请接口（返回按 XMEM_PAGE_SIZE 对齐的内存块，
+ *        参看 xmpool_alloc_aligned()）。
  * 
  * @param [in ] xst_size    : 请求的堆内存块大小。
  * @param [in ] xht_owner   : 持有该（返回的）堆内存块的标识句柄。
@@ -438,7 +763,13 @@ static x_void_t * xmem_heap_alloc(x_size_t xst_size,
                                   x_handle_t xht_owner,
                                   x_handle_t xht_context)
 {
-    return xmem_alloc(xst_size);
+#ifdef _MSC_VER
+    // HeapAlloc() 返回的地址并不按页对齐
+    return xsys_heap_alloc_aligned(xst_size, XMEM_PAGE_SIZE);
+#else // !_MSC_VER
+    // mmap() 返回的地址已按页对齐，无需多映射再裁剪
+    return xsys_heap_alloc(xst_size);
+#endif // _MSC_VER
 }
 
 /**********************************************************/
@@ -456,7 +787,56 @@ static x_void_t xmem_heap_free(x_void_t * xchunk_ptr,
                                x_handle_t xht_context)
 {
     if (X_NULL != xchunk_ptr)
-        xmem_free(xchunk_ptr);
+    {
+#ifdef _MSC_VER
+        xsys_heap_free_aligned(xchunk_ptr, xst_size);
+#else // !_MSC_VER
+        xsys_heap_free(xchunk_ptr, xst_size);
+#endif // _MSC_VER
+    }
+}
+
+/**********************************************************/
+/**
+ * @brief 默认的 堆内存块 原地调整大小的接口（xmem_heap_alloc() 与
+ *        xmem_heap_alloc_aligned() 申请的内存块均适用）。
+ */
+static x_bool_t xmem_heap_resize(x_void_t * xchunk_ptr,
+                                 x_size_t xst_size,
+                                 x_size_t xst_resize,
+                                 x_handle_t xht_owner,
+                                 x_handle_t xht_context)
+{
+#ifdef _MSC_VER
+    return xsys_heap_resize(xchunk_ptr, xst_size, xst_resize, X_TRUE);
+#else // !_MSC_VER
+    return xsys_heap_resize(xchunk_ptr, xst_size, xst_resize, X_FALSE);
+#endif // _MSC_VER
+}
+
+/**********************************************************/
+/**
+ * @brief XMPOOL_FLAG_ALIGN_CHUNK 模式下，默认的 堆内存块 申请接口
+ *        （返回按 XMPOOL_CHUNK_ALIGN 对齐的内存块）。
+ */
+static x_void_t * xmem_heap_alloc_aligned(x_size_t xst_size,
+                                          x_handle_t xht_owner,
+                                          x_handle_t xht_context)
+{
+    return xsys_heap_alloc_aligned(xst_size, XMPOOL_CHUNK_ALIGN);
+}
+
+/**********************************************************/
+/**
+ * @brief XMPOOL_FLAG_ALIGN_CHUNK 模式下，默认的 堆内存块 释放接口。
+ */
+static x_void_t xmem_heap_free_aligned(x_void_t * xchunk_ptr,
+                                       x_size_t xst_size,
+                                       x_handle_t xht_owner,
+                                       x_handle_t xht_context)
+{
+    if (X_NULL != xchunk_ptr)
+        xsys_heap_free_aligned(xchunk_ptr, xst_size);
 }
 
 /**********************************************************/
@@ -468,9 +848,9 @@ static inline x_uint32_t xmem_chunk_unused_size(
                                     x_uint32_t xslice_size)
 {
     XASSERT(xchunk_size >=
-            (sizeof(xmem_chunk_t) + sizeof(x_uint16_t) + xslice_size));
+            (XCHUNK_HEAD_SIZE(xchunk_size, xslice_size) + sizeof(x_uint16_t) + xslice_size));
 
-    xchunk_size -= sizeof(xmem_chunk_t);
+    xchunk_size -= XCHUNK_HEAD_SIZE(xchunk_size, xslice_size);
     xslice_size += sizeof(x_uint16_t  );
 
 	return (xchunk_size - (xchunk_size / xslice_size * xslice_size));
@@ -485,9 +865,9 @@ static inline x_uint32_t xmem_chunk_capacity(
                                     x_uint32_t xslice_size)
 {
     XASSERT(xchunk_size >=
-            (sizeof(xmem_chunk_t) + sizeof(x_uint16_t) + xslice_size));
+            (XCHUNK_HEAD_SIZE(xchunk_size, xslice_size) + sizeof(x_uint16_t) + xslice_size));
 
-	return ((xchunk_size - sizeof(xmem_chunk_t)) /
+	return ((xchunk_size - XCHUNK_HEAD_SIZE(xchunk_size, xslice_size)) /
             (xslice_size + sizeof(x_uint16_t  )));
 }
 
@@ -497,73 +877,147 @@ static inline x_uint32_t xmem_chunk_capacity(
  */
 x_uint32_t xmem_align_size(x_uint32_t xut_size)
 {
-    static x_uint32_t xsize_align_8[32] =
+    if (xut_size <= XSLICE_SIZE_65536)
     {
-          8,  16,  24,  32,  40,  48,  56,  64,
-         72,  80,  88,  96, 104, 112, 120, 128,
-        144, 144, 160, 160, 176, 176, 192, 192,
-        208, 208, 224, 224, 240, 240, 256, 256
-    };
+        if (xut_size <= 0)
+            return 0;
+        return X_slice_size_table[XSLICE_CLASS_INDEX(xut_size)];
+    }
 
-    static x_uint32_t xsize_align_32[24] =
-    {
-        288, 320, 352, 384, 416, 448,  480,  512, 
-        576, 576, 640, 640, 704, 704,  768,  768, 
-        832, 832, 896, 896, 960, 960, 1024, 1024
-    };
+    return X_ALIGN(xut_size, XMEM_PAGE_SIZE);
+}
+
+static x_uint32_t xmpool_class_chunk_size(x_uint32_t xslice_size,
+                                          x_uint32_t xut_lower,
+                                          x_uint32_t xut_upper);
+
+/**********************************************************/
+/**
+ * @brief 按分片大小计算分类的 chunk 对象方案。
+ * 
+ * @param [in ] xslice_size : 分片大小（不大于 XMPOOL_CLASS_MAX_SIZE）。
+ * @param [out] xchunk_size : 返回 chunk 对象大小（可为 X_NULL）。
+ * @param [out] xut_unused  : 返回 chunk 对象中未使用到的字节数（可为 X_NULL）。
+ * 
+ * @return x_uint32_t
+ *         - 返回 chunk 对象可容纳的分片数量（xslice_size 无效时，返回 0）。
+ */
+x_uint32_t xmem_chunk_layout(x_uint32_t xslice_size,
+                             x_uint32_t * xchunk_size,
+                             x_uint32_t * xut_unused)
+{
+    x_uint32_t xut_chunk = 0;
 
-    static x_uint32_t xsize_align_128[24] =
+    if ((xslice_size <= 0) || (xslice_size > XMPOOL_CLASS_MAX_SIZE))
     {
-        1152, 1280, 1408, 1536, 1664, 1792, 1920, 2048,
-        2304, 2304, 2560, 2560, 2816, 2816, 3072, 3072,
-        3328, 3328, 3584, 3584, 3840, 3840, 4096, 4096
-    };
+        return 0;
+    }
+
+    xut_chunk = xmpool_class_chunk_size(xslice_size,
+                                        XMPOOL_CHUNK_ALIGN / 4,
+                                        XMPOOL_CHUNK_ALIGN);
+
+    if (X_NULL != xchunk_size)
+        *xchunk_size = xut_chunk;
+    if (X_NULL != xut_unused)
+        *xut_unused = xmem_chunk_unused_size(xut_chunk, xslice_size);
+
+    return xmem_chunk_capacity(xut_chunk, xslice_size);
+}
+
+/**********************************************************/
+/**
+ * @brief 从文本中解析分类表（每行“分片大小 chunk大小”，'#' 开头的行为注释）。
+ * 
+ * @param [in ] xtext_ptr    : 以 '\0' 结尾的文本。
+ * @param [out] xclass_table : 存放解析结果的分类表。
+ * @param [in ] xut_max      : xclass_table 的容量（分类数量）。
+ * 
+ * @return x_uint32_t
+ *         - 返回解析到的分类数量；文本格式错误或分类数量超出 xut_max 时，返回 0。
+ */
+x_uint32_t xmpool_parse_classes(const x_char_t * xtext_ptr,
+                                xmpool_class_t * xclass_table,
+                                x_uint32_t xut_max)
+{
+    x_uint32_t xut_count = 0;
+    x_uint32_t xut_field = 0;
+    x_uint32_t xut_value[2];
 
-    static x_uint32_t xsize_align_512[24] =
+    if ((X_NULL == xtext_ptr) || (X_NULL == xclass_table))
     {
-         4608,  5120,  5632,  6144,  6656,  7168,  7680,  8192, 
-         9216,  9216, 10240, 10240, 11264, 11264, 12288, 12288, 
-        13312, 13312, 14336, 14336, 15360, 15360, 16384, 16384
-    };
+        return 0;
+    }
 
-    static x_uint32_t xsize_align_2048[24] =
+    while ('\0' != *xtext_ptr)
     {
-        18432, 20480, 22528, 24576, 26624, 28672, 30720, 32768,
-        36864, 36864, 40960, 40960, 45056, 45056, 49152, 49152,
-        53248, 53248, 57344, 57344, 61440, 61440, 65536, 65536
-    };
+        //======================================
+        // 逐行解析：跳过空白与注释，至多读取两个十进制数值
 
-#define X_INDEX(size, shift) ((((size) + (1 << (shift)) - 1) >> (shift)) - 1)
+        xut_field = 0;
 
-    if (xut_size <= 1024)
-    {
-        if (xut_size <= 256)
+        while ((' ' == *xtext_ptr) || ('\t' == *xtext_ptr) || ('\r' == *xtext_ptr))
+            ++xtext_ptr;
+
+        if ('#' == *xtext_ptr)
         {
-            if (xut_size <= 0)
+            while (('\0' != *xtext_ptr) && ('\n' != *xtext_ptr))
+                ++xtext_ptr;
+        }
+
+        while (('\0' != *xtext_ptr) && ('\n' != *xtext_ptr))
+        {
+            if ((*xtext_ptr < '0') || (*xtext_ptr > '9') || (xut_field >= 2))
+            {
                 return 0;
-            return xsize_align_8[X_INDEX(xut_size, 3)];
+            }
+
+            xut_value[xut_field] = 0;
+            while ((*xtext_ptr >= '0') && (*xtext_ptr <= '9'))
+            {
+                if (xut_value[xut_field] > ((0xFFFFFFFF - 9) / 10))
+                    return 0;
+                xut_value[xut_field] = xut_value[xut_field] * 10 + (x_uint32_t)(*xtext_ptr++ - '0');
+            }
+            xut_field += 1;
+
+            while ((' ' == *xtext_ptr) || ('\t' == *xtext_ptr) || ('\r' == *xtext_ptr))
+                ++xtext_ptr;
         }
-        return xsize_align_32[X_INDEX(xut_size - 256, 5)];
-    }
-    else if (xut_size <= 16384)
-    {
-        if (xut_size <= 4096)
-            return xsize_align_128[X_INDEX(xut_size - 1024, 7)];
-        return xsize_align_512[X_INDEX(xut_size - 4096, 9)];
-    }
-    else if (xut_size <= 65536)
-    {
-        return xsize_align_2048[X_INDEX(xut_size - 16384, 11)];
-    }
 
-    return X_ALIGN(xut_size, XMEM_PAGE_SIZE);
+        if ('\n' == *xtext_ptr)
+        {
+            ++xtext_ptr;
+        }
+
+        //======================================
+
+        if (0 == xut_field)
+        {
+            continue;
+        }
+
+        if (xut_count >= xut_max)
+        {
+            return 0;
+        }
+
+        xclass_table[xut_count].xslice_size = xut_value[0];
+        xclass_table[xut_count].xchunk_size = (xut_field > 1) ? xut_value[1] : 0;
+        xut_count += 1;
+    }
 
-#undef X_INDEX
+    return xut_count;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 
 static inline x_bool_t xmpool_dealloc_chunk(xmpool_handle_t , xchunk_handle_t);
+static x_uint32_t xchunk_rfree_harvest(xchunk_handle_t, x_bool_t);
+static x_uint32_t xmpool_drain_remote(xmpool_handle_t);
+static x_void_t xclass_list_move_chunk(xclass_handle_t, xchunk_handle_t, x_uint32_t);
+static inline x_void_t xclass_idle_enter(xclass_handle_t, xchunk_handle_t);
+static inline x_void_t xclass_idle_leave(xclass_handle_t, xchunk_handle_t);
 
 //====================================================================
 
@@ -596,433 +1050,701 @@ static x_bool_t xchunk_find_index(
 
 /**********************************************************/
 /**
- * @brief 从 chunk 对象中申请内存分片。
- * 
- * @param [in ] xchunk_ptr : chunk 对象。
- * 
- * @return xmem_slice_t
- *         - 成功，返回 内存分片；
- *         - 失败，返回 X_NULL，chunk 对象的分片队列已经为空。
+ * @brief 分片被分配出去时，清除其所覆盖的（已归还物理内存的）分页标识位，
+ *        这些分页在被访问时由系统重新提供（内容为 0）。
  */
-static xmem_slice_t xchunk_alloc_slice(xchunk_handle_t xchunk_ptr)
+static x_void_t xchunk_page_revive(xchunk_handle_t xchunk_ptr, x_uint32_t xut_index)
 {
-    x_uint16_t xut_index = 0;
+    xmem_slice_t xmem_slice = XSLICE_QUEUE_GET(xchunk_ptr, xut_index);
+    x_uint64_t * xpage_bits = XCHUNK_PAGE_BITS(xchunk_ptr);
+    x_uint32_t   xut_page   = XCHUNK_PAGE_INDEX(xchunk_ptr, xmem_slice);
+    x_uint32_t   xut_last   = XCHUNK_PAGE_INDEX(xchunk_ptr, xmem_slice + xchunk_ptr->xslice_size - 1);
+    x_uint32_t   xut_count  = 0;
 
-    if (XSLICE_QUEUE_IS_EMPTY(xchunk_ptr))
+    XASSERT(xut_last < 64 * XCHUNK_PAGE_WORDS(xchunk_ptr->xchunk_size, xchunk_ptr->xslice_size));
+
+    for (; xut_page <= xut_last; ++xut_page)
     {
-        return X_NULL;
+        if (XCHUNK_PAGE_IS_PURGED(xpage_bits, xut_page))
+        {
+            xpage_bits[xut_page >> 6] &= ~(1ULL << (xut_page & 63));
+            xut_count += 1;
+        }
     }
 
-    xut_index = XSLICE_QUEUE_INDEX_GET(
-                    xchunk_ptr, XSLICE_QUEUE(xchunk_ptr).xut_bpos, x_uint16_t);
-
-    XASSERT(xut_index < XSLICE_QUEUE_CAPACITY(xchunk_ptr));
-    XASSERT(!XSLICE_QUEUE_IS_ALLOCATED(xchunk_ptr, xut_index, x_uint16_t));
-
-    // 设置分片“已被分配出去”的标识位
-    XSLICE_QUEUE_ALLOCATED_SET(xchunk_ptr, xut_index, x_uint16_t);
-
-    XSLICE_QUEUE(xchunk_ptr).xut_bpos += 1;
-    XASSERT(0 != XSLICE_QUEUE(xchunk_ptr).xut_bpos);
-
-    xchunk_ptr->xowner.xclass_ptr->xslice_count -= 1;
+    XASSERT(xchunk_ptr->xpage_purged >= xut_count);
+    xchunk_ptr->xpage_purged -= (x_uint16_t)xut_count;
+    xchunk_ptr->xowner.xclass_ptr->xmpool_ptr->xsize_pgpurged -=
+                                (x_uint64_t)xut_count * XMEM_PAGE_SIZE;
+}
 
-    return XSLICE_QUEUE_GET(xchunk_ptr, xut_index);
+/**********************************************************/
+/**
+ * @brief 清除 chunk 对象所有分页的标识位（整个 chunk 对象被归还或释放时调用）。
+ */
+static inline x_void_t xchunk_page_reset(
+                            xmpool_handle_t xmpool_ptr,
+                            xchunk_handle_t xchunk_ptr)
+{
+    if (0 != xchunk_ptr->xpage_purged)
+    {
+        xmpool_ptr->xsize_pgpurged -=
+            (x_uint64_t)xchunk_ptr->xpage_purged * XMEM_PAGE_SIZE;
+        xchunk_ptr->xpage_purged = 0;
+        xmem_clear(XCHUNK_PAGE_BITS(xchunk_ptr),
+                   sizeof(x_uint64_t) * XCHUNK_PAGE_WORDS(xchunk_ptr->xchunk_size,
+                                                          xchunk_ptr->xslice_size));
+    }
 }
 
 /**********************************************************/
 /**
- * @brief 回收内存分片至 chunk 对象中。
+ * @brief 将 chunk 对象中，被连续的空闲分片完整覆盖的分页，归还物理内存。
+ * @note
+ * 空闲分片包括：分片队列中的（被回收的）与高水位线之上（从未被分配过）的；
+ * 已标识的分页不重复处理，也不重复计数。
  * 
- * @param [in ] xchunk_ptr : chunk 对象。
- * @param [in ] xmem_slice : 待回收的内存分片。
+ * @param [in ] xchunk_ptr : chunk 对象（分片大小不小于 XMEM_PAGE_SIZE）。
  * 
- * @return x_int32_t
- *         - 成功，返回 XMEM_ERR_OK；
- *         - 失败，返回 错误码。
+ * @return x_uint32_t
+ *         - 返回本次新归还物理内存的分页数量。
  */
-static x_int32_t xchunk_recyc_slice(
-                    xchunk_handle_t xchunk_ptr,
-                    xmem_slice_t xmem_slice)
+static x_uint32_t xchunk_purge_pages(xchunk_handle_t xchunk_ptr)
 {
-    XASSERT((xmem_slice > XCHUNK_LADDR(xchunk_ptr)) &&
-            (xmem_slice < XCHUNK_RADDR(xchunk_ptr)));
-    XASSERT(XSLICE_QUEUE_CAPACITY(xchunk_ptr) > 0);
-    XASSERT(!XSLICE_QUEUE_IS_FULL(xchunk_ptr, x_uint16_t));
+    XASSERT(XCHUNK_PAGE_PURGEABLE(xchunk_ptr->xslice_size));
 
-    x_int32_t  xit_error  = XMEM_ERR_UNKNOW;
-    x_uint32_t xut_offset = 0;
-    x_uint32_t xut_index  = 0;
+    x_uint32_t xut_iter  = 0;
+    x_uint32_t xut_bidx  = 0;
+    x_uint32_t xut_page  = 0;
+    x_uint32_t xut_lpage = 0;
+    x_uint32_t xut_rpage = 0;
+    x_uint32_t xut_begin = 0;
+    x_uint32_t xut_count = 0;
 
-    do
-    {
-        //======================================
+    const x_uint32_t xut_capacity = XSLICE_QUEUE_CAPACITY(xchunk_ptr);
+    x_uint64_t * const xpage_bits = XCHUNK_PAGE_BITS(xchunk_ptr);
 
-        xut_offset = (x_uint32_t)(xmem_slice - XCHUNK_LADDR(xchunk_ptr));
-        if (xut_offset < XSLICE_QUEUE(xchunk_ptr).xut_offset)
-        {
-            xit_error = XMEM_ERR_UNALIGNED;
-            break;
-        }
+#define XCHUNK_SLICE_IS_FREE(xut_index)             \
+    (((xut_index) >= xchunk_ptr->xut_carve) ||      \
+     !XSLICE_QUEUE_IS_ALLOCATED(xchunk_ptr, (xut_index), x_uint16_t))
 
-        xut_offset -= XSLICE_QUEUE(xchunk_ptr).xut_offset;
-        if (0 != (xut_offset % XSLICE_MSIZE(xchunk_ptr)))
+    while (xut_iter < xut_capacity)
+    {
+        if (!XCHUNK_SLICE_IS_FREE(xut_iter))
         {
-            xit_error = XMEM_ERR_UNALIGNED;
-            break;
+            xut_iter += 1;
+            continue;
         }
 
         //======================================
+        // 连续空闲分片 [xut_bidx, xut_iter) 所完整覆盖的分页为 [xut_lpage, xut_rpage)
 
-        xut_index = xut_offset / xchunk_ptr->xslice_size;
-        XASSERT(xut_index < XSLICE_QUEUE_CAPACITY(xchunk_ptr));
-
-        // 判断分片是否已经被回收
-        if (!XSLICE_QUEUE_IS_ALLOCATED(xchunk_ptr, xut_index, x_uint16_t))
+        xut_bidx = xut_iter;
+        while ((xut_iter < xut_capacity) && XCHUNK_SLICE_IS_FREE(xut_iter))
         {
-            xit_error = XMEM_ERR_RECYCLED;
-            break;
+            xut_iter += 1;
         }
 
-        XASSERT(!xchunk_find_index(xchunk_ptr, (x_uint16_t)xut_index));
-        XSLICE_QUEUE_INDEX_SET(xchunk_ptr,
-                               XSLICE_QUEUE(xchunk_ptr).xut_epos,
-                               xut_index,
-                               x_uint16_t);
-
-        // 标识分片“未被分配出去”
-        XSLICE_QUEUE_ALLOCATED_RESET(xchunk_ptr, xut_index, x_uint16_t);
+        xut_lpage = XCHUNK_PAGE_INDEX(xchunk_ptr,
+                        XSLICE_QUEUE_GET(xchunk_ptr, xut_bidx) + XMEM_PAGE_SIZE - 1);
+        xut_rpage = XCHUNK_PAGE_INDEX(xchunk_ptr,
+                        XSLICE_QUEUE_GET(xchunk_ptr, xut_iter));
 
-        XSLICE_QUEUE(xchunk_ptr).xut_epos += 1;
+        //======================================
+        // 其中未标识的分页，按连续的段归还物理内存
 
-        if (0 == XSLICE_QUEUE(xchunk_ptr).xut_epos)
+        for (xut_page = xut_lpage; xut_page < xut_rpage;)
         {
-            XSLICE_QUEUE(xchunk_ptr).xut_epos =
-                XSLICE_QUEUE_COUNT(xchunk_ptr, x_uint16_t);
+            if (XCHUNK_PAGE_IS_PURGED(xpage_bits, xut_page))
+            {
+                xut_page += 1;
+                continue;
+            }
 
-            XSLICE_QUEUE(xchunk_ptr).xut_bpos %=
-                XSLICE_QUEUE_CAPACITY(xchunk_ptr);
+            xut_begin = xut_page;
+            while ((xut_page < xut_rpage) && !XCHUNK_PAGE_IS_PURGED(xpage_bits, xut_page))
+            {
+                xpage_bits[xut_page >> 6] |= (1ULL << (xut_page & 63));
+                xut_page += 1;
+            }
 
-            XSLICE_QUEUE(xchunk_ptr).xut_epos +=
-                XSLICE_QUEUE(xchunk_ptr).xut_bpos;
-        }
+            xsys_heap_discard(
+                (xmem_handle_t)(((x_size_t)xchunk_ptr & ~((x_size_t)XMEM_PAGE_SIZE - 1)) +
+                                (x_size_t)xut_begin * XMEM_PAGE_SIZE),
+                (x_size_t)(xut_page - xut_begin) * XMEM_PAGE_SIZE);
 
-        xchunk_ptr->xowner.xclass_ptr->xslice_count += 1;
+            xut_count += (xut_page - xut_begin);
+        }
+    }
 
-        //======================================
+#undef XCHUNK_SLICE_IS_FREE
 
-        xit_error = XMEM_ERR_OK;
-    } while (0);
+    xchunk_ptr->xpage_purged += (x_uint16_t)xut_count;
 
-    return xit_error;
+    return xut_count;
 }
 
-//====================================================================
-
-// 
-// xmem_class_t 相关的操作接口
-// 
-
 /**********************************************************/
 /**
- * @brief 将 chunk 对象从分类管理的链表中移除。
+ * @brief 从（非空的）分片队列中取出一个分片的索引号。
+ * @note
+ * 默认按 先进先出 从队首取出；分类设置为 后进先出 时，从队尾取出最近回收的分片，
+ * 紧密的 申请/回收 循环反复使用同一批（仍在 CPU 缓存中的）分片，
+ * 而不是轮转遍历整个 chunk 对象（参看 xmpool_set_lifo()）。
  */
-static x_void_t xclass_list_erase_chunk(
-                            xclass_handle_t xclass_ptr,
-                            xchunk_handle_t xchunk_ptr)
+static inline x_uint16_t xchunk_queue_pop(xchunk_handle_t xchunk_ptr)
 {
-    XASSERT(xclass_ptr == xchunk_ptr->xowner.xclass_ptr);
-    XASSERT(X_NULL != xchunk_ptr->xlist_node.xchunk_prev);
-    XASSERT(X_NULL != xchunk_ptr->xlist_node.xchunk_next);
+    XASSERT(XSLICE_QUEUE_NOT_EMPTY(xchunk_ptr));
 
-    xchunk_ptr->xlist_node.xchunk_prev->xlist_node.xchunk_next =
-        xchunk_ptr->xlist_node.xchunk_next;
-    xchunk_ptr->xlist_node.xchunk_next->xlist_node.xchunk_prev =
-        xchunk_ptr->xlist_node.xchunk_prev;
+    x_uint16_t xut_index = 0;
 
-    xchunk_ptr->xlist_node.xchunk_prev = X_NULL;
-    xchunk_ptr->xlist_node.xchunk_next = X_NULL;
+    if (xchunk_ptr->xowner.xclass_ptr->xbt_lifo)
+    {
+        XSLICE_QUEUE(xchunk_ptr).xut_epos -= 1;
+        xut_index = XSLICE_QUEUE_INDEX_GET(
+                        xchunk_ptr, XSLICE_QUEUE(xchunk_ptr).xut_epos, x_uint16_t);
+    }
+    else
+    {
+        xut_index = XSLICE_QUEUE_INDEX_GET(
+                        xchunk_ptr, XSLICE_QUEUE(xchunk_ptr).xut_bpos, x_uint16_t);
+        XSLICE_QUEUE(xchunk_ptr).xut_bpos += 1;
+        XASSERT(0 != XSLICE_QUEUE(xchunk_ptr).xut_bpos);
+    }
 
-    xclass_ptr->xchunk_count -= 1;
-    xclass_ptr->xslice_count -= XSLICE_QUEUE_COUNT(xchunk_ptr, x_uint16_t);
+    return xut_index;
 }
 
 /**********************************************************/
 /**
- * @brief 将 chunk 对象插入到分类管理的链表头部。
+ * @brief 从 chunk 对象中申请内存分片。
+ * 
+ * @param [in ] xchunk_ptr : chunk 对象。
+ * 
+ * @return xmem_slice_t
+ *         - 成功，返回 内存分片；
+ *         - 失败，返回 X_NULL，chunk 对象的所有分片都已经被分配出去。
  */
-static x_void_t xclass_list_push_head(
-                            xclass_handle_t xclass_ptr,
-                            xchunk_handle_t xchunk_ptr)
+static xmem_slice_t xchunk_alloc_slice(xchunk_handle_t xchunk_ptr)
 {
-    XASSERT(xclass_ptr == xchunk_ptr->xowner.xclass_ptr);
+    x_uint16_t xut_index = 0;
+    x_bool_t   xbt_idle  = X_FALSE;
 
-    if (XCLASS_LIST_FRONT(xclass_ptr) == xchunk_ptr)
+    if (XSLICE_QUEUE_IS_EMPTY(xchunk_ptr))
     {
-        return;
+        // 本地分片队列为空时，先取回其他线程回收的分片，
+        // 仍为空时，再切分从未被分配过的分片
+        if ((XCHUNK_RFREE_QUIET(xchunk_ptr) ||
+             (0 == xchunk_rfree_harvest(xchunk_ptr, X_FALSE))) &&
+            (xchunk_ptr->xut_carve >= XSLICE_QUEUE_CAPACITY(xchunk_ptr)))
+        {
+            return X_NULL;
+        }
     }
 
-    xchunk_ptr->xlist_node.xchunk_prev = XCLASS_LIST_HEAD(xclass_ptr);
-    xchunk_ptr->xlist_node.xchunk_next = XCLASS_LIST_FRONT(xclass_ptr);
+    xbt_idle = XCHUNK_IS_IDLE(xchunk_ptr);
 
-    XCLASS_LIST_FRONT(xclass_ptr)->xlist_node.xchunk_prev = xchunk_ptr;
-    XCLASS_LIST_HEAD(xclass_ptr)->xlist_node.xchunk_next  = xchunk_ptr;
+    if (XSLICE_QUEUE_NOT_EMPTY(xchunk_ptr))
+    {
+        xut_index = xchunk_queue_pop(xchunk_ptr);
 
-    xclass_ptr->xchunk_count += 1;
-    xclass_ptr->xslice_count += XSLICE_QUEUE_COUNT(xchunk_ptr, x_uint16_t);
-}
+        XASSERT(xut_index < xchunk_ptr->xut_carve);
+        XASSERT(!XSLICE_QUEUE_IS_ALLOCATED(xchunk_ptr, xut_index, x_uint16_t));
+    }
+    else
+    {
+        // 从高水位线处切分（此时该分片的标识位尚未初始化）
+        xut_index = xchunk_ptr->xut_carve++;
+    }
 
-/**********************************************************/
-/**
- * @brief 将 chunk 对象插入到分类管理的链表尾部。
- */
-static x_void_t xclass_list_push_tail(
-                            xclass_handle_t xclass_ptr,
-                            xchunk_handle_t xchunk_ptr)
-{
-    XASSERT(xclass_ptr == xchunk_ptr->xowner.xclass_ptr);
+    // 设置分片“已被分配出去”的标识位（保留该位置上的队列索引号）
+    XSLICE_QUEUE_ALLOCATED_SET(xchunk_ptr, xut_index, x_uint16_t);
 
-    if (XCLASS_LIST_BACK(xclass_ptr) == xchunk_ptr)
+    if (0 != xchunk_ptr->xpage_purged)
     {
-        return;
+        xchunk_page_revive(xchunk_ptr, xut_index);
     }
 
-    xchunk_ptr->xlist_node.xchunk_next = XCLASS_LIST_TAIL(xclass_ptr);
-    xchunk_ptr->xlist_node.xchunk_prev = XCLASS_LIST_BACK(xclass_ptr);
+    xchunk_ptr->xowner.xclass_ptr->xslice_count -= 1;
 
-    XCLASS_LIST_BACK(xclass_ptr)->xlist_node.xchunk_next = xchunk_ptr;
-    XCLASS_LIST_TAIL(xclass_ptr)->xlist_node.xchunk_prev = xchunk_ptr;
+    if (xbt_idle)
+    {
+        xclass_idle_leave(xchunk_ptr->xowner.xclass_ptr, xchunk_ptr);
+    }
 
-    xclass_ptr->xchunk_count += 1;
-    xclass_ptr->xslice_count += XSLICE_QUEUE_COUNT(xchunk_ptr, x_uint16_t);
+    // 分片队列状态变化时，chunk 对象转移至对应的链表
+    if (XCHUNK_IS_BUSY(xchunk_ptr))
+    {
+        xclass_list_move_chunk(
+            xchunk_ptr->xowner.xclass_ptr, xchunk_ptr, XCHUNK_LIST_BUSY);
+    }
+    else if (xbt_idle)
+    {
+        xclass_list_move_chunk(
+            xchunk_ptr->xowner.xclass_ptr, xchunk_ptr, XCHUNK_LIST_PART);
+    }
+
+    return XSLICE_QUEUE_GET(xchunk_ptr, xut_index);
 }
 
 /**********************************************************/
 /**
- * @brief 从分类管理的 class 对象中，获取首个非空（仍可分配到分片）chunk 对象。
+ * @brief 从 chunk 对象中批量申请内存分片。
+ * @note
+ * 先取分片队列中的分片，再从高水位线处顺序切分，
+ * 只在最后更新一次 class 对象的计数与 chunk 对象所在的链表。
+ *
+ * @param [in ] xchunk_ptr : chunk 对象。
+ * @param [in ] xut_count  : 申请的分片数量。
+ * @param [out] xslice_vec : 存放所申请到的分片的数组。
+ *
+ * @return x_uint32_t
+ *         - 返回申请到的分片数量（不大于 xut_count）。
  */
-static xchunk_handle_t xclass_get_non_empty_chunk(xclass_handle_t xclass_ptr)
+static x_uint32_t xchunk_alloc_batch(
+                        xchunk_handle_t xchunk_ptr,
+                        x_uint32_t xut_count,
+                        xmem_slice_t * xslice_vec)
 {
-    xchunk_handle_t xchunk_ptr = X_NULL;
+    x_uint32_t xut_iter  = 0;
+    x_uint16_t xut_index = 0;
+    x_bool_t   xbt_idle  = X_FALSE;
 
-    if ((xclass_ptr->xchunk_count <= 0) || (xclass_ptr->xslice_count <= 0))
+    // 本地分片不足时，先取回其他线程回收的分片
+    if (!XCHUNK_RFREE_QUIET(xchunk_ptr) &&
+        (XCHUNK_FREE_COUNT(xchunk_ptr) < xut_count))
     {
-        return X_NULL;
+        xchunk_rfree_harvest(xchunk_ptr, X_FALSE);
     }
 
-    for (xchunk_ptr  = XCLASS_LIST_FRONT(xclass_ptr);
-         xchunk_ptr != XCLASS_LIST_TAIL(xclass_ptr);
-         xchunk_ptr  = xchunk_ptr->xlist_node.xchunk_next)
+    xbt_idle = XCHUNK_IS_IDLE(xchunk_ptr);
+
+    while ((xut_iter < xut_count) && XSLICE_QUEUE_NOT_EMPTY(xchunk_ptr))
     {
-        if (XSLICE_QUEUE_NOT_EMPTY(xchunk_ptr))
-        {
-            if (xchunk_ptr != XCLASS_LIST_FRONT(xclass_ptr))
-            {
-                xclass_list_erase_chunk(xclass_ptr, xchunk_ptr);
-                xclass_list_push_head(xclass_ptr, xchunk_ptr);
-            }
+        xut_index = xchunk_queue_pop(xchunk_ptr);
 
-            return xchunk_ptr;
-        }
+        XASSERT(xut_index < xchunk_ptr->xut_carve);
+        XASSERT(!XSLICE_QUEUE_IS_ALLOCATED(xchunk_ptr, xut_index, x_uint16_t));
+
+        XSLICE_QUEUE_ALLOCATED_SET(xchunk_ptr, xut_index, x_uint16_t);
+        if (0 != xchunk_ptr->xpage_purged)
+            xchunk_page_revive(xchunk_ptr, xut_index);
+        xslice_vec[xut_iter++] = XSLICE_QUEUE_GET(xchunk_ptr, xut_index);
     }
 
-    return X_NULL;
-}
+    while ((xut_iter < xut_count) &&
+           (xchunk_ptr->xut_carve < XSLICE_QUEUE_CAPACITY(xchunk_ptr)))
+    {
+        xut_index = xchunk_ptr->xut_carve++;
 
-//====================================================================
+        XSLICE_QUEUE_ALLOCATED_SET(xchunk_ptr, xut_index, x_uint16_t);
+        if (0 != xchunk_ptr->xpage_purged)
+            xchunk_page_revive(xchunk_ptr, xut_index);
+        xslice_vec[xut_iter++] = XSLICE_QUEUE_GET(xchunk_ptr, xut_index);
+    }
 
-// 
-// xslice_rqueue_t : 分片回收队列的相关操作接口
-// 
+    if (0 == xut_iter)
+    {
+        return 0;
+    }
 
-/**********************************************************/
-/**
- * @brief 初始化 xslice_rqueue_t 对象。
- */
-static x_void_t xsrque_init(xsrque_handle_t xsrque_ptr)
-{
-    xsrque_ptr->xqueue_size = 0;
-    xsrque_ptr->xarray_sptr = X_NULL;
-    xsrque_ptr->xarray_bpos = 0;
-    xsrque_ptr->xarray_bptr = X_NULL;
-    xsrque_ptr->xarray_epos = 0;
-    xsrque_ptr->xarray_eptr = X_NULL;
+    xchunk_ptr->xowner.xclass_ptr->xslice_count -= xut_iter;
+
+    if (xbt_idle)
+    {
+        xclass_idle_leave(xchunk_ptr->xowner.xclass_ptr, xchunk_ptr);
+    }
 
-    xsrque_ptr->xarray_bptr =
-        (xslice_arrptr_t)xmem_heap_alloc(sizeof(xslice_array_t), X_NULL, X_NULL);
-    xsrque_ptr->xarray_eptr = xsrque_ptr->xarray_bptr;
+    if (XCHUNK_IS_BUSY(xchunk_ptr))
+    {
+        xclass_list_move_chunk(
+            xchunk_ptr->xowner.xclass_ptr, xchunk_ptr, XCHUNK_LIST_BUSY);
+    }
+    else if (xbt_idle)
+    {
+        xclass_list_move_chunk(
+            xchunk_ptr->xowner.xclass_ptr, xchunk_ptr, XCHUNK_LIST_PART);
+    }
 
-    XASSERT(X_NULL != xsrque_ptr->xarray_bptr);
+    return xut_iter;
 }
 
 /**********************************************************/
 /**
- * @brief 释放 xslice_rqueue_t 对象的系统资源。
+ * @brief 回收内存分片至 chunk 对象中。
+ * 
+ * @param [in ] xchunk_ptr : chunk 对象。
+ * @param [in ] xmem_slice : 待回收的内存分片。
+ * 
+ * @return x_int32_t
+ *         - 成功，返回 XMEM_ERR_OK；
+ *         - 失败，返回 错误码。
  */
-static x_void_t xsrque_release(xsrque_handle_t xsrque_ptr)
+static x_int32_t xchunk_recyc_slice(
+                    xchunk_handle_t xchunk_ptr,
+                    xmem_slice_t xmem_slice)
 {
-    xslice_arrptr_t xarray_ptr = X_NULL;
-
-    XASSERT(0 == xatomic_add_32(&xsrque_ptr->xqueue_size, 0));
+    XASSERT((xmem_slice > XCHUNK_LADDR(xchunk_ptr)) &&
+            (xmem_slice < XCHUNK_RADDR(xchunk_ptr)));
+    XASSERT(XSLICE_QUEUE_CAPACITY(xchunk_ptr) > 0);
 
-    //======================================
+    x_int32_t  xit_error  = XMEM_ERR_UNKNOW;
+    x_uint32_t xut_offset = 0;
+    x_uint32_t xut_index  = 0;
+    x_bool_t   xbt_busy   = XCHUNK_IS_BUSY(xchunk_ptr);
 
-    while (X_TRUE)
+    do
     {
-        if (xsrque_ptr->xarray_bptr == xsrque_ptr->xarray_eptr)
+        //======================================
+
+        xut_offset = (x_uint32_t)(xmem_slice - XCHUNK_LADDR(xchunk_ptr));
+        if (xut_offset < XSLICE_QUEUE(xchunk_ptr).xut_offset)
         {
-            xmem_heap_free(
-                xsrque_ptr->xarray_bptr, sizeof(xslice_array_t), X_NULL, X_NULL);
+            xit_error = XMEM_ERR_UNALIGNED;
             break;
         }
 
-        xarray_ptr = xsrque_ptr->xarray_bptr;
-        xsrque_ptr->xarray_bptr = xsrque_ptr->xarray_bptr->xarray_next;
-        if (X_NULL != xarray_ptr)
+        xut_offset -= XSLICE_QUEUE(xchunk_ptr).xut_offset;
+        if (0 != (xut_offset % XSLICE_MSIZE(xchunk_ptr)))
         {
-            xmem_heap_free(xarray_ptr, sizeof(xslice_array_t), X_NULL, X_NULL);
+            xit_error = XMEM_ERR_UNALIGNED;
+            break;
         }
-    }
 
-    //======================================
+        //======================================
 
-    xarray_ptr = (xslice_arrptr_t)xatomic_xchg_ptr(
-        (x_void_t * volatile *)&xsrque_ptr->xarray_sptr, (x_void_t *)X_NULL);
+        xut_index = xut_offset / xchunk_ptr->xslice_size;
+        XASSERT(xut_index < XSLICE_QUEUE_CAPACITY(xchunk_ptr));
 
-    if (X_NULL != xarray_ptr)
-    {
-        xmem_heap_free(xarray_ptr, sizeof(xslice_array_t), X_NULL, X_NULL);
-    }
+        // 判断分片是否已经被回收（高水位线之上的分片从未被分配过）
+        if ((xut_index >= xchunk_ptr->xut_carve) ||
+            !XSLICE_QUEUE_IS_ALLOCATED(xchunk_ptr, xut_index, x_uint16_t))
+        {
+            xit_error = XMEM_ERR_RECYCLED;
+            break;
+        }
 
-    //======================================
+        XASSERT(!xchunk_find_index(xchunk_ptr, (x_uint16_t)xut_index));
+        XSLICE_QUEUE_INDEX_SET(xchunk_ptr,
+                               XSLICE_QUEUE(xchunk_ptr).xut_epos,
+                               xut_index,
+                               x_uint16_t);
 
-    xsrque_ptr->xqueue_size = 0;
-    xsrque_ptr->xarray_sptr = X_NULL;
-    xsrque_ptr->xarray_bpos = 0;
-    xsrque_ptr->xarray_bptr = X_NULL;
-    xsrque_ptr->xarray_epos = 0;
-    xsrque_ptr->xarray_eptr = X_NULL;
+        // 标识分片“未被分配出去”
+        XSLICE_QUEUE_ALLOCATED_RESET(xchunk_ptr, xut_index, x_uint16_t);
 
-    //======================================
-}
+        XSLICE_QUEUE(xchunk_ptr).xut_epos += 1;
 
-/**********************************************************/
-/**
- * @brief 向 xslice_rqueue_t 队列尾端压入一个分片。
- */
-static x_void_t xsrque_push(xsrque_handle_t xsrque_ptr, xmem_slice_t xemt_value)
-{
-    xslice_arrptr_t xarray_ptr = X_NULL;
+        if (0 == XSLICE_QUEUE(xchunk_ptr).xut_epos)
+        {
+            XSLICE_QUEUE(xchunk_ptr).xut_epos =
+                XSLICE_QUEUE_COUNT(xchunk_ptr, x_uint16_t);
 
-    xsrque_ptr->xarray_eptr->xslice_aptr[xsrque_ptr->xarray_epos] = xemt_value;
+            XSLICE_QUEUE(xchunk_ptr).xut_bpos %=
+                XSLICE_QUEUE_CAPACITY(xchunk_ptr);
 
-    xatomic_add_32(&xsrque_ptr->xqueue_size, 1);
+            XSLICE_QUEUE(xchunk_ptr).xut_epos +=
+                XSLICE_QUEUE(xchunk_ptr).xut_bpos;
+        }
 
-    if (++xsrque_ptr->xarray_epos == XSLICE_ARRAY_SIZE)
-    {
-        xarray_ptr =
-            (xslice_arrptr_t)xatomic_xchg_ptr(
-                    (x_void_t * volatile *)&xsrque_ptr->xarray_sptr,
-                    (x_void_t *)X_NULL);
+        xchunk_ptr->xowner.xclass_ptr->xslice_count += 1;
 
-        if (X_NULL != xarray_ptr)
+        // 分片队列状态变化时，chunk 对象转移至对应的链表
+        if (XCHUNK_IS_IDLE(xchunk_ptr))
         {
-            xsrque_ptr->xarray_eptr->xarray_next = xarray_ptr;
-            xarray_ptr->xarray_prev = xsrque_ptr->xarray_eptr;
+            // 所有分片都已回收，复位高水位线，之后重新按顺序切分
+            XSLICE_QUEUE(xchunk_ptr).xut_bpos = 0;
+            XSLICE_QUEUE(xchunk_ptr).xut_epos = 0;
+            xchunk_ptr->xut_carve = 0;
+
+            xclass_list_move_chunk(
+                xchunk_ptr->xowner.xclass_ptr, xchunk_ptr, XCHUNK_LIST_IDLE);
+            xclass_idle_enter(xchunk_ptr->xowner.xclass_ptr, xchunk_ptr);
         }
-        else
+        else if (xbt_busy)
         {
-            xsrque_ptr->xarray_eptr->xarray_next =
-                (xslice_arrptr_t)xmem_heap_alloc(
-                    sizeof(xslice_array_t), X_NULL, X_NULL);
-            xsrque_ptr->xarray_eptr->xarray_prev = xsrque_ptr->xarray_eptr;
+            xclass_list_move_chunk(
+                xchunk_ptr->xowner.xclass_ptr, xchunk_ptr, XCHUNK_LIST_PART);
         }
 
-        xsrque_ptr->xarray_eptr = xsrque_ptr->xarray_eptr->xarray_next;
-        xsrque_ptr->xarray_epos = 0;
-    }
+        //======================================
+
+        xit_error = XMEM_ERR_OK;
+    } while (0);
+
+    return xit_error;
 }
 
 /**********************************************************/
 /**
- * @brief 从 xslice_rqueue_t 队列前端弹出一个分片。
+ * @brief 取回 chunk 对象中（其他线程回收的）待回收分片栈，并逐个回收至分片队列。
+ * @note  只能在工作线程中调用。
+ * 
+ * @param [in ] xchunk_ptr : chunk 对象（分片容量须大于 0）。
+ * @param [in ] xbt_unlink : chunk 对象是否刚从 xchunk_rlist 链表中取回，
+ *                           为 X_TRUE 时一并清除 XSLICE_RFREE_LINKED 标志位；
+ *                           否则保留该标志位（chunk 仍在链表中，或正被其他线程挂入）。
+ * 
+ * @return x_uint32_t
+ *         - 返回成功回收的分片数量。
  */
-static xmem_slice_t xsrque_pop(xsrque_handle_t xsrque_ptr)
+static x_uint32_t xchunk_rfree_harvest(xchunk_handle_t xchunk_ptr, x_bool_t xbt_unlink)
 {
-    xmem_slice_t    xmem_slice = X_NULL;
-    xslice_arrptr_t xarray_ptr = X_NULL;
+    XASSERT(XSLICE_QUEUE_CAPACITY(xchunk_ptr) > 0);
 
-    if (0 == xatomic_add_32(&xsrque_ptr->xqueue_size, 0))
+    xmpool_handle_t xmpool_ptr  = xchunk_ptr->xowner.xclass_ptr->xmpool_ptr;
+    xmem_slice_t    xmem_slice  = X_NULL;
+    xmem_slice_t    xslice_next = X_NULL;
+    x_uint32_t      xut_count   = 0;
+
+    if (xbt_unlink)
     {
-        return X_NULL;
+        xmem_slice = (xmem_slice_t)xatomic_xchg_ptr(
+                        (x_void_t * volatile *)&xchunk_ptr->xslice_rfree, X_NULL);
+    }
+    else
+    {
+        do
+        {
+            xmem_slice = XCHUNK_RFREE_LOAD(xchunk_ptr);
+        } while (xmem_slice != (xmem_slice_t)xatomic_cmpxchg_ptr(
+                    (x_void_t * volatile *)&xchunk_ptr->xslice_rfree,
+                    (x_void_t *)((x_size_t)xmem_slice & XSLICE_RFREE_LINKED),
+                    xmem_slice));
     }
 
-    xatomic_sub_32(&xsrque_ptr->xqueue_size, 1);
-
-    xmem_slice = xsrque_ptr->xarray_bptr->xslice_aptr[xsrque_ptr->xarray_bpos];
+    xmem_slice = XSLICE_RFREE_TOP(xmem_slice);
 
-    if (++xsrque_ptr->xarray_bpos == XSLICE_ARRAY_SIZE)
+    while (X_NULL != xmem_slice)
     {
-        xarray_ptr = xsrque_ptr->xarray_bptr;
-        xsrque_ptr->xarray_bptr = xsrque_ptr->xarray_bptr->xarray_next;
-        XASSERT(X_NULL != xsrque_ptr->xarray_bptr);
-        xsrque_ptr->xarray_bptr->xarray_prev = X_NULL;
-        xsrque_ptr->xarray_bpos = 0;
-
-        xarray_ptr = (xslice_arrptr_t)xatomic_xchg_ptr(
-            (x_void_t * volatile *)&xsrque_ptr->xarray_sptr, xarray_ptr);
+        xslice_next = XSLICE_RFREE_NEXT(xmem_slice);
 
-        if (X_NULL != xarray_ptr)
+        if (XMEM_ERR_OK == xchunk_recyc_slice(xchunk_ptr, xmem_slice))
+        {
+            XCHUNK_PROF_ERASE(xmpool_ptr, xchunk_ptr, xmem_slice);
+            xut_count += 1;
+        }
+        else
         {
-            xmem_heap_free(xarray_ptr, sizeof(xslice_array_t), X_NULL, X_NULL);
+            XASSERT(X_FALSE);
         }
+
+        xmem_slice = xslice_next;
     }
 
-    return xmem_slice;
+    xmpool_ptr->xsize_using -= (x_uint64_t)xut_count * xchunk_ptr->xslice_size;
+    xchunk_ptr->xowner.xclass_ptr->xstat_free += xut_count;
+
+    return xut_count;
 }
 
 //====================================================================
 
 // 
-// xmem_pool_t ：存储管理使用的红黑树的相关操作接口
+// xmem_class_t 相关的操作接口
 // 
 
-XRBTREE_CTYPE_API(xchunk_handle_t, static, inline, chunk)
-
 /**********************************************************/
 /**
- * @brief 查找内存分片可能隶属的 chunk 对象。
- * @note 该接口只检测内存分片的地址是否在 chunk 对象内存区域的范围内，
- *       对分片 “是否对齐 chunk 对象内的有效分片位置” 并不关心。
+ * @brief 将 chunk 对象从所在的链表中断开（不更新 class 对象的计数）。
  */
-static xchunk_handle_t xrbtree_hit_chunk(
-                            x_rbtree_ptr xthis_ptr,
-                            xmem_slice_t xmem_slice)
+static inline x_void_t xclass_list_unlink(xchunk_handle_t xchunk_ptr)
 {
-    x_rbnode_iter   xiter_node = XRBT_NULL;
-    xchunk_handle_t xchunk_ptr = X_NULL;
-
-#if ENABLE_XASSERT
-    // 为了避免 xrbtree_chunk_compare() 中的 XASSERT_CHECK() 的
-    // 错误断言，调试版本下使用这一部分代码实现
+    XASSERT(X_NULL != xchunk_ptr->xlist_node.xchunk_prev);
+    XASSERT(X_NULL != xchunk_ptr->xlist_node.xchunk_next);
 
-    // 将 xmem_slice 伪造成 chunk 对象，并将 xchunk_size 置 1，
-    // 以便在 红黑树节点索引键 的回调比对时，好判断 slice 是否属于
-    // 某个 chunk 对象，详细过程可参看 xrbtree_chunk_compare()
-    x_uint32_t xsize_backup = ((xchunk_handle_t)xmem_slice)->xchunk_size;
-    ((xchunk_handle_t)xmem_slice)->xchunk_size = 1;
-#endif // ENABLE_XASSERT
+    xchunk_ptr->xlist_node.xchunk_prev->xlist_node.xchunk_next =
+        xchunk_ptr->xlist_node.xchunk_next;
+    xchunk_ptr->xlist_node.xchunk_next->xlist_node.xchunk_prev =
+        xchunk_ptr->xlist_node.xchunk_prev;
 
-    xiter_node = xrbtree_lower_bound_chunk(
-                        xthis_ptr, (xchunk_handle_t)xmem_slice);
+    xchunk_ptr->xlist_node.xchunk_prev = X_NULL;
+    xchunk_ptr->xlist_node.xchunk_next = X_NULL;
+}
 
-    if (!xrbtree_iter_is_nil(xiter_node))
-    {
+/**********************************************************/
+/**
+ * @brief 将 chunk 对象链接到 class 对象指定链表的头部（不更新 class 对象的计数）。
+ */
+static inline x_void_t xclass_list_link_head(
+                                xclass_handle_t xclass_ptr,
+                                xchunk_handle_t xchunk_ptr,
+                                x_uint32_t xut_list)
+{
+    XASSERT(xut_list < XCHUNK_LIST_COUNT);
+
+    xchunk_ptr->xlist_node.xchunk_prev = XCLASS_LIST_HEAD(xclass_ptr, xut_list);
+    xchunk_ptr->xlist_node.xchunk_next = XCLASS_LIST_FRONT(xclass_ptr, xut_list);
+
+    XCLASS_LIST_FRONT(xclass_ptr, xut_list)->xlist_node.xchunk_prev = xchunk_ptr;
+    XCLASS_LIST_HEAD(xclass_ptr, xut_list)->xlist_node.xchunk_next  = xchunk_ptr;
+}
+
+/**********************************************************/
+/**
+ * @brief chunk 对象转入 XCHUNK_LIST_IDLE 链表后，更新 空闲 chunk 对象的计数，
+ *        并标记 class 对象待检查保留上限（参看 xmpool_trim_idle()）。
+ */
+static inline x_void_t xclass_idle_enter(
+                                xclass_handle_t xclass_ptr,
+                                xchunk_handle_t xchunk_ptr)
+{
+    xclass_ptr->xidle_count += 1;
+    xclass_ptr->xmpool_ptr->xsize_idle += xchunk_ptr->xchunk_size;
+    xclass_ptr->xmpool_ptr->xdirty_added += xchunk_ptr->xchunk_size;
+    xclass_ptr->xmpool_ptr->xclass_trim = xclass_ptr;
+}
+
+/**********************************************************/
+/**
+ * @brief chunk 对象离开 XCHUNK_LIST_IDLE 链表后，更新 空闲 chunk 对象的计数。
+ */
+static inline x_void_t xclass_idle_leave(
+                                xclass_handle_t xclass_ptr,
+                                xchunk_handle_t xchunk_ptr)
+{
+    XASSERT(xclass_ptr->xidle_count > 0);
+
+    xclass_ptr->xidle_count -= 1;
+    xclass_ptr->xmpool_ptr->xsize_idle -= xchunk_ptr->xchunk_size;
+
+    if (0 != xchunk_ptr->xut_purged)
+    {
+        xclass_ptr->xmpool_ptr->xsize_purged -= xchunk_ptr->xchunk_size;
+        xchunk_ptr->xut_purged = 0;
+    }
+}
+
+/**********************************************************/
+/**
+ * @brief 将 chunk 对象从分类管理的链表中移除。
+ */
+static x_void_t xclass_list_erase_chunk(
+                            xclass_handle_t xclass_ptr,
+                            xchunk_handle_t xchunk_ptr)
+{
+    XASSERT(xclass_ptr == xchunk_ptr->xowner.xclass_ptr);
+
+    xclass_list_unlink(xchunk_ptr);
+
+    if (XCHUNK_IS_IDLE(xchunk_ptr))
+    {
+        xclass_idle_leave(xclass_ptr, xchunk_ptr);
+    }
+
+    xclass_ptr->xchunk_count -= 1;
+    xclass_ptr->xslice_count -= XCHUNK_FREE_COUNT(xchunk_ptr);
+}
+
+/**********************************************************/
+/**
+ * @brief 将（新的）chunk 对象，按其分片队列的状态，插入到分类管理的对应链表头部。
+ */
+static x_void_t xclass_list_push_chunk(
+                            xclass_handle_t xclass_ptr,
+                            xchunk_handle_t xchunk_ptr)
+{
+    XASSERT(xclass_ptr == xchunk_ptr->xowner.xclass_ptr);
+    XASSERT(X_NULL == xchunk_ptr->xlist_node.xchunk_prev);
+
+    xclass_list_link_head(xclass_ptr, xchunk_ptr, XCHUNK_LIST_STATE(xchunk_ptr));
+
+    if (XCHUNK_IS_IDLE(xchunk_ptr))
+    {
+        xclass_idle_enter(xclass_ptr, xchunk_ptr);
+    }
+
+    xclass_ptr->xchunk_count += 1;
+    xclass_ptr->xslice_count += XCHUNK_FREE_COUNT(xchunk_ptr);
+}
+
+/**********************************************************/
+/**
+ * @brief 分片队列状态变化后，将 chunk 对象转移到对应链表的头部。
+ */
+static x_void_t xclass_list_move_chunk(
+                            xclass_handle_t xclass_ptr,
+                            xchunk_handle_t xchunk_ptr,
+                            x_uint32_t xut_list)
+{
+    XASSERT(xclass_ptr == xchunk_ptr->xowner.xclass_ptr);
+    XASSERT(xut_list == (x_uint32_t)XCHUNK_LIST_STATE(xchunk_ptr));
+
+    xclass_list_unlink(xchunk_ptr);
+    xclass_list_link_head(xclass_ptr, xchunk_ptr, xut_list);
+}
+
+/**********************************************************/
+/**
+ * @brief 从分类管理的 class 对象中，获取一个非空（仍可分配到分片）chunk 对象。
+ * @note
+ * 优先取 XCHUNK_LIST_PART 链表的首个 chunk 对象，其次为 XCHUNK_LIST_IDLE 链表的，
+ * 两者均为 O(1) 操作，与 XCHUNK_LIST_BUSY 链表中 chunk 对象的数量无关。
+ */
+static inline xchunk_handle_t xclass_get_non_empty_chunk(xclass_handle_t xclass_ptr)
+{
+    if (xclass_ptr->xslice_count <= 0)
+    {
+        return X_NULL;
+    }
+
+    if (!XCLASS_LIST_EMPTY(xclass_ptr, XCHUNK_LIST_PART))
+    {
+        return XCLASS_LIST_FRONT(xclass_ptr, XCHUNK_LIST_PART);
+    }
+
+    if (!XCLASS_LIST_EMPTY(xclass_ptr, XCHUNK_LIST_IDLE))
+    {
+        return XCLASS_LIST_FRONT(xclass_ptr, XCHUNK_LIST_IDLE);
+    }
+
+    return X_NULL;
+}
+
+//====================================================================
+
+// 
+// xmem_pool_t ：存储管理使用的红黑树的相关操作接口
+// 
+
+XRBTREE_CTYPE_API(xchunk_handle_t, static, inline, chunk)
+
+/**********************************************************/
+/**
+ * @brief 查找内存分片可能隶属的 chunk 对象。
+ * @note 该接口只检测内存分片的地址是否在 chunk 对象内存区域的范围内，
+ *       对分片 “是否对齐 chunk 对象内的有效分片位置” 并不关心。
+ */
+static xchunk_handle_t xrbtree_hit_chunk(
+                            x_rbtree_ptr xthis_ptr,
+                            xmem_slice_t xmem_slice)
+{
+    x_rbnode_iter   xiter_node = XRBT_NULL;
+    xchunk_handle_t xchunk_ptr = X_NULL;
+
+#if ENABLE_XASSERT
+    // 为了避免 xrbtree_chunk_compare() 中的 XASSERT_CHECK() 的
+    // 错误断言，调试版本下使用这一部分代码实现
+
+    // 将 xmem_slice 伪造成 chunk 对象，并将 xchunk_size 置 1，
+    // 以便在 红黑树节点索引键 的回调比对时，好判断 slice 是否属于
+    // 某个 chunk 对象，详细过程可参看 xrbtree_chunk_compare()
+    x_uint32_t xsize_backup = ((xchunk_handle_t)xmem_slice)->xchunk_size;
+    ((xchunk_handle_t)xmem_slice)->xchunk_size = 1;
+#endif // ENABLE_XASSERT
+
+    xiter_node = xrbtree_lower_bound_chunk(
+                        xthis_ptr, (xchunk_handle_t)xmem_slice);
+
+    if (!xrbtree_iter_is_nil(xiter_node))
+    {
         xchunk_ptr = xrbtree_iter_chunk(xiter_node);
         XASSERT(X_NULL != xchunk_ptr);
-        XASSERT(xmem_slice > XCHUNK_LADDR(xchunk_ptr));
 
-        if (xmem_slice >= XCHUNK_RADDR(xchunk_ptr))
+        // 返回的是首个右边界大于 xmem_slice 的 chunk 对象，
+        // 其它内存池对象的地址可能落在该 chunk 对象之前的空隙中
+        if ((xmem_slice <= XCHUNK_LADDR(xchunk_ptr)) ||
+            (xmem_slice >= XCHUNK_RADDR(xchunk_ptr)))
         {
             xchunk_ptr = X_NULL;
         }
@@ -1077,6 +1799,8 @@ static xrbt_void_t xrbtree_node_memfree(
     xmpool_ptr->xsize_valid -=
         (xchunk_ptr->xchunk_size - XSLICE_QUEUE(xchunk_ptr).xut_offset);
 
+    xchunk_page_reset(xmpool_ptr, xchunk_ptr);
+
     xmpool_ptr->xsize_cached -= xchunk_ptr->xchunk_size;
     xmpool_ptr->xfunc_free(xchunk_ptr,
                            xchunk_ptr->xchunk_size,
@@ -1122,12 +1846,17 @@ static xrbt_void_t xrbtree_chunk_destruct(
 
     xchunk_handle_t xchunk_ptr = *(xchunk_handle_t *)xrbt_vkey;
 
-    XASSERT(XSLICE_QUEUE_IS_FULL(xchunk_ptr, x_uint16_t));
+    XASSERT(XCHUNK_IS_IDLE(xchunk_ptr));
 
     // 分片容量大于 0 的情况下，chunk 才会进行分类管理
     if (XSLICE_QUEUE_CAPACITY(xchunk_ptr) > 0)
     {
         XASSERT(X_NULL != xchunk_ptr->xowner.xclass_ptr);
+        if (xchunk_ptr == xchunk_ptr->xowner.xclass_ptr->xchunk_rptr)
+        {
+            xchunk_ptr->xowner.xclass_ptr->xchunk_rptr = X_NULL;
+        }
+
         xclass_list_erase_chunk(xchunk_ptr->xowner.xclass_ptr, xchunk_ptr);
         xchunk_ptr->xowner.xclass_ptr = X_NULL;
     }
@@ -1167,69 +1896,311 @@ static xrbt_bool_t xrbtree_chunk_compare(
 // xmem_pool_t : internal calls
 // 
 
+/**********************************************************/
+/**
+ * @brief 判断 chunk 对象的分片方案是否可用：容量不超过 0x7FFF 个分片，
+ *        且首个分片的偏移量（XSLICE_QUEUE(xchunk_ptr).xut_offset）不超过 0xFFFF。
+ */
+static inline x_bool_t xmem_chunk_layout_valid(x_uint32_t xchunk_size, x_uint32_t xslice_size)
+{
+    x_uint32_t xut_capacity = xmem_chunk_capacity(xchunk_size, xslice_size);
+
+    // 因分片的 索引号（只有 16 位）的最高位用于
+    // 标识“分片是否已被分配出去”，
+    // 所以 chunk 对象的容量上限也就为 0x00007FFF
+    return ((xut_capacity >= 1) && (xut_capacity <= 0x00007FFF) &&
+            ((xchunk_size - xslice_size * xut_capacity) <= 0x0000FFFF));
+}
+
+/**********************************************************/
+/**
+ * @brief 计算分类的 chunk 对象大小：在 [xut_lower, xut_upper] 范围内，
+ *        选取按 xslice_size 分片后未使用字节数最少的大小（尽可能的利用 chunk 对象的缓存）。
+ * 
+ * @return x_uint32_t
+ *         - 返回 chunk 对象大小（范围内没有可用的分片方案时，返回 0）。
+ */
+static x_uint32_t xmpool_class_chunk_size(x_uint32_t xslice_size,
+                                          x_uint32_t xut_lower,
+                                          x_uint32_t xut_upper)
+{
+    x_uint32_t xchunk_size = 0;
+    x_uint32_t xut_unused  = 0;
+    x_uint32_t xut_minusd  = 0xFFFFFFFF;
+    x_uint32_t xut_expect  = 0;
+
+    for (xut_expect  = xut_lower;
+         xut_expect <= xut_upper;
+         xut_expect += XCHUNK_INC_SIZE)
+    {
+        if (xut_expect < (XCHUNK_HEAD_SIZE(xut_expect, xslice_size) + sizeof(x_uint16_t) + xslice_size))
+        {
+            continue;
+        }
+
+        if (!xmem_chunk_layout_valid(xut_expect, xslice_size))
+        {
+            continue;
+        }
+
+        xut_unused = xmem_chunk_unused_size(xut_expect, xslice_size);
+        if (xut_unused < xut_minusd)
+        {
+            xut_minusd  = xut_unused;
+            xchunk_size = xut_expect;
+        }
+    }
+
+    return xchunk_size;
+}
+
+/**********************************************************/
+/**
+ * @brief 计算分类下一个新建的 chunk 对象的大小。
+ * @note
+ * 第 N 级（N 为分类现有的 chunk 对象数量，不超过 XCHUNK_GROW_STEPS）的大小
+ * 在 [xchunk_base << N, 1.25 倍] 范围内选取分片余量最少的值，且不超过 xchunk_limit；
+ * 少量使用的分类只占用较小的 chunk 对象，频繁使用的分类逐步换用较大的 chunk 对象，
+ * chunk 对象被释放后，数量减少，新建的 chunk 对象也随之变小。
+ * 级数变化时才重新计算，结果缓存在 xchunk_size 中。
+ */
+static x_uint32_t xclass_chunk_size(xclass_handle_t xclass_ptr)
+{
+    x_uint32_t xut_step  = xclass_ptr->xchunk_count;
+    x_uint32_t xut_lower = 0;
+    x_uint32_t xut_upper = 0;
+    x_uint32_t xut_chunk = 0;
+
+    if (xut_step > XCHUNK_GROW_STEPS)
+        xut_step = XCHUNK_GROW_STEPS;
+
+    if ((xut_step == xclass_ptr->xchunk_step) ||
+        (xclass_ptr->xchunk_base >= xclass_ptr->xchunk_limit))
+    {
+        return xclass_ptr->xchunk_size;
+    }
+
+    xut_lower = xclass_ptr->xchunk_base << xut_step;
+    xut_upper = xut_lower + X_ALIGN(xut_lower / 4, XCHUNK_INC_SIZE);
+    if (xut_upper > xclass_ptr->xchunk_limit)
+    {
+        // 到达上限后，在 [0.75 倍上限, 上限] 范围内选取
+        xut_upper = xclass_ptr->xchunk_limit;
+        if (xut_lower > (xut_upper - xut_upper / 4))
+            xut_lower = X_ALIGN(xut_upper - xut_upper / 4, XCHUNK_INC_SIZE);
+    }
+
+    // 范围内没有可用的分片方案时，沿用之前的大小
+    xut_chunk = xmpool_class_chunk_size(xclass_ptr->xslice_size, xut_lower, xut_upper);
+    if (0 != xut_chunk)
+        xclass_ptr->xchunk_size = xut_chunk;
+    xclass_ptr->xchunk_step = xut_step;
+
+    return xclass_ptr->xchunk_size;
+}
+
+/**********************************************************/
+/**
+ * @brief 校验自定义的分类表（条件参看 xmpool_create_classes() 的说明）。
+ */
+static x_bool_t xmpool_class_table_check(const xmpool_class_t * xclass_table,
+                                         x_uint32_t xut_count,
+                                         x_uint32_t xut_flags)
+{
+    x_uint32_t xut_iter    = 0;
+    x_uint32_t xslice_size = 0;
+    x_uint32_t xchunk_size = 0;
+
+    if ((X_NULL == xclass_table) ||
+        (xut_count < 1) || (xut_count > XMPOOL_CLASS_MAX_COUNT))
+    {
+        return X_FALSE;
+    }
+
+    for (xut_iter = 0; xut_iter < xut_count; ++xut_iter)
+    {
+        xslice_size = xclass_table[xut_iter].xslice_size;
+        xchunk_size = xclass_table[xut_iter].xchunk_size;
+
+        // 分类索引表的粒度为 8 字节，分片大小须为其整数倍，且严格递增
+        if ((xslice_size <= 0) || (xslice_size > XMPOOL_CLASS_MAX_SIZE) ||
+            (0 != (xslice_size & ((1 << XSLICE_INDEX_SHIFT) - 1))) ||
+            ((xut_iter > 0) && (xslice_size <= xclass_table[xut_iter - 1].xslice_size)))
+        {
+            return X_FALSE;
+        }
+
+        // XMPOOL_CLASS_SIZE() 向上对齐到缓存行后，须恰好命中缓存行整数倍的分类
+        if ((0 != (xut_flags & XMPOOL_FLAG_CACHE_ALIGN)) &&
+            (xslice_size >= XMPOOL_CACHE_LINE) &&
+            (0 != (xslice_size & (XMPOOL_CACHE_LINE - 1))))
+        {
+            return X_FALSE;
+        }
+
+        if (0 == xchunk_size)
+        {
+            continue;
+        }
+
+        if ((xchunk_size != X_ALIGN(xchunk_size, XMEM_PAGE_SIZE)) ||
+            (xchunk_size > XMPOOL_CHUNK_ALIGN) ||
+            (xchunk_size < (XCHUNK_HEAD_SIZE(xchunk_size, xslice_size) + sizeof(x_uint16_t) + xslice_size)))
+        {
+            return X_FALSE;
+        }
+
+        if (!xmem_chunk_layout_valid(xchunk_size, xslice_size))
+        {
+            return X_FALSE;
+        }
+    }
+
+    return X_TRUE;
+}
+
+/**********************************************************/
+/**
+ * @brief 由（已校验的）自定义分类表生成分类索引表
+ *        （使用 xsys_heap_free() 释放，大小为 XMPOOL_INDEX_SLOTS(最大分片大小)）。
+ * @note  每个表项都映射到 不小于 (下标 << XSLICE_INDEX_SHIFT) 的 最小分片大小 的分类。
+ */
+static x_uint8_t * xmpool_class_index_build(const xmpool_class_t * xclass_table,
+                                            x_uint32_t xut_count)
+{
+    x_uint32_t  xut_iter   = 0;
+    x_uint32_t  xut_index  = 0;
+    x_uint32_t  xut_slots  =
+        XMPOOL_INDEX_SLOTS(xclass_table[xut_count - 1].xslice_size);
+    x_uint8_t * xindex_ptr = (x_uint8_t *)xsys_heap_alloc(xut_slots);
+
+    if (X_NULL == xindex_ptr)
+    {
+        return X_NULL;
+    }
+
+    for (xut_iter = 0; xut_iter < xut_slots; ++xut_iter)
+    {
+        while ((xut_iter << XSLICE_INDEX_SHIFT) > xclass_table[xut_index].xslice_size)
+        {
+            xut_index += 1;
+        }
+
+        XASSERT(xut_index < xut_count);
+        xindex_ptr[xut_iter] = (x_uint8_t)xut_index;
+    }
+
+    return xindex_ptr;
+}
+
 /**********************************************************/
 /**
  * @brief 初始化 内存分类对象 表。
+ * 
+ * @param [in ] xmpool_ptr   : 内存池对象（分类索引表等信息已设置）。
+ * @param [in ] xclass_table : 自定义的分类表（为 X_NULL 时，使用默认分类表）。
  */
-static x_void_t xmpool_class_initialize(xmpool_handle_t xmpool_ptr)
+static x_void_t xmpool_class_initialize(xmpool_handle_t xmpool_ptr,
+                                        const xmpool_class_t * xclass_table)
 {
     xclass_handle_t xclass_ptr = X_NULL;
+    xchunk_list_t * xlist_ptr  = X_NULL;
 
-    x_int32_t  xit_iter   = 0;
-    x_uint32_t xut_unused = 0;
-    x_uint32_t xut_minusd = XCHUNK_MAX_SIZE;
+    x_uint32_t xut_iter   = 0;
+    x_uint32_t xut_list   = 0;
+    x_uint32_t xut_base   = 0;
+    x_uint32_t xut_limit  = 0;
+#if ENABLE_XASSERT
     x_uint32_t xut_expect = 0;
+#endif // ENABLE_XASSERT
 
-    for (xit_iter = 0; xit_iter < XSLICE_TYPE_COUNT; ++xit_iter)
+    for (xut_iter = 0; xut_iter < xmpool_ptr->xclass_count; ++xut_iter)
     {
         //======================================
 
-        xclass_ptr = &xmpool_ptr->xclass_ptr[xit_iter];
+        xclass_ptr = &xmpool_ptr->xclass_ptr[xut_iter];
 
-        xclass_ptr->xchunk_size  = XCHUNK_MIN_SIZE;
-        xclass_ptr->xslice_size  = X_slice_size_table[xit_iter];
+        xclass_ptr->xslice_size  = (X_NULL != xclass_table) ?
+                                        xclass_table[xut_iter].xslice_size :
+                                        X_slice_size_table[xut_iter];
         xclass_ptr->xchunk_count = 0;
         xclass_ptr->xslice_count = 0;
         xclass_ptr->xmpool_ptr   = xmpool_ptr;
-        xclass_ptr->xlist_head.xchunk_size = sizeof(xchunk_alias_t);
-        xclass_ptr->xlist_head.xslice_size = 0;
-        xclass_ptr->xlist_head.xlist_node.xchunk_prev = X_NULL;
-        xclass_ptr->xlist_head.xlist_node.xchunk_next = XCLASS_LIST_TAIL(xclass_ptr);
-        xclass_ptr->xlist_tail.xchunk_size = sizeof(xchunk_alias_t);
-        xclass_ptr->xlist_tail.xslice_size = 0;
-        xclass_ptr->xlist_tail.xlist_node.xchunk_prev = XCLASS_LIST_HEAD(xclass_ptr);
-        xclass_ptr->xlist_tail.xlist_node.xchunk_next = X_NULL;
+        xclass_ptr->xchunk_rptr  = X_NULL;
+        xclass_ptr->xidle_count  = 0;
+        xclass_ptr->xbt_lifo     = (0 != (xmpool_ptr->xut_flags & XMPOOL_FLAG_LIFO));
+        xclass_ptr->xmag_count   = 0;
+        xclass_ptr->xmag_limit   = XCLASS_MAGAZINE_BYTES / xclass_ptr->xslice_size;
+        xclass_ptr->xstat_alloc  = 0;
+        xclass_ptr->xstat_free   = 0;
+        xclass_ptr->xstat_slow   = 0;
+        xclass_ptr->xstat_round  = 0;
+
+        if (xclass_ptr->xmag_limit > XCLASS_MAGAZINE_SLOTS)
+            xclass_ptr->xmag_limit = XCLASS_MAGAZINE_SLOTS;
+        else if (xclass_ptr->xmag_limit < 1)
+            xclass_ptr->xmag_limit = 1;
+
+        for (xut_list = 0; xut_list < XCHUNK_LIST_COUNT; ++xut_list)
+        {
+            xlist_ptr = &xclass_ptr->xlist[xut_list];
+            xlist_ptr->xlist_head.xchunk_size = sizeof(xchunk_alias_t);
+            xlist_ptr->xlist_head.xslice_size = 0;
+            xlist_ptr->xlist_head.xlist_node.xchunk_prev = X_NULL;
+            xlist_ptr->xlist_head.xlist_node.xchunk_next = XCLASS_LIST_TAIL(xclass_ptr, xut_list);
+            xlist_ptr->xlist_tail.xchunk_size = sizeof(xchunk_alias_t);
+            xlist_ptr->xlist_tail.xslice_size = 0;
+            xlist_ptr->xlist_tail.xlist_node.xchunk_prev = XCLASS_LIST_HEAD(xclass_ptr, xut_list);
+            xlist_ptr->xlist_tail.xlist_node.xchunk_next = X_NULL;
+        }
 
         //======================================
-        // 计算最优的内存分片方案（尽可能的利用 chunk 对象的缓存）
+        // 自定义分类表指定了 chunk 大小时固定使用，
+        // 否则从较小的 chunk 大小开始，随 chunk 数量逐级倍增（参看 xclass_chunk_size()）
 
-        xut_minusd = xmem_chunk_unused_size(
-                            XCHUNK_MIN_SIZE, xclass_ptr->xslice_size);
-
-        for (xut_expect  = XCHUNK_MIN_SIZE;
-             xut_expect <= XCHUNK_MAX_SIZE;
-             xut_expect += XCHUNK_INC_SIZE)
+        if ((X_NULL != xclass_table) && (0 != xclass_table[xut_iter].xchunk_size))
         {
-            // 因分片的 索引号（只有 16 位）的最高位用于
-            // 标识“分片是否已被分配出去”，
-            // 所以 chunk 对象的容量上限也就为 0x00007FFF
-            if (xmem_chunk_capacity(
-                    xut_expect, xclass_ptr->xslice_size) > 0x00007FFF)
-            {
-                break;
-            }
-
-            xut_unused = xmem_chunk_unused_size(
-                                xut_expect, xclass_ptr->xslice_size);
-            if (xut_unused < xut_minusd)
-            {
-                xut_minusd = xut_unused;
-                xclass_ptr->xchunk_size = xut_expect;
-            }
+            xclass_ptr->xchunk_base  = xclass_table[xut_iter].xchunk_size;
+            xclass_ptr->xchunk_limit = xclass_table[xut_iter].xchunk_size;
+            xclass_ptr->xchunk_size  = xclass_table[xut_iter].xchunk_size;
+        }
+        else
+        {
+            // XMPOOL_FLAG_ALIGN_CHUNK 模式下，须保证分片都在对齐的首个区间内
+            xut_limit = XMPOOL_IS_ALIGNED(xmpool_ptr) ? XMPOOL_CHUNK_ALIGN : XCHUNK_MAX_SIZE;
+
+            xut_base = X_ALIGN(XCHUNK_HEAD_SIZE(XCHUNK_MAX_SIZE, xclass_ptr->xslice_size) + XCHUNK_MIN_SLICES *
+                               (xclass_ptr->xslice_size + (x_uint32_t)sizeof(x_uint16_t)),
+                               XCHUNK_INC_SIZE);
+            if (xut_base < XCHUNK_MIN_SIZE)
+                xut_base = XCHUNK_MIN_SIZE;
+            if (xut_base > xut_limit)
+                xut_base = xut_limit;
+
+            xclass_ptr->xchunk_base  = xut_base;
+            xclass_ptr->xchunk_limit = xut_limit;
+            xclass_ptr->xchunk_size  = xut_base;
         }
 
+        // 置为无效的级数，由 xclass_chunk_size() 计算第 0 级的大小
+        xclass_ptr->xchunk_step = XCHUNK_GROW_STEPS + 1;
+        xclass_chunk_size(xclass_ptr);
+        XASSERT(xmem_chunk_layout_valid(xclass_ptr->xchunk_size, xclass_ptr->xslice_size));
+
         //======================================
     }
+
+#if ENABLE_XASSERT
+    // 校验分类索引表：每个大小都映射到 不小于它的 最小分片大小
+    for (xut_expect = 1; xut_expect <= xmpool_ptr->xslice_max; ++xut_expect)
+    {
+        xut_iter = XMPOOL_CLASS_INDEX(xmpool_ptr, xut_expect);
+        XASSERT(xut_iter < xmpool_ptr->xclass_count);
+        XASSERT(xmpool_ptr->xclass_ptr[xut_iter].xslice_size >= xut_expect);
+        XASSERT((0 == xut_iter) ||
+                (xmpool_ptr->xclass_ptr[xut_iter - 1].xslice_size < xut_expect));
+    }
+#endif // ENABLE_XASSERT
 }
 
 /**********************************************************/
@@ -1238,12 +2209,12 @@ static x_void_t xmpool_class_initialize(xmpool_handle_t xmpool_ptr)
  */
 static x_void_t xmpool_class_release(xmpool_handle_t xmpool_ptr)
 {
-    x_int32_t       xit_iter   = 0;
+    x_uint32_t      xut_iter   = 0;
     xclass_handle_t xclass_ptr = X_NULL;
 
-    for (xit_iter = 0; xit_iter < XSLICE_TYPE_COUNT; ++xit_iter)
+    for (xut_iter = 0; xut_iter < xmpool_ptr->xclass_count; ++xut_iter)
     {
-        xclass_ptr = &xmpool_ptr->xclass_ptr[xit_iter];
+        xclass_ptr = &xmpool_ptr->xclass_ptr[xut_iter];
 
         XASSERT((0 == xclass_ptr->xchunk_count) &&
                 (0 == xclass_ptr->xslice_count));
@@ -1254,141 +2225,191 @@ static x_void_t xmpool_class_release(xmpool_handle_t xmpool_ptr)
 
 /**********************************************************/
 /**
- * @brief 按照给定的 分片大小，获取对应的 class 分类对象。
+ * @brief 按照给定的 分类索引号，获取对应的 class 分类对象。
  */
-static xclass_handle_t xmpool_get_class(
-                            xmpool_handle_t xmpool_ptr,
-                            x_uint32_t xslice_size)
+static inline xclass_handle_t xmpool_get_class(
+                                    xmpool_handle_t xmpool_ptr,
+                                    x_uint32_t xut_index)
 {
     XASSERT(X_NULL != xmpool_ptr);
-    XASSERT((xslice_size > 0) && (xmem_align_size(xslice_size) == xslice_size));
-
-    xclass_handle_t xclass_ptr = X_NULL;
+    XASSERT(xut_index < xmpool_ptr->xclass_count);
 
-    switch (xslice_size)
-    {
-    case XSLICE_SIZE_____8 : xclass_ptr = &xmpool_ptr->xclass_ptr[ 0]; break;
-    case XSLICE_SIZE____16 : xclass_ptr = &xmpool_ptr->xclass_ptr[ 1]; break;
-    case XSLICE_SIZE____24 : xclass_ptr = &xmpool_ptr->xclass_ptr[ 2]; break;
-    case XSLICE_SIZE____32 : xclass_ptr = &xmpool_ptr->xclass_ptr[ 3]; break;
-    case XSLICE_SIZE____40 : xclass_ptr = &xmpool_ptr->xclass_ptr[ 4]; break;
-    case XSLICE_SIZE____48 : xclass_ptr = &xmpool_ptr->xclass_ptr[ 5]; break;
-    case XSLICE_SIZE____56 : xclass_ptr = &xmpool_ptr->xclass_ptr[ 6]; break;
-    case XSLICE_SIZE____64 : xclass_ptr = &xmpool_ptr->xclass_ptr[ 7]; break;
-    case XSLICE_SIZE____72 : xclass_ptr = &xmpool_ptr->xclass_ptr[ 8]; break;
-    case XSLICE_SIZE____80 : xclass_ptr = &xmpool_ptr->xclass_ptr[ 9]; break;
-    case XSLICE_SIZE____88 : xclass_ptr = &xmpool_ptr->xclass_ptr[10]; break;
-    case XSLICE_SIZE____96 : xclass_ptr = &xmpool_ptr->xclass_ptr[11]; break;
-    case XSLICE_SIZE___104 : xclass_ptr = &xmpool_ptr->xclass_ptr[12]; break;
-    case XSLICE_SIZE___112 : xclass_ptr = &xmpool_ptr->xclass_ptr[13]; break;
-    case XSLICE_SIZE___120 : xclass_ptr = &xmpool_ptr->xclass_ptr[14]; break;
-    case XSLICE_SIZE___128 : xclass_ptr = &xmpool_ptr->xclass_ptr[15]; break;
-    case XSLICE_SIZE___144 : xclass_ptr = &xmpool_ptr->xclass_ptr[16]; break;
-    case XSLICE_SIZE___160 : xclass_ptr = &xmpool_ptr->xclass_ptr[17]; break;
-    case XSLICE_SIZE___176 : xclass_ptr = &xmpool_ptr->xclass_ptr[18]; break;
-    case XSLICE_SIZE___192 : xclass_ptr = &xmpool_ptr->xclass_ptr[19]; break;
-    case XSLICE_SIZE___208 : xclass_ptr = &xmpool_ptr->xclass_ptr[20]; break;
-    case XSLICE_SIZE___224 : xclass_ptr = &xmpool_ptr->xclass_ptr[21]; break;
-    case XSLICE_SIZE___240 : xclass_ptr = &xmpool_ptr->xclass_ptr[22]; break;
-    case XSLICE_SIZE___256 : xclass_ptr = &xmpool_ptr->xclass_ptr[23]; break;
-    case XSLICE_SIZE___288 : xclass_ptr = &xmpool_ptr->xclass_ptr[24]; break;
-    case XSLICE_SIZE___320 : xclass_ptr = &xmpool_ptr->xclass_ptr[25]; break;
-    case XSLICE_SIZE___352 : xclass_ptr = &xmpool_ptr->xclass_ptr[26]; break;
-    case XSLICE_SIZE___384 : xclass_ptr = &xmpool_ptr->xclass_ptr[27]; break;
-    case XSLICE_SIZE___416 : xclass_ptr = &xmpool_ptr->xclass_ptr[28]; break;
-    case XSLICE_SIZE___448 : xclass_ptr = &xmpool_ptr->xclass_ptr[29]; break;
-    case XSLICE_SIZE___480 : xclass_ptr = &xmpool_ptr->xclass_ptr[30]; break;
-    case XSLICE_SIZE___512 : xclass_ptr = &xmpool_ptr->xclass_ptr[31]; break;
-    case XSLICE_SIZE___576 : xclass_ptr = &xmpool_ptr->xclass_ptr[32]; break;
-    case XSLICE_SIZE___640 : xclass_ptr = &xmpool_ptr->xclass_ptr[33]; break;
-    case XSLICE_SIZE___704 : xclass_ptr = &xmpool_ptr->xclass_ptr[34]; break;
-    case XSLICE_SIZE___768 : xclass_ptr = &xmpool_ptr->xclass_ptr[35]; break;
-    case XSLICE_SIZE___832 : xclass_ptr = &xmpool_ptr->xclass_ptr[36]; break;
-    case XSLICE_SIZE___896 : xclass_ptr = &xmpool_ptr->xclass_ptr[37]; break;
-    case XSLICE_SIZE___960 : xclass_ptr = &xmpool_ptr->xclass_ptr[38]; break;
-    case XSLICE_SIZE__1024 : xclass_ptr = &xmpool_ptr->xclass_ptr[39]; break;
-    case XSLICE_SIZE__1152 : xclass_ptr = &xmpool_ptr->xclass_ptr[40]; break;
-    case XSLICE_SIZE__1280 : xclass_ptr = &xmpool_ptr->xclass_ptr[41]; break;
-    case XSLICE_SIZE__1408 : xclass_ptr = &xmpool_ptr->xclass_ptr[42]; break;
-    case XSLICE_SIZE__1536 : xclass_ptr = &xmpool_ptr->xclass_ptr[43]; break;
-    case XSLICE_SIZE__1664 : xclass_ptr = &xmpool_ptr->xclass_ptr[44]; break;
-    case XSLICE_SIZE__1792 : xclass_ptr = &xmpool_ptr->xclass_ptr[45]; break;
-    case XSLICE_SIZE__1920 : xclass_ptr = &xmpool_ptr->xclass_ptr[46]; break;
-    case XSLICE_SIZE__2048 : xclass_ptr = &xmpool_ptr->xclass_ptr[47]; break;
-    case XSLICE_SIZE__2304 : xclass_ptr = &xmpool_ptr->xclass_ptr[48]; break;
-    case XSLICE_SIZE__2560 : xclass_ptr = &xmpool_ptr->xclass_ptr[49]; break;
-    case XSLICE_SIZE__2816 : xclass_ptr = &xmpool_ptr->xclass_ptr[50]; break;
-    case XSLICE_SIZE__3072 : xclass_ptr = &xmpool_ptr->xclass_ptr[51]; break;
-    case XSLICE_SIZE__3328 : xclass_ptr = &xmpool_ptr->xclass_ptr[52]; break;
-    case XSLICE_SIZE__3584 : xclass_ptr = &xmpool_ptr->xclass_ptr[53]; break;
-    case XSLICE_SIZE__3840 : xclass_ptr = &xmpool_ptr->xclass_ptr[54]; break;
-    case XSLICE_SIZE__4096 : xclass_ptr = &xmpool_ptr->xclass_ptr[55]; break;
-    case XSLICE_SIZE__4608 : xclass_ptr = &xmpool_ptr->xclass_ptr[56]; break;
-    case XSLICE_SIZE__5120 : xclass_ptr = &xmpool_ptr->xclass_ptr[57]; break;
-    case XSLICE_SIZE__5632 : xclass_ptr = &xmpool_ptr->xclass_ptr[58]; break;
-    case XSLICE_SIZE__6144 : xclass_ptr = &xmpool_ptr->xclass_ptr[59]; break;
-    case XSLICE_SIZE__6656 : xclass_ptr = &xmpool_ptr->xclass_ptr[60]; break;
-    case XSLICE_SIZE__7168 : xclass_ptr = &xmpool_ptr->xclass_ptr[61]; break;
-    case XSLICE_SIZE__7680 : xclass_ptr = &xmpool_ptr->xclass_ptr[62]; break;
-    case XSLICE_SIZE__8192 : xclass_ptr = &xmpool_ptr->xclass_ptr[63]; break;
-    case XSLICE_SIZE__9216 : xclass_ptr = &xmpool_ptr->xclass_ptr[64]; break;
-    case XSLICE_SIZE_10240 : xclass_ptr = &xmpool_ptr->xclass_ptr[65]; break;
-    case XSLICE_SIZE_11264 : xclass_ptr = &xmpool_ptr->xclass_ptr[66]; break;
-    case XSLICE_SIZE_12288 : xclass_ptr = &xmpool_ptr->xclass_ptr[67]; break;
-    case XSLICE_SIZE_13312 : xclass_ptr = &xmpool_ptr->xclass_ptr[68]; break;
-    case XSLICE_SIZE_14336 : xclass_ptr = &xmpool_ptr->xclass_ptr[69]; break;
-    case XSLICE_SIZE_15360 : xclass_ptr = &xmpool_ptr->xclass_ptr[70]; break;
-    case XSLICE_SIZE_16384 : xclass_ptr = &xmpool_ptr->xclass_ptr[71]; break;
-    case XSLICE_SIZE_18432 : xclass_ptr = &xmpool_ptr->xclass_ptr[72]; break;
-    case XSLICE_SIZE_20480 : xclass_ptr = &xmpool_ptr->xclass_ptr[73]; break;
-    case XSLICE_SIZE_22528 : xclass_ptr = &xmpool_ptr->xclass_ptr[74]; break;
-    case XSLICE_SIZE_24576 : xclass_ptr = &xmpool_ptr->xclass_ptr[75]; break;
-    case XSLICE_SIZE_26624 : xclass_ptr = &xmpool_ptr->xclass_ptr[76]; break;
-    case XSLICE_SIZE_28672 : xclass_ptr = &xmpool_ptr->xclass_ptr[77]; break;
-    case XSLICE_SIZE_30720 : xclass_ptr = &xmpool_ptr->xclass_ptr[78]; break;
-    case XSLICE_SIZE_32768 : xclass_ptr = &xmpool_ptr->xclass_ptr[79]; break;
-    case XSLICE_SIZE_36864 : xclass_ptr = &xmpool_ptr->xclass_ptr[80]; break;
-    case XSLICE_SIZE_40960 : xclass_ptr = &xmpool_ptr->xclass_ptr[81]; break;
-    case XSLICE_SIZE_45056 : xclass_ptr = &xmpool_ptr->xclass_ptr[82]; break;
-    case XSLICE_SIZE_49152 : xclass_ptr = &xmpool_ptr->xclass_ptr[83]; break;
-    case XSLICE_SIZE_53248 : xclass_ptr = &xmpool_ptr->xclass_ptr[84]; break;
-    case XSLICE_SIZE_57344 : xclass_ptr = &xmpool_ptr->xclass_ptr[85]; break;
-    case XSLICE_SIZE_61440 : xclass_ptr = &xmpool_ptr->xclass_ptr[86]; break;
-    case XSLICE_SIZE_65536 : xclass_ptr = &xmpool_ptr->xclass_ptr[87]; break;
-
-    default: break;
-    }
-
-    XASSERT_CHECK(X_NULL != xclass_ptr, xslice_size == xclass_ptr->xslice_size);
-
-    return xclass_ptr;
+    return &xmpool_ptr->xclass_ptr[xut_index];
 }
 
 /**********************************************************/
 /**
- * @brief 申请新的 chunk 对象。
+ * @brief 以地址掩码的方式，查找内存分片所在的 分类 chunk 对象（XMPOOL_FLAG_ALIGN_CHUNK 模式）。
+ * @note
+ * 分类 chunk 对象不大于 XMPOOL_CHUNK_ALIGN 且按其对齐，所以本内存池对象的分类 chunk 中的地址，
+ * 掩码后必然是其 chunk 头部，查找结果是确定的。但掩码后的地址并不一定是 chunk 头部：
+ * - 大块 chunk 中超出首个对齐区间的地址，掩码后落在分片数据（用户数据）内部；
+ * - 不隶属于任何（对齐的）chunk 对象的地址，掩码后可能是未映射的内存。
+ * 因此，该接口会读取掩码地址处的内容，调用方须保证传入的地址隶属于某个对齐的 chunk 对象；
+ * 读取到的字段只作校验，只有 class 指针恰为本内存池对象的某个 class 对象，
+ * 且 分片大小、chunk 大小 与之吻合时，才视为命中。用户数据仍可能恰好伪造出这些字段，
+ * 所以大块 chunk 对象一律不由此处确认（返回 X_NULL），由调用方查找红黑树。
  * 
- * @param [in ] xmpool_ptr  : 内存池对象。
- * @param [in ] xchunk_size : chunk 对象大小。
- * @param [in ] xslice_size : 分片大小。
+ * @param [in ] xmpool_ptr : 内存池对象。
+ * @param [in ] xmem_slice : 内存分片（或其内部地址）。
  * 
  * @return xchunk_handle_t
  *         - 成功，返回 chunk 对象；
- *         - 失败，返回 X_NULL。
+ *         - 失败，返回 X_NULL（未命中，或为大块 chunk 对象）。
  */
-static xchunk_handle_t xmpool_alloc_chunk(
-                            xmpool_handle_t xmpool_ptr,
-                            x_uint32_t xchunk_size,
-                            x_uint32_t xslice_size)
+static inline xchunk_handle_t xmpool_mask_chunk(
+                                    xmpool_handle_t xmpool_ptr,
+                                    xmem_slice_t xmem_slice)
 {
-    XASSERT(X_NULL != xmpool_ptr);
-    XASSERT((xslice_size > 0) &&
-            (xchunk_size >= (xslice_size + sizeof(xmem_chunk_t))));
+    xchunk_handle_t xchunk_ptr = XCHUNK_MASKED(xmem_slice);
+    xclass_handle_t xclass_ptr = X_NULL;
+    x_size_t        xst_offset = 0;
 
-    x_uint16_t xut_iter = 0;
+    if ((0 == XSLICE_QUEUE_CAPACITY(xchunk_ptr)) ||
+        (xchunk_ptr->xchunk_size > XMPOOL_CHUNK_ALIGN))
+    {
+        return X_NULL;
+    }
 
-    xchunk_handle_t xchunk_ptr =
-        (xchunk_handle_t)xmpool_ptr->xfunc_alloc(
+    // class 指针须恰好指向本内存池对象 class 数组中的某个元素
+    xclass_ptr = xchunk_ptr->xowner.xclass_ptr;
+    xst_offset = (x_size_t)xclass_ptr - (x_size_t)&xmpool_ptr->xclass_ptr[0];
+    if ((xst_offset >= (x_size_t)xmpool_ptr->xclass_count * sizeof(xmem_class_t)) ||
+        (0 != (xst_offset % sizeof(xmem_class_t))) ||
+        (xclass_ptr->xslice_size != xchunk_ptr->xslice_size))
+    {
+        return X_NULL;
+    }
+
+    if ((xmem_slice < XSLICE_QUEUE_BEGIN(xchunk_ptr)) ||
+        (xmem_slice >= XCHUNK_RADDR(xchunk_ptr)))
+    {
+        return X_NULL;
+    }
+
+    return xchunk_ptr;
+}
+
+/**********************************************************/
+/**
+ * @brief 查找内存分片（或其内部地址）所在的 chunk 对象。
+ * @note  允许在非工作线程中调用。
+ * 
+ * @param [in ] xmpool_ptr : 内存池对象。
+ * @param [in ] xmem_slice : 内存分片（或其内部地址）。
+ * 
+ * @return xchunk_handle_t
+ *         - 成功，返回 chunk 对象；
+ *         - 失败，返回 X_NULL。
+ */
+static xchunk_handle_t xmpool_hit_chunk(
+                            xmpool_handle_t xmpool_ptr,
+                            xmem_slice_t xmem_slice)
+{
+    xchunk_handle_t xchunk_ptr = X_NULL;
+
+    if (XMPOOL_IS_ALIGNED(xmpool_ptr))
+    {
+        xchunk_ptr = xmpool_mask_chunk(xmpool_ptr, xmem_slice);
+        if (X_NULL != xchunk_ptr)
+        {
+            return xchunk_ptr;
+        }
+
+        // 大块 chunk 对象（及未命中的地址）仍需查找红黑树确认
+    }
+
+    if (xsys_tid() == xmpool_ptr->xut_worktid)
+    {
+        xchunk_ptr = xrbtree_hit_chunk(XMPOOL_RBTREE(xmpool_ptr), xmem_slice);
+    }
+    else
+    {
+        // 只有工作线程会修改红黑树，此处加锁仅为避免与其 插入/删除 操作冲突
+        xatomic_spin_lock(&xmpool_ptr->xspinlock_tree);
+        xchunk_ptr = xrbtree_hit_chunk(XMPOOL_RBTREE(xmpool_ptr), xmem_slice);
+        xatomic_spin_unlock(&xmpool_ptr->xspinlock_tree);
+    }
+
+    return xchunk_ptr;
+}
+
+/**********************************************************/
+/**
+ * @brief 在指定的 class 对象中，查找内存分片所在的 chunk 对象（只在工作线程中调用）。
+ * @note
+ * 依次匹配：xchunk_cptr、class 最近回收分片的 chunk、PART/BUSY 链表的首个 chunk
+ * （地址掩码模式下直接掩码定位），均为 O(1) 操作，与内存池的 chunk 数量无关；
+ * 全部未命中时，才退回到 xmpool_hit_chunk() 的红黑树查找。
+ * 
+ * @param [in ] xmpool_ptr : 内存池对象。
+ * @param [in ] xclass_ptr : 分片所属的 class 对象。
+ * @param [in ] xmem_slice : 内存分片。
+ * 
+ * @return xchunk_handle_t
+ *         - 成功，返回 chunk 对象（其分片大小可能与 class 对象的不一致）；
+ *         - 失败，返回 X_NULL。
+ */
+static xchunk_handle_t xmpool_class_hit_chunk(
+                            xmpool_handle_t xmpool_ptr,
+                            xclass_handle_t xclass_ptr,
+                            xmem_slice_t xmem_slice)
+{
+#define XCHUNK_HOLDS(xchunk_ptr, xmem_slice)                    \
+    (((xmem_slice) > XCHUNK_LADDR(xchunk_ptr)) &&               \
+     ((xmem_slice) < XCHUNK_RADDR(xchunk_ptr)))
+
+    xchunk_handle_t xchunk_ptr = xmpool_ptr->xchunk_cptr;
+
+    if ((X_NULL != xchunk_ptr) && XCHUNK_HOLDS(xchunk_ptr, xmem_slice))
+        return xchunk_ptr;
+
+    if (XMPOOL_IS_ALIGNED(xmpool_ptr))
+        return xmpool_hit_chunk(xmpool_ptr, xmem_slice);
+
+    xchunk_ptr = xclass_ptr->xchunk_rptr;
+    if ((X_NULL != xchunk_ptr) && XCHUNK_HOLDS(xchunk_ptr, xmem_slice))
+        return xchunk_ptr;
+
+    // 伪 chunk 节点的 xchunk_size 为 sizeof(xchunk_alias_t)，不会命中分片地址
+    xchunk_ptr = XCLASS_LIST_FRONT(xclass_ptr, XCHUNK_LIST_PART);
+    if (XCHUNK_HOLDS(xchunk_ptr, xmem_slice))
+        return xchunk_ptr;
+
+    xchunk_ptr = XCLASS_LIST_FRONT(xclass_ptr, XCHUNK_LIST_BUSY);
+    if (XCHUNK_HOLDS(xchunk_ptr, xmem_slice))
+        return xchunk_ptr;
+
+    return xmpool_hit_chunk(xmpool_ptr, xmem_slice);
+
+#undef XCHUNK_HOLDS
+}
+
+/**********************************************************/
+/**
+ * @brief 申请新的 chunk 对象。
+ * 
+ * @param [in ] xmpool_ptr  : 内存池对象。
+ * @param [in ] xchunk_size : chunk 对象大小。
+ * @param [in ] xslice_size : 分片大小。
+ * 
+ * @return xchunk_handle_t
+ *         - 成功，返回 chunk 对象；
+ *         - 失败，返回 X_NULL。
+ */
+static xchunk_handle_t xmpool_alloc_chunk(
+                            xmpool_handle_t xmpool_ptr,
+                            x_uint32_t xchunk_size,
+                            x_uint32_t xslice_size)
+{
+    XASSERT(X_NULL != xmpool_ptr);
+    XASSERT((xslice_size > 0) &&
+            (xchunk_size >= (xslice_size + sizeof(xmem_chunk_t))));
+
+    x_bool_t   xbt_insert = X_FALSE;
+
+    xchunk_handle_t xchunk_ptr =
+        (xchunk_handle_t)xmpool_ptr->xfunc_alloc(
                             xchunk_size,
                             (x_handle_t)xmpool_ptr,
                             xmpool_ptr->xht_context);
@@ -1397,16 +2418,29 @@ static xchunk_handle_t xmpool_alloc_chunk(
         return X_NULL;
     }
 
+    if (XMPOOL_IS_ALIGNED(xmpool_ptr) &&
+        (xchunk_ptr != XCHUNK_MASKED(xchunk_ptr)))
+    {
+        // 外部提供的 xfunc_alloc 未满足 XMPOOL_CHUNK_ALIGN 对齐要求
+        XASSERT(X_FALSE);
+        xmpool_ptr->xfunc_free(xchunk_ptr,
+                               xchunk_size,
+                               (x_handle_t)xmpool_ptr,
+                               xmpool_ptr->xht_context);
+        return X_NULL;
+    }
+
     xmpool_ptr->xsize_cached += xchunk_size;
 
     xmem_clear(xchunk_ptr, sizeof(xmem_chunk_t));
 
-    if (xslice_size > XSLICE_SIZE_65536)
+    if (xslice_size > xmpool_ptr->xslice_max)
     {
+        // 大块 chunk 对象的分片偏移量由调用方决定（参看 xmpool_alloc_large()）
         xchunk_ptr->xchunk_size = xchunk_size;
-        xchunk_ptr->xslice_size = xchunk_size - sizeof(xmem_chunk_t);
+        xchunk_ptr->xslice_size = xslice_size;
         xchunk_ptr->xowner.xmpool_ptr = xmpool_ptr;
-        XSLICE_QUEUE(xchunk_ptr).xut_offset   = sizeof(xmem_chunk_t);
+        XSLICE_QUEUE(xchunk_ptr).xut_offset   = xchunk_size - xslice_size;
         XSLICE_QUEUE(xchunk_ptr).xut_capacity = 0;
     }
     else
@@ -1423,23 +2457,27 @@ static xchunk_handle_t xmpool_alloc_chunk(
                 (xchunk_size - 
                  xslice_size * XSLICE_QUEUE_CAPACITY(xchunk_ptr));
 
-        for (xut_iter = 0;
-             xut_iter < XSLICE_QUEUE_CAPACITY(xchunk_ptr);
-             ++xut_iter)
-        {
-            // 最高位为 0 值，表示分片未被分配出去
-            XSLICE_QUEUE(xchunk_ptr).xut_index[xut_iter] =
-                            (xut_iter & XSLICE_IMASK(x_uint16_t));
-        }
+        // 分页位标识数组位于首个分片之前的填充区中（分片大小为 8 字节的整数倍）
+        XASSERT(0 == ((x_size_t)XCHUNK_PAGE_BITS(xchunk_ptr) & (sizeof(x_uint64_t) - 1)));
+        xmem_clear(XCHUNK_PAGE_BITS(xchunk_ptr),
+                   sizeof(x_uint64_t) * XCHUNK_PAGE_WORDS(xchunk_size, xslice_size));
 
+        // 分片索引号队列初始为空，所有分片均在高水位线之上，
+        // 由 xchunk_alloc_slice() 按需切分，不预先写入（也不触及）索引号队列
         XSLICE_QUEUE(xchunk_ptr).xut_bpos = 0;
-        XSLICE_QUEUE(xchunk_ptr).xut_epos = XSLICE_QUEUE_CAPACITY(xchunk_ptr);
+        XSLICE_QUEUE(xchunk_ptr).xut_epos = 0;
+        xchunk_ptr->xut_carve  = 0;
+        xchunk_ptr->xut_purged = 0;
     }
 
     xmpool_ptr->xsize_valid +=
         (xchunk_ptr->xchunk_size - XSLICE_QUEUE(xchunk_ptr).xut_offset);
 
-    if (!xrbtree_insert_chunk(XMPOOL_RBTREE(xmpool_ptr), xchunk_ptr))
+    xatomic_spin_lock(&xmpool_ptr->xspinlock_tree);
+    xbt_insert = xrbtree_insert_chunk(XMPOOL_RBTREE(xmpool_ptr), xchunk_ptr);
+    xatomic_spin_unlock(&xmpool_ptr->xspinlock_tree);
+
+    if (!xbt_insert)
     {
         XASSERT(X_FALSE);
 
@@ -1465,314 +2503,2296 @@ static inline x_bool_t xmpool_dealloc_chunk(
                                     xmpool_handle_t xmpool_ptr,
                                     xchunk_handle_t xchunk_ptr)
 {
-    return xrbtree_erase_chunk(XMPOOL_RBTREE(xmpool_ptr), xchunk_ptr);
+    x_bool_t xbt_erase = X_FALSE;
+
+    XASSERT(XCHUNK_RFREE_QUIET(xchunk_ptr));
+
+    xatomic_spin_lock(&xmpool_ptr->xspinlock_tree);
+    xbt_erase = xrbtree_erase_chunk(XMPOOL_RBTREE(xmpool_ptr), xchunk_ptr);
+    xatomic_spin_unlock(&xmpool_ptr->xspinlock_tree);
+
+    return xbt_erase;
 }
 
-//====================================================================
+/**********************************************************/
+/**
+ * @brief 将 chunk 对象从大块缓存中移除。
+ */
+static inline x_void_t xmpool_large_unlink(
+                                xmpool_handle_t xmpool_ptr,
+                                xchunk_handle_t xchunk_ptr)
+{
+    XASSERT(XCHUNK_IS_CACHED(xchunk_ptr));
+    XASSERT(xmpool_ptr->xlarge_count > 0);
 
-// 
-// xmem_pool_t : public interfaces
-// 
+    xclass_list_unlink(xchunk_ptr);
+
+    xmpool_ptr->xlarge_count -= 1;
+    xmpool_ptr->xlarge_bytes -= xchunk_ptr->xchunk_size;
+}
 
 /**********************************************************/
 /**
- * @brief 创建 内存池对象。
- * 
- * @param [in ] xfunc_alloc : 申请堆内存块的接口。
- * @param [in ] xfunc_free  : 释放堆内存块的接口。
- * @param [in ] xht_context : 调用 xfunc_alloc/xfunc_free 时回调的上下文句柄。
+ * @brief 释放大块缓存中最早回收的 chunk 对象，直至满足指定的上限。
  * 
- * @return xmpool_handle_t
- *         - 成功，返回 内存池对象 的操作句柄。
- *         - 失败，返回 X_NULL。
+ * @param [in ] xmpool_ptr  : 内存池对象。
+ * @param [in ] xut_count   : 保留的 chunk 对象数量上限。
+ * @param [in ] xsize_bytes : 保留的 chunk 对象总大小上限。
  */
-xmpool_handle_t xmpool_create(xfunc_alloc_t xfunc_alloc,
-                              xfunc_free_t xfunc_free,
-                              x_handle_t xht_context)
+static x_void_t xmpool_large_trim(
+                        xmpool_handle_t xmpool_ptr,
+                        x_uint32_t xut_count,
+                        x_uint64_t xsize_bytes)
 {
-    xrbt_callback_t xcallback =
-    {
-        /* .xfunc_n_memalloc = */ &xrbtree_node_memalloc ,
-        /* .xfunc_n_memfree  = */ &xrbtree_node_memfree  ,
-        /* .xfunc_k_copyfrom = */ &xrbtree_chunk_copyfrom,
-        /* .xfunc_k_destruct = */ &xrbtree_chunk_destruct,
-        /* .xfunc_k_lesscomp = */ &xrbtree_chunk_compare ,
-        /* .xctxt_t_callback = */ XRBT_NULL
-    };
+    xchunk_handle_t xchunk_ptr = X_NULL;
 
-    xmpool_handle_t xmpool_ptr =
-        (xmpool_handle_t)xmem_heap_alloc(sizeof(xmem_pool_t), X_NULL, X_NULL);
+    while ((xmpool_ptr->xlarge_count > xut_count) ||
+           (xmpool_ptr->xlarge_bytes > xsize_bytes))
+    {
+        xchunk_ptr = XMPOOL_LARGE_BACK(xmpool_ptr);
+        xmpool_large_unlink(xmpool_ptr, xchunk_ptr);
 
-    XASSERT(X_NULL != xmpool_ptr);
+        if (!xmpool_dealloc_chunk(xmpool_ptr, xchunk_ptr))
+        {
+            XASSERT(X_FALSE);
+        }
+    }
+}
 
-    xmpool_ptr->xfunc_alloc = (X_NULL != xfunc_alloc) ? xfunc_alloc : &xmem_heap_alloc;
-    xmpool_ptr->xfunc_free  = (X_NULL != xfunc_free ) ? xfunc_free  : &xmem_heap_free ;
-    xmpool_ptr->xht_context = xht_context;
+/**********************************************************/
+/**
+ * @brief 回收（已不再使用的）大块 chunk 对象：放入大块缓存，或直接释放。
+ * @note
+ * 单个 chunk 对象超过大块缓存上限的 1/4 时直接释放，以免挤占其他缓存；
+ * 否则挂入大块缓存头部，并按数量与总大小上限释放最早回收的 chunk 对象。
+ */
+static x_void_t xmpool_large_cache(
+                        xmpool_handle_t xmpool_ptr,
+                        xchunk_handle_t xchunk_ptr)
+{
+    XASSERT(0 == XSLICE_QUEUE_CAPACITY(xchunk_ptr));
+    XASSERT(!XCHUNK_IS_CACHED(xchunk_ptr));
 
-    xmpool_ptr->xsize_cached = 0;
-    xmpool_ptr->xsize_valid  = 0;
-    xmpool_ptr->xsize_using  = 0;
+    if (xchunk_ptr == xmpool_ptr->xchunk_cptr)
+    {
+        xmpool_ptr->xchunk_cptr = X_NULL;
+    }
 
-    xmpool_ptr->xut_worktid   = xsys_tid();
-    xmpool_ptr->xspinlock_que = 0;
-    xsrque_init(&xmpool_ptr->xslice_rqueue);
+    if (xchunk_ptr->xchunk_size > (xmpool_ptr->xlarge_limit / 4))
+    {
+        if (!xmpool_dealloc_chunk(xmpool_ptr, xchunk_ptr))
+        {
+            XASSERT(X_FALSE);
+        }
 
-    xcallback.xctxt_t_callback = xmpool_ptr;
-    XASSERT(XMPOOL_RBTREE_SIZE >= xrbtree_sizeof());
-    xrbtree_emplace_create(XMPOOL_RBTREE(xmpool_ptr),
-                           sizeof(xchunk_handle_t),
-                           &xcallback);
+        return;
+    }
 
-    xmpool_ptr->xchunk_cptr = X_NULL;
+    xmpool_large_trim(xmpool_ptr,
+                      XMPOOL_LARGE_CACHE_COUNT - 1,
+                      xmpool_ptr->xlarge_limit - xchunk_ptr->xchunk_size);
 
-    xmpool_class_initialize(xmpool_ptr);
+    xchunk_ptr->xlist_node.xchunk_prev = XMPOOL_LARGE_HEAD(xmpool_ptr);
+    xchunk_ptr->xlist_node.xchunk_next = XMPOOL_LARGE_FRONT(xmpool_ptr);
+    XMPOOL_LARGE_FRONT(xmpool_ptr)->xlist_node.xchunk_prev = xchunk_ptr;
+    XMPOOL_LARGE_HEAD(xmpool_ptr)->xlist_node.xchunk_next  = xchunk_ptr;
 
-    return xmpool_ptr;
+    xmpool_ptr->xlarge_count += 1;
+    xmpool_ptr->xlarge_bytes += xchunk_ptr->xchunk_size;
+    xmpool_ptr->xlarge_added += xchunk_ptr->xchunk_size;
 }
 
 /**********************************************************/
 /**
- * @brief 销毁内存池对象。
+ * @brief 从大块缓存中，按最佳适配（不小于所需大小的最小者）取出 chunk 对象。
+ * @note
+ * 尾部余量超出 XMPOOL_LARGE_SLACK() 时，先经 xfunc_resize 接口将其原地收缩
+ * （多余的尾部归还给系统），无法收缩的则不复用。
+ * 
+ * @param [in ] xmpool_ptr  : 内存池对象。
+ * @param [in ] xchunk_size : 所需的 chunk 对象大小（按页对齐）。
+ * @param [in ] xut_offset  : 分片在 chunk 对象中的起始偏移量。
+ * 
+ * @return xchunk_handle_t
+ *         - 成功，返回 chunk 对象（已设置好分片的偏移量与大小）；
+ *         - 失败，返回 X_NULL。
  */
-x_void_t xmpool_destroy(xmpool_handle_t xmpool_ptr)
+static xchunk_handle_t xmpool_large_reuse(
+                            xmpool_handle_t xmpool_ptr,
+                            x_uint32_t xchunk_size,
+                            x_uint32_t xut_offset)
 {
-    XASSERT(X_NULL != xmpool_ptr);
-    XASSERT(0 == xmpool_ptr->xsize_using);
+    xchunk_handle_t xchunk_ptr = X_NULL;
+    xchunk_handle_t xchunk_fit = X_NULL;
 
-    xmpool_ptr->xut_worktid   = 0;
-    xmpool_ptr->xspinlock_que = 0;
-    xsrque_release(&xmpool_ptr->xslice_rqueue);
+    for (xchunk_ptr  = XMPOOL_LARGE_FRONT(xmpool_ptr);
+         xchunk_ptr != XMPOOL_LARGE_TAIL(xmpool_ptr);
+         xchunk_ptr  = xchunk_ptr->xlist_node.xchunk_next)
+    {
+        if ((xchunk_ptr->xchunk_size >= xchunk_size) &&
+            ((X_NULL == xchunk_fit) ||
+             (xchunk_ptr->xchunk_size < xchunk_fit->xchunk_size)))
+        {
+            xchunk_fit = xchunk_ptr;
+            if (xchunk_fit->xchunk_size == xchunk_size)
+                break;
+        }
+    }
 
-    xrbtree_emplace_destroy(XMPOOL_RBTREE(xmpool_ptr));
-    xmpool_class_release(xmpool_ptr);
+    if (X_NULL == xchunk_fit)
+    {
+        return X_NULL;
+    }
 
-    xmpool_ptr->xfunc_alloc  = X_NULL;
-    xmpool_ptr->xfunc_free   = X_NULL;
-    xmpool_ptr->xht_context  = X_NULL;
-    xmpool_ptr->xsize_cached = 0;
-    xmpool_ptr->xsize_valid  = 0;
-    xmpool_ptr->xsize_using  = 0;
-    xmpool_ptr->xchunk_cptr  = X_NULL;
+    if ((xchunk_fit->xchunk_size - xchunk_size) > XMPOOL_LARGE_SLACK(xchunk_size))
+    {
+        if ((X_NULL == xmpool_ptr->xfunc_resize) ||
+            !xmpool_ptr->xfunc_resize(xchunk_fit,
+                                      xchunk_fit->xchunk_size,
+                                      xchunk_size,
+                                      (x_handle_t)xmpool_ptr,
+                                      xmpool_ptr->xht_context))
+        {
+            return X_NULL;
+        }
+
+        xmpool_ptr->xlarge_bytes -= (xchunk_fit->xchunk_size - xchunk_size);
+        xmpool_ptr->xsize_cached -= (xchunk_fit->xchunk_size - xchunk_size);
+        xmpool_ptr->xsize_valid  -= (xchunk_fit->xchunk_size - xchunk_size);
+
+        // 非工作线程查找红黑树时会读取 xchunk_size，须与之互斥
+        xatomic_spin_lock(&xmpool_ptr->xspinlock_tree);
+        xchunk_fit->xchunk_size = xchunk_size;
+        xatomic_spin_unlock(&xmpool_ptr->xspinlock_tree);
+    }
 
-    xmem_heap_free(xmpool_ptr, sizeof(xmem_pool_t), X_NULL, X_NULL);
+    xmpool_large_unlink(xmpool_ptr, xchunk_fit);
+
+    // 按本次申请的偏移量（对齐要求）重新布局分片
+    xmpool_ptr->xsize_valid += XSLICE_QUEUE(xchunk_fit).xut_offset;
+    xmpool_ptr->xsize_valid -= xut_offset;
+
+    xatomic_spin_lock(&xmpool_ptr->xspinlock_tree);
+    XSLICE_QUEUE(xchunk_fit).xut_offset = xut_offset;
+    xchunk_fit->xslice_size = xchunk_fit->xchunk_size - xut_offset;
+    xatomic_spin_unlock(&xmpool_ptr->xspinlock_tree);
+
+    return xchunk_fit;
 }
 
 /**********************************************************/
 /**
- * @brief 内存池对象 所隶属的工作线程 ID。
+ * @brief 对申请到的分片进行一次采样（只在工作线程中调用）。
+ * @note
+ * 记录分片的调用栈，并标记其所在的 chunk 对象（参看 XCHUNK_PROF_ERASE()），
+ * 之后重新计算距离下一次采样的字节数。
+ * 
+ * @param [in ] xmpool_ptr : 内存池对象。
+ * @param [in ] xmem_slice : 申请到的分片。
+ * @param [in ] xut_size   : 申请的大小。
  */
-x_uint32_t xmpool_worktid(xmpool_handle_t xmpool_ptr)
+static x_void_t xmpool_prof_sample(
+                    xmpool_handle_t xmpool_ptr,
+                    xmem_slice_t xmem_slice,
+                    x_uint32_t xut_size)
 {
-    XASSERT(X_NULL != xmpool_ptr);
-    return xmpool_ptr->xut_worktid;
+    xchunk_handle_t xchunk_ptr = xmpool_hit_chunk(xmpool_ptr, xmem_slice);
+
+    xmpool_ptr->xprof_left =
+        xmprof_next_sample(xmpool_ptr->xprof_ptr, &xmpool_ptr->xprof_seed);
+
+    // 略去 xmpool_prof_sample() 与 xmpool_alloc() 等申请接口的栈帧
+    if ((X_NULL != xchunk_ptr) &&
+        (xchunk_ptr->xut_sampled < 0xFFFF) &&
+        xmprof_record(xmpool_ptr->xprof_ptr, (x_handle_t)xmpool_ptr,
+                      xmem_slice, xut_size, 2))
+    {
+        xchunk_ptr->xut_sampled += 1;
+    }
 }
 
+/** 申请到分片后，按申请的字节数递减采样计数，减至负数时进行一次采样 */
+#define XMPOOL_PROF_ALLOC(xmpool_ptr, xmem_slice, xut_size)                 \
+    do                                                                      \
+    {                                                                       \
+        if ((X_NULL != (xmpool_ptr)->xprof_ptr) && (X_NULL != (xmem_slice)) && \
+            (((xmpool_ptr)->xprof_left -= (xut_size)) < 0))                 \
+        {                                                                   \
+            xmpool_prof_sample((xmpool_ptr), (xmem_slice), (xut_size));     \
+        }                                                                   \
+    } while (0)
+
 /**********************************************************/
 /**
- * @brief 设置 内存池对象 所隶属的工作线程 ID。
+ * @brief 申请（非分类管理的）大块分片，其独占一个 chunk 对象。
+ * 
+ * @param [in ] xmpool_ptr : 内存池对象。
+ * @param [in ] xut_size   : 申请的分片大小（大于内存池对象的 xslice_max）。
+ * @param [in ] xut_offset : 分片在 chunk 对象中的起始偏移量，
+ *                           其对齐值即为分片地址的对齐值（不大于 XMEM_PAGE_SIZE）。
+ * 
+ * @return xmem_slice_t
+ *         - 成功，返回 内存分片；
+ *         - 失败，返回 X_NULL 。
  */
-x_void_t xmpool_set_worktid(xmpool_handle_t xmpool_ptr, x_uint32_t xut_worktid)
+static xmem_slice_t xmpool_alloc_large(
+                        xmpool_handle_t xmpool_ptr,
+                        x_uint32_t xut_size,
+                        x_uint32_t xut_offset)
 {
-    XASSERT(X_NULL != xmpool_ptr);
-    xmpool_ptr->xut_worktid = xut_worktid;
+    XASSERT(xut_size > xmpool_ptr->xslice_max);
+    XASSERT(xut_offset >= sizeof(xmem_chunk_t));
+
+    xchunk_handle_t xchunk_ptr = X_NULL;
+
+    xmpool_drain_remote(xmpool_ptr);
+
+    if (xut_size > (0xFFFFFFFF - xut_offset - XMEM_PAGE_SIZE))
+        return X_NULL;
+
+    xut_size = X_ALIGN(xut_size + xut_offset, XMEM_PAGE_SIZE);
+
+    // 优先复用大块缓存中的 chunk 对象
+    xchunk_ptr = xmpool_large_reuse(xmpool_ptr, xut_size, xut_offset);
+    if (X_NULL == xchunk_ptr)
+    {
+        xchunk_ptr = xmpool_alloc_chunk(xmpool_ptr, xut_size, xut_size - xut_offset);
+        if (X_NULL == xchunk_ptr)
+        {
+            return X_NULL;
+        }
+    }
+
+    xmpool_ptr->xsize_using += xchunk_ptr->xslice_size;
+    xmpool_ptr->xchunk_cptr  = xchunk_ptr;
+    xmpool_ptr->xstat_lalloc += 1;
+
+    return XSLICE_QUEUE_BEGIN(xchunk_ptr);
 }
 
 /**********************************************************/
 /**
- * @brief 内存池对象 总共缓存的内存大小。
+ * @brief 按保留上限，释放内存池中多余的 空闲 chunk 对象（只在工作线程中调用）。
+ * @note
+ * 先处理 xclass_trim 标记的 class 对象：超出 xidle_chunks 的 空闲 chunk 对象被释放；
+ * 之后若所有 空闲 chunk 对象的总大小仍超出 xidle_bytes，再依次从各个 class 对象中释放。
+ * 释放时从 XCHUNK_LIST_IDLE 链表的尾部（最早转入空闲状态的）开始，
+ * 仍有其他线程的回收操作在进行中的 chunk 对象（参看 XCHUNK_RFREE_QUIET）不能释放，
+ * 其所在的 class 对象重新标记到 xclass_trim，留待下次处理。
+ * 
+ * @param [in ] xmpool_ptr : 内存池对象。
  */
-x_uint64_t xmpool_cached_size(xmpool_handle_t xmpool_ptr)
+static x_void_t xmpool_trim_idle(xmpool_handle_t xmpool_ptr)
 {
-    XASSERT(X_NULL != xmpool_ptr);
-    return xmpool_ptr->xsize_cached;
+#define XCLASS_OVER_RETAIN(xclass_ptr)                          \
+    (((xclass_ptr)->xidle_count > xmpool_ptr->xidle_chunks) ||  \
+     (xmpool_ptr->xsize_idle > xmpool_ptr->xidle_bytes))
+
+    xclass_handle_t xclass_ptr  = xmpool_ptr->xclass_trim;
+    xclass_handle_t xclass_busy = X_NULL;
+    xchunk_handle_t xchunk_ptr  = X_NULL;
+    xchunk_handle_t xchunk_tmp  = X_NULL;
+    x_int32_t       xit_iter    = -1;
+
+    xmpool_ptr->xclass_trim = X_NULL;
+
+    while (X_NULL != xclass_ptr)
+    {
+        for (xchunk_ptr = XCLASS_LIST_BACK(xclass_ptr, XCHUNK_LIST_IDLE);
+             (xchunk_ptr != XCLASS_LIST_HEAD(xclass_ptr, XCHUNK_LIST_IDLE)) &&
+             XCLASS_OVER_RETAIN(xclass_ptr);)
+        {
+            XASSERT(XCHUNK_IS_IDLE(xchunk_ptr));
+
+            xchunk_tmp = xchunk_ptr->xlist_node.xchunk_prev;
+
+            if (XCHUNK_RFREE_QUIET(xchunk_ptr))
+            {
+                if (xmpool_ptr->xchunk_cptr == xchunk_ptr)
+                {
+                    xmpool_ptr->xchunk_cptr = X_NULL;
+                }
+
+                xmpool_dealloc_chunk(xmpool_ptr, xchunk_ptr);
+            }
+            else
+            {
+                xclass_busy = xclass_ptr;
+            }
+
+            xchunk_ptr = xchunk_tmp;
+        }
+
+        if (xmpool_ptr->xsize_idle <= xmpool_ptr->xidle_bytes)
+        {
+            break;
+        }
+
+        // 总大小仍超出上限，依次处理各个 class 对象
+        xit_iter  += 1;
+        xclass_ptr = (xit_iter < (x_int32_t)xmpool_ptr->xclass_count) ?
+                        &xmpool_ptr->xclass_ptr[xit_iter] : X_NULL;
+    }
+
+    // 工作线程取回这些 chunk 对象的待回收分片之后，下次回收操作时再检查
+    xmpool_ptr->xclass_trim = xclass_busy;
+
+#undef XCLASS_OVER_RETAIN
+}
+
+/**********************************************************/
+/**
+ * @brief 按衰减操作计算出的超出量，将 空闲 chunk 对象归还给系统（只在工作线程中调用）。
+ * @note
+ * 依次从各个 class 对象 XCHUNK_LIST_IDLE 链表的尾部（最早转入空闲状态的）开始，
+ * 以 chunk 对象为单位（剩余超出量不小于其一半时）进行处理，
+ * 仍有其他线程的回收操作在进行中的不做处理（参看 XCHUNK_RFREE_QUIET）。
+ * 
+ * @param [in ] xmpool_ptr   : 内存池对象。
+ * @param [in ] xsize_excess : 超出允许保留大小的部分。
+ * @param [in ] xbt_purged   : 为 X_TRUE 时，释放已归还物理内存的 chunk 对象；
+ *                             否则，归还未归还物理内存的 chunk 对象的物理内存。
+ * 
+ * @return x_uint64_t
+ *         - 返回归还给系统的内存大小。
+ */
+static x_uint64_t xmpool_decay_chunks(
+                        xmpool_handle_t xmpool_ptr,
+                        x_uint64_t xsize_excess,
+                        x_bool_t xbt_purged)
+{
+    xclass_handle_t xclass_ptr = X_NULL;
+    xchunk_handle_t xchunk_ptr = X_NULL;
+    xchunk_handle_t xchunk_tmp = X_NULL;
+    x_uint64_t      xsize_free = 0;
+    x_int32_t       xit_iter   = 0;
+
+    for (xit_iter = 0; (xit_iter < (x_int32_t)xmpool_ptr->xclass_count) && (xsize_excess > 0); ++xit_iter)
+    {
+        xclass_ptr = &xmpool_ptr->xclass_ptr[xit_iter];
+
+        for (xchunk_ptr = XCLASS_LIST_BACK(xclass_ptr, XCHUNK_LIST_IDLE);
+             (xchunk_ptr != XCLASS_LIST_HEAD(xclass_ptr, XCHUNK_LIST_IDLE)) &&
+             (xsize_excess > 0);
+             xchunk_ptr = xchunk_tmp)
+        {
+            XASSERT(XCHUNK_IS_IDLE(xchunk_ptr));
+
+            xchunk_tmp = xchunk_ptr->xlist_node.xchunk_prev;
+
+            if (!XCHUNK_RFREE_QUIET(xchunk_ptr) ||
+                (xbt_purged != (0 != xchunk_ptr->xut_purged)) ||
+                (xsize_excess < (xchunk_ptr->xchunk_size / 2)))
+            {
+                continue;
+            }
+
+            xsize_excess -= (xsize_excess > xchunk_ptr->xchunk_size) ?
+                                xchunk_ptr->xchunk_size : xsize_excess;
+            xsize_free   += xchunk_ptr->xchunk_size;
+
+            if (xbt_purged)
+            {
+                if (xmpool_ptr->xchunk_cptr == xchunk_ptr)
+                {
+                    xmpool_ptr->xchunk_cptr = X_NULL;
+                }
+
+                xmpool_dealloc_chunk(xmpool_ptr, xchunk_ptr);
+            }
+            else
+            {
+                // chunk 头部（含分片索引号队列所在分页之前的部分）须保持有效，
+                // 空闲 chunk 对象的分片队列为空，队列及分片内容均无需保留
+                // 分页位标识数组也在归还的范围内，须先清零
+                xchunk_page_reset(xmpool_ptr, xchunk_ptr);
+
+                xsys_heap_purge(XSLICE_QUEUE(xchunk_ptr).xut_index,
+                                (x_size_t)(XCHUNK_RADDR(xchunk_ptr) -
+                                (xmem_slice_t)XSLICE_QUEUE(xchunk_ptr).xut_index));
+
+                xchunk_ptr->xut_purged    = 1;
+                xmpool_ptr->xsize_purged += xchunk_ptr->xchunk_size;
+                xmpool_ptr->xmuzzy_added += xchunk_ptr->xchunk_size;
+            }
+        }
+    }
+
+    return xsize_free;
+}
+
+/**********************************************************/
+/**
+ * @brief 将 class 对象弹匣底部（最早压入）的分片归还至各自的 chunk 对象，
+ *        只保留顶部的 xut_keep 个分片。
+ * @note  弹匣中的分片已不计入 xsize_using，此处无需再调整。
+ * 
+ * @param [in ] xmpool_ptr : 内存池对象。
+ * @param [in ] xclass_ptr : class 对象。
+ * @param [in ] xut_keep   : 弹匣中保留的分片数量。
+ */
+static x_void_t xmpool_magazine_flush(
+                        xmpool_handle_t xmpool_ptr,
+                        xclass_handle_t xclass_ptr,
+                        x_uint32_t xut_keep)
+{
+    xchunk_handle_t xchunk_ptr = X_NULL;
+    xmem_slice_t    xmem_slice = X_NULL;
+    x_uint32_t      xut_iter   = 0;
+    x_uint32_t      xut_flush  = 0;
+
+    if (xclass_ptr->xmag_count <= xut_keep)
+    {
+        return;
+    }
+
+    xut_flush = xclass_ptr->xmag_count - xut_keep;
+
+    for (xut_iter = 0; xut_iter < xut_flush; ++xut_iter)
+    {
+        xmem_slice = xclass_ptr->xmag_slice[xut_iter];
+
+        // 沿用上一个分片所在的 chunk 对象
+        if ((X_NULL == xchunk_ptr) ||
+            (xmem_slice <= XCHUNK_LADDR(xchunk_ptr)) ||
+            (xmem_slice >= XCHUNK_RADDR(xchunk_ptr)))
+        {
+            xchunk_ptr = xmpool_class_hit_chunk(xmpool_ptr, xclass_ptr, xmem_slice);
+            XASSERT((X_NULL != xchunk_ptr) &&
+                    (xclass_ptr == xchunk_ptr->xowner.xclass_ptr));
+        }
+
+        if (XMEM_ERR_OK != xchunk_recyc_slice(xchunk_ptr, xmem_slice))
+        {
+            XASSERT(X_FALSE);
+        }
+    }
+
+    for (xut_iter = 0; xut_iter < xut_keep; ++xut_iter)
+    {
+        xclass_ptr->xmag_slice[xut_iter] =
+            xclass_ptr->xmag_slice[xut_flush + xut_iter];
+    }
+
+    xclass_ptr->xmag_count = xut_keep;
+    xclass_ptr->xchunk_rptr = xchunk_ptr;
+}
+
+/**********************************************************/
+/**
+ * @brief 清空内存池对象所有 class 对象的分片弹匣。
+ */
+static x_void_t xmpool_magazine_flush_all(xmpool_handle_t xmpool_ptr)
+{
+    x_int32_t xit_iter = 0;
+
+    for (xit_iter = 0; xit_iter < (x_int32_t)xmpool_ptr->xclass_count; ++xit_iter)
+    {
+        xmpool_magazine_flush(xmpool_ptr, &xmpool_ptr->xclass_ptr[xit_iter], 0);
+    }
+}
+
+/**********************************************************/
+/**
+ * @brief 以批量的方式从 chunk 对象补充 class 对象的（已空的）分片弹匣，
+ *        并从中申请一个分片。
+ * @note
+ * 一次补充弹匣容量的一半，留出的另一半空位供随后的回收操作使用；
+ * 分片逆序存放，使得连续申请的分片地址递增。
+ * 
+ * @param [in ] xmpool_ptr : 内存池对象。
+ * @param [in ] xclass_ptr : class 对象。
+ * 
+ * @return xmem_slice_t
+ *         - 成功，返回 内存分片；
+ *         - 失败，返回 X_NULL。
+ */
+static xmem_slice_t xmpool_magazine_refill(
+                        xmpool_handle_t xmpool_ptr,
+                        xclass_handle_t xclass_ptr)
+{
+    XASSERT(0 == xclass_ptr->xmag_count);
+
+    xchunk_handle_t xchunk_ptr = xmpool_ptr->xchunk_cptr;
+    xmem_slice_t    xmem_slice = X_NULL;
+    x_uint32_t      xut_count  = 0;
+    x_uint32_t      xut_iter   = 0;
+    x_uint32_t      xut_refill = (xclass_ptr->xmag_limit + 1) / 2;
+
+    //======================================
+
+    if ((X_NULL != xchunk_ptr) &&
+        (xclass_ptr->xslice_size == xchunk_ptr->xslice_size))
+    {
+        xut_count = xchunk_alloc_batch(xchunk_ptr, xut_refill, xclass_ptr->xmag_slice);
+    }
+
+    if (0 == xut_count)
+    {
+        xclass_ptr->xstat_slow += 1;
+
+        // 慢速路径中，顺带回收其他线程投递过来的分片
+        xmpool_drain_remote(xmpool_ptr);
+
+        xchunk_ptr = xclass_get_non_empty_chunk(xclass_ptr);
+        if (X_NULL == xchunk_ptr)
+        {
+            xchunk_ptr = xmpool_alloc_chunk(
+                                xmpool_ptr,
+                                xclass_chunk_size(xclass_ptr),
+                                xclass_ptr->xslice_size);
+            if (X_NULL == xchunk_ptr)
+            {
+                return X_NULL;
+            }
+
+            xchunk_ptr->xowner.xclass_ptr = xclass_ptr;
+            xclass_list_push_chunk(xclass_ptr, xchunk_ptr);
+        }
+
+        xut_count = xchunk_alloc_batch(xchunk_ptr, xut_refill, xclass_ptr->xmag_slice);
+        XASSERT(xut_count > 0);
+    }
+
+    xmpool_ptr->xchunk_cptr = xchunk_ptr;
+
+    //======================================
+
+    for (xut_iter = 0; xut_iter < xut_count / 2; ++xut_iter)
+    {
+        xmem_slice = xclass_ptr->xmag_slice[xut_iter];
+        xclass_ptr->xmag_slice[xut_iter] = xclass_ptr->xmag_slice[xut_count - 1 - xut_iter];
+        xclass_ptr->xmag_slice[xut_count - 1 - xut_iter] = xmem_slice;
+    }
+
+    xclass_ptr->xmag_count   = xut_count - 1;
+    xmpool_ptr->xsize_using += xclass_ptr->xslice_size;
+
+    return xclass_ptr->xmag_slice[xut_count - 1];
+}
+
+/**********************************************************/
+/**
+ * @brief 将（隶属于 chunk 对象的）内存分片压入其 class 对象的分片弹匣。
+ * @note
+ * 弹匣已满时，先将其底部一半的分片归还至 chunk 对象；
+ * 已归还至 chunk 对象的分片被重复回收时，仍返回 XMEM_ERR_RECYCLED。
+ * 
+ * @param [in ] xmpool_ptr : 内存池对象。
+ * @param [in ] xchunk_ptr : 分片所在的 chunk 对象（分片容量须大于 0）。
+ * @param [in ] xmem_slice : 待回收的内存分片。
+ * 
+ * @return x_int32_t
+ *         - 成功，返回 XMEM_ERR_OK；
+ *         - 失败，返回 错误码（参看 @see xmem_err_code 枚举值）。
+ */
+static x_int32_t xmpool_magazine_push(
+                        xmpool_handle_t xmpool_ptr,
+                        xchunk_handle_t xchunk_ptr,
+                        xmem_slice_t xmem_slice)
+{
+    XASSERT(XSLICE_QUEUE_CAPACITY(xchunk_ptr) > 0);
+
+    xclass_handle_t xclass_ptr = xchunk_ptr->xowner.xclass_ptr;
+    x_uint32_t      xut_offset = 0;
+    x_uint32_t      xut_index  = 0;
+
+    //======================================
+
+    xut_offset = (x_uint32_t)(xmem_slice - XCHUNK_LADDR(xchunk_ptr));
+    if (xut_offset < XSLICE_QUEUE(xchunk_ptr).xut_offset)
+    {
+        return XMEM_ERR_UNALIGNED;
+    }
+
+    xut_offset -= XSLICE_QUEUE(xchunk_ptr).xut_offset;
+    xut_index   = xut_offset / xchunk_ptr->xslice_size;
+    if (xut_offset != (xut_index * xchunk_ptr->xslice_size))
+    {
+        return XMEM_ERR_UNALIGNED;
+    }
+
+    if ((xut_index >= xchunk_ptr->xut_carve) ||
+        !XSLICE_QUEUE_IS_ALLOCATED(xchunk_ptr, xut_index, x_uint16_t))
+    {
+        return XMEM_ERR_RECYCLED;
+    }
+
+#if ENABLE_XASSERT
+    for (xut_index = 0; xut_index < xclass_ptr->xmag_count; ++xut_index)
+    {
+        XASSERT(xmem_slice != xclass_ptr->xmag_slice[xut_index]);
+    }
+#endif // ENABLE_XASSERT
+
+    //======================================
+
+    if (xclass_ptr->xmag_count >= xclass_ptr->xmag_limit)
+    {
+        xmpool_magazine_flush(xmpool_ptr, xclass_ptr, xclass_ptr->xmag_limit / 2);
+    }
+
+    xclass_ptr->xmag_slice[xclass_ptr->xmag_count++] = xmem_slice;
+    xclass_ptr->xstat_free  += 1;
+    XCHUNK_PROF_ERASE(xmpool_ptr, xchunk_ptr, xmem_slice);
+    xmpool_ptr->xsize_using -= xchunk_ptr->xslice_size;
+    xmpool_ptr->xchunk_cptr  = xchunk_ptr;
+
+    //======================================
+
+    return XMEM_ERR_OK;
+}
+
+/**********************************************************/
+/**
+ * @brief 在工作线程中回收内存分片（直接操作 chunk 对象的分片队列）。
+ * 
+ * @param [in ] xmpool_ptr : 内存池对象。
+ * @param [in ] xmem_slice : 待回收的内存分片。
+ * 
+ * @return x_int32_t
+ *         - 成功，返回 XMEM_ERR_OK；
+ *         - 失败，返回 错误码（参看 @see xmem_err_code 枚举值）。
+ */
+static x_int32_t xmpool_recyc_local(
+                        xmpool_handle_t xmpool_ptr,
+                        xmem_slice_t xmem_slice)
+{
+    x_int32_t xit_error = XMEM_ERR_UNKNOW;
+
+    //======================================
+
+    xchunk_handle_t xchunk_ptr = X_NULL;
+
+    if ((X_NULL != xmpool_ptr->xchunk_cptr) &&
+        (xmem_slice > XCHUNK_LADDR(xmpool_ptr->xchunk_cptr)) &&
+        (xmem_slice < XCHUNK_RADDR(xmpool_ptr->xchunk_cptr)))
+    {
+        xchunk_ptr = xmpool_ptr->xchunk_cptr;
+    }
+    else
+    {
+        xchunk_ptr = xmpool_hit_chunk(xmpool_ptr, xmem_slice);
+    }
+
+    if (X_NULL == xchunk_ptr)
+    {
+        return XMEM_ERR_NOT_FOUND;
+    }
+
+    //======================================
+    // 回收 slice
+
+    // 若 chunk 对象没有多个分片，则不属于分类管理的 chunk 对象，放入大块缓存（或直接删除）
+    if (XSLICE_QUEUE_CAPACITY(xchunk_ptr) == 0)
+    {
+        if (xmem_slice != XSLICE_QUEUE_BEGIN(xchunk_ptr))
+        {
+            return XMEM_ERR_UNALIGNED;
+        }
+
+        if (XCHUNK_IS_CACHED(xchunk_ptr))
+        {
+            return XMEM_ERR_RECYCLED;
+        }
+
+        xmpool_ptr->xsize_using -= xchunk_ptr->xslice_size;
+        xmpool_ptr->xstat_lfree += 1;
+        XCHUNK_PROF_ERASE(xmpool_ptr, xchunk_ptr, xmem_slice);
+        xmpool_large_cache(xmpool_ptr, xchunk_ptr);
+
+        return XMEM_ERR_OK;
+    }
+
+    if (XMPOOL_USE_MAGAZINE(xmpool_ptr))
+    {
+        return xmpool_magazine_push(xmpool_ptr, xchunk_ptr, xmem_slice);
+    }
+
+    // chunk 对象属于分类管理的 chunk 类型，需要进行 chunk 分片回收操作
+    xit_error = xchunk_recyc_slice(xchunk_ptr, xmem_slice);
+    if (XMEM_ERR_OK == xit_error)
+    {
+        xmpool_ptr->xsize_using -= xchunk_ptr->xslice_size;
+        xchunk_ptr->xowner.xclass_ptr->xchunk_rptr = xchunk_ptr;
+        xchunk_ptr->xowner.xclass_ptr->xstat_free += 1;
+        XCHUNK_PROF_ERASE(xmpool_ptr, xchunk_ptr, xmem_slice);
+    }
+
+    xmpool_ptr->xchunk_cptr = xchunk_ptr;
+
+    //======================================
+
+    return xit_error;
+}
+
+/**********************************************************/
+/**
+ * @brief 校验分片地址是否对齐于 chunk 对象的分片边界。
+ * @note  chunk 对象的分片布局在创建后不再变化，允许在非工作线程中调用。
+ */
+static inline x_bool_t xchunk_slice_aligned(
+                            xchunk_handle_t xchunk_ptr,
+                            xmem_slice_t xmem_slice)
+{
+    x_uint32_t xut_offset = (x_uint32_t)(xmem_slice - XCHUNK_LADDR(xchunk_ptr));
+
+    return ((xut_offset >= XSLICE_QUEUE(xchunk_ptr).xut_offset) &&
+            (0 == ((xut_offset - XSLICE_QUEUE(xchunk_ptr).xut_offset) %
+                   XSLICE_MSIZE(xchunk_ptr))));
+}
+
+/**********************************************************/
+/**
+ * @brief 将（已串接好的）分片链压入 chunk 对象的待回收分片栈。
+ * @note
+ * 允许在非工作线程中调用。压栈时同时置位 XSLICE_RFREE_LINKED 标志位，
+ * 由置位该标志位的首个线程负责将 chunk 对象挂入内存池的 xchunk_rlist 链表。
+ * 在工作线程取回该 chunk 对象之前，xslice_rfree 一直不为 X_NULL，
+ * chunk 对象不会被释放，故挂链操作（本函数对 chunk 对象的最后一次访问）是安全的。
+ * 
+ * @param [in ] xmpool_ptr  : 内存池对象。
+ * @param [in ] xchunk_ptr  : 分片链所在的 chunk 对象。
+ * @param [in ] xslice_head : 分片链的首个分片。
+ * @param [in ] xslice_tail : 分片链的末尾分片。
+ */
+static x_void_t xmpool_rfree_push(
+                    xmpool_handle_t xmpool_ptr,
+                    xchunk_handle_t xchunk_ptr,
+                    xmem_slice_t xslice_head,
+                    xmem_slice_t xslice_tail)
+{
+    xchunk_handle_t xchunk_head = X_NULL;
+    xmem_slice_t    xslice_top  = X_NULL;
+
+    //======================================
+    // 压入 chunk 对象的待回收分片栈
+
+    do
+    {
+        xslice_top = XCHUNK_RFREE_LOAD(xchunk_ptr);
+        XSLICE_RFREE_NEXT(xslice_tail) = XSLICE_RFREE_TOP(xslice_top);
+    } while (xslice_top != (xmem_slice_t)xatomic_cmpxchg_ptr(
+                                (x_void_t * volatile *)&xchunk_ptr->xslice_rfree,
+                                (x_void_t *)((x_size_t)xslice_head | XSLICE_RFREE_LINKED),
+                                xslice_top));
+
+    //======================================
+    // 由首个置位 XSLICE_RFREE_LINKED 的线程，将 chunk 对象挂入内存池的 xchunk_rlist 链表
+
+    if (0 == ((x_size_t)xslice_top & XSLICE_RFREE_LINKED))
+    {
+        do
+        {
+            xchunk_head = (xchunk_handle_t)xatomic_load_ptr(
+                                (x_void_t * volatile *)&xmpool_ptr->xchunk_rlist);
+            xchunk_ptr->xchunk_rnext = xchunk_head;
+        } while (xchunk_head != (xchunk_handle_t)xatomic_cmpxchg_ptr(
+                                    (x_void_t * volatile *)&xmpool_ptr->xchunk_rlist,
+                                    xchunk_ptr,
+                                    xchunk_head));
+    }
+}
+
+/**********************************************************/
+/**
+ * @brief 在非工作线程中回收内存分片（压入分片所在 chunk 对象的待回收分片栈）。
+ * 
+ * @param [in ] xmpool_ptr : 内存池对象。
+ * @param [in ] xmem_slice : 待回收的内存分片。
+ * 
+ * @return x_int32_t
+ *         - 成功，返回 XMEM_ERR_OK；
+ *         - 失败，返回 错误码（参看 @see xmem_err_code 枚举值）。
+ */
+static x_int32_t xmpool_recyc_remote(
+                        xmpool_handle_t xmpool_ptr,
+                        xmem_slice_t xmem_slice)
+{
+    xchunk_handle_t xchunk_ptr = xmpool_hit_chunk(xmpool_ptr, xmem_slice);
+    if (X_NULL == xchunk_ptr)
+    {
+        return XMEM_ERR_NOT_FOUND;
+    }
+
+    if (!xchunk_slice_aligned(xchunk_ptr, xmem_slice))
+    {
+        return XMEM_ERR_UNALIGNED;
+    }
+
+    xmpool_rfree_push(xmpool_ptr, xchunk_ptr, xmem_slice, xmem_slice);
+
+    return XMEM_ERR_OK;
+}
+
+/**********************************************************/
+/**
+ * @brief 工作线程回收 xchunk_rlist 链表中各个 chunk 对象的待回收分片。
+ * 
+ * @param [in ] xmpool_ptr : 内存池对象。
+ * 
+ * @return x_uint32_t
+ *         - 返回本次回收的分片数量。
+ */
+static x_uint32_t xmpool_drain_remote(xmpool_handle_t xmpool_ptr)
+{
+    xchunk_handle_t xchunk_ptr  = X_NULL;
+    xchunk_handle_t xchunk_next = X_NULL;
+    x_uint32_t      xut_count   = 0;
+
+    // 此处只作（acquire 语义读取的）预判，避免在链表为空时进行原子交换操作
+    if (X_NULL == xatomic_load_ptr((x_void_t * volatile *)&xmpool_ptr->xchunk_rlist))
+    {
+        return 0;
+    }
+
+    xchunk_ptr = (xchunk_handle_t)xatomic_xchg_ptr(
+                    (x_void_t * volatile *)&xmpool_ptr->xchunk_rlist, X_NULL);
+
+    while (X_NULL != xchunk_ptr)
+    {
+        // 须在清除 XSLICE_RFREE_LINKED 标志位之前读取后继节点，
+        // 清除后 chunk 对象随时可能被其他线程重新挂入链表
+        xchunk_next = xchunk_ptr->xchunk_rnext;
+        xchunk_ptr->xchunk_rnext = X_NULL;
+        XASSERT(0 != ((x_size_t)XCHUNK_RFREE_LOAD(xchunk_ptr) & XSLICE_RFREE_LINKED));
+
+        if (XSLICE_QUEUE_CAPACITY(xchunk_ptr) > 0)
+        {
+            xut_count += xchunk_rfree_harvest(xchunk_ptr, X_TRUE);
+        }
+        else if ((X_NULL != XSLICE_RFREE_TOP(xatomic_xchg_ptr(
+                    (x_void_t * volatile *)&xchunk_ptr->xslice_rfree, X_NULL))) &&
+                 !XCHUNK_IS_CACHED(xchunk_ptr))
+        {
+            // 非分类管理的 chunk 对象只有一个分片，被回收后即可放入大块缓存（或直接删除）
+            xmpool_ptr->xsize_using -= xchunk_ptr->xslice_size;
+            xmpool_ptr->xstat_lfree += 1;
+            XCHUNK_PROF_ERASE(xmpool_ptr, xchunk_ptr, XSLICE_QUEUE_BEGIN(xchunk_ptr));
+            xmpool_large_cache(xmpool_ptr, xchunk_ptr);
+
+            xut_count += 1;
+        }
+
+        xchunk_ptr = xchunk_next;
+    }
+
+    return xut_count;
+}
+
+//====================================================================
+
+// 
+// xmem_pool_t : public interfaces
+// 
+
+/**********************************************************/
+/**
+ * @brief 创建 内存池对象。
+ * 
+ * @param [in ] xfunc_alloc : 申请堆内存块的接口。
+ * @param [in ] xfunc_free  : 释放堆内存块的接口。
+ * @param [in ] xht_context : 调用 xfunc_alloc/xfunc_free 时回调的上下文句柄。
+ * 
+ * @return xmpool_handle_t
+ *         - 成功，返回 内存池对象 的操作句柄。
+ *         - 失败，返回 X_NULL。
+ */
+xmpool_handle_t xmpool_create(xfunc_alloc_t xfunc_alloc,
+                              xfunc_free_t xfunc_free,
+                              x_handle_t xht_context)
+{
+    return xmpool_create_ex(xfunc_alloc, xfunc_free, xht_context, XMPOOL_FLAG_NONE);
+}
+
+/**********************************************************/
+/**
+ * @brief 创建 内存池对象（可指定工作模式）。
+ * 
+ * @param [in ] xfunc_alloc : 申请堆内存块的接口。
+ * @param [in ] xfunc_free  : 释放堆内存块的接口。
+ * @param [in ] xht_context : 调用 xfunc_alloc/xfunc_free 时回调的上下文句柄。
+ * @param [in ] xut_flags   : 工作模式标识位（参看 @see xmpool_flags 枚举值）。
+ * 
+ * @return xmpool_handle_t
+ *         - 成功，返回 内存池对象 的操作句柄。
+ *         - 失败，返回 X_NULL。
+ */
+xmpool_handle_t xmpool_create_ex(xfunc_alloc_t xfunc_alloc,
+                                 xfunc_free_t xfunc_free,
+                                 x_handle_t xht_context,
+                                 x_uint32_t xut_flags)
+{
+    return xmpool_create_classes(xfunc_alloc, xfunc_free, xht_context, xut_flags, X_NULL, 0);
+}
+
+/**********************************************************/
+/**
+ * @brief 以自定义的分类表创建 内存池对象。
+ * 
+ * @param [in ] xfunc_alloc  : 申请堆内存块的接口。
+ * @param [in ] xfunc_free   : 释放堆内存块的接口。
+ * @param [in ] xht_context  : 调用 xfunc_alloc/xfunc_free 时回调的上下文句柄。
+ * @param [in ] xut_flags    : 工作模式标识位（参看 @see xmpool_flags 枚举值）。
+ * @param [in ] xclass_table : 分类表（按分片大小升序排列，为 X_NULL 时使用默认分类表）。
+ * @param [in ] xut_count    : 分类表的分类数量。
+ * 
+ * @return xmpool_handle_t
+ *         - 成功，返回 内存池对象 的操作句柄。
+ *         - 失败（或分类表无效），返回 X_NULL。
+ */
+xmpool_handle_t xmpool_create_classes(xfunc_alloc_t xfunc_alloc,
+                                      xfunc_free_t xfunc_free,
+                                      x_handle_t xht_context,
+                                      x_uint32_t xut_flags,
+                                      const xmpool_class_t * xclass_table,
+                                      x_uint32_t xut_count)
+{
+    x_uint8_t * xindex_ptr = X_NULL;
+
+    xrbt_callback_t xcallback =
+    {
+        /* .xfunc_n_memalloc = */ &xrbtree_node_memalloc ,
+        /* .xfunc_n_memfree  = */ &xrbtree_node_memfree  ,
+        /* .xfunc_k_copyfrom = */ &xrbtree_chunk_copyfrom,
+        /* .xfunc_k_destruct = */ &xrbtree_chunk_destruct,
+        /* .xfunc_k_lesscomp = */ &xrbtree_chunk_compare ,
+        /* .xctxt_t_callback = */ XRBT_NULL
+    };
+
+    if (X_NULL != xclass_table)
+    {
+        if (!xmpool_class_table_check(xclass_table, xut_count, xut_flags))
+        {
+            return X_NULL;
+        }
+
+        xindex_ptr = xmpool_class_index_build(xclass_table, xut_count);
+        if (X_NULL == xindex_ptr)
+        {
+            return X_NULL;
+        }
+    }
+
+    xmpool_handle_t xmpool_ptr =
+        (xmpool_handle_t)xsys_heap_alloc(sizeof(xmem_pool_t));
+    if (X_NULL == xmpool_ptr)
+    {
+        if (X_NULL != xindex_ptr)
+        {
+            xsys_heap_free(xindex_ptr,
+                           XMPOOL_INDEX_SLOTS(xclass_table[xut_count - 1].xslice_size));
+        }
+        return X_NULL;
+    }
+
+    if (0 != (xut_flags & XMPOOL_FLAG_ALIGN_CHUNK))
+    {
+        xmpool_ptr->xfunc_alloc = (X_NULL != xfunc_alloc) ? xfunc_alloc : &xmem_heap_alloc_aligned;
+        xmpool_ptr->xfunc_free  = (X_NULL != xfunc_free ) ? xfunc_free  : &xmem_heap_free_aligned ;
+    }
+    else
+    {
+        xmpool_ptr->xfunc_alloc = (X_NULL != xfunc_alloc) ? xfunc_alloc : &xmem_heap_alloc;
+        xmpool_ptr->xfunc_free  = (X_NULL != xfunc_free ) ? xfunc_free  : &xmem_heap_free ;
+    }
+
+    // 只有默认的 堆内存块 接口，才可确定默认的原地调整接口适用
+    xmpool_ptr->xfunc_resize =
+        ((X_NULL == xfunc_alloc) && (X_NULL == xfunc_free)) ? &xmem_heap_resize : X_NULL;
+
+    xmpool_ptr->xht_context = xht_context;
+    xmpool_ptr->xut_flags   = xut_flags;
+
+    xmpool_ptr->xsize_cached = 0;
+    xmpool_ptr->xsize_valid  = 0;
+    xmpool_ptr->xsize_using  = 0;
+    xmpool_ptr->xsize_idle   = 0;
+    xmpool_ptr->xsize_pgpurged = 0;
+
+    xmpool_ptr->xidle_chunks = XMPOOL_RETAIN_CHUNKS;
+    xmpool_ptr->xidle_bytes  = XMPOOL_RETAIN_BYTES;
+    xmpool_ptr->xclass_trim  = X_NULL;
+
+    xmpool_ptr->xsize_purged = 0;
+    xmpool_ptr->xdecay_ms    = XMEM_DECAY_MS;
+    xmpool_ptr->xdecay_tick  = xsys_msecs();
+    xmpool_ptr->xdecay_dirty = 0;
+    xmpool_ptr->xdecay_muzzy = 0;
+    xmpool_ptr->xdirty_added = 0;
+    xmpool_ptr->xmuzzy_added = 0;
+
+    xmpool_ptr->xlarge_list.xlist_head.xchunk_size = sizeof(xchunk_alias_t);
+    xmpool_ptr->xlarge_list.xlist_head.xslice_size = 0;
+    xmpool_ptr->xlarge_list.xlist_head.xlist_node.xchunk_prev = X_NULL;
+    xmpool_ptr->xlarge_list.xlist_head.xlist_node.xchunk_next = XMPOOL_LARGE_TAIL(xmpool_ptr);
+    xmpool_ptr->xlarge_list.xlist_tail.xchunk_size = sizeof(xchunk_alias_t);
+    xmpool_ptr->xlarge_list.xlist_tail.xslice_size = 0;
+    xmpool_ptr->xlarge_list.xlist_tail.xlist_node.xchunk_prev = XMPOOL_LARGE_HEAD(xmpool_ptr);
+    xmpool_ptr->xlarge_list.xlist_tail.xlist_node.xchunk_next = X_NULL;
+    xmpool_ptr->xlarge_count = 0;
+    xmpool_ptr->xlarge_bytes = 0;
+    xmpool_ptr->xlarge_limit = XMPOOL_LARGE_CACHE_BYTES;
+    xmpool_ptr->xdecay_large = 0;
+    xmpool_ptr->xlarge_added = 0;
+    xmpool_ptr->xstat_lalloc = 0;
+    xmpool_ptr->xstat_lfree  = 0;
+    xmpool_ptr->xprof_ptr    = X_NULL;
+    xmpool_ptr->xprof_left   = 0;
+    xmpool_ptr->xprof_seed   = 0;
+
+    xmpool_ptr->xut_worktid    = xsys_tid();
+    xmpool_ptr->xspinlock_tree = 0;
+    xmpool_ptr->xchunk_rlist   = X_NULL;
+
+    xcallback.xctxt_t_callback = xmpool_ptr;
+    XASSERT(XMPOOL_RBTREE_SIZE >= xrbtree_sizeof());
+    xrbtree_emplace_create(XMPOOL_RBTREE(xmpool_ptr),
+                           sizeof(xchunk_handle_t),
+                           &xcallback);
+
+    xmpool_ptr->xchunk_cptr = X_NULL;
+
+    if (X_NULL != xclass_table)
+    {
+        xmpool_ptr->xclass_count = xut_count;
+        xmpool_ptr->xslice_max   = xclass_table[xut_count - 1].xslice_size;
+        xmpool_ptr->xclass_index = xindex_ptr;
+    }
+    else
+    {
+        xmpool_ptr->xclass_count = XSLICE_TYPE_COUNT;
+        xmpool_ptr->xslice_max   = XSLICE_SIZE_65536;
+        xmpool_ptr->xclass_index = X_class_index_table;
+    }
+
+    xmpool_class_initialize(xmpool_ptr, xclass_table);
+
+    return xmpool_ptr;
+}
+
+/**********************************************************/
+/**
+ * @brief 销毁内存池对象。
+ */
+x_void_t xmpool_destroy(xmpool_handle_t xmpool_ptr)
+{
+    XASSERT(X_NULL != xmpool_ptr);
+
+    xmpool_magazine_flush_all(xmpool_ptr);
+    xmpool_drain_remote(xmpool_ptr);
+    XASSERT(0 == xmpool_ptr->xsize_using);
+    XASSERT(X_NULL == xmpool_ptr->xchunk_rlist);
+
+    xmpool_set_profiler(xmpool_ptr, X_NULL);
+
+    xmpool_ptr->xut_worktid    = 0;
+    xmpool_ptr->xspinlock_tree = 0;
+
+    xrbtree_emplace_destroy(XMPOOL_RBTREE(xmpool_ptr));
+    xmpool_class_release(xmpool_ptr);
+
+    if (X_class_index_table != xmpool_ptr->xclass_index)
+    {
+        xsys_heap_free((xmem_handle_t)xmpool_ptr->xclass_index,
+                       XMPOOL_INDEX_SLOTS(xmpool_ptr->xslice_max));
+    }
+
+    xmpool_ptr->xclass_count = 0;
+    xmpool_ptr->xslice_max   = 0;
+    xmpool_ptr->xclass_index = X_NULL;
+
+    xmpool_ptr->xfunc_alloc  = X_NULL;
+    xmpool_ptr->xfunc_free   = X_NULL;
+    xmpool_ptr->xfunc_resize = X_NULL;
+    xmpool_ptr->xht_context  = X_NULL;
+    xmpool_ptr->xut_flags    = 0;
+    xmpool_ptr->xsize_cached = 0;
+    xmpool_ptr->xsize_valid  = 0;
+    xmpool_ptr->xsize_using  = 0;
+    xmpool_ptr->xsize_idle   = 0;
+    xmpool_ptr->xsize_purged = 0;
+    xmpool_ptr->xsize_pgpurged = 0;
+    xmpool_ptr->xlarge_count = 0;
+    xmpool_ptr->xlarge_bytes = 0;
+    xmpool_ptr->xclass_trim  = X_NULL;
+    xmpool_ptr->xchunk_cptr  = X_NULL;
+
+    xsys_heap_free(xmpool_ptr, sizeof(xmem_pool_t));
+}
+
+/**********************************************************/
+/**
+ * @brief 按内存池对象的分类表，计算申请大小对齐后（实际分配）的分片大小。
+ */
+x_uint32_t xmpool_align_size(xmpool_handle_t xmpool_ptr, x_uint32_t xut_size)
+{
+    XASSERT(X_NULL != xmpool_ptr);
+
+    if (xut_size <= 0)
+    {
+        return 0;
+    }
+
+    xut_size = XMPOOL_CLASS_SIZE(xmpool_ptr, xut_size);
+    if (xut_size <= xmpool_ptr->xslice_max)
+    {
+        return xmpool_ptr->xclass_ptr[XMPOOL_CLASS_INDEX(xmpool_ptr, xut_size)].xslice_size;
+    }
+
+    return X_ALIGN(xut_size, XMEM_PAGE_SIZE);
+}
+
+/**********************************************************/
+/**
+ * @brief 内存池对象 所隶属的工作线程 ID。
+ */
+x_uint32_t xmpool_worktid(xmpool_handle_t xmpool_ptr)
+{
+    XASSERT(X_NULL != xmpool_ptr);
+    return xmpool_ptr->xut_worktid;
+}
+
+/**********************************************************/
+/**
+ * @brief 设置 内存池对象 所隶属的工作线程 ID。
+ */
+x_void_t xmpool_set_worktid(xmpool_handle_t xmpool_ptr, x_uint32_t xut_worktid)
+{
+    XASSERT(X_NULL != xmpool_ptr);
+    xmpool_ptr->xut_worktid = xut_worktid;
+}
+
+/**********************************************************/
+/**
+ * @brief 在 fork() 之前，锁定 内存池对象 中供其他线程查找 chunk 的旋转锁。
+ */
+x_void_t xmpool_fork_lock(xmpool_handle_t xmpool_ptr)
+{
+    XASSERT(X_NULL != xmpool_ptr);
+    xatomic_spin_lock(&xmpool_ptr->xspinlock_tree);
+}
+
+/**********************************************************/
+/**
+ * @brief 在 fork() 之后，解除 xmpool_fork_lock() 的锁定。
+ */
+x_void_t xmpool_fork_unlock(xmpool_handle_t xmpool_ptr)
+{
+    XASSERT(X_NULL != xmpool_ptr);
+    xatomic_spin_unlock(&xmpool_ptr->xspinlock_tree);
+}
+
+/**********************************************************/
+/**
+ * @brief 设置 内存池对象 原地调整（大块分片所在）堆内存块大小的接口。
+ */
+x_void_t xmpool_set_resize(xmpool_handle_t xmpool_ptr, xfunc_resize_t xfunc_resize)
+{
+    XASSERT(X_NULL != xmpool_ptr);
+    xmpool_ptr->xfunc_resize = xfunc_resize;
+}
+
+/**********************************************************/
+/**
+ * @brief 设置 内存池对象 保留 空闲 chunk 对象的上限。
+ */
+x_void_t xmpool_set_retain(xmpool_handle_t xmpool_ptr,
+                           x_uint32_t xut_chunks,
+                           x_uint64_t xsize_bytes)
+{
+    XASSERT(X_NULL != xmpool_ptr);
+
+    x_int32_t xit_iter = 0;
+
+    xmpool_ptr->xidle_chunks = xut_chunks;
+    xmpool_ptr->xidle_bytes  = xsize_bytes;
+
+    if (xsys_tid() != xmpool_ptr->xut_worktid)
+    {
+        return;
+    }
+
+    // 按新的上限，逐个检查各个 class 对象
+    for (xit_iter = 0; xit_iter < (x_int32_t)xmpool_ptr->xclass_count; ++xit_iter)
+    {
+        xmpool_ptr->xclass_trim = &xmpool_ptr->xclass_ptr[xit_iter];
+        xmpool_trim_idle(xmpool_ptr);
+    }
+}
+
+/**********************************************************/
+/**
+ * @brief 设置 内存池对象 大块缓存的总大小上限。
+ */
+x_void_t xmpool_set_large_cache(xmpool_handle_t xmpool_ptr, x_uint64_t xsize_bytes)
+{
+    XASSERT(X_NULL != xmpool_ptr);
+
+    xmpool_ptr->xlarge_limit = xsize_bytes;
+
+    if (xsys_tid() == xmpool_ptr->xut_worktid)
+    {
+        xmpool_large_trim(xmpool_ptr, XMPOOL_LARGE_CACHE_COUNT, xsize_bytes);
+    }
+}
+
+/**********************************************************/
+/**
+ * @brief 设置分类中（chunk 对象内）被回收分片的再分配次序。
+ */
+x_bool_t xmpool_set_lifo(xmpool_handle_t xmpool_ptr, x_uint32_t xut_size, x_bool_t xbt_lifo)
+{
+    XASSERT(X_NULL != xmpool_ptr);
+    XASSERT(xsys_tid() == xmpool_ptr->xut_worktid);
+
+    x_uint32_t xut_iter = 0;
+
+    if (0 == xut_size)
+    {
+        for (xut_iter = 0; xut_iter < xmpool_ptr->xclass_count; ++xut_iter)
+        {
+            xmpool_ptr->xclass_ptr[xut_iter].xbt_lifo = xbt_lifo;
+        }
+
+        return X_TRUE;
+    }
+
+    xut_size = XMPOOL_CLASS_SIZE(xmpool_ptr, xut_size);
+    if (xut_size > xmpool_ptr->xslice_max)
+    {
+        return X_FALSE;
+    }
+
+    xmpool_ptr->xclass_ptr[XMPOOL_CLASS_INDEX(xmpool_ptr, xut_size)].xbt_lifo = xbt_lifo;
+
+    return X_TRUE;
+}
+
+/**********************************************************/
+/**
+ * @brief 设置 内存池对象 空闲 chunk 对象按时间衰减归还系统的半衰期。
+ */
+x_void_t xmpool_set_decay(xmpool_handle_t xmpool_ptr, x_uint32_t xut_decay_ms)
+{
+    XASSERT(X_NULL != xmpool_ptr);
+
+    xmpool_ptr->xdecay_ms   = xut_decay_ms;
+    xmpool_ptr->xdecay_tick = xsys_msecs();
+}
+
+/**********************************************************/
+/**
+ * @brief 设置 内存池对象 所使用的堆内存剖析器（为 X_NULL 时停止采样）。
+ */
+x_void_t xmpool_set_profiler(xmpool_handle_t xmpool_ptr, xmprof_handle_t xmprof_ptr)
+{
+    XASSERT(X_NULL != xmpool_ptr);
+
+    if (xmprof_ptr == xmpool_ptr->xprof_ptr)
+    {
+        return;
+    }
+
+    // 原剖析器中的采样记录随之删除，chunk 对象上残留的 xut_sampled 计数
+    // 只会使之后回收其分片时多做一次（未命中的）查找
+    if (X_NULL != xmpool_ptr->xprof_ptr)
+    {
+        xmpool_drain_remote(xmpool_ptr);
+        xmprof_erase_owner(xmpool_ptr->xprof_ptr, (x_handle_t)xmpool_ptr);
+    }
+
+    xmpool_ptr->xprof_ptr  = xmprof_ptr;
+    xmpool_ptr->xprof_left = (X_NULL != xmprof_ptr) ?
+        xmprof_next_sample(xmprof_ptr, &xmpool_ptr->xprof_seed) : 0;
+}
+
+/**********************************************************/
+/**
+ * @brief 按时间衰减策略，将 内存池对象 中的 空闲 chunk 对象逐步归还给系统。
+ */
+x_uint64_t xmpool_tick(xmpool_handle_t xmpool_ptr, x_uint64_t xut_now)
+{
+    XASSERT(X_NULL != xmpool_ptr);
+
+    x_uint64_t xut_elapsed = 0;
+    x_uint64_t xsize_dirty = 0;
+    x_uint64_t xsize_large = 0;
+    x_uint64_t xsize_free  = 0;
+
+    if ((0 == xmpool_ptr->xdecay_ms) || (xsys_tid() != xmpool_ptr->xut_worktid))
+    {
+        return 0;
+    }
+
+    // 其他线程回收的分片，可能使更多的 chunk 对象转入 空闲 状态
+    xmpool_drain_remote(xmpool_ptr);
+
+    if (xut_now > xmpool_ptr->xdecay_tick)
+    {
+        xut_elapsed = xut_now - xmpool_ptr->xdecay_tick;
+        xmpool_ptr->xdecay_tick = xut_now;
+    }
+
+    //======================================
+    // 已归还物理内存的 空闲 chunk 对象，超出允许保留大小的，释放其地址空间
+
+    xmpool_ptr->xdecay_muzzy =
+        xmem_decay_size(xmpool_ptr->xdecay_muzzy, xut_elapsed, xmpool_ptr->xdecay_ms) +
+        xmpool_ptr->xmuzzy_added;
+    xmpool_ptr->xmuzzy_added = 0;
+
+    if (xmpool_ptr->xdecay_muzzy > xmpool_ptr->xsize_purged)
+    {
+        xmpool_ptr->xdecay_muzzy = xmpool_ptr->xsize_purged;
+    }
+
+    xsize_free += xmpool_decay_chunks(
+                    xmpool_ptr,
+                    xmpool_ptr->xsize_purged - xmpool_ptr->xdecay_muzzy,
+                    X_TRUE);
+
+    //======================================
+    // 未归还物理内存的 空闲 chunk 对象，超出允许保留大小的，归还其物理内存
+
+    xsize_dirty = xmpool_ptr->xsize_idle - xmpool_ptr->xsize_purged;
+
+    xmpool_ptr->xdecay_dirty =
+        xmem_decay_size(xmpool_ptr->xdecay_dirty, xut_elapsed, xmpool_ptr->xdecay_ms) +
+        xmpool_ptr->xdirty_added;
+    xmpool_ptr->xdirty_added = 0;
+
+    if (xmpool_ptr->xdecay_dirty > xsize_dirty)
+    {
+        xmpool_ptr->xdecay_dirty = xsize_dirty;
+    }
+
+    xsize_free += xmpool_decay_chunks(
+                    xmpool_ptr,
+                    xsize_dirty - xmpool_ptr->xdecay_dirty,
+                    X_FALSE);
+
+    //======================================
+    // 大块缓存中超出允许保留大小的，从最早回收的开始释放
+
+    xmpool_ptr->xdecay_large =
+        xmem_decay_size(xmpool_ptr->xdecay_large, xut_elapsed, xmpool_ptr->xdecay_ms) +
+        xmpool_ptr->xlarge_added;
+    xmpool_ptr->xlarge_added = 0;
+
+    if (xmpool_ptr->xdecay_large > xmpool_ptr->xlarge_bytes)
+    {
+        xmpool_ptr->xdecay_large = xmpool_ptr->xlarge_bytes;
+    }
+
+    if (xmpool_ptr->xlarge_bytes > xmpool_ptr->xdecay_large)
+    {
+        xsize_large = xmpool_ptr->xlarge_bytes;
+        xmpool_large_trim(xmpool_ptr, XMPOOL_LARGE_CACHE_COUNT, xmpool_ptr->xdecay_large);
+        xsize_free += xsize_large - xmpool_ptr->xlarge_bytes;
+    }
+
+    //======================================
+
+    return xsize_free;
+}
+
+/**********************************************************/
+/**
+ * @brief 内存池对象 总共缓存的内存大小。
+ */
+x_uint64_t xmpool_cached_size(xmpool_handle_t xmpool_ptr)
+{
+    XASSERT(X_NULL != xmpool_ptr);
+    return xmpool_ptr->xsize_cached;
+}
+
+/**********************************************************/
+/**
+ * @brief 内存池对象 可使用到的缓存大小。
+ */
+x_uint64_t xmpool_valid_size(xmpool_handle_t xmpool_ptr)
+{
+    XASSERT(X_NULL != xmpool_ptr);
+    return xmpool_ptr->xsize_valid;
+}
+
+/**********************************************************/
+/**
+ * @brief 内存池对象 正在使用的缓存大小。
+ */
+x_uint64_t xmpool_using_size(xmpool_handle_t xmpool_ptr)
+{
+    XASSERT(X_NULL != xmpool_ptr);
+    return xmpool_ptr->xsize_using;
+}
+
+/**********************************************************/
+/**
+ * @brief 内存池对象 非空闲 chunk 对象中，按分页归还了物理内存的大小。
+ */
+x_uint64_t xmpool_pgpurged_size(xmpool_handle_t xmpool_ptr)
+{
+    XASSERT(X_NULL != xmpool_ptr);
+    return xmpool_ptr->xsize_pgpurged;
+}
+
+/**********************************************************/
+/**
+ * @brief 获取内存池对象的统计信息快照（只在工作线程中调用）。
+ * @note
+ * 先取回其他线程投递过来的待回收分片，使各分类的计数与分片状态一致；
+ * 各分类 XCHUNK_LIST_BUSY 链表中 chunk 对象的数量需遍历链表得到，
+ * 其余数据都直接取自计数，不影响申请/回收的性能。
+ * 
+ * @param [in ] xmpool_ptr : 内存池对象的操作句柄。
+ * @param [out] xstats_ptr : 返回的统计信息。
+ */
+x_void_t xmpool_stats(xmpool_handle_t xmpool_ptr, xmpool_stats_t * xstats_ptr)
+{
+    XASSERT(X_NULL != xmpool_ptr);
+    XASSERT(X_NULL != xstats_ptr);
+    XASSERT(xsys_tid() == xmpool_ptr->xut_worktid);
+
+    xclass_handle_t        xclass_ptr = X_NULL;
+    xchunk_handle_t        xchunk_ptr = X_NULL;
+    xmpool_class_stats_t * xcstat_ptr = X_NULL;
+    x_uint32_t             xut_iter   = 0;
+
+    xmpool_drain_remote(xmpool_ptr);
+
+    //======================================
+
+    xstats_ptr->xsize_cached  = xmpool_ptr->xsize_cached;
+    xstats_ptr->xsize_valid   = xmpool_ptr->xsize_valid;
+    xstats_ptr->xsize_using   = xmpool_ptr->xsize_using;
+    xstats_ptr->xlarge_alloc  = xmpool_ptr->xstat_lalloc;
+    xstats_ptr->xlarge_free   = xmpool_ptr->xstat_lfree;
+    xstats_ptr->xlarge_cached = xmpool_ptr->xlarge_count;
+    xstats_ptr->xclass_count  = xmpool_ptr->xclass_count;
+
+    for (xut_iter = 0; xut_iter < xmpool_ptr->xclass_count; ++xut_iter)
+    {
+        xclass_ptr = &xmpool_ptr->xclass_ptr[xut_iter];
+        xcstat_ptr = &xstats_ptr->xclass_stats[xut_iter];
+
+        xcstat_ptr->xslice_size  = xclass_ptr->xslice_size;
+        xcstat_ptr->xchunk_size  = xclass_ptr->xchunk_size;
+        xcstat_ptr->xalloc_count = xclass_ptr->xstat_alloc;
+        xcstat_ptr->xfree_count  = xclass_ptr->xstat_free;
+        xcstat_ptr->xlive_count  = xclass_ptr->xstat_alloc - xclass_ptr->xstat_free;
+        xcstat_ptr->xslow_count  = xclass_ptr->xstat_slow;
+        xcstat_ptr->xround_bytes = xclass_ptr->xstat_round;
+        xcstat_ptr->xmag_count   = xclass_ptr->xmag_count;
+
+        xcstat_ptr->xchunk_busy = 0;
+        for (xchunk_ptr = XCLASS_LIST_FRONT(xclass_ptr, XCHUNK_LIST_BUSY);
+             xchunk_ptr != XCLASS_LIST_TAIL(xclass_ptr, XCHUNK_LIST_BUSY);
+             xchunk_ptr = xchunk_ptr->xlist_node.xchunk_next)
+        {
+            xcstat_ptr->xchunk_busy += 1;
+        }
+
+        xcstat_ptr->xchunk_idle = xclass_ptr->xidle_count;
+        xcstat_ptr->xchunk_part = xclass_ptr->xchunk_count -
+                                  xcstat_ptr->xchunk_busy -
+                                  xcstat_ptr->xchunk_idle;
+    }
+}
+
+/**********************************************************/
+/**
+ * @brief 申请内存分片（xmpool_alloc() 的实现，不含采样）。
+ */
+static inline xmem_slice_t xmpool_alloc_slice(
+                                xmpool_handle_t xmpool_ptr,
+                                x_uint32_t xut_size)
+{
+    XASSERT(X_NULL != xmpool_ptr);
+
+    xmem_slice_t    xmem_slice = X_NULL;
+    xchunk_handle_t xchunk_ptr = X_NULL;
+    xclass_handle_t xclass_ptr = X_NULL;
+    x_uint32_t      xut_index  = 0;
+    x_uint32_t      xut_needs  = xut_size;
+
+    //======================================
+
+    if (xut_size <= 0)
+        return X_NULL;
+
+    //======================================
+
+    xut_size = XMPOOL_CLASS_SIZE(xmpool_ptr, xut_size);
+
+    if (xut_size > xmpool_ptr->xslice_max)
+    {
+        return xmpool_alloc_large(
+                    xmpool_ptr,
+                    xut_size,
+                    XMPOOL_IS_CACHE_ALIGNED(xmpool_ptr) ?
+                        X_ALIGN(XCHUNK_LARGE_OFFSET, XMPOOL_CACHE_LINE) :
+                        XCHUNK_LARGE_OFFSET);
+    }
+    else
+    {
+        // 一次查表，同时得到 分类索引号 与 对齐后的分片大小
+        xut_index  = XMPOOL_CLASS_INDEX(xmpool_ptr, xut_size);
+
+        // 弹匣模式：弹匣非空时直接出栈，否则批量补充弹匣
+        if (XMPOOL_USE_MAGAZINE(xmpool_ptr))
+        {
+            xclass_ptr = xmpool_get_class(xmpool_ptr, xut_index);
+            if (xclass_ptr->xmag_count > 0)
+            {
+                xmpool_ptr->xsize_using += xclass_ptr->xslice_size;
+                XCLASS_STAT_ALLOC(xclass_ptr, 1, xut_needs);
+                return xclass_ptr->xmag_slice[--xclass_ptr->xmag_count];
+            }
+
+            xmem_slice = xmpool_magazine_refill(xmpool_ptr, xclass_ptr);
+            if (X_NULL != xmem_slice)
+            {
+                XCLASS_STAT_ALLOC(xclass_ptr, 1, xut_needs);
+            }
+
+            return xmem_slice;
+        }
+
+        xut_size   = xmpool_ptr->xclass_ptr[xut_index].xslice_size;
+        xchunk_ptr = xmpool_ptr->xchunk_cptr;
+
+        // 快速路径：当前 chunk 对象的分片队列为空时，
+        // xchunk_alloc_slice() 会取回其他线程回收的分片
+        if ((X_NULL != xchunk_ptr) && (xut_size == xchunk_ptr->xslice_size))
+        {
+            xmem_slice = xchunk_alloc_slice(xchunk_ptr);
+        }
+
+        if (X_NULL == xmem_slice)
+        {
+            // 慢速路径中，顺带回收其他线程投递过来的分片
+            xmpool_drain_remote(xmpool_ptr);
+
+            xclass_ptr = xmpool_get_class(xmpool_ptr, xut_index);
+            XASSERT(xut_size == xclass_ptr->xslice_size);
+            xclass_ptr->xstat_slow += 1;
+
+            xchunk_ptr = xclass_get_non_empty_chunk(xclass_ptr);
+            if (X_NULL == xchunk_ptr)
+            {
+                xchunk_ptr = xmpool_alloc_chunk(
+                                    xmpool_ptr,
+                                    xclass_chunk_size(xclass_ptr),
+                                    xclass_ptr->xslice_size);
+                if (X_NULL != xchunk_ptr)
+                {
+                    xchunk_ptr->xowner.xclass_ptr = xclass_ptr;
+                    xclass_list_push_chunk(xclass_ptr, xchunk_ptr);
+                }
+            }
+
+            if (X_NULL != xchunk_ptr)
+            {
+                xmem_slice = xchunk_alloc_slice(xchunk_ptr);
+            }
+        }
+    }
+
+    //======================================
+
+    if ((X_NULL != xmem_slice) && (X_NULL != xchunk_ptr))
+    {
+        xmpool_ptr->xsize_using += xchunk_ptr->xslice_size;
+        XCLASS_STAT_ALLOC(xchunk_ptr->xowner.xclass_ptr, 1, xut_needs);
+    }
+
+    xmpool_ptr->xchunk_cptr = xchunk_ptr;
+
+    //======================================
+
+    return xmem_slice;
+}
+
+/**********************************************************/
+/**
+ * @brief 申请内存分片。
+ * @note  内存池对象设置了堆内存剖析器时，按申请的字节数进行采样（参看 xmpool_set_profiler()）。
+ * 
+ * @param [in ] xmpool_ptr : 内存池对象的操作句柄。
+ * @param [in ] xut_size   : 申请的内存分片大小。
+ * 
+ * @return xmem_slice_t
+ *         - 成功，返回 内存分片；
+ *         - 失败，返回 X_NULL 。
+ */
+xmem_slice_t xmpool_alloc(xmpool_handle_t xmpool_ptr, x_uint32_t xut_size)
+{
+    xmem_slice_t xmem_slice = xmpool_alloc_slice(xmpool_ptr, xut_size);
+
+    XMPOOL_PROF_ALLOC(xmpool_ptr, xmem_slice, xut_size);
+
+    return xmem_slice;
+}
+
+/**********************************************************/
+/**
+ * @brief 原地调整（非分类管理的）大块 chunk 对象的大小。
+ * 
+ * @param [in ] xmpool_ptr  : 内存池对象。
+ * @param [in ] xchunk_ptr  : 大块 chunk 对象。
+ * @param [in ] xchunk_size : 调整后的 chunk 对象大小（按 XMEM_PAGE_SIZE 对齐）。
+ * 
+ * @return x_bool_t
+ *         - 成功，返回 X_TRUE；
+ *         - 失败，返回 X_FALSE，chunk 对象保持不变。
+ */
+static x_bool_t xmpool_resize_large(
+                    xmpool_handle_t xmpool_ptr,
+                    xchunk_handle_t xchunk_ptr,
+                    x_uint32_t xchunk_size)
+{
+    XASSERT(0 == XSLICE_QUEUE_CAPACITY(xchunk_ptr));
+    XASSERT(xchunk_size > XSLICE_QUEUE(xchunk_ptr).xut_offset);
+
+    x_uint32_t xchunk_prev = xchunk_ptr->xchunk_size;
+
+    if ((X_NULL == xmpool_ptr->xfunc_resize) ||
+        !xmpool_ptr->xfunc_resize(xchunk_ptr,
+                                  xchunk_prev,
+                                  xchunk_size,
+                                  (x_handle_t)xmpool_ptr,
+                                  xmpool_ptr->xht_context))
+    {
+        return X_FALSE;
+    }
+
+    // 非工作线程查找红黑树时会读取 xchunk_size，须与之互斥
+    xatomic_spin_lock(&xmpool_ptr->xspinlock_tree);
+    xchunk_ptr->xchunk_size = xchunk_size;
+    xchunk_ptr->xslice_size = xchunk_size - XSLICE_QUEUE(xchunk_ptr).xut_offset;
+    xatomic_spin_unlock(&xmpool_ptr->xspinlock_tree);
+
+    xmpool_ptr->xsize_cached += xchunk_size;
+    xmpool_ptr->xsize_valid  += xchunk_size;
+    xmpool_ptr->xsize_using  += xchunk_size;
+    xmpool_ptr->xsize_cached -= xchunk_prev;
+    xmpool_ptr->xsize_valid  -= xchunk_prev;
+    xmpool_ptr->xsize_using  -= xchunk_prev;
+
+    return X_TRUE;
+}
+
+/**********************************************************/
+/**
+ * @brief 重新调整内存分片的大小（只能在工作线程中调用）。
+ * @note
+ * - 新旧大小属于同一分类时，直接返回原分片；
+ * - 大块分片在其 chunk 对象按页对齐的尾部余量内调整，或经 xfunc_resize 接口
+ *   原地扩展/收缩其 chunk 对象时，也返回原分片；
+ * - 否则 申请新分片 + 复制 + 回收原分片。
+ * 
+ * @param [in ] xmpool_ptr : 内存池对象的操作句柄。
+ * @param [in ] xmem_slice : 原内存分片（为 X_NULL 时，等同于 xmpool_alloc()）。
+ * @param [in ] xut_size   : 新的分片大小（为 0 时，等同于 xmpool_recyc()，并返回 X_NULL）。
+ * 
+ * @return xmem_slice_t
+ *         - 成功，返回 内存分片（可能与 xmem_slice 相同）；
+ *         - 失败，返回 X_NULL，此时 xmem_slice 仍然有效。
+ */
+xmem_slice_t xmpool_realloc(xmpool_handle_t xmpool_ptr,
+                            xmem_slice_t xmem_slice,
+                            x_uint32_t xut_size)
+{
+    XASSERT(X_NULL != xmpool_ptr);
+    XASSERT(xsys_tid() == xmpool_ptr->xut_worktid);
+
+    xchunk_handle_t xchunk_ptr  = X_NULL;
+    xmem_slice_t    xnew_slice  = X_NULL;
+    x_uint32_t      xclass_size = 0;
+    x_uint32_t      xchunk_size = 0;
+
+    //======================================
+
+    if (X_NULL == xmem_slice)
+    {
+        return xmpool_alloc(xmpool_ptr, xut_size);
+    }
+
+    if (xut_size <= 0)
+    {
+        xmpool_recyc(xmpool_ptr, xmem_slice);
+        return X_NULL;
+    }
+
+    xchunk_ptr = xmpool_hit_chunk(xmpool_ptr, xmem_slice);
+    if ((X_NULL == xchunk_ptr) || !xchunk_slice_aligned(xchunk_ptr, xmem_slice))
+    {
+        XASSERT(X_FALSE);
+        return X_NULL;
+    }
+
+    //======================================
+
+    xclass_size = XMPOOL_CLASS_SIZE(xmpool_ptr, xut_size);
+
+    if (XSLICE_QUEUE_CAPACITY(xchunk_ptr) > 0)
+    {
+        // 同一分类，原地返回
+        if ((xclass_size <= xmpool_ptr->xslice_max) &&
+            (xchunk_ptr->xslice_size ==
+                xmpool_ptr->xclass_ptr[XMPOOL_CLASS_INDEX(xmpool_ptr, xclass_size)].xslice_size))
+        {
+            return xmem_slice;
+        }
+    }
+    else if ((xclass_size > xmpool_ptr->xslice_max) &&
+             (xclass_size <= (0xFFFFFFFF - XSLICE_QUEUE(xchunk_ptr).xut_offset - XMEM_PAGE_SIZE)))
+    {
+        xchunk_size = X_ALIGN(xclass_size + XSLICE_QUEUE(xchunk_ptr).xut_offset,
+                              XMEM_PAGE_SIZE);
+
+        // 页对齐后的尾部余量已足够，或者可原地扩展/收缩 chunk 对象
+        if ((xchunk_size == xchunk_ptr->xchunk_size) ||
+            xmpool_resize_large(xmpool_ptr, xchunk_ptr, xchunk_size))
+        {
+            return xmem_slice;
+        }
+
+        // 无法原地收缩时，原分片仍然可用
+        if (xchunk_size < xchunk_ptr->xchunk_size)
+        {
+            return xmem_slice;
+        }
+    }
+
+    //======================================
+    // 申请 + 复制 + 回收
+
+    xnew_slice = xmpool_alloc(xmpool_ptr, xut_size);
+    if (X_NULL != xnew_slice)
+    {
+        memcpy(xnew_slice,
+               xmem_slice,
+               (xut_size < xchunk_ptr->xslice_size) ? xut_size : xchunk_ptr->xslice_size);
+        xmpool_recyc(xmpool_ptr, xmem_slice);
+    }
+
+    //======================================
+
+    return xnew_slice;
+}
+
+/**********************************************************/
+/**
+ * @brief 按指定的对齐值申请内存分片。
+ * @note
+ * 分片地址为 chunk 起始地址 + (xchunk_size - xslice_size * 容量) + 索引号 * xslice_size，
+ * chunk 对象的起始地址与大小均按 XMEM_PAGE_SIZE 对齐，所以只要所选分类的分片大小
+ * 为 xut_align 的整数倍，其所有分片就都按 xut_align 对齐，无需额外的对齐余量；
+ * 默认分类表中，分片大小按 xut_align 向上对齐后，查表所得的分类恰好满足这一条件，
+ * 自定义分类表则从查表所得的分类起，向后选取首个满足条件的分类（没有时按大块分片申请）。
+ * 
+ * @param [in ] xmpool_ptr : 内存池对象的操作句柄。
+ * @param [in ] xut_size   : 申请的内存分片大小。
+ * @param [in ] xut_align  : 对齐值（须为 2 的幂，且不大于 XMEM_PAGE_SIZE）。
+ * 
+ * @return xmem_slice_t
+ *         - 成功，返回 内存分片（可直接用 xmpool_recyc() 回收）；
+ *         - 失败，返回 X_NULL 。
+ */
+xmem_slice_t xmpool_alloc_aligned(xmpool_handle_t xmpool_ptr,
+                                  x_uint32_t xut_size,
+                                  x_uint32_t xut_align)
+{
+    XASSERT(X_NULL != xmpool_ptr);
+
+    xmem_slice_t xmem_slice = X_NULL;
+    x_uint32_t   xut_index  = 0;
+
+    //======================================
+
+    if ((xut_size <= 0) || (xut_align <= 0) ||
+        (0 != (xut_align & (xut_align - 1))) ||
+        (xut_align > XMEM_PAGE_SIZE))
+    {
+        return X_NULL;
+    }
+
+    // 所有分片至少按 8 字节对齐
+    if (xut_align <= XSLICE_SIZE_____8)
+    {
+        return xmpool_alloc(xmpool_ptr, xut_size);
+    }
+
+    if (xut_size > (0xFFFFFFFF - xut_align))
+    {
+        return X_NULL;
+    }
+
+    xut_size = X_ALIGN(xut_size, xut_align);
+
+    //======================================
+
+    if (xut_size <= xmpool_ptr->xslice_max)
+    {
+        xut_index = XMPOOL_CLASS_INDEX(xmpool_ptr, xut_size);
+        while ((xut_index < xmpool_ptr->xclass_count) &&
+               (0 != (xmpool_ptr->xclass_ptr[xut_index].xslice_size & (xut_align - 1))))
+        {
+            xut_index += 1;
+        }
+
+        if (xut_index < xmpool_ptr->xclass_count)
+            xut_size = xmpool_ptr->xclass_ptr[xut_index].xslice_size;
+        else
+            xut_size = xmpool_ptr->xslice_max + 1;
+    }
+
+    if (xut_size > xmpool_ptr->xslice_max)
+    {
+        xmem_slice = xmpool_alloc_large(
+                        xmpool_ptr, xut_size, X_ALIGN(XCHUNK_LARGE_OFFSET, xut_align));
+        XMPOOL_PROF_ALLOC(xmpool_ptr, xmem_slice, xut_size);
+        return xmem_slice;
+    }
+
+    xmem_slice = xmpool_alloc(xmpool_ptr, xut_size);
+    if ((X_NULL != xmem_slice) &&
+        (0 != ((x_size_t)xmem_slice & (xut_align - 1))))
+    {
+        // 外部提供的 xfunc_alloc 未按 XMEM_PAGE_SIZE 对齐 chunk 对象
+        XASSERT(X_FALSE);
+        xmpool_recyc(xmpool_ptr, xmem_slice);
+        xmem_slice = X_NULL;
+    }
+
+    //======================================
+
+    return xmem_slice;
 }
 
 /**********************************************************/
 /**
- * @brief 内存池对象 可使用到的缓存大小。
+ * @brief 回收内存分片。
+ * @note
+ * 若调用线程不是内存池对象所隶属的工作线程，则分片只被（无锁地）压入
+ * 其所在 chunk 对象的待回收分片栈，由工作线程在 xmpool_alloc()/
+ * xmpool_release_unused() 中取回。
+ * 
+ * @param [in ] xmpool_ptr : 内存池对象的操作句柄。
+ * @param [in ] xmem_slice : 待回收的内存分片。
+ * 
+ * @return x_int32_t
+ *         - 成功，返回 XMEM_ERR_OK；
+ *         - 失败，返回 错误码（擦看 @see xmem_err_code 枚举值）。
  */
-x_uint64_t xmpool_valid_size(xmpool_handle_t xmpool_ptr)
+x_int32_t xmpool_recyc(xmpool_handle_t xmpool_ptr, xmem_slice_t xmem_slice)
 {
     XASSERT(X_NULL != xmpool_ptr);
-    return xmpool_ptr->xsize_valid;
+    XASSERT(X_NULL != xmem_slice);
+
+    x_int32_t xit_error = XMEM_ERR_UNKNOW;
+
+    if (xsys_tid() != xmpool_ptr->xut_worktid)
+    {
+        return xmpool_recyc_remote(xmpool_ptr, xmem_slice);
+    }
+
+    xit_error = xmpool_recyc_local(xmpool_ptr, xmem_slice);
+    if (X_NULL != xmpool_ptr->xclass_trim)
+    {
+        xmpool_trim_idle(xmpool_ptr);
+    }
+
+    return xit_error;
 }
 
 /**********************************************************/
 /**
- * @brief 内存池对象 正在使用的缓存大小。
+ * @brief 按申请时的大小回收内存分片。
+ * @note
+ * 工作线程中，以分片大小所属的 class 对象缩小 chunk 对象的查找范围
+ * （参看 xmpool_class_hit_chunk()），回收的开销不随 chunk 对象的数量增长；
+ * 调试版本中，会校验 xut_size 是否与分片所在 chunk 对象的分片大小一致。
+ * 非工作线程中，等同于 xmpool_recyc()。
+ * 
+ * @param [in ] xmpool_ptr : 内存池对象的操作句柄。
+ * @param [in ] xmem_slice : 待回收的内存分片。
+ * @param [in ] xut_size   : 申请该分片时的大小（即 xmpool_alloc() 的 xut_size 参数）。
+ * 
+ * @return x_int32_t
+ *         - 成功，返回 XMEM_ERR_OK；
+ *         - 失败，返回 错误码（参看 @see xmem_err_code 枚举值）。
  */
-x_uint64_t xmpool_using_size(xmpool_handle_t xmpool_ptr)
+x_int32_t xmpool_recyc_sized(xmpool_handle_t xmpool_ptr,
+                             xmem_slice_t xmem_slice,
+                             x_uint32_t xut_size)
 {
     XASSERT(X_NULL != xmpool_ptr);
-    return xmpool_ptr->xsize_using;
+    XASSERT(X_NULL != xmem_slice);
+
+    x_int32_t       xit_error  = XMEM_ERR_UNKNOW;
+    xclass_handle_t xclass_ptr = X_NULL;
+    xchunk_handle_t xchunk_ptr = X_NULL;
+
+    if (xsys_tid() != xmpool_ptr->xut_worktid)
+    {
+        return xmpool_recyc_remote(xmpool_ptr, xmem_slice);
+    }
+
+    if ((xut_size <= 0) || (xut_size > xmpool_ptr->xslice_max))
+    {
+        return xmpool_recyc_local(xmpool_ptr, xmem_slice);
+    }
+
+    //======================================
+
+    xut_size   = XMPOOL_CLASS_SIZE(xmpool_ptr, xut_size);
+    xclass_ptr = xmpool_get_class(xmpool_ptr, XMPOOL_CLASS_INDEX(xmpool_ptr, xut_size));
+    xchunk_ptr = xmpool_class_hit_chunk(xmpool_ptr, xclass_ptr, xmem_slice);
+    if (X_NULL == xchunk_ptr)
+    {
+        return XMEM_ERR_NOT_FOUND;
+    }
+
+    if (xchunk_ptr->xowner.xclass_ptr != xclass_ptr)
+    {
+        // 调用方传入的大小与分片的实际分类不符
+        XASSERT(X_FALSE);
+        return xmpool_recyc_local(xmpool_ptr, xmem_slice);
+    }
+
+    //======================================
+
+    if (XMPOOL_USE_MAGAZINE(xmpool_ptr))
+    {
+        xit_error = xmpool_magazine_push(xmpool_ptr, xchunk_ptr, xmem_slice);
+    }
+    else
+    {
+        xit_error = xchunk_recyc_slice(xchunk_ptr, xmem_slice);
+        if (XMEM_ERR_OK == xit_error)
+        {
+            xmpool_ptr->xsize_using -= xchunk_ptr->xslice_size;
+            xclass_ptr->xchunk_rptr  = xchunk_ptr;
+            xclass_ptr->xstat_free  += 1;
+            XCHUNK_PROF_ERASE(xmpool_ptr, xchunk_ptr, xmem_slice);
+        }
+
+        xmpool_ptr->xchunk_cptr = xchunk_ptr;
+    }
+
+    if (X_NULL != xmpool_ptr->xclass_trim)
+    {
+        xmpool_trim_idle(xmpool_ptr);
+    }
+
+    //======================================
+
+    return xit_error;
 }
 
 /**********************************************************/
 /**
- * @brief 申请内存分片。
- * 
+ * @brief 批量申请（同一大小的）内存分片。
+ * @note
+ * 只做一次分类查找，并在每个 chunk 对象中一次性取出尽可能多的分片，
+ * 省去逐个调用 xmpool_alloc() 时重复的查表、xchunk_cptr 判断与计数更新。
+ *
  * @param [in ] xmpool_ptr : 内存池对象的操作句柄。
  * @param [in ] xut_size   : 申请的内存分片大小。
- * 
- * @return xmem_slice_t
- *         - 成功，返回 内存分片；
- *         - 失败，返回 X_NULL 。
+ * @param [in ] xut_count  : 申请的分片数量。
+ * @param [out] xslice_vec : 存放所申请到的分片的数组（至少 xut_count 个元素）。
+ *
+ * @return x_uint32_t
+ *         - 返回申请到的分片数量，小于 xut_count 时，表示堆内存不足。
  */
-xmem_slice_t xmpool_alloc(xmpool_handle_t xmpool_ptr, x_uint32_t xut_size)
+x_uint32_t xmpool_alloc_batch(xmpool_handle_t xmpool_ptr,
+                              x_uint32_t xut_size,
+                              x_uint32_t xut_count,
+                              xmem_slice_t * xslice_vec)
 {
     XASSERT(X_NULL != xmpool_ptr);
 
-    xmem_slice_t    xmem_slice = X_NULL;
     xchunk_handle_t xchunk_ptr = X_NULL;
     xclass_handle_t xclass_ptr = X_NULL;
+    x_uint32_t      xut_index  = 0;
+    x_uint32_t      xut_iter   = 0;
+    x_uint32_t      xut_needs  = xut_size;
+    x_bool_t        xbt_drain  = X_FALSE;
 
     //======================================
 
-    if (xut_size <= 0)
-        return X_NULL;
+    if ((xut_size <= 0) || (xut_count <= 0) || (X_NULL == xslice_vec))
+        return 0;
 
     //======================================
 
-    if (xut_size > XSLICE_SIZE_65536)
+    // 大块分片各自独占一个 chunk 对象，批量申请没有收益
+    if (xut_size > xmpool_ptr->xslice_max)
     {
-        xut_size = X_ALIGN(xut_size + sizeof(xmem_chunk_t), XMEM_PAGE_SIZE);
-
-        xchunk_ptr = xmpool_alloc_chunk(
-                            xmpool_ptr,
-                            xut_size,
-                            xut_size - sizeof(xmem_chunk_t));
-        if (X_NULL != xchunk_ptr)
+        for (xut_iter = 0; xut_iter < xut_count; ++xut_iter)
         {
-            xmem_slice = XSLICE_QUEUE_BEGIN(xchunk_ptr);
+            xslice_vec[xut_iter] = xmpool_alloc(xmpool_ptr, xut_size);
+            if (X_NULL == xslice_vec[xut_iter])
+                break;
         }
+
+        return xut_iter;
     }
-    else
+
+    //======================================
+
+    xut_size   = XMPOOL_CLASS_SIZE(xmpool_ptr, xut_size);
+    xut_index  = XMPOOL_CLASS_INDEX(xmpool_ptr, xut_size);
+    xclass_ptr = xmpool_get_class(xmpool_ptr, xut_index);
+    xut_size   = xclass_ptr->xslice_size;
+    xchunk_ptr = xmpool_ptr->xchunk_cptr;
+
+    if ((X_NULL != xchunk_ptr) && (xut_size == xchunk_ptr->xslice_size))
     {
-        xut_size = xmem_align_size(xut_size);
+        xut_iter = xchunk_alloc_batch(xchunk_ptr, xut_count, xslice_vec);
+    }
 
-        if ((X_NULL != xmpool_ptr->xchunk_cptr) &&
-            (xut_size == xmpool_ptr->xchunk_cptr->xslice_size) &&
-            XSLICE_QUEUE_NOT_EMPTY(xmpool_ptr->xchunk_cptr))
-        {
-            xchunk_ptr = xmpool_ptr->xchunk_cptr;
-        }
-        else
+    while (xut_iter < xut_count)
+    {
+        if (!xbt_drain)
         {
-            xclass_ptr = xmpool_get_class(xmpool_ptr, xut_size);
-            XASSERT(X_NULL != xclass_ptr);
-
-            xchunk_ptr = xclass_get_non_empty_chunk(xclass_ptr);
+            xclass_ptr->xstat_slow += 1;
+            xmpool_drain_remote(xmpool_ptr);
+            xbt_drain = X_TRUE;
         }
 
+        xchunk_ptr = xclass_get_non_empty_chunk(xclass_ptr);
         if (X_NULL == xchunk_ptr)
         {
             xchunk_ptr = xmpool_alloc_chunk(
                                 xmpool_ptr,
-                                xclass_ptr->xchunk_size,
+                                xclass_chunk_size(xclass_ptr),
                                 xclass_ptr->xslice_size);
-            if (X_NULL != xchunk_ptr)
+            if (X_NULL == xchunk_ptr)
             {
-                xchunk_ptr->xowner.xclass_ptr = xclass_ptr;
-                xclass_list_push_head(xclass_ptr, xchunk_ptr);
-                xmem_slice = xchunk_alloc_slice(xchunk_ptr);
+                break;
             }
+
+            xchunk_ptr->xowner.xclass_ptr = xclass_ptr;
+            xclass_list_push_chunk(xclass_ptr, xchunk_ptr);
         }
-        else
-        {
-            xmem_slice = xchunk_alloc_slice(xchunk_ptr);
-        }
+
+        xut_iter += xchunk_alloc_batch(
+                        xchunk_ptr, xut_count - xut_iter, xslice_vec + xut_iter);
     }
 
     //======================================
 
-    if ((X_NULL != xmem_slice) && (X_NULL != xchunk_ptr))
+    xmpool_ptr->xsize_using += (x_uint64_t)xut_iter * xut_size;
+    XCLASS_STAT_ALLOC(xclass_ptr, xut_iter, xut_needs);
+
+    if (X_NULL != xchunk_ptr)
     {
-        xmpool_ptr->xsize_using += xchunk_ptr->xslice_size;
+        xmpool_ptr->xchunk_cptr = xchunk_ptr;
     }
 
-    xmpool_ptr->xchunk_cptr = xchunk_ptr;
+    if (X_NULL != xmpool_ptr->xprof_ptr)
+    {
+        for (xut_index = 0; xut_index < xut_iter; ++xut_index)
+        {
+            XMPOOL_PROF_ALLOC(xmpool_ptr, xslice_vec[xut_index], xut_needs);
+        }
+    }
 
     //======================================
 
-    return xmem_slice;
+    return xut_iter;
 }
 
 /**********************************************************/
 /**
- * @brief 回收内存分片。
- * 
+ * @brief 批量回收内存分片。
+ * @note
+ * 地址相邻（位于同一 chunk 对象）的连续分片只查找一次 chunk 对象；
+ * 在非工作线程中调用时，同一 chunk 对象的连续分片先串接成链，
+ * 再以一次原子操作压入其待回收分片栈。
+ *
  * @param [in ] xmpool_ptr : 内存池对象的操作句柄。
- * @param [in ] xmem_slice : 待回收的内存分片。
- * 
- * @return x_int32_t
- *         - 成功，返回 XMEM_ERR_OK；
- *         - 失败，返回 错误码（擦看 @see xmem_err_code 枚举值）。
+ * @param [in ] xslice_vec : 待回收的内存分片数组（不可包含 X_NULL）。
+ * @param [in ] xut_count  : 待回收的分片数量。
+ *
+ * @return x_uint32_t
+ *         - 返回成功回收的分片数量，小于 xut_count 时，表示存在无效分片。
  */
-x_int32_t xmpool_recyc(xmpool_handle_t xmpool_ptr, xmem_slice_t xmem_slice)
+x_uint32_t xmpool_recyc_batch(xmpool_handle_t xmpool_ptr,
+                              xmem_slice_t * xslice_vec,
+                              x_uint32_t xut_count)
 {
     XASSERT(X_NULL != xmpool_ptr);
-    XASSERT(X_NULL != xmem_slice);
 
-    x_int32_t xit_error = XMEM_ERR_UNKNOW;
+    xchunk_handle_t xchunk_ptr  = X_NULL;
+    xmem_slice_t    xmem_slice  = X_NULL;
+    xmem_slice_t    xslice_head = X_NULL;
+    xmem_slice_t    xslice_tail = X_NULL;
+    x_uint32_t      xut_iter    = 0;
+    x_uint32_t      xut_okay    = 0;
 
-    //======================================
+    if ((xut_count <= 0) || (X_NULL == xslice_vec))
+        return 0;
 
-    xchunk_handle_t xchunk_ptr = X_NULL;
+    //======================================
+    // 非工作线程：按 chunk 对象分组串接后压栈
 
-    if ((X_NULL != xmpool_ptr->xchunk_cptr) &&
-        (xmem_slice > XCHUNK_LADDR(xmpool_ptr->xchunk_cptr)) &&
-        (xmem_slice < XCHUNK_RADDR(xmpool_ptr->xchunk_cptr)))
-    {
-        xchunk_ptr = xmpool_ptr->xchunk_cptr;
-    }
-    else
+    if (xsys_tid() != xmpool_ptr->xut_worktid)
     {
-        xchunk_ptr = xrbtree_hit_chunk(XMPOOL_RBTREE(xmpool_ptr), xmem_slice);
-    }
+        for (xut_iter = 0; xut_iter < xut_count; ++xut_iter)
+        {
+            xmem_slice = xslice_vec[xut_iter];
+            XASSERT(X_NULL != xmem_slice);
 
-    if (X_NULL == xchunk_ptr)
-    {
-        return XMEM_ERR_NOT_FOUND;
+            if ((X_NULL == xchunk_ptr) ||
+                (xmem_slice <= XCHUNK_LADDR(xchunk_ptr)) ||
+                (xmem_slice >= XCHUNK_RADDR(xchunk_ptr)))
+            {
+                if (X_NULL != xslice_head)
+                {
+                    xmpool_rfree_push(xmpool_ptr, xchunk_ptr, xslice_head, xslice_tail);
+                    xslice_head = X_NULL;
+                }
+
+                xchunk_ptr = xmpool_hit_chunk(xmpool_ptr, xmem_slice);
+                if (X_NULL == xchunk_ptr)
+                {
+                    continue;
+                }
+            }
+
+            if (!xchunk_slice_aligned(xchunk_ptr, xmem_slice))
+            {
+                continue;
+            }
+
+            if (X_NULL == xslice_head)
+                xslice_head = xmem_slice;
+            else
+                XSLICE_RFREE_NEXT(xslice_tail) = xmem_slice;
+            xslice_tail = xmem_slice;
+
+            xut_okay += 1;
+        }
+
+        if (X_NULL != xslice_head)
+        {
+            xmpool_rfree_push(xmpool_ptr, xchunk_ptr, xslice_head, xslice_tail);
+        }
+
+        return xut_okay;
     }
 
     //======================================
-    // 回收 slice
+    // 工作线程：沿用上一个分片所在的 chunk 对象，直接回收至其分片队列
 
-    // 若 chunk 对象没有多个分片，则不属于分类管理的 chunk 对象，可直接删除
-    if (XSLICE_QUEUE_CAPACITY(xchunk_ptr) == 0)
+    for (xut_iter = 0; xut_iter < xut_count; ++xut_iter)
     {
-        if (xmem_slice != XSLICE_QUEUE_BEGIN(xchunk_ptr))
-        {
-            return XMEM_ERR_UNALIGNED;
-        }
+        xmem_slice = xslice_vec[xut_iter];
+        XASSERT(X_NULL != xmem_slice);
 
-        if (xchunk_ptr == xmpool_ptr->xchunk_cptr)
+        if ((X_NULL == xchunk_ptr) ||
+            (xmem_slice <= XCHUNK_LADDR(xchunk_ptr)) ||
+            (xmem_slice >= XCHUNK_RADDR(xchunk_ptr)))
         {
-            xmpool_ptr->xchunk_cptr = X_NULL;
-        }
+            xchunk_ptr = xmpool_hit_chunk(xmpool_ptr, xmem_slice);
+            if (X_NULL == xchunk_ptr)
+            {
+                continue;
+            }
 
-        xmpool_ptr->xsize_using -= xchunk_ptr->xslice_size;
+            // 大块分片的 chunk 对象回收后即被释放，交由 xmpool_recyc_local() 处理
+            if (0 == XSLICE_QUEUE_CAPACITY(xchunk_ptr))
+            {
+                xchunk_ptr = X_NULL;
+                if (XMEM_ERR_OK == xmpool_recyc_local(xmpool_ptr, xmem_slice))
+                    xut_okay += 1;
+                continue;
+            }
+        }
 
-        if (!xmpool_dealloc_chunk(xmpool_ptr, xchunk_ptr))
+        if (XMEM_ERR_OK == xchunk_recyc_slice(xchunk_ptr, xmem_slice))
         {
-            XASSERT(X_FALSE);
+            xmpool_ptr->xsize_using -= xchunk_ptr->xslice_size;
+            xchunk_ptr->xowner.xclass_ptr->xstat_free += 1;
+            XCHUNK_PROF_ERASE(xmpool_ptr, xchunk_ptr, xmem_slice);
+            xut_okay += 1;
         }
+    }
 
-        return XMEM_ERR_OK;
+    if (X_NULL != xchunk_ptr)
+    {
+        xmpool_ptr->xchunk_cptr = xchunk_ptr;
     }
 
-    // chunk 对象属于分类管理的 chunk 类型，需要进行 chunk 分片回收操作
-    xit_error = xchunk_recyc_slice(xchunk_ptr, xmem_slice);
-    if (XMEM_ERR_OK == xit_error)
+    if (X_NULL != xmpool_ptr->xclass_trim)
     {
-        xmpool_ptr->xsize_using -= xchunk_ptr->xslice_size;
+        xmpool_trim_idle(xmpool_ptr);
     }
 
-    xmpool_ptr->xchunk_cptr = xchunk_ptr;
+    return xut_okay;
+}
 
-    //======================================
+/**********************************************************/
+/**
+ * @brief 查询内存分片的（可使用的）容量大小。
+ * @note  允许在非工作线程中调用。
+ * 
+ * @param [in ] xmpool_ptr : 内存池对象的操作句柄。
+ * @param [in ] xmem_slice : 所查询的内存分片。
+ * 
+ * @return x_uint32_t
+ *         - 成功，返回 分片容量大小；
+ *         - 失败，返回 0，分片不隶属于该内存池对象。
+ */
+x_uint32_t xmpool_slice_size(xmpool_handle_t xmpool_ptr, xmem_slice_t xmem_slice)
+{
+    XASSERT(X_NULL != xmpool_ptr);
+    XASSERT(X_NULL != xmem_slice);
 
-    return xit_error;
+    xchunk_handle_t xchunk_ptr = xmpool_hit_chunk(xmpool_ptr, xmem_slice);
+    if (X_NULL == xchunk_ptr)
+    {
+        return 0;
+    }
+
+    return xchunk_ptr->xslice_size;
+}
+
+/**********************************************************/
+/**
+ * @brief 查询（内存分片内部的）地址所在内存分片的起始地址。
+ * @note  允许在非工作线程中调用。
+ * 
+ * @param [in ] xmpool_ptr : 内存池对象的操作句柄。
+ * @param [in ] xmem_addr  : 所查询的地址。
+ * 
+ * @return xmem_slice_t
+ *         - 成功，返回 分片起始地址；
+ *         - 失败，返回 X_NULL，地址不在该内存池对象的分片中。
+ */
+xmem_slice_t xmpool_slice_head(xmpool_handle_t xmpool_ptr, xmem_slice_t xmem_addr)
+{
+    XASSERT(X_NULL != xmpool_ptr);
+    XASSERT(X_NULL != xmem_addr);
+
+    xchunk_handle_t xchunk_ptr = X_NULL;
+    x_uint32_t      xut_offset = 0;
+
+    xchunk_ptr = xmpool_hit_chunk(xmpool_ptr, xmem_addr);
+    if ((X_NULL == xchunk_ptr) || (xmem_addr < XSLICE_QUEUE_BEGIN(xchunk_ptr)))
+    {
+        return X_NULL;
+    }
+
+    xut_offset = (x_uint32_t)(xmem_addr - XSLICE_QUEUE_BEGIN(xchunk_ptr));
+
+    return (XSLICE_QUEUE_BEGIN(xchunk_ptr) +
+            (xut_offset / xchunk_ptr->xslice_size) * xchunk_ptr->xslice_size);
 }
 
 /**********************************************************/
@@ -1789,14 +4809,23 @@ x_void_t xmpool_release_unused(xmpool_handle_t xmpool_ptr)
 
     x_int32_t xit_iter = 0;
 
-    for (xit_iter = 0; xit_iter < XSLICE_TYPE_COUNT; ++xit_iter)
+    // 弹匣中的分片归还后，其所在的 chunk 对象才可能转入 XCHUNK_LIST_IDLE 链表
+    xmpool_magazine_flush_all(xmpool_ptr);
+    xmpool_drain_remote(xmpool_ptr);
+    xmpool_large_trim(xmpool_ptr, 0, 0);
+
+    for (xit_iter = 0; xit_iter < (x_int32_t)xmpool_ptr->xclass_count; ++xit_iter)
     {
         xclass_ptr = &xmpool_ptr->xclass_ptr[xit_iter];
 
-        for (xchunk_ptr = XCLASS_LIST_FRONT(xclass_ptr);
-             xchunk_ptr != XCLASS_LIST_TAIL(xclass_ptr);)
+        // 只需遍历 XCHUNK_LIST_IDLE 链表（其中的 chunk 对象都没有分片被分配出去）
+        for (xchunk_ptr = XCLASS_LIST_FRONT(xclass_ptr, XCHUNK_LIST_IDLE);
+             xchunk_ptr != XCLASS_LIST_TAIL(xclass_ptr, XCHUNK_LIST_IDLE);)
         {
-            if (XSLICE_QUEUE_IS_FULL(xchunk_ptr, x_uint16_t))
+            XASSERT(XCHUNK_IS_IDLE(xchunk_ptr));
+
+            // 仍有其他线程的回收操作在进行中的 chunk 对象，留待下次回收后再释放
+            if (XCHUNK_RFREE_QUIET(xchunk_ptr))
             {
                 if (xmpool_ptr->xchunk_cptr == xchunk_ptr)
                 {
@@ -1813,6 +4842,53 @@ x_void_t xmpool_release_unused(xmpool_handle_t xmpool_ptr)
             }
         }
     }
+
+    xmpool_ptr->xclass_trim = X_NULL;
+}
+
+/**********************************************************/
+/**
+ * @brief 将部分使用中的 chunk 对象内，空闲分片所完整覆盖的分页归还物理内存。
+ */
+x_uint64_t xmpool_purge_pages(xmpool_handle_t xmpool_ptr)
+{
+    XASSERT(X_NULL != xmpool_ptr);
+
+    xclass_handle_t xclass_ptr = X_NULL;
+    xchunk_handle_t xchunk_ptr = X_NULL;
+    x_uint64_t      xut_pages  = 0;
+
+    x_int32_t xit_iter = 0;
+
+    if (xsys_tid() != xmpool_ptr->xut_worktid)
+    {
+        return 0;
+    }
+
+    // 弹匣中的分片在 chunk 对象中仍标识为“已分配”，先归还，才能一并处理
+    xmpool_magazine_flush_all(xmpool_ptr);
+    xmpool_drain_remote(xmpool_ptr);
+
+    for (xit_iter = 0; xit_iter < (x_int32_t)xmpool_ptr->xclass_count; ++xit_iter)
+    {
+        xclass_ptr = &xmpool_ptr->xclass_ptr[xit_iter];
+        if (!XCHUNK_PAGE_PURGEABLE(xclass_ptr->xslice_size))
+        {
+            continue;
+        }
+
+        // 只处理 XCHUNK_LIST_PART 链表（空闲 chunk 对象由保留上限与衰减策略处理）
+        for (xchunk_ptr  = XCLASS_LIST_FRONT(xclass_ptr, XCHUNK_LIST_PART);
+             xchunk_ptr != XCLASS_LIST_TAIL(xclass_ptr, XCHUNK_LIST_PART);
+             xchunk_ptr  = xchunk_ptr->xlist_node.xchunk_next)
+        {
+            xut_pages += xchunk_purge_pages(xchunk_ptr);
+        }
+    }
+
+    xmpool_ptr->xsize_pgpurged += xut_pages * XMEM_PAGE_SIZE;
+
+    return (xut_pages * XMEM_PAGE_SIZE);
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -64,6 +64,111 @@ typedef x_void_t (* xfunc_free_t)(x_void_t * xchunk_ptr,
                                   x_handle_t xht_owner,
                                   x_handle_t xht_context);
 
+/**
+ * @brief 原地（不移动起始地址）调整堆内存块大小的函数类型。
+ * 
+ * @param [in ] xchunk_ptr  : 待调整的堆内存块。
+ * @param [in ] xst_size    : 堆内存块当前的大小。
+ * @param [in ] xst_resize  : 调整后的大小。
+ * @param [in ] xht_owner   : 持有该堆内存块的标识句柄。
+ * @param [in ] xht_context : 回调的上下文标识句柄。
+ * 
+ * @return x_bool_t
+ *         - 成功，返回 X_TRUE；
+ *         - 失败，返回 X_FALSE，堆内存块保持不变。
+ */
+typedef x_bool_t (* xfunc_resize_t)(x_void_t * xchunk_ptr,
+                                    x_size_t xst_size,
+                                    x_size_t xst_resize,
+                                    x_handle_t xht_owner,
+                                    x_handle_t xht_context);
+
+/**
+ * @enum  xmpool_flags
+ * @brief 创建内存池对象时可选的标识位（参看 @see xmpool_create_ex()）。
+ */
+typedef enum xmpool_flags
+{
+    XMPOOL_FLAG_NONE        = 0x00000000, ///< 默认模式
+    XMPOOL_FLAG_ALIGN_CHUNK = 0x00000001, ///< chunk 按 XMPOOL_CHUNK_ALIGN 对齐，以地址掩码定位分片所属 chunk
+    XMPOOL_FLAG_CACHE_ALIGN = 0x00000002, ///< 不小于 XMPOOL_CACHE_LINE 的分片，均按 XMPOOL_CACHE_LINE 对齐
+    XMPOOL_FLAG_MAGAZINE    = 0x00000004, ///< 各分类以分片弹匣作为 申请/回收 的前端缓存
+    XMPOOL_FLAG_LIFO        = 0x00000008, ///< chunk 对象中的空闲分片按 后进先出 分配（参看 xmpool_set_lifo()）
+} xmpool_flags;
+
+/**
+ * XMPOOL_FLAG_ALIGN_CHUNK 模式下，chunk 对象起始地址的对齐值（1 MB），
+ * 不小于所有分类 chunk 对象的大小。
+ */
+#define XMPOOL_CHUNK_ALIGN  (1024 * 1024)
+
+/** XMPOOL_FLAG_CACHE_ALIGN 模式下，分片地址的对齐值（缓存行大小） */
+#define XMPOOL_CACHE_LINE   64
+
+/** 默认每个分类最多保留的 空闲 chunk 对象数量（参看 xmpool_set_retain()） */
+#define XMPOOL_RETAIN_CHUNKS    8
+
+/** 默认内存池最多保留的 空闲 chunk 对象总大小（参看 xmpool_set_retain()） */
+#define XMPOOL_RETAIN_BYTES     (64ULL * 1024 * 1024)
+
+/** 默认大块缓存的总大小上限（参看 xmpool_set_large_cache()） */
+#define XMPOOL_LARGE_CACHE_BYTES  (32ULL * 1024 * 1024)
+
+/** 大块缓存最多缓存的 chunk 对象数量 */
+#define XMPOOL_LARGE_CACHE_COUNT  16
+
+/** 自定义分类表（参看 xmpool_create_classes()）的分类数量上限 */
+#define XMPOOL_CLASS_MAX_COUNT    88
+
+/** 自定义分类表中，分片大小的上限（更大的分片按大块 chunk 对象管理） */
+#define XMPOOL_CLASS_MAX_SIZE     (64 * 1024)
+
+/**
+ * @struct xmpool_class_t
+ * @brief  自定义分类表（参看 xmpool_create_classes()）中，单个分类的描述信息。
+ */
+typedef struct xmpool_class_t
+{
+    x_uint32_t xslice_size;   ///< 分片大小（8 的倍数，不大于 XMPOOL_CLASS_MAX_SIZE）
+    x_uint32_t xchunk_size;   ///< chunk 大小（为 0 时，随 chunk 数量自适应增长，否则固定使用该大小）
+} xmpool_class_t;
+
+/**
+ * @struct xmpool_class_stats_t
+ * @brief  内存池对象中，单个分类的统计信息（参看 xmpool_stats()）。
+ */
+typedef struct xmpool_class_stats_t
+{
+    x_uint32_t xslice_size;   ///< 分片大小
+    x_uint32_t xchunk_size;   ///< 最近选取的 chunk 大小（随 chunk 数量自适应增长或回落）
+    x_uint64_t xalloc_count;  ///< 累计申请的分片数量
+    x_uint64_t xfree_count;   ///< 累计回收的分片数量（含其他线程回收的）
+    x_uint64_t xlive_count;   ///< 正在使用的分片数量
+    x_uint64_t xslow_count;   ///< 申请时当前 chunk 对象未命中（进入慢速路径）的次数
+    x_uint64_t xround_bytes;  ///< 申请大小向上对齐到分片大小所累计损失的字节数
+    x_uint32_t xchunk_busy;   ///< 分片已全部分配出去的 chunk 对象数量
+    x_uint32_t xchunk_part;   ///< 部分分片已分配出去的 chunk 对象数量
+    x_uint32_t xchunk_idle;   ///< 没有分片被分配出去的 chunk 对象数量
+    x_uint32_t xmag_count;    ///< 分片弹匣中缓存的分片数量（XMPOOL_FLAG_MAGAZINE 模式）
+} xmpool_class_stats_t;
+
+/**
+ * @struct xmpool_stats_t
+ * @brief  内存池对象的统计信息快照（参看 xmpool_stats()）。
+ */
+typedef struct xmpool_stats_t
+{
+    x_uint64_t xsize_cached;  ///< 总共缓存的内存大小（同 xmpool_cached_size()）
+    x_uint64_t xsize_valid;   ///< 可使用到的缓存大小（同 xmpool_valid_size()）
+    x_uint64_t xsize_using;   ///< 正在使用的缓存大小（同 xmpool_using_size()）
+    x_uint64_t xlarge_alloc;  ///< 累计申请的大块分片数量
+    x_uint64_t xlarge_free;   ///< 累计回收的大块分片数量
+    x_uint32_t xlarge_cached; ///< 大块缓存中的 chunk 对象数量
+    x_uint32_t xclass_count;  ///< 分类数量（xclass_stats 中的有效项数）
+
+    xmpool_class_stats_t xclass_stats[XMPOOL_CLASS_MAX_COUNT]; ///< 各个分类的统计信息
+} xmpool_stats_t;
+
 /** 内存池对象的结构体声明 */
 struct xmem_pool_t;
 
@@ -78,6 +183,44 @@ typedef struct xmem_pool_t * xmpool_handle_t;
  */
 x_uint32_t xmem_align_size(x_uint32_t xut_size);
 
+/**********************************************************/
+/**
+ * @brief 按分片大小计算分类的（固定大小的）chunk 对象方案。
+ * @note
+ * 在 [256 KB, 1 MB] 范围内（按 XMEM_PAGE_SIZE 递增），选取未使用字节数最少的 chunk 大小，
+ * 且容量不超过 0x7FFF 个分片；供离线生成分类表的工具（xmem_classgen）使用。
+ * 未指定 chunk 大小的分类不使用此方案：其 chunk 大小从 16 KB（至少容纳 4 个分片）起，
+ * 随分类的 chunk 数量逐级倍增，最大至 4 MB（XMPOOL_FLAG_ALIGN_CHUNK 模式下为 XMPOOL_CHUNK_ALIGN）。
+ * 
+ * @param [in ] xslice_size : 分片大小（不大于 XMPOOL_CLASS_MAX_SIZE）。
+ * @param [out] xchunk_size : 返回 chunk 对象大小（可为 X_NULL）。
+ * @param [out] xut_unused  : 返回 chunk 对象中未使用到的字节数（可为 X_NULL）。
+ * 
+ * @return x_uint32_t
+ *         - 返回 chunk 对象可容纳的分片数量（xslice_size 无效时，返回 0）。
+ */
+x_uint32_t xmem_chunk_layout(x_uint32_t xslice_size,
+                             x_uint32_t * xchunk_size,
+                             x_uint32_t * xut_unused);
+
+/**********************************************************/
+/**
+ * @brief 从文本中解析分类表（xmem_classgen 工具输出的可加载格式）。
+ * @note
+ * 文本中每行为一个分类：“分片大小 chunk大小”（chunk 大小可省略，即为 0），
+ * 以 '#' 开头的行为注释；解析的结果可直接传给 xmpool_create_classes()（由其校验）。
+ * 
+ * @param [in ] xtext_ptr    : 以 '\0' 结尾的文本。
+ * @param [out] xclass_table : 存放解析结果的分类表。
+ * @param [in ] xut_max      : xclass_table 的容量（分类数量）。
+ * 
+ * @return x_uint32_t
+ *         - 返回解析到的分类数量；文本格式错误或分类数量超出 xut_max 时，返回 0。
+ */
+x_uint32_t xmpool_parse_classes(const x_char_t * xtext_ptr,
+                                xmpool_class_t * xclass_table,
+                                x_uint32_t xut_max);
+
 /**********************************************************/
 /**
  * @brief 创建 内存池对象。
@@ -93,12 +236,90 @@ x_uint32_t xmem_align_size(x_uint32_t xut_size);
 xmpool_handle_t xmpool_create(
     xfunc_alloc_t xfunc_alloc, xfunc_free_t xfunc_free, x_handle_t xht_context);
 
+/**********************************************************/
+/**
+ * @brief 创建 内存池对象（可指定工作模式）。
+ * @note
+ * 指定 XMPOOL_FLAG_ALIGN_CHUNK 时：
+ * - xfunc_alloc 返回的内存块须按 XMPOOL_CHUNK_ALIGN 对齐，
+ *   xfunc_alloc/xfunc_free 为 X_NULL 时，默认使用系统的对齐映射内存；
+ * - 回收分类分片时，以地址掩码直接定位 chunk 对象（O(1)，无需查找红黑树，
+ *   非工作线程也无需加锁），掩码时会读取对齐地址处的内容，因此传入的分片须隶属于
+ *   某个（XMPOOL_FLAG_ALIGN_CHUNK 模式的）内存池对象；大块分片仍由红黑树确认。
+ * 
+ * 指定 XMPOOL_FLAG_CACHE_ALIGN 时，xmpool_alloc() 对不小于 XMPOOL_CACHE_LINE
+ * 的申请大小，只选用分片大小为 XMPOOL_CACHE_LINE 整数倍的分类，
+ * 使得分片之间不共享缓存行（代价是每个分片至多多占用 XMPOOL_CACHE_LINE - 8 字节）。
+ * 
+ * 指定 XMPOOL_FLAG_MAGAZINE 时，每个分类持有一个分片弹匣（可直接分配的分片指针数组），
+ * 工作线程中的 xmpool_alloc()/xmpool_recyc()/xmpool_recyc_sized() 优先由弹匣出入分片，
+ * 弹匣空/满时，再以批量的方式从 chunk 对象补充或归还至 chunk 对象：
+ * - 弹匣中的分片不计入 xmpool_using_size()，在 chunk 对象中仍标识为“已分配”，
+ *   xmpool_release_unused()/xmpool_destroy() 会先清空弹匣；
+ * - 重复回收仍在弹匣中的分片，只在调试版本中可被检出（XASSERT）。
+ * 
+ * 指定 XMPOOL_FLAG_LIFO 时，所有分类的初始分配次序为 后进先出（参看 xmpool_set_lifo()）。
+ * 
+ * @param [in ] xfunc_alloc : 申请堆内存块的接口。
+ * @param [in ] xfunc_free  : 释放堆内存块的接口。
+ * @param [in ] xht_context : 调用 xfunc_alloc/xfunc_free 时回调的上下文句柄。
+ * @param [in ] xut_flags   : 工作模式标识位（参看 @see xmpool_flags 枚举值）。
+ * 
+ * @return xmpool_handle_t
+ *         - 成功，返回 内存池对象 的操作句柄。
+ *         - 失败，返回 X_NULL。
+ */
+xmpool_handle_t xmpool_create_ex(
+    xfunc_alloc_t xfunc_alloc, xfunc_free_t xfunc_free,
+    x_handle_t xht_context, x_uint32_t xut_flags);
+
+/**********************************************************/
+/**
+ * @brief 以自定义的分类表创建 内存池对象。
+ * @note
+ * 默认的分类表（88 个分类，8 ~ 65536 字节）面向通用的大小分布，
+ * 申请大小集中在少数几个值（如 40、72、200 字节）的场景，可按实际分布指定分类，
+ * 减少分片大小向上取整带来的浪费。创建时由分类表生成 大小 -> 分类 的查找表，
+ * 之后的 申请/回收 路径与默认分类表相同（一次查表）。
+ * 分类表须满足以下条件，否则创建失败：
+ * - 分类数量在 [1, XMPOOL_CLASS_MAX_COUNT] 范围内，分片大小严格递增，
+ *   均为 8 的倍数，且不大于 XMPOOL_CLASS_MAX_SIZE；
+ * - xchunk_size 不为 0 时，须按 XMEM_PAGE_SIZE 对齐、不大于 XMPOOL_CHUNK_ALIGN，
+ *   可容纳 1 ~ 0x7FFF 个分片，并且分片之前的（头部、索引号队列与余量）字节数不超过 0xFFFF；
+ * - 指定 XMPOOL_FLAG_CACHE_ALIGN 时，不小于 XMPOOL_CACHE_LINE 的分片大小，
+ *   须为 XMPOOL_CACHE_LINE 的整数倍。
+ * 大于最大分类的申请，按大块 chunk 对象管理（与默认分类表中大于 65536 字节的申请相同）。
+ * xclass_table 为 X_NULL 时，等同于 xmpool_create_ex()。
+ * 
+ * @param [in ] xfunc_alloc  : 申请堆内存块的接口。
+ * @param [in ] xfunc_free   : 释放堆内存块的接口。
+ * @param [in ] xht_context  : 调用 xfunc_alloc/xfunc_free 时回调的上下文句柄。
+ * @param [in ] xut_flags    : 工作模式标识位（参看 @see xmpool_flags 枚举值）。
+ * @param [in ] xclass_table : 分类表（按分片大小升序排列）。
+ * @param [in ] xut_count    : 分类表的分类数量。
+ * 
+ * @return xmpool_handle_t
+ *         - 成功，返回 内存池对象 的操作句柄。
+ *         - 失败（或分类表无效），返回 X_NULL。
+ */
+xmpool_handle_t xmpool_create_classes(
+    xfunc_alloc_t xfunc_alloc, xfunc_free_t xfunc_free,
+    x_handle_t xht_context, x_uint32_t xut_flags,
+    const xmpool_class_t * xclass_table, x_uint32_t xut_count);
+
 /**********************************************************/
 /**
  * @brief 销毁内存池对象。
  */
 x_void_t xmpool_destroy(xmpool_handle_t xmpool_ptr);
 
+/**********************************************************/
+/**
+ * @brief 按内存池对象的分类表，计算申请大小对齐后（实际分配）的分片大小。
+ * @note  默认分类表的内存池对象，与 xmem_align_size() 的结果相同（XMPOOL_FLAG_CACHE_ALIGN 模式除外）。
+ */
+x_uint32_t xmpool_align_size(xmpool_handle_t xmpool_ptr, x_uint32_t xut_size);
+
 /**********************************************************/
 /**
  * @brief 内存池对象 所隶属的工作线程 ID。
@@ -111,6 +332,132 @@ x_uint32_t xmpool_worktid(xmpool_handle_t xmpool_ptr);
  */
 x_void_t xmpool_set_worktid(xmpool_handle_t xmpool_ptr, x_uint32_t xut_worktid);
 
+/**********************************************************/
+/**
+ * @brief 在 fork() 之前，锁定 内存池对象 中供其他线程查找 chunk 的旋转锁。
+ * @note
+ * 使子进程得到的红黑树处于一致的状态（参看 pthread_atfork()），
+ * 之后须在父进程与子进程中分别调用 xmpool_fork_unlock()。
+ */
+x_void_t xmpool_fork_lock(xmpool_handle_t xmpool_ptr);
+
+/**********************************************************/
+/**
+ * @brief 在 fork() 之后，解除 xmpool_fork_lock() 的锁定。
+ */
+x_void_t xmpool_fork_unlock(xmpool_handle_t xmpool_ptr);
+
+/**********************************************************/
+/**
+ * @brief 设置 内存池对象 原地调整（大块分片所在）堆内存块大小的接口。
+ * @note
+ * 使用默认的 xfunc_alloc/xfunc_free 接口创建的内存池对象，已设置默认的接口；
+ * 未设置（X_NULL）时，xmpool_realloc() 对大块分片的扩展只能 申请 + 复制。
+ */
+x_void_t xmpool_set_resize(xmpool_handle_t xmpool_ptr, xfunc_resize_t xfunc_resize);
+
+/**********************************************************/
+/**
+ * @brief 设置 内存池对象 保留 空闲 chunk 对象（无分片被分配出去）的上限。
+ * @note
+ * 创建内存池对象时，默认为 XMPOOL_RETAIN_CHUNKS 与 XMPOOL_RETAIN_BYTES，
+ * 通常在 xmpool_create()/xmpool_create_ex() 之后立即设置。
+ * 工作线程回收分片使得 chunk 对象转入空闲状态后，超出上限的（最早空闲的）
+ * chunk 对象即被释放，而不必等到 xmpool_release_unused()；
+ * 在工作线程中调用时，会立即按新的上限释放多余的 空闲 chunk 对象。
+ * 
+ * @param [in ] xmpool_ptr  : 内存池对象的操作句柄。
+ * @param [in ] xut_chunks  : 每个分类最多保留的 空闲 chunk 对象数量。
+ * @param [in ] xsize_bytes : 内存池最多保留的 空闲 chunk 对象总大小。
+ */
+x_void_t xmpool_set_retain(xmpool_handle_t xmpool_ptr,
+                           x_uint32_t xut_chunks,
+                           x_uint64_t xsize_bytes);
+
+/**********************************************************/
+/**
+ * @brief 设置 内存池对象 大块缓存的总大小上限。
+ * @note
+ * 大于最大分类（默认分类表为 XSLICE_SIZE_65536）的大块分片各自独占一个 chunk 对象，回收时不再立即释放，
+ * 而是放入大块缓存（最多 XMPOOL_LARGE_CACHE_COUNT 个，超出上限时释放最早回收的），
+ * 之后申请大块分片时按最佳适配复用，省去 xfunc_alloc/xfunc_free 的调用；
+ * 单个 chunk 对象大于上限的 1/4 时不缓存。创建内存池对象时，默认为 XMPOOL_LARGE_CACHE_BYTES，
+ * 设置为 0 时不缓存；在工作线程中调用时，会立即按新的上限释放多余的缓存。
+ * xmpool_release_unused() 会清空大块缓存；xmpool_tick() 也按半衰期衰减其允许保留的大小，
+ * 长时间未被复用的大块缓存逐步（从最早回收的开始）释放。
+ * 
+ * @param [in ] xmpool_ptr  : 内存池对象的操作句柄。
+ * @param [in ] xsize_bytes : 大块缓存的总大小上限。
+ */
+x_void_t xmpool_set_large_cache(xmpool_handle_t xmpool_ptr, x_uint64_t xsize_bytes);
+
+/**********************************************************/
+/**
+ * @brief 设置分类中（chunk 对象内）被回收分片的再分配次序。
+ * @note
+ * 默认为 先进先出：刚回收的分片排在队尾，紧密的 申请/回收 循环会轮转遍历整个 chunk 对象；
+ * 后进先出 时，优先分配最近回收的（仍在 CPU 缓存中的）分片，较早回收的分片保持冷态，
+ * 其分页也更容易被 xmpool_purge_pages() 归还。
+ * 只能在工作线程中调用；已在队列中的分片不受影响，之后的分配按新的次序进行。
+ * 
+ * @param [in ] xmpool_ptr : 内存池对象的操作句柄。
+ * @param [in ] xut_size   : 分类的（申请）大小，为 0 时，设置所有分类。
+ * @param [in ] xbt_lifo   : X_TRUE 为 后进先出，X_FALSE 为 先进先出。
+ * 
+ * @return x_bool_t
+ *         - 成功，返回 X_TRUE；
+ *         - xut_size 大于最大分类的分片大小时，返回 X_FALSE。
+ */
+x_bool_t xmpool_set_lifo(xmpool_handle_t xmpool_ptr, x_uint32_t xut_size, x_bool_t xbt_lifo);
+
+/**********************************************************/
+/**
+ * @brief 设置 内存池对象 空闲 chunk 对象按时间衰减归还系统的半衰期。
+ * @note
+ * 创建内存池对象时，默认为 XMEM_DECAY_MS；设置为 0 时，xmpool_tick() 不做任何操作。
+ * 
+ * @param [in ] xmpool_ptr   : 内存池对象的操作句柄。
+ * @param [in ] xut_decay_ms : 半衰期（毫秒）。
+ */
+x_void_t xmpool_set_decay(xmpool_handle_t xmpool_ptr, x_uint32_t xut_decay_ms);
+
+/**********************************************************/
+/**
+ * @brief 设置 内存池对象 所使用的堆内存剖析器（参看 xmem_prof.h），为 X_NULL 时停止采样。
+ * @note
+ * 只在工作线程中调用。设置后，xmpool_alloc()、xmpool_alloc_aligned()、
+ * xmpool_alloc_batch() 平均每申请 xmprof_interval() 字节采样一次，记录其调用栈，
+ * 被采样的分片回收（含其他线程回收后由工作线程取回）时删除其记录；
+ * 未设置剖析器时，申请接口只多一次指针判断。
+ * 更换或解除剖析器时，原剖析器中属于该内存池对象的记录一并删除。
+ * 
+ * @param [in ] xmpool_ptr : 内存池对象的操作句柄。
+ * @param [in ] xmprof_ptr : 堆内存剖析器（可被多个内存池对象共用）。
+ */
+x_void_t xmpool_set_profiler(xmpool_handle_t xmpool_ptr, xmprof_handle_t xmprof_ptr);
+
+/**********************************************************/
+/**
+ * @brief 按时间衰减策略，将 内存池对象 中的 空闲 chunk 对象逐步归还给系统。
+ * @note
+ * 只在工作线程中执行（其他线程调用时直接返回 0），通常由工作线程周期性调用。
+ * 空闲 chunk 对象分两个阶段归还：
+ * 1. 先以 xsys_heap_purge() 归还物理内存（保留地址映射，再次使用时无需重新申请）；
+ * 2. 已归还物理内存的，再释放其地址空间（xfunc_free）。
+ * 每个阶段允许保留的大小，按半衰期随时间指数衰减，
+ * 而上次调用后新进入该阶段的大小全部计入允许保留的大小，
+ * 故刚转入空闲状态的 chunk 对象不会被立即归还，长时间闲置的则逐步归还。
+ * 其他线程对其分片的回收操作尚在进行中的 chunk 对象不做处理，留待之后的调用。
+ * 大块缓存按同样的方式衰减：超出允许保留大小的，从最早回收的开始释放。
+ * 
+ * @param [in ] xmpool_ptr : 内存池对象的操作句柄。
+ * @param [in ] xut_now    : 当前的时间点（毫秒，通常为 xsys_msecs() 的返回值）。
+ * 
+ * @return x_uint64_t
+ *         - 返回本次归还给系统的（物理内存或地址空间的）内存大小。
+ */
+x_uint64_t xmpool_tick(xmpool_handle_t xmpool_ptr, x_uint64_t xut_now);
+
 /**********************************************************/
 /**
  * @brief 内存池对象 总共缓存的内存大小。
@@ -129,6 +476,27 @@ x_uint64_t xmpool_valid_size(xmpool_handle_t xmpool_ptr);
  */
 x_uint64_t xmpool_using_size(xmpool_handle_t xmpool_ptr);
 
+/**********************************************************/
+/**
+ * @brief 内存池对象 非空闲 chunk 对象中，按分页归还了物理内存的大小
+ *        （参看 xmpool_purge_pages()）。
+ */
+x_uint64_t xmpool_pgpurged_size(xmpool_handle_t xmpool_ptr);
+
+/**********************************************************/
+/**
+ * @brief 获取内存池对象的统计信息快照（只在工作线程中调用）。
+ * @note
+ * 各分类的计数均为内存池对象的普通字段，只在工作线程中更新，
+ * 不使用原子操作，可在生产环境中常开；
+ * 其他线程回收的分片，在工作线程取回后才计入（本接口会先行取回）。
+ * 分类的慢速路径命中率为 xslow_count / xalloc_count。
+ * 
+ * @param [in ] xmpool_ptr : 内存池对象的操作句柄。
+ * @param [out] xstats_ptr : 返回的统计信息。
+ */
+x_void_t xmpool_stats(xmpool_handle_t xmpool_ptr, xmpool_stats_t * xstats_ptr);
+
 /**********************************************************/
 /**
  * @brief 申请内存分片。
@@ -145,6 +513,9 @@ xmem_slice_t xmpool_alloc(xmpool_handle_t xmpool_ptr, x_uint32_t xut_size);
 /**********************************************************/
 /**
  * @brief 回收内存分片。
+ * @note
+ * 允许在非工作线程中调用，此时分片只被（无锁地）压入其所在 chunk 对象的
+ * 待回收分片栈，由工作线程在 xmpool_alloc()/xmpool_release_unused() 中取回。
  * 
  * @param [in ] xmpool_ptr : 内存池对象的操作句柄。
  * @param [in ] xmem_slice : 待回收的内存分片。
@@ -155,12 +526,155 @@ xmem_slice_t xmpool_alloc(xmpool_handle_t xmpool_ptr, x_uint32_t xut_size);
  */
 x_int32_t xmpool_recyc(xmpool_handle_t xmpool_ptr, xmem_slice_t xmem_slice);
 
+/**********************************************************/
+/**
+ * @brief 重新调整内存分片的大小（只能在工作线程中调用）。
+ * @note
+ * - 新旧大小属于同一分类时，直接返回原分片；
+ * - 大块分片（大于 64 KB）在其 chunk 对象的尾部余量内，或经 xfunc_resize 接口
+ *   原地扩展/收缩其 chunk 对象时，也返回原分片；
+ * - 否则 申请新分片 + 复制 + 回收原分片。
+ *
+ * @param [in ] xmpool_ptr : 内存池对象的操作句柄。
+ * @param [in ] xmem_slice : 原内存分片（为 X_NULL 时，等同于 xmpool_alloc()）。
+ * @param [in ] xut_size   : 新的分片大小（为 0 时，等同于 xmpool_recyc()，并返回 X_NULL）。
+ *
+ * @return xmem_slice_t
+ *         - 成功，返回 内存分片（可能与 xmem_slice 相同）；
+ *         - 失败，返回 X_NULL，此时 xmem_slice 仍然有效。
+ */
+xmem_slice_t xmpool_realloc(xmpool_handle_t xmpool_ptr,
+                            xmem_slice_t xmem_slice,
+                            x_uint32_t xut_size);
+
+/**********************************************************/
+/**
+ * @brief 按指定的对齐值申请内存分片。
+ * @note
+ * 要求 xfunc_alloc 返回的堆内存块按 XMEM_PAGE_SIZE 对齐（默认接口与 xmem_heap 均满足），
+ * 返回的分片即为分片的起始地址，可直接使用 xmpool_recyc() 等接口
+ * （使用 xmpool_recyc_sized() 时，大小参数为 X_ALIGN(xut_size, xut_align)）。
+ *
+ * @param [in ] xmpool_ptr : 内存池对象的操作句柄。
+ * @param [in ] xut_size   : 申请的内存分片大小。
+ * @param [in ] xut_align  : 对齐值（须为 2 的幂，且不大于 XMEM_PAGE_SIZE）。
+ *
+ * @return xmem_slice_t
+ *         - 成功，返回 内存分片；
+ *         - 失败，返回 X_NULL 。
+ */
+xmem_slice_t xmpool_alloc_aligned(xmpool_handle_t xmpool_ptr,
+                                  x_uint32_t xut_size,
+                                  x_uint32_t xut_align);
+
+/**********************************************************/
+/**
+ * @brief 按申请时的大小回收内存分片（如 C++ 的 sized operator delete）。
+ * @note
+ * 以分片大小所属的分类缩小 chunk 对象的查找范围，回收开销不随 chunk 对象的数量增长；
+ * 调试版本中，会校验 xut_size 与分片的实际分类是否一致。
+ *
+ * @param [in ] xmpool_ptr : 内存池对象的操作句柄。
+ * @param [in ] xmem_slice : 待回收的内存分片。
+ * @param [in ] xut_size   : 申请该分片时的大小。
+ *
+ * @return x_int32_t
+ *         - 成功，返回 XMEM_ERR_OK；
+ *         - 失败，返回 错误码（参看 @see xmem_err_code 枚举值）。
+ */
+x_int32_t xmpool_recyc_sized(xmpool_handle_t xmpool_ptr,
+                             xmem_slice_t xmem_slice,
+                             x_uint32_t xut_size);
+
+/**********************************************************/
+/**
+ * @brief 批量申请（同一大小的）内存分片。
+ * @note  只做一次分类查找，并在每个 chunk 对象中一次性取出尽可能多的分片。
+ *
+ * @param [in ] xmpool_ptr : 内存池对象的操作句柄。
+ * @param [in ] xut_size   : 申请的内存分片大小。
+ * @param [in ] xut_count  : 申请的分片数量。
+ * @param [out] xslice_vec : 存放所申请到的分片的数组（至少 xut_count 个元素）。
+ *
+ * @return x_uint32_t
+ *         - 返回申请到的分片数量，小于 xut_count 时，表示堆内存不足。
+ */
+x_uint32_t xmpool_alloc_batch(xmpool_handle_t xmpool_ptr,
+                              x_uint32_t xut_size,
+                              x_uint32_t xut_count,
+                              xmem_slice_t * xslice_vec);
+
+/**********************************************************/
+/**
+ * @brief 批量回收内存分片。
+ * @note
+ * 同一 chunk 对象中的连续分片只查找一次 chunk 对象；允许在非工作线程中调用，
+ * 此时同一 chunk 对象的连续分片以一次原子操作压入其待回收分片栈。
+ *
+ * @param [in ] xmpool_ptr : 内存池对象的操作句柄。
+ * @param [in ] xslice_vec : 待回收的内存分片数组（不可包含 X_NULL）。
+ * @param [in ] xut_count  : 待回收的分片数量。
+ *
+ * @return x_uint32_t
+ *         - 返回成功回收的分片数量，小于 xut_count 时，表示存在无效分片。
+ */
+x_uint32_t xmpool_recyc_batch(xmpool_handle_t xmpool_ptr,
+                              xmem_slice_t * xslice_vec,
+                              x_uint32_t xut_count);
+
+/**********************************************************/
+/**
+ * @brief 查询内存分片的（可使用的）容量大小。
+ * @note  允许在非工作线程中调用。
+ * 
+ * @param [in ] xmpool_ptr : 内存池对象的操作句柄。
+ * @param [in ] xmem_slice : 所查询的内存分片。
+ * 
+ * @return x_uint32_t
+ *         - 成功，返回 分片容量大小；
+ *         - 失败，返回 0，分片不隶属于该内存池对象。
+ */
+x_uint32_t xmpool_slice_size(xmpool_handle_t xmpool_ptr, xmem_slice_t xmem_slice);
+
+/**********************************************************/
+/**
+ * @brief 查询（内存分片内部的）地址所在内存分片的起始地址。
+ * @note  允许在非工作线程中调用。
+ * 
+ * @param [in ] xmpool_ptr : 内存池对象的操作句柄。
+ * @param [in ] xmem_addr  : 所查询的地址。
+ * 
+ * @return xmem_slice_t
+ *         - 成功，返回 分片起始地址；
+ *         - 失败，返回 X_NULL，地址不在该内存池对象的分片中。
+ */
+xmem_slice_t xmpool_slice_head(xmpool_handle_t xmpool_ptr, xmem_slice_t xmem_addr);
+
 /**********************************************************/
 /**
  * @brief 释放内存池中未使用的缓存块。
  */
 x_void_t xmpool_release_unused(xmpool_handle_t xmpool_ptr);
 
+/**********************************************************/
+/**
+ * @brief 将部分使用中的 chunk 对象内，空闲分片所完整覆盖的分页归还物理内存。
+ * @note
+ * 只要仍有一个分片在使用，chunk 对象就不能被 xmpool_release_unused() 释放；
+ * 对于分片大小不小于 XMEM_PAGE_SIZE 的分类（默认分类表中为 XSLICE_SIZE__4096 ~ XSLICE_SIZE_65536），
+ * 此操作找出 XCHUNK_LIST_PART 链表中各个 chunk 对象内，由连续的空闲分片完整覆盖的分页，
+ * 以 xsys_heap_discard() 归还其物理内存，分片对象不会被移动。
+ * - 每个 chunk 对象以位标识数组记录已归还的分页，重复调用不会重复处理和计数；
+ * - 分片再次被分配出去时，清除其所覆盖分页的标识位，这些分页在被访问时由系统重新提供；
+ * - 只在工作线程中有效（非工作线程调用时直接返回 0），会先清空各个分类的分片弹匣。
+ * 
+ * @param [in ] xmpool_ptr : 内存池对象的操作句柄。
+ * 
+ * @return x_uint64_t
+ *         - 返回本次新归还物理内存的大小。
+ */
+x_uint64_t xmpool_purge_pages(xmpool_handle_t xmpool_ptr);
+
 ////////////////////////////////////////////////////////////////////////////////
 
 #ifdef __cplusplus
@@ -0,0 +1,333 @@
+﻿/**
+ * @file    xmem_preload.c
+ * <pre>
+ * Copyright (c) 2019, Gaaagaa All rights reserved.
+ *
+ * 文件名称：xmem_preload.c
+ * 创建日期：2026年10月18日
+ * 文件标识：
+ * 文件摘要：以 xmem_malloc() 等接口替换 C 标准库内存分配接口的 LD_PRELOAD 动态库。
+ *
+ * 编译方式：
+ *   gcc -O2 -fPIC -shared -ftls-model=initial-exec -o libxmem_preload.so \
+ *       xmem_preload.c xmem_malloc.c xmem_pool.c xmem_heap.c xmem_prof.c xrbtree.c -lpthread
+ *
+ * 使用方式：
+ *   LD_PRELOAD=/path/to/libxmem_preload.so ./app
+ *
+ * 堆内存采样剖析（参看 xmem_prof_start()）：
+ *   XMEM_PROF_INTERVAL=524288 XMEM_PROF_FILE=app.heap LD_PRELOAD=... ./app
+ *   进程退出时将仍在使用中的被采样内存输出至 XMEM_PROF_FILE（默认为 xmem.heap），
+ *   之后使用 pprof -top ./app app.heap 查看。
+ *
+ * 当前版本：1.0.0.0
+ * 作    者：
+ * 完成日期：2026年10月18日
+ * 版本摘要：
+ *
+ * 历史版本：
+ * 原作者  ：
+ * 完成日期：
+ * 版本摘要：
+ * </pre>
+ */
+
+#include "xmem_comm.h"
+
+#ifndef __GNUC__
+#error "xmem_preload.c only supports the GNUC (ELF/LD_PRELOAD) platform"
+#endif // __GNUC__
+
+#include <errno.h>
+#include <stdlib.h>
+#include <malloc.h>
+
+////////////////////////////////////////////////////////////////////////////////
+
+/** 自举内存区的大小 */
+#define XPRELOAD_ARENA_SIZE   (256 * 1024)
+
+/** 申请内存时的对齐值（与 glibc 的 malloc() 保持一致） */
+#define XPRELOAD_ALIGN        16
+
+/** 申请内存的导出接口的属性 */
+#define XPRELOAD_EXPORT       __attribute__((visibility("default")))
+
+/**
+ * @brief 自举内存区：在分配器内部（如初始化过程中）重入申请内存接口时使用，
+ *        其中的内存只分配，不回收。
+ */
+static x_byte_t X_arena_buf[XPRELOAD_ARENA_SIZE] __attribute__((aligned(XPRELOAD_ALIGN)));
+
+/** 自举内存区已分配的字节数 */
+static volatile x_uint32_t X_arena_used = 0;
+
+/** 当前线程是否正处于分配器内部 */
+static __thread x_uint32_t X_tls_inside __attribute__((tls_model("initial-exec"))) = 0;
+
+/** 判断地址是否位于自举内存区中 */
+#define XPRELOAD_IN_ARENA(xmem_ptr)                     \
+    (((x_byte_t *)(xmem_ptr) >= X_arena_buf) &&         \
+     ((x_byte_t *)(xmem_ptr) <  (X_arena_buf + XPRELOAD_ARENA_SIZE)))
+
+/** 自举内存区中，内存地址前部记录的内存大小 */
+#define XPRELOAD_ARENA_SIZE_OF(xmem_ptr) \
+    (*(x_size_t *)((x_byte_t *)(xmem_ptr) - XPRELOAD_ALIGN))
+
+////////////////////////////////////////////////////////////////////////////////
+
+//====================================================================
+
+//
+// internal calls
+//
+
+/**********************************************************/
+/**
+ * @brief 从自举内存区中申请内存（在内存地址前部记录其大小）。
+ */
+static x_void_t * xpreload_arena_alloc(x_size_t xst_size)
+{
+    x_byte_t * xmem_ptr  = X_NULL;
+    x_uint32_t xut_total = 0;
+    x_uint32_t xut_begin = 0;
+
+    if (xst_size > XPRELOAD_ARENA_SIZE)
+    {
+        return X_NULL;
+    }
+
+    xut_total = (x_uint32_t)X_ALIGN(xst_size, XPRELOAD_ALIGN) + XPRELOAD_ALIGN;
+    xut_begin = xatomic_add_32(&X_arena_used, xut_total);
+    if ((xut_begin + xut_total) > XPRELOAD_ARENA_SIZE)
+    {
+        return X_NULL;
+    }
+
+    xmem_ptr = X_arena_buf + xut_begin + XPRELOAD_ALIGN;
+    XPRELOAD_ARENA_SIZE_OF(xmem_ptr) = xst_size;
+
+    return xmem_ptr;
+}
+
+/**********************************************************/
+/**
+ * @brief 申请内存（按 XPRELOAD_ALIGN 对齐）。
+ */
+static x_void_t * xpreload_alloc(x_size_t xst_align, x_size_t xst_size)
+{
+    x_void_t * xmem_ptr = X_NULL;
+
+    // 分配器内部重入时，使用自举内存区，避免死锁或无限递归
+    if (0 != X_tls_inside)
+    {
+        return (xst_align <= XPRELOAD_ALIGN) ? xpreload_arena_alloc(xst_size) : X_NULL;
+    }
+
+    X_tls_inside = 1;
+
+    // 分片大小为 16 的倍数时，分片地址按 16 字节对齐
+    if (xst_size < XPRELOAD_ALIGN)
+        xst_size = XPRELOAD_ALIGN;
+    else if (xst_size < ((x_size_t)-1 - XPRELOAD_ALIGN))
+        xst_size = X_ALIGN(xst_size, XPRELOAD_ALIGN);
+
+    if (xst_align <= XPRELOAD_ALIGN)
+        xmem_ptr = xmem_malloc(xst_size);
+    else
+        xmem_ptr = xmem_memalign(xst_align, xst_size);
+
+    X_tls_inside = 0;
+
+    if (X_NULL == xmem_ptr)
+    {
+        errno = ENOMEM;
+    }
+
+    return xmem_ptr;
+}
+
+/**********************************************************/
+/**
+ * @brief 查询内存的可使用容量大小。
+ */
+static x_size_t xpreload_usable_size(x_void_t * xmem_ptr)
+{
+    if (X_NULL == xmem_ptr)
+    {
+        return 0;
+    }
+
+    if (XPRELOAD_IN_ARENA(xmem_ptr))
+    {
+        return XPRELOAD_ARENA_SIZE_OF(xmem_ptr);
+    }
+
+    return xmem_usable_size(xmem_ptr);
+}
+
+//====================================================================
+
+//
+// 导出的 C 标准库内存分配接口（函数原型须与 C 标准库完全一致）
+//
+
+XPRELOAD_EXPORT void * malloc(size_t xst_size)
+{
+    return xpreload_alloc(XPRELOAD_ALIGN, xst_size);
+}
+
+XPRELOAD_EXPORT void free(void * xmem_ptr)
+{
+    if ((X_NULL == xmem_ptr) || XPRELOAD_IN_ARENA(xmem_ptr))
+    {
+        return;
+    }
+
+    xmem_free(xmem_ptr);
+}
+
+XPRELOAD_EXPORT void * calloc(size_t xst_count, size_t xst_size)
+{
+    x_void_t * xmem_ptr = X_NULL;
+
+    if ((0 != xst_size) && (xst_count > (((x_size_t)-1) / xst_size)))
+    {
+        errno = ENOMEM;
+        return X_NULL;
+    }
+
+    xmem_ptr = xpreload_alloc(XPRELOAD_ALIGN, xst_count * xst_size);
+    if ((X_NULL != xmem_ptr) && !XPRELOAD_IN_ARENA(xmem_ptr))
+    {
+        memset(xmem_ptr, 0, xst_count * xst_size);
+    }
+
+    return xmem_ptr;
+}
+
+XPRELOAD_EXPORT void * realloc(void * xmem_ptr, size_t xst_size)
+{
+    x_void_t * xnew_ptr = X_NULL;
+    x_size_t   xst_used = 0;
+
+    if (X_NULL == xmem_ptr)
+    {
+        return malloc(xst_size);
+    }
+
+    if (0 == xst_size)
+    {
+        free(xmem_ptr);
+        return X_NULL;
+    }
+
+    xst_used = xpreload_usable_size(xmem_ptr);
+    if (!XPRELOAD_IN_ARENA(xmem_ptr) &&
+        (xst_size <= xst_used) && (xst_size >= (xst_used / 2)))
+    {
+        return xmem_ptr;
+    }
+
+    xnew_ptr = malloc(xst_size);
+    if (X_NULL != xnew_ptr)
+    {
+        memcpy(xnew_ptr, xmem_ptr, (xst_size < xst_used) ? xst_size : xst_used);
+        free(xmem_ptr);
+    }
+
+    return xnew_ptr;
+}
+
+XPRELOAD_EXPORT void * memalign(size_t xst_align, size_t xst_size)
+{
+    if ((0 == xst_align) || (0 != (xst_align & (xst_align - 1))))
+    {
+        errno = EINVAL;
+        return X_NULL;
+    }
+
+    return xpreload_alloc(xst_align, xst_size);
+}
+
+XPRELOAD_EXPORT int posix_memalign(void ** xmem_pptr,
+                                   size_t xst_align,
+                                   size_t xst_size)
+{
+    x_void_t * xmem_ptr = X_NULL;
+
+    if ((xst_align < sizeof(x_void_t *)) ||
+        (0 != (xst_align & (xst_align - 1))))
+    {
+        return EINVAL;
+    }
+
+    xmem_ptr = xpreload_alloc(xst_align, xst_size);
+    if (X_NULL == xmem_ptr)
+    {
+        return ENOMEM;
+    }
+
+    *xmem_pptr = xmem_ptr;
+    return 0;
+}
+
+XPRELOAD_EXPORT void * aligned_alloc(size_t xst_align, size_t xst_size)
+{
+    return memalign(xst_align, xst_size);
+}
+
+XPRELOAD_EXPORT void * valloc(size_t xst_size)
+{
+    return memalign(XMEM_PAGE_SIZE, xst_size);
+}
+
+XPRELOAD_EXPORT void * pvalloc(size_t xst_size)
+{
+    return memalign(XMEM_PAGE_SIZE, X_ALIGN(xst_size, XMEM_PAGE_SIZE));
+}
+
+XPRELOAD_EXPORT size_t malloc_usable_size(void * xmem_ptr)
+{
+    return xpreload_usable_size(xmem_ptr);
+}
+
+//====================================================================
+
+//
+// 堆内存采样剖析的启动与输出
+//
+
+/**********************************************************/
+/**
+ * @brief 动态库加载时，按环境变量 XMEM_PROF_INTERVAL（平均采样间隔字节数）启动采样。
+ */
+__attribute__((constructor)) static x_void_t xpreload_prof_init(void)
+{
+    const x_char_t * xenv_ptr = getenv("XMEM_PROF_INTERVAL");
+
+    if ((X_NULL != xenv_ptr) && ('\0' != xenv_ptr[0]))
+    {
+        xmem_prof_start((x_uint32_t)strtoul(xenv_ptr, X_NULL, 10));
+    }
+}
+
+/**********************************************************/
+/**
+ * @brief 进程退出时，将剖析结果输出至环境变量 XMEM_PROF_FILE 指定的文件（默认为 xmem.heap）。
+ */
+__attribute__((destructor)) static x_void_t xpreload_prof_fini(void)
+{
+    const x_char_t * xenv_ptr = getenv("XMEM_PROF_INTERVAL");
+    const x_char_t * xpath_ptr = getenv("XMEM_PROF_FILE");
+
+    if ((X_NULL == xenv_ptr) || ('\0' == xenv_ptr[0]))
+    {
+        return;
+    }
+
+    xmem_prof_dump(((X_NULL != xpath_ptr) && ('\0' != xpath_ptr[0])) ?
+                   xpath_ptr : "xmem.heap");
+}
+
+////////////////////////////////////////////////////////////////////////////////
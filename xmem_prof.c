@@ -0,0 +1,691 @@
+﻿/**
+ * @file    xmem_prof.c
+ * <pre>
+ * Copyright (c) 2019, Gaaagaa All rights reserved.
+ * 
+ * 文件名称：xmem_prof.c
+ * 创建日期：2026年10月18日
+ * 文件标识：
+ * 文件摘要：按申请字节数采样、记录调用栈的堆内存剖析器。
+ * 
+ * 当前版本：1.0.0.0
+ * 作    者：
+ * 完成日期：2026年10月18日
+ * 版本摘要：
+ * 
+ * 历史版本：
+ * 原作者  ：
+ * 完成日期：
+ * 版本摘要：
+ * </pre>
+ */
+
+#include "xmem_comm.h"
+
+#include <stdio.h>
+
+////////////////////////////////////////////////////////////////////////////////
+
+#ifdef __GNUC__
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wunused-function"
+#endif // __GNUC__
+
+////////////////////////////////////////////////////////////////////////////////
+
+/** 采样记录哈希表的桶数量（须为 2 的幂，桶数远多于记录数时，未命中的查找多数无需加锁） */
+#define XMPROF_BUCKET_BITS    14
+#define XMPROF_BUCKET_COUNT   (1 << XMPROF_BUCKET_BITS)
+
+/** 采样记录的内存块大小 */
+#define XMPROF_SLAB_SIZE      (64 * 1024)
+
+/** 捕获调用栈时，可略去的栈帧数量上限 */
+#define XMPROF_SKIP_MAX       16
+
+/**
+ * @struct xmprof_record_t
+ * @brief  被采样对象的记录。
+ */
+typedef struct xmprof_record_t
+{
+    struct xmprof_record_t * xnext_ptr;   ///< 哈希桶（或空闲链表）中的后继节点
+    x_void_t               * xmem_ptr;    ///< 对象地址
+    x_handle_t               xowner_ptr;  ///< 对象的持有者
+    x_uint64_t               xut_size;    ///< 对象大小
+    x_uint32_t               xut_depth;   ///< 调用栈深度
+    x_void_t               * xframe_vec[XMPROF_MAX_DEPTH]; ///< 调用栈的返回地址
+} xmprof_record_t;
+
+/**
+ * @struct xmprof_slab_t
+ * @brief  采样记录的内存块（直接向系统申请），头部之后为连续的记录节点。
+ */
+typedef struct xmprof_slab_t
+{
+    struct xmprof_slab_t * xnext_ptr;     ///< 后继内存块
+} xmprof_slab_t;
+
+/**
+ * @struct xmem_prof_t
+ * @brief  堆内存剖析器的结构体描述信息。
+ */
+typedef struct xmem_prof_t
+{
+    xatomic_lock_t      xspinlock;        ///< 记录表的同步旋转锁
+    volatile x_uint32_t xut_interval;     ///< 平均采样间隔（字节）
+    x_uint32_t          xut_count;        ///< 使用中的被采样对象数量
+    x_uint64_t          xut_size;         ///< 使用中的被采样对象总大小
+    xmprof_record_t   * xfree_list;       ///< 空闲的记录节点链表
+    xmprof_slab_t     * xslab_list;       ///< 记录节点的内存块链表
+    xmprof_record_t   * volatile xbucket_vec[XMPROF_BUCKET_COUNT]; ///< 记录哈希表
+} xmem_prof_t;
+
+////////////////////////////////////////////////////////////////////////////////
+
+/**********************************************************/
+/**
+ * @brief 对象地址在记录哈希表中的桶索引号。
+ */
+static inline x_uint32_t xmprof_bucket(x_void_t * xmem_ptr)
+{
+    x_uint64_t xut_hash = ((x_uint64_t)(x_size_t)xmem_ptr >> 4) *
+                          0x9E3779B97F4A7C15ULL;
+    return (x_uint32_t)(xut_hash >> (64 - XMPROF_BUCKET_BITS));
+}
+
+/**********************************************************/
+/**
+ * @brief 自然对数（x > 0），避免依赖 libm 的 log()。
+ * @note
+ * 按 IEEE 754 双精度的位模式拆分出 x = m * 2^e（m 位于 [1, 2)），
+ * ln(m) 使用 2 * atanh((m - 1) / (m + 1)) 的级数展开计算，
+ * 采样间隔只需要近似的指数分布，精度已足够。
+ */
+static x_lfloat_t xmprof_log(x_lfloat_t xlft_value)
+{
+    union
+    {
+        x_lfloat_t xlft_value;
+        x_uint64_t xut_bits;
+    } xbits;
+
+    x_int32_t  xit_exp = 0;
+    x_lfloat_t xlft_s   = 0.0;
+    x_lfloat_t xlft_s2  = 0.0;
+    x_lfloat_t xlft_sum = 0.0;
+    x_lfloat_t xlft_pow = 0.0;
+    x_int32_t  xit_iter;
+
+    xbits.xlft_value = xlft_value;
+    xit_exp = (x_int32_t)((xbits.xut_bits >> 52) & 0x7FF) - 1023;
+    xbits.xut_bits = (xbits.xut_bits & 0x000FFFFFFFFFFFFFULL) |
+                     0x3FF0000000000000ULL;
+
+    xlft_s   = (xbits.xlft_value - 1.0) / (xbits.xlft_value + 1.0);
+    xlft_s2  = xlft_s * xlft_s;
+    xlft_pow = xlft_s;
+    for (xit_iter = 1; xit_iter < 20; xit_iter += 2)
+    {
+        xlft_sum += xlft_pow / xit_iter;
+        xlft_pow *= xlft_s2;
+    }
+
+    return (2.0 * xlft_sum + xit_exp * 0.69314718055994530942);
+}
+
+/**********************************************************/
+/**
+ * @brief 申请一个空闲的记录节点（须在 xspinlock 的保护下调用）。
+ */
+static xmprof_record_t * xmprof_record_new(xmprof_handle_t xmprof_ptr)
+{
+    xmprof_slab_t   * xslab_ptr   = X_NULL;
+    xmprof_record_t * xrecord_ptr = X_NULL;
+    x_uint32_t        xut_iter    = 0;
+    x_uint32_t        xut_count   = 0;
+
+    //======================================
+
+    if (X_NULL == xmprof_ptr->xfree_list)
+    {
+        xslab_ptr = (xmprof_slab_t *)xsys_heap_alloc(XMPROF_SLAB_SIZE);
+        if (X_NULL == xslab_ptr)
+        {
+            return X_NULL;
+        }
+
+        xslab_ptr->xnext_ptr   = xmprof_ptr->xslab_list;
+        xmprof_ptr->xslab_list = xslab_ptr;
+
+        xrecord_ptr = (xmprof_record_t *)X_ALIGN(
+                        (x_size_t)(xslab_ptr + 1), sizeof(x_size_t));
+        xut_count = (x_uint32_t)(((x_byte_t *)xslab_ptr + XMPROF_SLAB_SIZE -
+                                  (x_byte_t *)xrecord_ptr) /
+                                 sizeof(xmprof_record_t));
+        for (xut_iter = 0; xut_iter < xut_count; ++xut_iter)
+        {
+            xrecord_ptr[xut_iter].xnext_ptr = xmprof_ptr->xfree_list;
+            xmprof_ptr->xfree_list = &xrecord_ptr[xut_iter];
+        }
+    }
+
+    xrecord_ptr = xmprof_ptr->xfree_list;
+    xmprof_ptr->xfree_list = xrecord_ptr->xnext_ptr;
+
+    //======================================
+
+    return xrecord_ptr;
+}
+
+/**********************************************************/
+/**
+ * @brief 按调用栈比较两条记录（xmprof_dump() 中排序使用）。
+ */
+static int xmprof_record_cmp(const void * xlhs_ptr, const void * xrhs_ptr)
+{
+    const xmprof_record_t * xlhs = (const xmprof_record_t *)xlhs_ptr;
+    const xmprof_record_t * xrhs = (const xmprof_record_t *)xrhs_ptr;
+    x_uint32_t xut_iter;
+
+    if (xlhs->xut_depth != xrhs->xut_depth)
+        return (xlhs->xut_depth < xrhs->xut_depth) ? -1 : 1;
+
+    for (xut_iter = 0; xut_iter < xlhs->xut_depth; ++xut_iter)
+    {
+        if (xlhs->xframe_vec[xut_iter] != xrhs->xframe_vec[xut_iter])
+            return ((x_size_t)xlhs->xframe_vec[xut_iter] <
+                    (x_size_t)xrhs->xframe_vec[xut_iter]) ? -1 : 1;
+    }
+
+    return 0;
+}
+
+/**********************************************************/
+/**
+ * @brief 写入当前进程的内存映射信息（Linux 下为 /proc/self/maps 的内容）。
+ */
+static x_void_t xmprof_dump_maps(FILE * xfile_ptr)
+{
+#ifdef __linux__
+    FILE   * xmaps_ptr = fopen("/proc/self/maps", "r");
+    x_char_t xbuffer[4096];
+    size_t   xst_read  = 0;
+
+    if (X_NULL == xmaps_ptr)
+    {
+        return;
+    }
+
+    while ((xst_read = fread(xbuffer, 1, sizeof(xbuffer), xmaps_ptr)) > 0)
+    {
+        fwrite(xbuffer, 1, xst_read, xfile_ptr);
+    }
+
+    fclose(xmaps_ptr);
+#else // !__linux__
+    XASSERT(X_NULL != xfile_ptr);
+#endif // __linux__
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+/**********************************************************/
+/**
+ * @brief 创建 堆内存剖析器。
+ * @note
+ * 剖析器内部以旋转锁保护采样记录表，可被多个 内存池对象/堆内存管理对象 共用
+ * （参看 xmpool_set_profiler()/xmheap_set_profiler()）；
+ * 记录表的内存直接向系统申请，不经过被剖析的分配器。
+ * 
+ * @param [in ] xut_interval : 平均采样间隔（字节，为 0 时暂停采样）。
+ * 
+ * @return xmprof_handle_t
+ *         - 成功，返回 剖析器句柄；
+ *         - 失败，返回 X_NULL。
+ */
+xmprof_handle_t xmprof_create(x_uint32_t xut_interval)
+{
+    xmprof_handle_t xmprof_ptr = X_NULL;
+    x_void_t      * xframe_vec[4];
+
+    //======================================
+
+    xmprof_ptr = (xmprof_handle_t)xsys_heap_alloc(sizeof(xmem_prof_t));
+    if (X_NULL == xmprof_ptr)
+    {
+        return X_NULL;
+    }
+
+    memset(xmprof_ptr, 0, sizeof(xmem_prof_t));
+    xmprof_ptr->xut_interval = xut_interval;
+
+    // 预先完成 xsys_backtrace() 的初始化（glibc 下首次调用会加载
+    // libgcc_s 并申请内存），避免在分配器内部采样时重入
+    xsys_backtrace(xframe_vec, 4);
+
+    //======================================
+
+    return xmprof_ptr;
+}
+
+/**********************************************************/
+/**
+ * @brief 销毁 堆内存剖析器。
+ * @note  须在所有使用该剖析器的对象解除关联（或销毁）之后调用。
+ */
+x_void_t xmprof_destroy(xmprof_handle_t xmprof_ptr)
+{
+    xmprof_slab_t * xslab_ptr = X_NULL;
+
+    if (X_NULL == xmprof_ptr)
+    {
+        return;
+    }
+
+    while (X_NULL != xmprof_ptr->xslab_list)
+    {
+        xslab_ptr = xmprof_ptr->xslab_list;
+        xmprof_ptr->xslab_list = xslab_ptr->xnext_ptr;
+        xsys_heap_free(xslab_ptr, XMPROF_SLAB_SIZE);
+    }
+
+    xsys_heap_free(xmprof_ptr, sizeof(xmem_prof_t));
+}
+
+/**********************************************************/
+/**
+ * @brief 设置平均采样间隔（字节，为 0 时暂停采样，已采样的对象仍跟踪至其被释放）。
+ * @note  各个使用者在其下一次采样之后，才按新的间隔计算。
+ */
+x_void_t xmprof_set_interval(xmprof_handle_t xmprof_ptr, x_uint32_t xut_interval)
+{
+    XASSERT(X_NULL != xmprof_ptr);
+    xmprof_ptr->xut_interval = xut_interval;
+}
+
+/**********************************************************/
+/**
+ * @brief 平均采样间隔（字节）。
+ */
+x_uint32_t xmprof_interval(xmprof_handle_t xmprof_ptr)
+{
+    XASSERT(X_NULL != xmprof_ptr);
+    return xmprof_ptr->xut_interval;
+}
+
+/**********************************************************/
+/**
+ * @brief 计算距离下一次采样的字节数。
+ * @note
+ * 采样点之间的间隔服从均值为采样间隔的指数分布，
+ * 即每个字节被采样的概率均为 1 / 采样间隔（与 tcmalloc、jemalloc 的方式相同），
+ * 使用者按申请的字节数递减该值，减至负数时进行一次采样。
+ * 
+ * @param [in    ] xmprof_ptr : 剖析器句柄。
+ * @param [in,out] xut_seed   : 使用者自身的随机数状态（首次使用时可为 0）。
+ * 
+ * @return x_int64_t
+ *         - 返回距离下一次采样的字节数（暂停采样时，返回 XMPROF_NEVER）。
+ */
+x_int64_t xmprof_next_sample(xmprof_handle_t xmprof_ptr, x_uint64_t * xut_seed)
+{
+    x_uint32_t xut_interval = xmprof_ptr->xut_interval;
+    x_uint64_t xut_rand     = *xut_seed;
+    x_lfloat_t xlft_unit     = 0.0;
+
+    //======================================
+
+    if (0 == xut_interval)
+    {
+        return XMPROF_NEVER;
+    }
+
+    if (0 == xut_rand)
+    {
+        xut_rand = ((x_uint64_t)(x_size_t)xut_seed * 0x9E3779B97F4A7C15ULL) ^
+                   xsys_msecs() ^ 0x2545F4914F6CDD1DULL;
+    }
+
+    // xorshift64
+    xut_rand ^= xut_rand << 13;
+    xut_rand ^= xut_rand >> 7;
+    xut_rand ^= xut_rand << 17;
+    *xut_seed = xut_rand;
+
+    // 取高 53 位，得到 (0, 1] 区间的均匀分布值
+    xlft_unit = (x_lfloat_t)((xut_rand >> 11) + 1) * (1.0 / 9007199254740992.0);
+
+    //======================================
+
+    return (x_int64_t)(-xmprof_log(xlft_unit) * xut_interval) + 1;
+}
+
+/**********************************************************/
+/**
+ * @brief 记录一个被采样的对象（捕获当前的调用栈）。
+ * 
+ * @param [in ] xmprof_ptr : 剖析器句柄。
+ * @param [in ] xowner_ptr : 对象的持有者（参看 xmprof_erase_owner()）。
+ * @param [in ] xmem_ptr   : 对象地址。
+ * @param [in ] xut_size   : 对象大小。
+ * @param [in ] xut_skip   : 调用栈顶部略去的（分配器内部的）栈帧数量。
+ * 
+ * @return x_bool_t
+ *         - 成功，返回 X_TRUE；
+ *         - 失败（记录表内存不足），返回 X_FALSE。
+ */
+x_bool_t xmprof_record(xmprof_handle_t xmprof_ptr,
+                       x_handle_t xowner_ptr,
+                       x_void_t * xmem_ptr,
+                       x_uint64_t xut_size,
+                       x_uint32_t xut_skip)
+{
+    x_void_t        * xframe_vec[XMPROF_MAX_DEPTH + XMPROF_SKIP_MAX + 1];
+    x_int32_t         xit_depth   = 0;
+    x_uint32_t        xut_bucket  = 0;
+    xmprof_record_t * xrecord_ptr = X_NULL;
+
+    //======================================
+    // 在锁外捕获调用栈（连同本函数自身的栈帧一并略去）
+
+    if (xut_skip > XMPROF_SKIP_MAX)
+        xut_skip = XMPROF_SKIP_MAX;
+    xut_skip += 1;
+
+    xit_depth = xsys_backtrace(xframe_vec, XMPROF_MAX_DEPTH + (x_int32_t)xut_skip);
+    if (xit_depth > (x_int32_t)xut_skip)
+        xit_depth -= (x_int32_t)xut_skip;
+    else
+        xit_depth = xut_skip = 0;
+
+    //======================================
+
+    xut_bucket = xmprof_bucket(xmem_ptr);
+
+    xatomic_spin_lock(&xmprof_ptr->xspinlock);
+
+    xrecord_ptr = xmprof_record_new(xmprof_ptr);
+    if (X_NULL == xrecord_ptr)
+    {
+        xatomic_spin_unlock(&xmprof_ptr->xspinlock);
+        return X_FALSE;
+    }
+
+    xrecord_ptr->xmem_ptr   = xmem_ptr;
+    xrecord_ptr->xowner_ptr = xowner_ptr;
+    xrecord_ptr->xut_size   = xut_size;
+    xrecord_ptr->xut_depth  = (x_uint32_t)xit_depth;
+    memcpy(xrecord_ptr->xframe_vec,
+           xframe_vec + xut_skip,
+           xit_depth * sizeof(x_void_t *));
+
+    xrecord_ptr->xnext_ptr = xmprof_ptr->xbucket_vec[xut_bucket];
+    xmprof_ptr->xbucket_vec[xut_bucket] = xrecord_ptr;
+
+    xmprof_ptr->xut_count += 1;
+    xmprof_ptr->xut_size  += xut_size;
+
+    xatomic_spin_unlock(&xmprof_ptr->xspinlock);
+
+    //======================================
+
+    return X_TRUE;
+}
+
+/**********************************************************/
+/**
+ * @brief 被采样的对象释放时，删除其记录。
+ * 
+ * @return x_bool_t
+ *         - 找到并删除了记录，返回 X_TRUE；
+ *         - 否则，返回 X_FALSE。
+ */
+x_bool_t xmprof_erase(xmprof_handle_t xmprof_ptr, x_void_t * xmem_ptr)
+{
+    xmprof_record_t * volatile * xlink_ptr = X_NULL;
+    xmprof_record_t            * xrecord_ptr = X_NULL;
+
+    //======================================
+    // 对象的记录总是先于其释放操作插入（同一线程，或经由传递对象地址时的同步），
+    // 故桶为空时可直接判定未命中：chunk 对象中只要有分片被采样，
+    // 其所有分片回收时都会调用本接口，此处避免了绝大多数的加锁操作
+
+    xlink_ptr = &xmprof_ptr->xbucket_vec[xmprof_bucket(xmem_ptr)];
+    if (X_NULL == *xlink_ptr)
+    {
+        return X_FALSE;
+    }
+
+    xatomic_spin_lock(&xmprof_ptr->xspinlock);
+
+    while (X_NULL != (xrecord_ptr = *xlink_ptr))
+    {
+        if (xrecord_ptr->xmem_ptr == xmem_ptr)
+        {
+            *xlink_ptr = xrecord_ptr->xnext_ptr;
+
+            xmprof_ptr->xut_count -= 1;
+            xmprof_ptr->xut_size  -= xrecord_ptr->xut_size;
+
+            xrecord_ptr->xnext_ptr = xmprof_ptr->xfree_list;
+            xmprof_ptr->xfree_list = xrecord_ptr;
+            break;
+        }
+
+        xlink_ptr = &xrecord_ptr->xnext_ptr;
+    }
+
+    xatomic_spin_unlock(&xmprof_ptr->xspinlock);
+
+    //======================================
+
+    return (X_NULL != xrecord_ptr);
+}
+
+/**********************************************************/
+/**
+ * @brief 删除指定持有者的所有记录（持有者销毁或与剖析器解除关联时调用）。
+ */
+x_void_t xmprof_erase_owner(xmprof_handle_t xmprof_ptr, x_handle_t xowner_ptr)
+{
+    xmprof_record_t * volatile * xlink_ptr = X_NULL;
+    xmprof_record_t            * xrecord_ptr = X_NULL;
+    x_uint32_t                   xut_iter    = 0;
+
+    //======================================
+
+    xatomic_spin_lock(&xmprof_ptr->xspinlock);
+
+    for (xut_iter = 0; xut_iter < XMPROF_BUCKET_COUNT; ++xut_iter)
+    {
+        xlink_ptr = &xmprof_ptr->xbucket_vec[xut_iter];
+        while (X_NULL != (xrecord_ptr = *xlink_ptr))
+        {
+            if (xrecord_ptr->xowner_ptr != xowner_ptr)
+            {
+                xlink_ptr = &xrecord_ptr->xnext_ptr;
+                continue;
+            }
+
+            *xlink_ptr = xrecord_ptr->xnext_ptr;
+
+            xmprof_ptr->xut_count -= 1;
+            xmprof_ptr->xut_size  -= xrecord_ptr->xut_size;
+
+            xrecord_ptr->xnext_ptr = xmprof_ptr->xfree_list;
+            xmprof_ptr->xfree_list = xrecord_ptr;
+        }
+    }
+
+    xatomic_spin_unlock(&xmprof_ptr->xspinlock);
+
+    //======================================
+}
+
+/**********************************************************/
+/**
+ * @brief 当前仍在使用中的被采样对象数量。
+ */
+x_uint32_t xmprof_live_count(xmprof_handle_t xmprof_ptr)
+{
+    XASSERT(X_NULL != xmprof_ptr);
+    return xmprof_ptr->xut_count;
+}
+
+/**********************************************************/
+/**
+ * @brief 当前仍在使用中的被采样对象总大小（未按采样率放大）。
+ */
+x_uint64_t xmprof_live_size(xmprof_handle_t xmprof_ptr)
+{
+    XASSERT(X_NULL != xmprof_ptr);
+    return xmprof_ptr->xut_size;
+}
+
+/**********************************************************/
+/**
+ * @brief 在 fork() 之前锁定记录表。
+ */
+x_void_t xmprof_fork_lock(xmprof_handle_t xmprof_ptr)
+{
+    XASSERT(X_NULL != xmprof_ptr);
+    xatomic_spin_lock(&xmprof_ptr->xspinlock);
+}
+
+/**********************************************************/
+/**
+ * @brief 在 fork() 之后，解除 xmprof_fork_lock() 的锁定。
+ */
+x_void_t xmprof_fork_unlock(xmprof_handle_t xmprof_ptr)
+{
+    XASSERT(X_NULL != xmprof_ptr);
+    xatomic_spin_unlock(&xmprof_ptr->xspinlock);
+}
+
+/**********************************************************/
+/**
+ * @brief 将仍在使用中的被采样对象，按调用栈汇总后输出至文件。
+ * @note
+ * 输出为 pprof 可直接读取的（gperftools 旧版文本格式）heap 剖析文件：
+ * 首行为 "heap profile: ... @ heap_v2/采样间隔"，pprof 据此按采样率还原估算值；
+ * 之后每行为一个调用栈的 "对象数: 字节数 [对象数: 字节数] @ 返回地址..."
+ * （只跟踪使用中的对象，方括号中的累计申请数据与之相同）；
+ * Linux 下末尾附上 /proc/self/maps 的内容（MAPPED_LIBRARIES），供 pprof 解析符号。
+ * 例如：pprof -top ./app heap.prof
+ * 
+ * @param [in ] xmprof_ptr : 剖析器句柄。
+ * @param [in ] xpath_ptr  : 输出的文件路径。
+ * 
+ * @return x_int32_t
+ *         - 成功，返回 XMEM_ERR_OK；
+ *         - 失败，返回 错误码。
+ */
+x_int32_t xmprof_dump(xmprof_handle_t xmprof_ptr, const x_char_t * xpath_ptr)
+{
+    xmprof_record_t * xrecord_ptr = X_NULL;
+    xmprof_record_t * xsnap_vec   = X_NULL;
+    x_size_t          xst_snap    = 0;
+    x_uint32_t        xut_count   = 0;
+    x_uint32_t        xut_iter    = 0;
+    x_uint32_t        xut_jter    = 0;
+    x_uint32_t        xut_depth   = 0;
+    x_uint64_t        xut_size    = 0;
+    FILE            * xfile_ptr   = X_NULL;
+
+    //======================================
+    // 在锁内复制记录的快照，之后的排序与文件操作都在锁外进行
+
+    for (;;)
+    {
+        xut_count = xmprof_ptr->xut_count;
+        xst_snap  = X_ALIGN((xut_count + 1) * sizeof(xmprof_record_t),
+                            XMEM_PAGE_SIZE);
+        xsnap_vec = (xmprof_record_t *)xsys_heap_alloc(xst_snap);
+        if (X_NULL == xsnap_vec)
+        {
+            return XMEM_ERR_UNKNOW;
+        }
+
+        xatomic_spin_lock(&xmprof_ptr->xspinlock);
+        if (xmprof_ptr->xut_count <= xut_count + 1)
+            break;
+        xatomic_spin_unlock(&xmprof_ptr->xspinlock);
+
+        xsys_heap_free(xsnap_vec, xst_snap);
+    }
+
+    xut_count = 0;
+    for (xut_iter = 0; xut_iter < XMPROF_BUCKET_COUNT; ++xut_iter)
+    {
+        for (xrecord_ptr  = xmprof_ptr->xbucket_vec[xut_iter];
+             xrecord_ptr != X_NULL;
+             xrecord_ptr  = xrecord_ptr->xnext_ptr)
+        {
+            memcpy(&xsnap_vec[xut_count++], xrecord_ptr, sizeof(xmprof_record_t));
+        }
+    }
+
+    xatomic_spin_unlock(&xmprof_ptr->xspinlock);
+
+    qsort(xsnap_vec, xut_count, sizeof(xmprof_record_t), xmprof_record_cmp);
+
+    //======================================
+
+    xfile_ptr = fopen(xpath_ptr, "w");
+    if (X_NULL == xfile_ptr)
+    {
+        xsys_heap_free(xsnap_vec, xst_snap);
+        return XMEM_ERR_UNKNOW;
+    }
+
+    for (xut_iter = 0; xut_iter < xut_count; ++xut_iter)
+    {
+        xut_size += xsnap_vec[xut_iter].xut_size;
+    }
+
+    fprintf(xfile_ptr,
+            "heap profile: %6u: %8llu [%6u: %8llu] @ heap_v2/%u\n",
+            xut_count, (unsigned long long)xut_size,
+            xut_count, (unsigned long long)xut_size,
+            xmprof_ptr->xut_interval);
+
+    for (xut_iter = 0; xut_iter < xut_count; xut_iter = xut_jter)
+    {
+        xut_size = 0;
+        for (xut_jter = xut_iter; xut_jter < xut_count; ++xut_jter)
+        {
+            if (0 != xmprof_record_cmp(&xsnap_vec[xut_iter], &xsnap_vec[xut_jter]))
+                break;
+            xut_size += xsnap_vec[xut_jter].xut_size;
+        }
+
+        fprintf(xfile_ptr,
+                "%6u: %8llu [%6u: %8llu] @",
+                xut_jter - xut_iter, (unsigned long long)xut_size,
+                xut_jter - xut_iter, (unsigned long long)xut_size);
+        for (xut_depth = 0; xut_depth < xsnap_vec[xut_iter].xut_depth; ++xut_depth)
+        {
+            fprintf(xfile_ptr, " %p", xsnap_vec[xut_iter].xframe_vec[xut_depth]);
+        }
+        fprintf(xfile_ptr, "\n");
+    }
+
+    fprintf(xfile_ptr, "\nMAPPED_LIBRARIES:\n");
+    xmprof_dump_maps(xfile_ptr);
+
+    fclose(xfile_ptr);
+    xsys_heap_free(xsnap_vec, xst_snap);
+
+    //======================================
+
+    return XMEM_ERR_OK;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+#ifdef __GNUC__
+#pragma GCC diagnostic pop
+#endif // __GNUC__
+
+////////////////////////////////////////////////////////////////////////////////
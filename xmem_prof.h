@@ -0,0 +1,197 @@
+﻿/**
+ * @file    xmem_prof.h
+ * <pre>
+ * Copyright (c) 2019, Gaaagaa All rights reserved.
+ * 
+ * 文件名称：xmem_prof.h
+ * 创建日期：2026年10月18日
+ * 文件标识：
+ * 文件摘要：按申请字节数采样、记录调用栈的堆内存剖析器。
+ * 
+ * 当前版本：1.0.0.0
+ * 作    者：
+ * 完成日期：2026年10月18日
+ * 版本摘要：
+ * 
+ * 历史版本：
+ * 原作者  ：
+ * 完成日期：
+ * 版本摘要：
+ * </pre>
+ */
+
+#ifndef __XMEM_PROF_H__
+#define __XMEM_PROF_H__
+
+#ifndef __XMEM_COMM_H__
+#error "Please include xmem_comm.h"
+#endif // __XMEM_COMM_H__
+
+////////////////////////////////////////////////////////////////////////////////
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif // __cplusplus
+
+////////////////////////////////////////////////////////////////////////////////
+
+/** 采样记录的调用栈最大深度 */
+#define XMPROF_MAX_DEPTH      32
+
+/** 默认的平均采样间隔（字节） */
+#define XMPROF_INTERVAL       (512 * 1024)
+
+/** 采样间隔为 0（暂停采样）时，xmprof_next_sample() 的返回值 */
+#define XMPROF_NEVER          ((x_int64_t)0x7FFFFFFFFFFFFFFFLL)
+
+/** 堆内存剖析器的结构体声明 */
+struct xmem_prof_t;
+
+/** 堆内存剖析器的句柄类型 */
+typedef struct xmem_prof_t * xmprof_handle_t;
+
+////////////////////////////////////////////////////////////////////////////////
+
+/**********************************************************/
+/**
+ * @brief 创建 堆内存剖析器。
+ * @note
+ * 剖析器内部以旋转锁保护采样记录表，可被多个 内存池对象/堆内存管理对象 共用
+ * （参看 xmpool_set_profiler()/xmheap_set_profiler()）；
+ * 记录表的内存直接向系统申请，不经过被剖析的分配器。
+ * 
+ * @param [in ] xut_interval : 平均采样间隔（字节，为 0 时暂停采样）。
+ * 
+ * @return xmprof_handle_t
+ *         - 成功，返回 剖析器句柄；
+ *         - 失败，返回 X_NULL。
+ */
+xmprof_handle_t xmprof_create(x_uint32_t xut_interval);
+
+/**********************************************************/
+/**
+ * @brief 销毁 堆内存剖析器。
+ * @note  须在所有使用该剖析器的对象解除关联（或销毁）之后调用。
+ */
+x_void_t xmprof_destroy(xmprof_handle_t xmprof_ptr);
+
+/**********************************************************/
+/**
+ * @brief 设置平均采样间隔（字节，为 0 时暂停采样，已采样的对象仍跟踪至其被释放）。
+ * @note  各个使用者在其下一次采样之后，才按新的间隔计算。
+ */
+x_void_t xmprof_set_interval(xmprof_handle_t xmprof_ptr, x_uint32_t xut_interval);
+
+/**********************************************************/
+/**
+ * @brief 平均采样间隔（字节）。
+ */
+x_uint32_t xmprof_interval(xmprof_handle_t xmprof_ptr);
+
+/**********************************************************/
+/**
+ * @brief 计算距离下一次采样的字节数。
+ * @note
+ * 采样点之间的间隔服从均值为采样间隔的指数分布，
+ * 即每个字节被采样的概率均为 1 / 采样间隔（与 tcmalloc、jemalloc 的方式相同），
+ * 使用者按申请的字节数递减该值，减至负数时进行一次采样。
+ * 
+ * @param [in    ] xmprof_ptr : 剖析器句柄。
+ * @param [in,out] xut_seed   : 使用者自身的随机数状态（首次使用时可为 0）。
+ * 
+ * @return x_int64_t
+ *         - 返回距离下一次采样的字节数（暂停采样时，返回 XMPROF_NEVER）。
+ */
+x_int64_t xmprof_next_sample(xmprof_handle_t xmprof_ptr, x_uint64_t * xut_seed);
+
+/**********************************************************/
+/**
+ * @brief 记录一个被采样的对象（捕获当前的调用栈）。
+ * 
+ * @param [in ] xmprof_ptr : 剖析器句柄。
+ * @param [in ] xowner_ptr : 对象的持有者（参看 xmprof_erase_owner()）。
+ * @param [in ] xmem_ptr   : 对象地址。
+ * @param [in ] xut_size   : 对象大小。
+ * @param [in ] xut_skip   : 调用栈顶部略去的（分配器内部的）栈帧数量。
+ * 
+ * @return x_bool_t
+ *         - 成功，返回 X_TRUE；
+ *         - 失败（记录表内存不足），返回 X_FALSE。
+ */
+x_bool_t xmprof_record(xmprof_handle_t xmprof_ptr,
+                       x_handle_t xowner_ptr,
+                       x_void_t * xmem_ptr,
+                       x_uint64_t xut_size,
+                       x_uint32_t xut_skip);
+
+/**********************************************************/
+/**
+ * @brief 被采样的对象释放时，删除其记录。
+ * 
+ * @return x_bool_t
+ *         - 找到并删除了记录，返回 X_TRUE；
+ *         - 否则，返回 X_FALSE。
+ */
+x_bool_t xmprof_erase(xmprof_handle_t xmprof_ptr, x_void_t * xmem_ptr);
+
+/**********************************************************/
+/**
+ * @brief 删除指定持有者的所有记录（持有者销毁或与剖析器解除关联时调用）。
+ */
+x_void_t xmprof_erase_owner(xmprof_handle_t xmprof_ptr, x_handle_t xowner_ptr);
+
+/**********************************************************/
+/**
+ * @brief 当前仍在使用中的被采样对象数量。
+ */
+x_uint32_t xmprof_live_count(xmprof_handle_t xmprof_ptr);
+
+/**********************************************************/
+/**
+ * @brief 当前仍在使用中的被采样对象总大小（未按采样率放大）。
+ */
+x_uint64_t xmprof_live_size(xmprof_handle_t xmprof_ptr);
+
+/**********************************************************/
+/**
+ * @brief 在 fork() 之前锁定记录表（参看 pthread_atfork()），
+ *        之后须在父进程与子进程中分别调用 xmprof_fork_unlock()。
+ */
+x_void_t xmprof_fork_lock(xmprof_handle_t xmprof_ptr);
+
+/**********************************************************/
+/**
+ * @brief 在 fork() 之后，解除 xmprof_fork_lock() 的锁定。
+ */
+x_void_t xmprof_fork_unlock(xmprof_handle_t xmprof_ptr);
+
+/**********************************************************/
+/**
+ * @brief 将仍在使用中的被采样对象，按调用栈汇总后输出至文件。
+ * @note
+ * 输出为 pprof 可直接读取的（gperftools 旧版文本格式）heap 剖析文件：
+ * 首行为 "heap profile: ... @ heap_v2/采样间隔"，pprof 据此按采样率还原估算值；
+ * 之后每行为一个调用栈的 "对象数: 字节数 [对象数: 字节数] @ 返回地址..."
+ * （只跟踪使用中的对象，方括号中的累计申请数据与之相同）；
+ * Linux 下末尾附上 /proc/self/maps 的内容（MAPPED_LIBRARIES），供 pprof 解析符号。
+ * 例如：pprof -top ./app heap.prof
+ * 
+ * @param [in ] xmprof_ptr : 剖析器句柄。
+ * @param [in ] xpath_ptr  : 输出的文件路径。
+ * 
+ * @return x_int32_t
+ *         - 成功，返回 XMEM_ERR_OK；
+ *         - 失败，返回 错误码。
+ */
+x_int32_t xmprof_dump(xmprof_handle_t xmprof_ptr, const x_char_t * xpath_ptr);
+
+////////////////////////////////////////////////////////////////////////////////
+
+#ifdef __cplusplus
+}; // extern "C"
+#endif // __cplusplus
+
+////////////////////////////////////////////////////////////////////////////////
+
+#endif // __XMEM_PROF_H__